@@ -6,15 +6,21 @@
 enum BtDebugSubmenuIndex {
     BtDebugSubmenuIndexCarrierTest,
     BtDebugSubmenuIndexPacketTest,
+    BtDebugSubmenuIndexSerialStats,
 };
 
 void bt_debug_submenu_callback(void* context, uint32_t index) {
     furi_assert(context);
     BtDebugApp* app = context;
     if(index == BtDebugSubmenuIndexCarrierTest) {
+        // Radio tests need radio for themselves
+        furi_hal_bt_stop_advertising();
         view_dispatcher_switch_to_view(app->view_dispatcher, BtDebugAppViewCarrierTest);
     } else if(index == BtDebugSubmenuIndexPacketTest) {
+        furi_hal_bt_stop_advertising();
         view_dispatcher_switch_to_view(app->view_dispatcher, BtDebugAppViewPacketTest);
+    } else if(index == BtDebugSubmenuIndexSerialStats) {
+        view_dispatcher_switch_to_view(app->view_dispatcher, BtDebugAppViewSerialStats);
     }
 }
 
@@ -49,6 +55,12 @@ BtDebugApp* bt_debug_app_alloc() {
         app);
     submenu_add_item(
         app->submenu, "Packet test", BtDebugSubmenuIndexPacketTest, bt_debug_submenu_callback, app);
+    submenu_add_item(
+        app->submenu,
+        "Serial stats",
+        BtDebugSubmenuIndexSerialStats,
+        bt_debug_submenu_callback,
+        app);
     view_set_previous_callback(submenu_get_view(app->submenu), bt_debug_exit);
     view_dispatcher_add_view(
         app->view_dispatcher, BtDebugAppViewSubmenu, submenu_get_view(app->submenu));
@@ -65,6 +77,13 @@ BtDebugApp* bt_debug_app_alloc() {
         app->view_dispatcher,
         BtDebugAppViewPacketTest,
         bt_packet_test_get_view(app->bt_packet_test));
+    app->bt_serial_stats = bt_serial_stats_alloc();
+    view_set_previous_callback(
+        bt_serial_stats_get_view(app->bt_serial_stats), bt_debug_start_view);
+    view_dispatcher_add_view(
+        app->view_dispatcher,
+        BtDebugAppViewSerialStats,
+        bt_serial_stats_get_view(app->bt_serial_stats));
 
     // Switch to menu
     view_dispatcher_switch_to_view(app->view_dispatcher, BtDebugAppViewSubmenu);
@@ -82,6 +101,8 @@ void bt_debug_app_free(BtDebugApp* app) {
     bt_carrier_test_free(app->bt_carrier_test);
     view_dispatcher_remove_view(app->view_dispatcher, BtDebugAppViewPacketTest);
     bt_packet_test_free(app->bt_packet_test);
+    view_dispatcher_remove_view(app->view_dispatcher, BtDebugAppViewSerialStats);
+    bt_serial_stats_free(app->bt_serial_stats);
     view_dispatcher_free(app->view_dispatcher);
 
     // Close gui record
@@ -102,15 +123,13 @@ int32_t bt_debug_app(void* p) {
     }
 
     BtDebugApp* app = bt_debug_app_alloc();
-    // Was bt active?
+    // Was bt active? Radio tests stop advertising, serial stats need connection alive
     const bool was_active = furi_hal_bt_is_active();
-    // Stop advertising
-    furi_hal_bt_stop_advertising();
 
     view_dispatcher_run(app->view_dispatcher);
 
     // Restart advertising
-    if(was_active) {
+    if(was_active && !furi_hal_bt_is_active()) {
         furi_hal_bt_start_advertising();
     }
     bt_debug_app_free(app);
@@ -10,6 +10,7 @@
 
 #include "views/bt_carrier_test.h"
 #include "views/bt_packet_test.h"
+#include "views/bt_serial_stats.h"
 
 typedef struct {
     Gui* gui;
@@ -17,10 +18,12 @@ typedef struct {
     Submenu* submenu;
     BtCarrierTest* bt_carrier_test;
     BtPacketTest* bt_packet_test;
+    BtSerialStats* bt_serial_stats;
 } BtDebugApp;
 
 typedef enum {
     BtDebugAppViewSubmenu,
     BtDebugAppViewCarrierTest,
     BtDebugAppViewPacketTest,
+    BtDebugAppViewSerialStats,
 } BtDebugAppView;
@@ -0,0 +1,154 @@
+#include "bt_serial_stats.h"
+#include <gui/canvas.h>
+#include <furi.h>
+#include <furi_hal_bt_serial.h>
+
+struct BtSerialStats {
+    View* view;
+    FuriTimer* timer;
+    uint32_t last_bytes;
+    uint32_t last_tick;
+};
+
+typedef struct {
+    FuriHalBtSerialTxStats stats;
+    uint32_t rate;
+} BtSerialStatsModel;
+
+static uint32_t bt_serial_stats_ticks_to_ms(uint32_t ticks) {
+    return (uint64_t)ticks * 1000 / furi_kernel_get_tick_frequency();
+}
+
+static void bt_serial_stats_draw_callback(Canvas* canvas, void* _model) {
+    BtSerialStatsModel* model = _model;
+    FuriHalBtSerialTxStats* stats = &model->stats;
+    char buffer[64];
+
+    canvas_clear(canvas);
+    canvas_set_font(canvas, FontPrimary);
+    canvas_draw_str(canvas, 0, 10, "Serial TX");
+    canvas_set_font(canvas, FontSecondary);
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "%s, win %u",
+        stats->notifications ? "Notify" : "Indicate",
+        stats->window);
+    canvas_draw_str_aligned(canvas, 128, 10, AlignRight, AlignBottom, buffer);
+
+    snprintf(
+        buffer, sizeof(buffer), "Sent: %lu pkt, %lu KiB", stats->packets, stats->bytes / 1024);
+    canvas_draw_str(canvas, 0, 19, buffer);
+
+    snprintf(buffer, sizeof(buffer), "Rate: %lu B/s", model->rate);
+    canvas_draw_str(canvas, 0, 28, buffer);
+
+    uint32_t active_ms = bt_serial_stats_ticks_to_ms(stats->active_time);
+    uint32_t average = active_ms ? (uint64_t)stats->bytes * 1000 / active_ms : 0;
+    snprintf(buffer, sizeof(buffer), "Avg: %lu B/s", average);
+    canvas_draw_str(canvas, 0, 37, buffer);
+
+    uint32_t depth_x10 = stats->packets ? stats->in_flight_total * 10 / stats->packets : 0;
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "Depth: %u, max %u, avg %lu.%lu",
+        stats->in_flight,
+        stats->in_flight_max,
+        depth_x10 / 10,
+        depth_x10 % 10);
+    canvas_draw_str(canvas, 0, 46, buffer);
+
+    snprintf(buffer, sizeof(buffer), "Busy: %lu", stats->busy);
+    canvas_draw_str(canvas, 0, 55, buffer);
+
+    canvas_draw_str(canvas, 0, 64, "OK: reset");
+}
+
+static void bt_serial_stats_update(BtSerialStats* bt_serial_stats) {
+    FuriHalBtSerialTxStats stats;
+    furi_hal_bt_serial_get_tx_stats(&stats);
+
+    uint32_t tick = furi_get_tick();
+    uint32_t elapsed_ms = bt_serial_stats_ticks_to_ms(tick - bt_serial_stats->last_tick);
+    uint32_t rate = 0;
+    if(elapsed_ms && stats.bytes >= bt_serial_stats->last_bytes) {
+        rate = (uint64_t)(stats.bytes - bt_serial_stats->last_bytes) * 1000 / elapsed_ms;
+    }
+    bt_serial_stats->last_bytes = stats.bytes;
+    bt_serial_stats->last_tick = tick;
+
+    with_view_model(
+        bt_serial_stats->view,
+        BtSerialStatsModel * model,
+        {
+            model->stats = stats;
+            model->rate = rate;
+        },
+        true);
+}
+
+static void bt_serial_stats_timer_callback(void* context) {
+    furi_assert(context);
+    bt_serial_stats_update(context);
+}
+
+static bool bt_serial_stats_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    BtSerialStats* bt_serial_stats = context;
+    bool consumed = false;
+
+    if(event->type == InputTypeShort && event->key == InputKeyOk) {
+        furi_hal_bt_serial_reset_tx_stats();
+        bt_serial_stats->last_bytes = 0;
+        bt_serial_stats_update(bt_serial_stats);
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+static void bt_serial_stats_enter_callback(void* context) {
+    furi_assert(context);
+    BtSerialStats* bt_serial_stats = context;
+    FuriHalBtSerialTxStats stats;
+    furi_hal_bt_serial_get_tx_stats(&stats);
+    bt_serial_stats->last_bytes = stats.bytes;
+    bt_serial_stats->last_tick = furi_get_tick();
+    bt_serial_stats_update(bt_serial_stats);
+    furi_timer_start(bt_serial_stats->timer, furi_kernel_get_tick_frequency());
+}
+
+static void bt_serial_stats_exit_callback(void* context) {
+    furi_assert(context);
+    BtSerialStats* bt_serial_stats = context;
+    furi_timer_stop(bt_serial_stats->timer);
+}
+
+BtSerialStats* bt_serial_stats_alloc() {
+    BtSerialStats* bt_serial_stats = malloc(sizeof(BtSerialStats));
+    bt_serial_stats->view = view_alloc();
+    view_set_context(bt_serial_stats->view, bt_serial_stats);
+    view_allocate_model(bt_serial_stats->view, ViewModelTypeLocking, sizeof(BtSerialStatsModel));
+    view_set_draw_callback(bt_serial_stats->view, bt_serial_stats_draw_callback);
+    view_set_input_callback(bt_serial_stats->view, bt_serial_stats_input_callback);
+    view_set_enter_callback(bt_serial_stats->view, bt_serial_stats_enter_callback);
+    view_set_exit_callback(bt_serial_stats->view, bt_serial_stats_exit_callback);
+
+    bt_serial_stats->timer =
+        furi_timer_alloc(bt_serial_stats_timer_callback, FuriTimerTypePeriodic, bt_serial_stats);
+
+    return bt_serial_stats;
+}
+
+void bt_serial_stats_free(BtSerialStats* bt_serial_stats) {
+    furi_assert(bt_serial_stats);
+    furi_timer_free(bt_serial_stats->timer);
+    view_free(bt_serial_stats->view);
+    free(bt_serial_stats);
+}
+
+View* bt_serial_stats_get_view(BtSerialStats* bt_serial_stats) {
+    furi_assert(bt_serial_stats);
+    return bt_serial_stats->view;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <gui/view.h>
+
+typedef struct BtSerialStats BtSerialStats;
+
+BtSerialStats* bt_serial_stats_alloc();
+
+void bt_serial_stats_free(BtSerialStats* bt_serial_stats);
+
+View* bt_serial_stats_get_view(BtSerialStats* bt_serial_stats);
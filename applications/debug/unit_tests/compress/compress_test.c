@@ -0,0 +1,318 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <toolbox/compress.h>
+#include <gui/icon_i.h>
+#include <assets_icons.h>
+
+#include "../minunit.h"
+
+#define TAG "CompressTest"
+
+#define COMPRESS_TEST_CACHE_SIZE (4 * 1024)
+#define COMPRESS_TEST_MENU_REDRAWS (512)
+#define COMPRESS_TEST_MENU_REDRAWS_PER_ITEM (16)
+#define COMPRESS_TEST_DESKTOP_LOOPS (8)
+/* Animation frame change, then status bar update */
+#define COMPRESS_TEST_DESKTOP_REDRAWS_PER_FRAME (2)
+
+static const Icon* const compress_test_menu_icons[] = {
+    &A_Sub1ghz_14,
+    &A_125khz_14,
+    &A_NFC_14,
+    &A_Infrared_14,
+    &A_GPIO_14,
+    &A_iButton_14,
+    &A_BadUsb_14,
+    &A_U2F_14,
+    &A_Plugins_14,
+    &A_Debug_14,
+    &A_Settings_14,
+};
+
+static size_t compress_test_frame_size(const Icon* icon) {
+    return ((icon->width + 7) / 8) * icon->height;
+}
+
+/* Size of icon data as stored in firmware: header and payload */
+static size_t compress_test_data_size(const uint8_t* icon_data, size_t frame_size) {
+    if(icon_data[0]) {
+        return 4 + (icon_data[2] | (icon_data[3] << 8));
+    } else {
+        return 1 + frame_size;
+    }
+}
+
+/* Decode with cache and check result against uncached decoder */
+static bool compress_test_decode(
+    CompressIcon* compress_icon,
+    CompressIcon* reference_icon,
+    const Icon* icon,
+    size_t frame) {
+    const size_t frame_size = compress_test_frame_size(icon);
+    uint8_t* decoded = NULL;
+    uint8_t* reference = NULL;
+
+    compress_icon_decode(compress_icon, icon->frames[frame], &decoded);
+    compress_icon_decode(reference_icon, icon->frames[frame], &reference);
+    return memcmp(decoded, reference, frame_size) == 0;
+}
+
+/* Three visible items, only selected one is animated. Returns number of decodes. */
+static uint32_t compress_test_render_menu(
+    CompressIcon* compress_icon,
+    CompressIcon* reference_icon,
+    uint32_t* mismatches) {
+    const size_t count = COUNT_OF(compress_test_menu_icons);
+    uint32_t decodes = 0;
+
+    for(size_t i = 0; i < COMPRESS_TEST_MENU_REDRAWS; i++) {
+        size_t selected = (i / COMPRESS_TEST_MENU_REDRAWS_PER_ITEM) % count;
+        for(size_t shift = 0; shift < 3; shift++) {
+            const Icon* icon = compress_test_menu_icons[(selected + shift + count - 1) % count];
+            size_t frame = (shift == 1) ? (i % icon->frame_count) : 0;
+            if(!compress_test_decode(compress_icon, reference_icon, icon, frame)) {
+                (*mismatches)++;
+            }
+            decodes++;
+        }
+    }
+
+    return decodes;
+}
+
+static uint32_t compress_test_render_desktop(
+    CompressIcon* compress_icon,
+    CompressIcon* reference_icon,
+    const Icon* icon,
+    uint32_t* mismatches) {
+    uint32_t decodes = 0;
+
+    for(size_t loop = 0; loop < COMPRESS_TEST_DESKTOP_LOOPS; loop++) {
+        for(size_t frame = 0; frame < icon->frame_count; frame++) {
+            for(size_t i = 0; i < COMPRESS_TEST_DESKTOP_REDRAWS_PER_FRAME; i++) {
+                if(!compress_test_decode(compress_icon, reference_icon, icon, frame)) {
+                    (*mismatches)++;
+                }
+                decodes++;
+            }
+        }
+    }
+
+    return decodes;
+}
+
+MU_TEST(compress_icon_cache_test) {
+    const Icon* icon = &A_Levelup1_128x64;
+    const size_t frame_size = compress_test_frame_size(icon);
+    CompressIcon* compress_icon = compress_icon_alloc();
+    uint8_t* reference = malloc(frame_size);
+    uint8_t* decoded = NULL;
+    CompressIconCacheStats stats;
+
+    // Disabled by default
+    compress_icon_decode(compress_icon, icon->frames[0], &decoded);
+    memcpy(reference, decoded, frame_size);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.misses);
+    mu_assert_int_eq(0, stats.entries);
+
+    compress_icon_set_cache_size(compress_icon, COMPRESS_TEST_CACHE_SIZE);
+    compress_icon_decode(compress_icon, icon->frames[0], &decoded);
+    mu_assert_mem_eq(reference, decoded, frame_size);
+    compress_icon_decode(compress_icon, icon->frames[1], &decoded);
+    compress_icon_decode(compress_icon, icon->frames[0], &decoded);
+    mu_assert_mem_eq(reference, decoded, frame_size);
+
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(1, stats.hits);
+    mu_assert_int_eq(2, stats.misses);
+    mu_assert_int_eq(2, stats.entries);
+
+    // Room for a single frame: least recently used one goes
+    compress_icon_set_cache_size(compress_icon, frame_size + 64);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(1, stats.entries);
+    mu_assert_int_eq(1, stats.evictions);
+    compress_icon_decode(compress_icon, icon->frames[0], &decoded);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(2, stats.hits);
+    mu_check(stats.used <= frame_size + 64);
+
+    // Too big to be cached at all
+    compress_icon_set_cache_size(compress_icon, frame_size / 2);
+    compress_icon_decode(compress_icon, icon->frames[1], &decoded);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.entries);
+    mu_assert_int_eq(1, stats.uncached);
+
+    // Heap copies are never cached
+    size_t data_size = compress_test_data_size(icon->frames[0], frame_size);
+    uint8_t* heap_copy = malloc(data_size);
+    memcpy(heap_copy, icon->frames[0], data_size);
+    compress_icon_set_cache_size(compress_icon, COMPRESS_TEST_CACHE_SIZE);
+    compress_icon_decode(compress_icon, heap_copy, &decoded);
+    compress_icon_decode(compress_icon, heap_copy, &decoded);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.entries);
+    free(heap_copy);
+
+    compress_icon_cache_flush(compress_icon);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.used);
+
+    free(reference);
+    compress_icon_free(compress_icon);
+}
+
+MU_TEST(compress_icon_cache_workload) {
+    const Icon* desktop_icon = &A_Levelup1_128x64;
+    CompressIconCacheStats stats;
+    uint32_t mismatches = 0;
+
+    CompressIcon* compress_icon = compress_icon_alloc();
+    CompressIcon* reference_icon = compress_icon_alloc();
+    compress_icon_set_cache_size(compress_icon, COMPRESS_TEST_CACHE_SIZE);
+
+    // Neighbours and animation frames of selected item fit: most redraws are hits
+    uint32_t menu_decodes = compress_test_render_menu(compress_icon, reference_icon, &mismatches);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    FURI_LOG_I(
+        TAG,
+        "Main menu: %lu decodes, hits %lu, misses %lu, evictions %lu, %u bytes",
+        menu_decodes,
+        stats.hits,
+        stats.misses,
+        stats.evictions,
+        stats.used);
+    mu_assert_int_eq(0, mismatches);
+    mu_assert_int_eq(menu_decodes, stats.hits + stats.misses);
+    mu_check(stats.hits > stats.misses);
+    mu_check(stats.used <= COMPRESS_TEST_CACHE_SIZE);
+
+    compress_icon_cache_flush(compress_icon);
+    uint32_t hits = stats.hits;
+    uint32_t misses = stats.misses;
+
+    // Every frame is drawn twice in a row: second draw is always a hit
+    uint32_t desktop_decodes =
+        compress_test_render_desktop(compress_icon, reference_icon, desktop_icon, &mismatches);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    FURI_LOG_I(
+        TAG,
+        "Desktop: %lu decodes, hits %lu, misses %lu, evictions %lu",
+        desktop_decodes,
+        stats.hits - hits,
+        stats.misses - misses,
+        stats.evictions);
+    mu_assert_int_eq(0, mismatches);
+    mu_assert_int_eq(desktop_decodes, (stats.hits - hits) + (stats.misses - misses));
+    mu_check(
+        (stats.hits - hits) >= desktop_decodes / COMPRESS_TEST_DESKTOP_REDRAWS_PER_FRAME);
+    mu_check(stats.used <= COMPRESS_TEST_CACHE_SIZE);
+
+    compress_icon_free(reference_icon);
+    compress_icon_free(compress_icon);
+}
+
+typedef struct {
+    uint32_t hit_cycles;
+    uint32_t hits;
+    uint32_t miss_cycles;
+    uint32_t misses;
+} CompressTestTiming;
+
+/* Time a single decode and account it as a hit or a miss */
+static void compress_test_timed_decode(
+    CompressIcon* compress_icon,
+    const uint8_t* icon_data,
+    CompressTestTiming* timing) {
+    CompressIconCacheStats before, after;
+    uint8_t* decoded = NULL;
+
+    compress_icon_get_cache_stats(compress_icon, &before);
+    uint32_t start = DWT->CYCCNT;
+    compress_icon_decode(compress_icon, icon_data, &decoded);
+    uint32_t cycles = DWT->CYCCNT - start;
+    compress_icon_get_cache_stats(compress_icon, &after);
+
+    if(after.hits != before.hits) {
+        timing->hit_cycles += cycles;
+        timing->hits++;
+    } else {
+        timing->miss_cycles += cycles;
+        timing->misses++;
+    }
+}
+
+static void compress_test_log_timing(const char* workload, const CompressTestTiming* timing) {
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    const uint32_t miss_us = timing->miss_cycles / MAX(timing->misses, 1UL) / cycles_per_us;
+    const uint32_t hit_us = timing->hit_cycles / MAX(timing->hits, 1UL) / cycles_per_us;
+    FURI_LOG_I(
+        TAG,
+        "%s: miss %lu us, hit %lu us, saved %lu us per cached frame, hits %lu, misses %lu",
+        workload,
+        miss_us,
+        hit_us,
+        (miss_us > hit_us) ? (miss_us - hit_us) : 0,
+        timing->hits,
+        timing->misses);
+}
+
+MU_TEST(compress_icon_cache_benchmark) {
+    const Icon* desktop_icon = &A_Levelup1_128x64;
+    const size_t menu_count = COUNT_OF(compress_test_menu_icons);
+    CompressTestTiming menu_timing = {0};
+    CompressTestTiming desktop_timing = {0};
+
+    CompressIcon* compress_icon = compress_icon_alloc();
+    compress_icon_set_cache_size(compress_icon, COMPRESS_TEST_CACHE_SIZE);
+
+    for(size_t i = 0; i < COMPRESS_TEST_MENU_REDRAWS; i++) {
+        size_t selected = (i / COMPRESS_TEST_MENU_REDRAWS_PER_ITEM) % menu_count;
+        for(size_t shift = 0; shift < 3; shift++) {
+            const Icon* icon =
+                compress_test_menu_icons[(selected + shift + menu_count - 1) % menu_count];
+            size_t frame = (shift == 1) ? (i % icon->frame_count) : 0;
+            compress_test_timed_decode(compress_icon, icon->frames[frame], &menu_timing);
+        }
+    }
+    compress_test_log_timing("Main menu", &menu_timing);
+
+    compress_icon_cache_flush(compress_icon);
+
+    for(size_t loop = 0; loop < COMPRESS_TEST_DESKTOP_LOOPS; loop++) {
+        for(size_t frame = 0; frame < desktop_icon->frame_count; frame++) {
+            for(size_t i = 0; i < COMPRESS_TEST_DESKTOP_REDRAWS_PER_FRAME; i++) {
+                compress_test_timed_decode(
+                    compress_icon, desktop_icon->frames[frame], &desktop_timing);
+            }
+        }
+    }
+    compress_test_log_timing("Desktop", &desktop_timing);
+
+    // Timing is only reported: a busy system must not fail the run
+    mu_check(menu_timing.hits > 0);
+    mu_check(desktop_timing.hits > 0);
+
+    compress_icon_free(compress_icon);
+}
+
+MU_TEST_SUITE(compress_suite) {
+    MU_RUN_TEST(compress_icon_cache_test);
+    MU_RUN_TEST(compress_icon_cache_workload);
+}
+
+MU_TEST_SUITE(compress_benchmark_suite) {
+    MU_RUN_TEST(compress_icon_cache_benchmark);
+}
+
+int run_minunit_test_compress() {
+    MU_RUN_SUITE(compress_suite);
+    return MU_EXIT_CODE;
+}
+
+int run_minunit_test_compress_benchmark() {
+    MU_RUN_SUITE(compress_benchmark_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,168 @@
+#include <furi.h>
+#include "../minunit.h"
+
+#define TAG "TestFuriEventLoop"
+
+#define EVENT_LOOP_MESSAGES (256)
+#define EVENT_LOOP_BYTES (1024)
+#define EVENT_LOOP_FLAG_DONE (1 << 0)
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriThreadId consumer_id;
+    FuriMessageQueue* queue;
+    FuriStreamBuffer* stream;
+    FuriEventLoopTimer* timer;
+
+    uint32_t messages;
+    uint32_t message_errors;
+    uint32_t bytes;
+    uint32_t byte_errors;
+    uint32_t timer_ticks;
+    bool producer_done;
+} TestFuriEventLoopData;
+
+static int32_t test_furi_event_loop_producer(void* context) {
+    TestFuriEventLoopData* data = context;
+
+    for(uint32_t i = 0; i < EVENT_LOOP_MESSAGES; i++) {
+        furi_check(furi_message_queue_put(data->queue, &i, FuriWaitForever) == FuriStatusOk);
+        if(i % 16 == 0) furi_delay_tick(1);
+    }
+
+    for(uint32_t i = 0; i < EVENT_LOOP_BYTES; i++) {
+        uint8_t byte = i & 0xFF;
+        furi_check(furi_stream_buffer_send(data->stream, &byte, 1, FuriWaitForever) == 1);
+    }
+
+    furi_thread_flags_set(data->consumer_id, EVENT_LOOP_FLAG_DONE);
+
+    return 0;
+}
+
+static void test_furi_event_loop_check_done(TestFuriEventLoopData* data) {
+    if(data->producer_done && data->messages == EVENT_LOOP_MESSAGES &&
+       data->bytes == EVENT_LOOP_BYTES) {
+        furi_event_loop_stop(data->event_loop);
+    }
+}
+
+static void test_furi_event_loop_queue_callback(FuriMessageQueue* queue, void* context) {
+    TestFuriEventLoopData* data = context;
+
+    uint32_t message;
+    while(furi_message_queue_get(queue, &message, 0) == FuriStatusOk) {
+        if(message != data->messages) data->message_errors++;
+        data->messages++;
+    }
+    test_furi_event_loop_check_done(data);
+}
+
+static void test_furi_event_loop_stream_callback(FuriStreamBuffer* stream, void* context) {
+    TestFuriEventLoopData* data = context;
+
+    uint8_t buffer[64];
+    size_t received;
+    while((received = furi_stream_buffer_receive(stream, buffer, sizeof(buffer), 0)) > 0) {
+        for(size_t i = 0; i < received; i++) {
+            if(buffer[i] != ((data->bytes + i) & 0xFF)) data->byte_errors++;
+        }
+        data->bytes += received;
+    }
+    test_furi_event_loop_check_done(data);
+}
+
+static void test_furi_event_loop_flags_callback(uint32_t flags, void* context) {
+    TestFuriEventLoopData* data = context;
+    if(flags & EVENT_LOOP_FLAG_DONE) data->producer_done = true;
+    test_furi_event_loop_check_done(data);
+}
+
+static void test_furi_event_loop_timer_callback(void* context) {
+    TestFuriEventLoopData* data = context;
+    data->timer_ticks++;
+}
+
+static void test_furi_event_loop_once_callback(void* context) {
+    TestFuriEventLoopData* data = context;
+    data->timer_ticks++;
+    furi_event_loop_stop(data->event_loop);
+}
+
+void test_furi_event_loop() {
+    TestFuriEventLoopData data = {0};
+
+    data.event_loop = furi_event_loop_alloc();
+    data.consumer_id = furi_thread_get_current_id();
+    data.queue = furi_message_queue_alloc(16, sizeof(uint32_t));
+    data.stream = furi_stream_buffer_alloc(128, 1);
+
+    furi_event_loop_subscribe_message_queue(
+        data.event_loop,
+        data.queue,
+        FuriEventLoopEventIn,
+        test_furi_event_loop_queue_callback,
+        &data);
+    furi_event_loop_subscribe_stream_buffer(
+        data.event_loop,
+        data.stream,
+        FuriEventLoopEventIn,
+        test_furi_event_loop_stream_callback,
+        &data);
+    furi_event_loop_subscribe_thread_flags(
+        data.event_loop, EVENT_LOOP_FLAG_DONE, test_furi_event_loop_flags_callback, &data);
+
+    data.timer = furi_event_loop_timer_alloc(
+        data.event_loop,
+        test_furi_event_loop_timer_callback,
+        FuriEventLoopTimerTypePeriodic,
+        &data);
+    furi_event_loop_timer_start(data.timer, 10);
+    mu_check(furi_event_loop_timer_is_running(data.timer));
+
+    FuriThread* producer =
+        furi_thread_alloc_ex("EventLoopProducer", 1024, test_furi_event_loop_producer, &data);
+    furi_thread_start(producer);
+
+    furi_event_loop_run(data.event_loop);
+
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+
+    mu_assert_int_eq(EVENT_LOOP_MESSAGES, data.messages);
+    mu_assert_int_eq(0, data.message_errors);
+    mu_assert_int_eq(EVENT_LOOP_BYTES, data.bytes);
+    mu_assert_int_eq(0, data.byte_errors);
+
+    FuriEventLoopStats stats;
+    furi_event_loop_get_stats(data.event_loop, &stats);
+    FURI_LOG_I(
+        TAG,
+        "%lu wakeups, %lu dispatches, %lu events, %lu timer ticks in %lu ms, latency max %lu us",
+        stats.wakeups,
+        stats.dispatches,
+        stats.events,
+        data.timer_ticks,
+        stats.duration,
+        stats.latency_max);
+    // Loop sleeps between events: no more wakeups than callbacks, plus timer
+    mu_check(stats.events > 0);
+    mu_check(stats.wakeups <= stats.dispatches + 1);
+
+    // one shot timer fires once and stops loop from its callback
+    furi_event_loop_timer_free(data.timer);
+    data.timer_ticks = 0;
+    data.timer = furi_event_loop_timer_alloc(
+        data.event_loop, test_furi_event_loop_once_callback, FuriEventLoopTimerTypeOnce, &data);
+    furi_event_loop_timer_start(data.timer, 1);
+    furi_event_loop_run(data.event_loop);
+    mu_assert_int_eq(1, data.timer_ticks);
+    mu_check(!furi_event_loop_timer_is_running(data.timer));
+
+    furi_event_loop_timer_free(data.timer);
+    furi_event_loop_unsubscribe(data.event_loop, data.queue);
+    furi_event_loop_unsubscribe(data.event_loop, data.stream);
+    furi_event_loop_free(data.event_loop);
+    furi_message_queue_free(data.queue);
+    furi_stream_buffer_free(data.stream);
+}
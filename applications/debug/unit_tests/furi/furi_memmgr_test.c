@@ -1,4 +1,5 @@
 #include "../minunit.h"
+#include <furi.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
@@ -36,3 +37,109 @@ void test_furi_memmgr() {
     }
     free(ptr);
 }
+
+void test_furi_memmgr_slab() {
+    MemmgrSlabStats stats_before, stats_after;
+    memmgr_slab_get_stats(&stats_before);
+
+    // small allocation comes from slab, zeroed and released by plain free
+    uint8_t* ptr = memmgr_slab_alloc(24);
+    mu_check(memmgr_slab_is_allocated(ptr));
+    for(int i = 0; i < 24; i++) {
+        mu_assert_int_eq(0, ptr[i]);
+    }
+    memset(ptr, 66, 24);
+
+    // growing to another class keeps content
+    ptr = realloc(ptr, 100);
+    mu_check(memmgr_slab_is_allocated(ptr));
+    for(int i = 0; i < 24; i++) {
+        mu_assert_int_eq(66, ptr[i]);
+    }
+    free(ptr);
+    mu_check(!memmgr_slab_is_allocated(ptr));
+
+    // large allocation goes to heap
+    ptr = memmgr_slab_alloc(MEMMGR_SLAB_CLASS_MAX + 1);
+    mu_check(!memmgr_slab_owns(ptr));
+    memmgr_slab_free(ptr);
+
+    // counters are shared by all threads: others may allocate meanwhile
+    memmgr_slab_get_stats(&stats_after);
+    mu_check(stats_after.classes[1].allocations >= stats_before.classes[1].allocations + 1);
+    mu_check(stats_after.classes[3].allocations >= stats_before.classes[3].allocations + 1);
+    mu_check(stats_after.heap_fallbacks >= stats_before.heap_fallbacks + 1);
+
+    // arena: strings of current thread are bump allocated and dropped at once
+    MemmgrArena* arena = memmgr_arena_alloc(256);
+    memmgr_arena_enter(arena);
+    FuriString* string = furi_string_alloc_set_str("arena");
+    for(int i = 0; i < 100; i++) {
+        furi_string_cat_str(string, " string");
+    }
+    mu_check(memmgr_slab_owns(string));
+    mu_check(!memmgr_slab_is_allocated(string));
+    mu_assert_int_eq(5 + 7 * 100, furi_string_size(string));
+    furi_string_free(string);
+    memmgr_arena_exit(arena);
+
+    MemmgrArenaStats arena_stats;
+    memmgr_arena_get_stats(arena, &arena_stats);
+    mu_check(arena_stats.allocations >= 2);
+    mu_check(arena_stats.used_peak > 5 + 7 * 100);
+
+    memmgr_arena_reset(arena);
+    memmgr_arena_get_stats(arena, &arena_stats);
+    mu_assert_int_eq(1, arena_stats.blocks);
+    mu_assert_int_eq(0, arena_stats.used);
+    memmgr_arena_free(arena);
+}
+
+void test_furi_memmgr_profiler() {
+    MemmgrProfilerConfig config = {.sample_period = 1, .stack_depth = 2};
+    mu_check(memmgr_profiler_start(&config));
+    mu_check(!memmgr_profiler_start(&config));
+
+    // every allocation is sampled, all of them come from one call site
+    void* ptrs[8];
+    for(size_t i = 0; i < COUNT_OF(ptrs); i++) {
+        ptrs[i] = malloc(1000);
+    }
+
+    MemmgrProfilerStats stats;
+    mu_check(memmgr_profiler_get_stats(&stats));
+    mu_check(stats.allocations >= COUNT_OF(ptrs));
+    mu_check(stats.samples >= COUNT_OF(ptrs));
+
+    MemmgrProfilerSite* sites = malloc(sizeof(MemmgrProfilerSite) * MEMMGR_PROFILER_SITES);
+    size_t sites_count = memmgr_profiler_get_sites(sites, MEMMGR_PROFILER_SITES);
+    uintptr_t pc = 0;
+    for(size_t i = 0; i < sites_count; i++) {
+        if(sites[i].live_bytes >= 1000 * COUNT_OF(ptrs)) pc = sites[i].pc;
+    }
+    mu_check(pc != 0);
+
+    for(size_t i = 0; i < COUNT_OF(ptrs); i++) {
+        free(ptrs[i]);
+    }
+
+    // releases are accounted to the same site
+    sites_count = memmgr_profiler_get_sites(sites, MEMMGR_PROFILER_SITES);
+    bool found = false;
+    for(size_t i = 0; i < sites_count; i++) {
+        if(sites[i].pc != pc) continue;
+        found = true;
+        mu_check(sites[i].frees >= COUNT_OF(ptrs));
+        mu_check(sites[i].live_bytes < 1000 * COUNT_OF(ptrs));
+    }
+    mu_check(found);
+    free(sites);
+
+    MemmgrProfilerSample sample;
+    mu_assert_int_eq(1, memmgr_profiler_get_samples(&sample, 1));
+    mu_check(sample.pc[0] != 0);
+
+    memmgr_profiler_stop();
+    mu_check(!memmgr_profiler_is_running());
+    mu_check(!memmgr_profiler_get_stats(&stats));
+}
@@ -7,8 +7,11 @@
 void test_furi_create_open();
 void test_furi_concurrent_access();
 void test_furi_pubsub();
+void test_furi_event_loop();
 
 void test_furi_memmgr();
+void test_furi_memmgr_slab();
+void test_furi_memmgr_profiler();
 
 static int foo = 0;
 
@@ -33,12 +36,24 @@ MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_event_loop) {
+    test_furi_event_loop();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_memmgr_slab) {
+    test_furi_memmgr_slab();
+}
+
+MU_TEST(mu_test_furi_memmgr_profiler) {
+    test_furi_memmgr_profiler();
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -47,7 +62,10 @@ MU_TEST_SUITE(test_suite) {
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_event_loop);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_memmgr_slab);
+    MU_RUN_TEST(mu_test_furi_memmgr_profiler);
 }
 
 int run_minunit_test_furi() {
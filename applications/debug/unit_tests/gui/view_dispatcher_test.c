@@ -0,0 +1,111 @@
+#include <furi.h>
+#include <gui/view_dispatcher.h>
+#include "../minunit.h"
+
+#define TAG "TestViewDispatcher"
+
+#define VIEW_DISPATCHER_TEST_EVENTS (1000)
+
+typedef enum {
+    ViewDispatcherTestEventCount,
+    ViewDispatcherTestEventLatest,
+    ViewDispatcherTestEventDone,
+} ViewDispatcherTestEvent;
+
+typedef struct {
+    ViewDispatcher* view_dispatcher;
+    uint32_t count;
+    uint32_t count_dispatches;
+    uint32_t latest;
+    uint32_t latest_dispatches;
+    uint32_t count_at_done;
+    uint32_t producer_duration;
+} ViewDispatcherTestData;
+
+static int32_t view_dispatcher_test_producer(void* context) {
+    ViewDispatcherTestData* data = context;
+
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < VIEW_DISPATCHER_TEST_EVENTS; i++) {
+        view_dispatcher_send_custom_event(data->view_dispatcher, ViewDispatcherTestEventCount);
+        view_dispatcher_send_custom_event_value(
+            data->view_dispatcher, ViewDispatcherTestEventLatest, i);
+    }
+    data->producer_duration = furi_get_tick() - start;
+    view_dispatcher_send_custom_event(data->view_dispatcher, ViewDispatcherTestEventDone);
+
+    return 0;
+}
+
+static bool view_dispatcher_test_custom_event_callback(void* context, uint32_t event) {
+    ViewDispatcherTestData* data = context;
+    uint32_t value = view_dispatcher_get_custom_event_value(data->view_dispatcher);
+
+    if(event == ViewDispatcherTestEventCount) {
+        data->count += value;
+        data->count_dispatches++;
+    } else if(event == ViewDispatcherTestEventLatest) {
+        data->latest = value;
+        data->latest_dispatches++;
+    } else if(event == ViewDispatcherTestEventDone) {
+        data->count_at_done = data->count;
+        view_dispatcher_stop(data->view_dispatcher);
+    }
+
+    return true;
+}
+
+MU_TEST(view_dispatcher_coalesced_events_test) {
+    ViewDispatcherTestData data = {0};
+
+    data.view_dispatcher = view_dispatcher_alloc();
+    view_dispatcher_enable_queue(data.view_dispatcher);
+    view_dispatcher_set_event_callback_context(data.view_dispatcher, &data);
+    view_dispatcher_set_custom_event_callback(
+        data.view_dispatcher, view_dispatcher_test_custom_event_callback);
+    view_dispatcher_set_custom_event_mode(
+        data.view_dispatcher, ViewDispatcherTestEventCount, ViewDispatcherCustomEventModeCount);
+    view_dispatcher_set_custom_event_mode(
+        data.view_dispatcher, ViewDispatcherTestEventLatest, ViewDispatcherCustomEventModeLatest);
+
+    FuriThread* producer = furi_thread_alloc_ex(
+        "ViewDispatcherProducer", 1024, view_dispatcher_test_producer, &data);
+    furi_thread_start(producer);
+
+    view_dispatcher_run(data.view_dispatcher);
+
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+
+    ViewDispatcherCustomEventStats stats;
+    view_dispatcher_get_custom_event_stats(data.view_dispatcher, &stats);
+    FURI_LOG_I(
+        TAG,
+        "%lu sent, %lu dispatched, %lu merged, %lu dropped in %lu ms",
+        stats.sent,
+        stats.dispatched,
+        stats.merged,
+        stats.dropped,
+        data.producer_duration);
+
+    // Nothing lost, merged events delivered before queued one sent after them
+    mu_assert_int_eq(VIEW_DISPATCHER_TEST_EVENTS, data.count);
+    mu_assert_int_eq(VIEW_DISPATCHER_TEST_EVENTS, data.count_at_done);
+    mu_assert_int_eq(VIEW_DISPATCHER_TEST_EVENTS - 1, data.latest);
+    mu_assert_int_eq(VIEW_DISPATCHER_TEST_EVENTS * 2 + 1, stats.sent);
+    mu_assert_int_eq(VIEW_DISPATCHER_TEST_EVENTS, stats.merged + data.count_dispatches);
+    mu_assert_int_eq(VIEW_DISPATCHER_TEST_EVENTS, stats.dropped + data.latest_dispatches);
+    mu_assert_int_eq(data.count_dispatches + data.latest_dispatches + 1, stats.dispatched);
+    mu_assert_int_eq(0, stats.stalls);
+
+    view_dispatcher_free(data.view_dispatcher);
+}
+
+MU_TEST_SUITE(view_dispatcher_suite) {
+    MU_RUN_TEST(view_dispatcher_coalesced_events_test);
+}
+
+int run_minunit_test_view_dispatcher() {
+    MU_RUN_SUITE(view_dispatcher_suite);
+    return MU_EXIT_CODE;
+}
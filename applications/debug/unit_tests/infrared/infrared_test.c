@@ -1,13 +1,34 @@
 #include <furi.h>
 #include <flipper_format.h>
 #include <infrared.h>
+#include <infrared_index.h>
 #include <common/infrared_common_i.h>
+#include <furi_hal.h>
 #include "../minunit.h"
 
 #define IR_TEST_FILES_DIR EXT_PATH("unit_tests/infrared/")
 #define IR_TEST_FILE_PREFIX "test_"
 #define IR_TEST_FILE_SUFFIX ".irtest"
 
+#define IR_TEST_INDEX_DIR EXT_PATH("unit_tests/infrared_index")
+#define IR_TEST_INDEX_PATH IR_TEST_INDEX_DIR "/.index"
+#define IR_TEST_INDEX_FILES 4
+/* Commands of a library start at a multiple of this */
+#define IR_TEST_INDEX_SIGNALS 1000
+/* Functional test keeps the libraries small, benchmark fills them up */
+#define IR_TEST_INDEX_SMALL_FILES 2
+#define IR_TEST_INDEX_SMALL_SIGNALS 32
+#define IR_TEST_INDEX_LOOKUPS 200
+/* Every fourth signal is raw */
+#define IR_TEST_INDEX_RAW_STEP 4
+#define IR_TEST_INDEX_RAW_BITS 16
+/* Header, two timings per bit and stop mark at most */
+#define IR_TEST_INDEX_RAW_SIZE_MAX (3 + IR_TEST_INDEX_RAW_BITS * 2)
+/* Capture error: remote clock drift, per mille, and receiver jitter, us,
+ * within bit tolerance of protocol decoders */
+#define IR_TEST_INDEX_RAW_DRIFT 50
+#define IR_TEST_INDEX_RAW_JITTER 100
+
 typedef struct {
     InfraredDecoderHandler* decoder_handler;
     InfraredEncoderHandler* encoder_handler;
@@ -522,6 +543,310 @@ MU_TEST(infrared_test_encoder_decoder_all) {
     infrared_test_run_encoder_decoder(InfraredProtocolRCA, 1);
 }
 
+typedef struct {
+    uint32_t header_mark;
+    uint32_t header_space;
+    uint32_t mark;
+    uint32_t space[2];
+    uint32_t manchester; /**< Half bit duration, other fields are unused if set */
+} InfraredTestIndexRawProtocol;
+
+/* Timings of real protocols: pulse distance, pulse width and manchester */
+static const InfraredTestIndexRawProtocol infrared_test_index_raw_protocols[] = {
+    {.header_mark = 9000, .header_space = 4500, .mark = 560, .space = {560, 1690}}, // NEC
+    {.header_mark = 4500, .header_space = 4500, .mark = 550, .space = {550, 1650}}, // Samsung32
+    {.header_mark = 3456, .header_space = 1728, .mark = 432, .space = {432, 1296}}, // Kaseikyo
+    {.header_mark = 2400, .header_space = 600, .mark = 0, .space = {600, 1200}}, // SIRC
+    {.manchester = 889}, // RC5
+};
+
+static uint32_t infrared_test_index_random(uint32_t* seed) {
+    *seed = *seed * 1103515245UL + 12345UL;
+    return *seed >> 16;
+}
+
+/* Signal with given id, as captured by a receiver if seed is not 0 */
+static size_t infrared_test_index_raw_timings(uint32_t id, uint32_t seed, uint32_t* timings) {
+    const InfraredTestIndexRawProtocol* protocol = &infrared_test_index_raw_protocols
+        [(id / IR_TEST_INDEX_RAW_STEP) % COUNT_OF(infrared_test_index_raw_protocols)];
+    size_t size = 0;
+
+    if(protocol->manchester) {
+        // Start bit, then half bit levels merged into runs, leading space is not seen
+        bool level = true;
+        timings[size++] = protocol->manchester;
+        for(size_t i = 0; i < IR_TEST_INDEX_RAW_BITS; i++) {
+            bool bit = id & (1 << i);
+            if(bit == level) {
+                timings[size++] = protocol->manchester;
+                timings[size++] = protocol->manchester;
+            } else {
+                timings[size - 1] += protocol->manchester;
+                timings[size++] = protocol->manchester;
+            }
+            level = bit;
+        }
+        // Capture ends with the last mark
+        if(!level) size--;
+    } else {
+        timings[size++] = protocol->header_mark;
+        timings[size++] = protocol->header_space;
+        for(size_t i = 0; i < IR_TEST_INDEX_RAW_BITS; i++) {
+            bool bit = id & (1 << i);
+            // Pulse width protocols have constant space and mark from the table
+            timings[size++] = protocol->mark ? protocol->mark : protocol->space[bit];
+            timings[size++] = protocol->mark ? protocol->space[bit] : protocol->space[0];
+        }
+        // Capture ends with the last mark: stop bit or mark of the last bit
+        if(protocol->mark) {
+            timings[size++] = protocol->mark;
+        } else {
+            size--;
+        }
+    }
+
+    if(seed) {
+        int32_t drift = (int32_t)(infrared_test_index_random(&seed) %
+                                  (IR_TEST_INDEX_RAW_DRIFT * 2 + 1)) -
+                        IR_TEST_INDEX_RAW_DRIFT;
+        for(size_t i = 0; i < size; i++) {
+            int32_t jitter = (int32_t)(infrared_test_index_random(&seed) %
+                                       (IR_TEST_INDEX_RAW_JITTER * 2 + 1)) -
+                             IR_TEST_INDEX_RAW_JITTER;
+            timings[i] = (int32_t)timings[i] * (1000 + drift) / 1000 + jitter;
+        }
+    }
+
+    return size;
+}
+
+static bool infrared_test_index_write_library(
+    uint32_t file_index,
+    uint32_t command_base,
+    uint32_t signal_count) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc_printf("%s/lib_%lu.ir", IR_TEST_INDEX_DIR, file_index);
+    FuriString* text = furi_string_alloc_set("Filetype: IR signals file\nVersion: 1\n");
+    uint32_t timings[IR_TEST_INDEX_RAW_SIZE_MAX];
+    bool success =
+        storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS);
+
+    for(uint32_t i = 0; success && (i < signal_count); i++) {
+        uint32_t command = command_base + i;
+        if(i % IR_TEST_INDEX_RAW_STEP) {
+            furi_string_cat_printf(
+                text,
+                "#\nname: Btn_%lu\ntype: parsed\nprotocol: NECext\n"
+                "address: %02lX 00 00 00\ncommand: %02lX %02lX 00 00\n",
+                command,
+                file_index,
+                command & 0xFF,
+                command >> 8);
+        } else {
+            size_t timings_size =
+                infrared_test_index_raw_timings(file_index << 12 | command, 0, timings);
+            furi_string_cat_printf(
+                text,
+                "#\nname: Raw_%lu\ntype: raw\nfrequency: 38000\nduty_cycle: 0.330000\ndata:",
+                command);
+            for(size_t j = 0; j < timings_size; j++) {
+                furi_string_cat_printf(text, " %lu", timings[j]);
+            }
+            furi_string_push_back(text, '\n');
+        }
+
+        if((furi_string_size(text) > 2048) || (i == signal_count - 1)) {
+            size_t size = furi_string_size(text);
+            success = storage_file_write(file, furi_string_get_cstr(text), size) == size;
+            furi_string_reset(text);
+        }
+    }
+
+    furi_string_free(text);
+    furi_string_free(path);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+typedef struct {
+    FuriString* path;
+    FuriString* name;
+    bool found;
+} InfraredTestIndexMatch;
+
+static bool infrared_test_index_match_callback(const InfraredIndexMatch* match, void* context) {
+    InfraredTestIndexMatch* expected = context;
+    if(!expected->path) return false;
+    expected->found |= furi_string_equal(expected->path, match->path) &&
+                       furi_string_equal(expected->name, match->name);
+    return true;
+}
+
+static bool infrared_test_index_find(
+    InfraredIndex* index,
+    uint32_t file_index,
+    uint32_t command,
+    uint32_t* cycles) {
+    InfraredTestIndexMatch expected = {
+        .path = furi_string_alloc_printf("%s/lib_%lu.ir", IR_TEST_INDEX_DIR, file_index),
+        .name = furi_string_alloc(),
+        .found = false,
+    };
+    uint32_t start = DWT->CYCCNT;
+
+    if((command % IR_TEST_INDEX_SIGNALS) % IR_TEST_INDEX_RAW_STEP) {
+        InfraredMessage message = {
+            .protocol = InfraredProtocolNECext,
+            .address = file_index,
+            .command = command,
+        };
+        furi_string_printf(expected.name, "Btn_%lu", command);
+        start = DWT->CYCCNT;
+        infrared_index_lookup_message(
+            index, &message, infrared_test_index_match_callback, &expected);
+    } else {
+        // Every timing of the capture is off, differently for every signal
+        uint32_t timings[IR_TEST_INDEX_RAW_SIZE_MAX];
+        uint32_t id = file_index << 12 | command;
+        size_t timings_size =
+            infrared_test_index_raw_timings(id, id * 2654435761UL | 1, timings);
+        furi_string_printf(expected.name, "Raw_%lu", command);
+        start = DWT->CYCCNT;
+        infrared_index_lookup_raw(
+            index, timings, timings_size, infrared_test_index_match_callback, &expected);
+    }
+
+    *cycles += DWT->CYCCNT - start;
+    furi_string_free(expected.path);
+    furi_string_free(expected.name);
+    return expected.found;
+}
+
+MU_TEST(infrared_test_index) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    InfraredIndexStats stats;
+    uint32_t cycles = 0;
+    const uint32_t signals = IR_TEST_INDEX_SMALL_SIGNALS;
+
+    storage_simply_remove_recursive(storage, IR_TEST_INDEX_DIR);
+    mu_assert(storage_simply_mkdir(storage, IR_TEST_INDEX_DIR), "Failed to create dir");
+    for(uint32_t i = 0; i < IR_TEST_INDEX_SMALL_FILES; i++) {
+        mu_assert(infrared_test_index_write_library(i, 0, signals), "Failed to write library");
+    }
+
+    InfraredIndex* index = infrared_index_alloc(storage, IR_TEST_INDEX_PATH);
+    infrared_index_add_source_dir(index, IR_TEST_INDEX_DIR);
+    mu_assert(infrared_index_sync(index), "Index sync failed");
+    infrared_index_get_stats(index, &stats);
+    mu_assert_int_eq(IR_TEST_INDEX_SMALL_FILES, stats.sources_parsed);
+    mu_assert_int_eq(IR_TEST_INDEX_SMALL_FILES * signals, stats.entry_count);
+
+    // Parsed and raw signals of every library
+    for(uint32_t i = 0; i < IR_TEST_INDEX_SMALL_FILES; i++) {
+        for(uint32_t command = 0; command < signals; command++) {
+            mu_assert(infrared_test_index_find(index, i, command, &cycles), "Signal not found");
+        }
+    }
+
+    InfraredMessage unknown = {.protocol = InfraredProtocolRC5, .address = 1, .command = 2};
+    InfraredTestIndexMatch none = {.path = NULL, .name = NULL, .found = false};
+    mu_assert_int_eq(
+        0,
+        infrared_index_lookup_message(index, &unknown, infrared_test_index_match_callback, &none));
+
+    // Nothing changed
+    mu_assert(infrared_index_sync(index), "Index sync failed");
+    infrared_index_get_stats(index, &stats);
+    mu_assert_int_eq(0, stats.sources_parsed);
+
+    // New source is parsed, existing ones are reused
+    mu_assert(
+        infrared_test_index_write_library(IR_TEST_INDEX_SMALL_FILES, 0, signals),
+        "Failed to write library");
+    mu_assert(infrared_index_sync(index), "Index sync failed");
+    infrared_index_get_stats(index, &stats);
+    mu_assert_int_eq(1, stats.sources_parsed);
+    mu_assert_int_eq((IR_TEST_INDEX_SMALL_FILES + 1) * signals, stats.entry_count);
+    mu_assert(infrared_test_index_find(index, 0, 5, &cycles), "Signal not found");
+    mu_assert(
+        infrared_test_index_find(index, IR_TEST_INDEX_SMALL_FILES, 8, &cycles),
+        "Signal not found");
+
+    // Signals of a removed source are gone
+    mu_assert(
+        storage_simply_remove(storage, IR_TEST_INDEX_DIR "/lib_0.ir"), "Failed to remove library");
+    mu_assert(infrared_index_sync(index), "Index sync failed");
+    infrared_index_get_stats(index, &stats);
+    mu_assert_int_eq(0, stats.sources_parsed);
+    mu_assert_int_eq(IR_TEST_INDEX_SMALL_FILES * signals, stats.entry_count);
+    mu_assert(!infrared_test_index_find(index, 0, 5, &cycles), "Stale signal found");
+    mu_assert(infrared_test_index_find(index, 1, 5, &cycles), "Signal not found");
+
+    infrared_index_free(index);
+    storage_simply_remove_recursive(storage, IR_TEST_INDEX_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(infrared_test_index_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    InfraredIndexStats stats;
+    uint32_t cycles = 0;
+
+    storage_simply_remove_recursive(storage, IR_TEST_INDEX_DIR);
+    mu_assert(storage_simply_mkdir(storage, IR_TEST_INDEX_DIR), "Failed to create dir");
+    for(uint32_t i = 0; i < IR_TEST_INDEX_FILES; i++) {
+        mu_assert(
+            infrared_test_index_write_library(i, 0, IR_TEST_INDEX_SIGNALS),
+            "Failed to write library");
+    }
+
+    InfraredIndex* index = infrared_index_alloc(storage, IR_TEST_INDEX_PATH);
+    infrared_index_add_source_dir(index, IR_TEST_INDEX_DIR);
+    mu_assert(infrared_index_sync(index), "Index sync failed");
+    infrared_index_get_stats(index, &stats);
+    mu_assert_int_eq(IR_TEST_INDEX_FILES, stats.sources_parsed);
+    mu_assert_int_eq(IR_TEST_INDEX_FILES * IR_TEST_INDEX_SIGNALS, stats.entry_count);
+    FURI_LOG_I("IrIndex", "Built for %u signals in %lu ms", stats.entry_count, stats.sync_time);
+
+    for(uint32_t i = 0; i < IR_TEST_INDEX_LOOKUPS; i++) {
+        uint32_t command = (i * 37) % IR_TEST_INDEX_SIGNALS;
+        mu_assert(
+            infrared_test_index_find(index, i % IR_TEST_INDEX_FILES, command, &cycles),
+            "Signal not found");
+    }
+    FURI_LOG_I(
+        "IrIndex",
+        "Lookup: %lu us",
+        cycles / IR_TEST_INDEX_LOOKUPS / furi_hal_cortex_instructions_per_microsecond());
+
+    // Nothing changed
+    mu_assert(infrared_index_sync(index), "Index sync failed");
+    infrared_index_get_stats(index, &stats);
+    mu_assert_int_eq(0, stats.sources_parsed);
+
+    // FAT timestamp resolution is 2 seconds
+    furi_delay_ms(2000);
+    mu_assert(
+        infrared_test_index_write_library(1, 2000, IR_TEST_INDEX_SIGNALS),
+        "Failed to write library");
+    mu_assert(infrared_index_sync(index), "Index sync failed");
+    infrared_index_get_stats(index, &stats);
+    mu_assert_int_eq(1, stats.sources_parsed);
+    mu_assert_int_eq(IR_TEST_INDEX_FILES * IR_TEST_INDEX_SIGNALS, stats.entry_count);
+
+    // Unchanged sources are still there, changed one has new content only
+    mu_assert(infrared_test_index_find(index, 0, 5, &cycles), "Signal not found");
+    mu_assert(infrared_test_index_find(index, 3, 8, &cycles), "Signal not found");
+    mu_assert(infrared_test_index_find(index, 1, 2005, &cycles), "Signal not found");
+    mu_assert(!infrared_test_index_find(index, 1, 5, &cycles), "Stale signal found");
+
+    infrared_index_free(index);
+    storage_simply_remove_recursive(storage, IR_TEST_INDEX_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(infrared_test) {
     MU_SUITE_CONFIGURE(&infrared_test_alloc, &infrared_test_free);
 
@@ -541,9 +866,19 @@ MU_TEST_SUITE(infrared_test) {
     MU_RUN_TEST(infrared_test_decoder_rca);
     MU_RUN_TEST(infrared_test_decoder_mixed);
     MU_RUN_TEST(infrared_test_encoder_decoder_all);
+    MU_RUN_TEST(infrared_test_index);
+}
+
+MU_TEST_SUITE(infrared_benchmark) {
+    MU_RUN_TEST(infrared_test_index_benchmark);
 }
 
 int run_minunit_test_infrared() {
     MU_RUN_SUITE(infrared_test);
     return MU_EXIT_CODE;
 }
+
+int run_minunit_test_infrared_benchmark() {
+    MU_RUN_SUITE(infrared_benchmark);
+    return MU_EXIT_CODE;
+}
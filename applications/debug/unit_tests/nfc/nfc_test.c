@@ -3,6 +3,7 @@
 #include <storage/storage.h>
 #include <lib/flipper_format/flipper_format.h>
 #include <lib/nfc/protocols/nfca.h>
+#include <lib/nfc/protocols/nfc_util.h>
 #include <lib/nfc/helpers/mf_classic_dict.h>
 #include <lib/digital_signal/digital_signal.h>
 #include <lib/nfc/nfc_device.h>
@@ -33,6 +34,9 @@ static const uint32_t nfc_test_file_version = 1;
 #define NFC_TEST_4_BYTE_BUILD_SIGNAL_TIM_MAX (110)
 #define NFC_TEST_16_BYTE_BUILD_SIGNAL_TIM_MAX (440)
 
+#define NFC_TEST_SIGNAL_CACHE_SIZE (8 * 1024)
+#define NFC_TEST_SIGNAL_CACHE_SENDS (16)
+
 typedef struct {
     Storage* storage;
     NfcaSignal* signal;
@@ -222,6 +226,71 @@ MU_TEST(nfc_digital_signal_test) {
         "NFC long digital signal test failed\r\n");
 }
 
+MU_TEST(nfca_signal_cache_test) {
+    // Page read of an Ultralight dump: 16 bytes and CRC
+    uint8_t data[18];
+    uint8_t parity[3] = {};
+    for(size_t i = 0; i < 16; i++) {
+        data[i] = i * 0x11;
+    }
+    nfca_append_crc16(data, 16);
+    nfc_util_odd_parity(data, parity, sizeof(data));
+
+    NfcaSignal* signal = nfca_signal_alloc();
+    DigitalSignalCacheStats stats;
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    // Signal goes to the NFC chip MOSI line, keep the chip deselected meanwhile
+    furi_hal_spi_acquire(&furi_hal_spi_bus_handle_nfc);
+    furi_hal_spi_bus_handle_deinit(&furi_hal_spi_bus_handle_nfc);
+
+    // Disabled by default
+    for(size_t i = 0; i < NFC_TEST_SIGNAL_CACHE_SENDS; i++) {
+        nfca_signal_send(signal, data, sizeof(data) * 8, parity);
+    }
+    nfca_signal_get_cache_stats(signal, &stats);
+    mu_assert_int_eq(0, stats.hits);
+    mu_assert_int_eq(NFC_TEST_SIGNAL_CACHE_SENDS, stats.misses);
+    uint32_t miss_time = stats.miss_prepare_time / stats.misses / cycles_per_us;
+
+    nfca_signal_set_cache_size(signal, NFC_TEST_SIGNAL_CACHE_SIZE);
+    mu_check(nfca_signal_cache_add(signal, data, sizeof(data) * 8, parity));
+    for(size_t i = 0; i < NFC_TEST_SIGNAL_CACHE_SENDS; i++) {
+        nfca_signal_send(signal, data, sizeof(data) * 8, parity);
+    }
+    nfca_signal_get_cache_stats(signal, &stats);
+    mu_assert_int_eq(NFC_TEST_SIGNAL_CACHE_SENDS, stats.hits);
+    mu_assert_int_eq(NFC_TEST_SIGNAL_CACHE_SENDS, stats.misses);
+    mu_assert_int_eq(1, stats.entries);
+    uint32_t hit_time = stats.hit_prepare_time / stats.hits / cycles_per_us;
+
+    FURI_LOG_I(
+        TAG,
+        "16 byte response preparation: %lu us uncached, %lu us cached, %u bytes",
+        miss_time,
+        hit_time,
+        stats.used);
+    mu_check(hit_time < miss_time);
+
+    // Same data with other parity is another frame
+    parity[0] ^= 0x80;
+    nfca_signal_send(signal, data, sizeof(data) * 8, parity);
+    nfca_signal_get_cache_stats(signal, &stats);
+    mu_assert_int_eq(NFC_TEST_SIGNAL_CACHE_SENDS + 1, stats.misses);
+
+    // Too small for the entry
+    nfca_signal_set_cache_size(signal, stats.used / 2);
+    nfca_signal_get_cache_stats(signal, &stats);
+    mu_assert_int_eq(0, stats.entries);
+    mu_check(!nfca_signal_cache_add(signal, data, sizeof(data) * 8, parity));
+
+    furi_hal_gpio_write(&gpio_spi_r_mosi, false);
+    furi_hal_spi_bus_handle_init(&furi_hal_spi_bus_handle_nfc);
+    furi_hal_spi_release(&furi_hal_spi_bus_handle_nfc);
+
+    nfca_signal_free(signal);
+}
+
 MU_TEST(mf_classic_dict_test) {
     MfClassicDict* instance = NULL;
     uint64_t key = 0;
@@ -563,6 +632,7 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_1k_7b_file_test);
     MU_RUN_TEST(mf_classic_4k_7b_file_test);
     MU_RUN_TEST(nfc_digital_signal_test);
+    MU_RUN_TEST(nfca_signal_cache_test);
     MU_RUN_TEST(mf_classic_dict_test);
     MU_RUN_TEST(mf_classic_dict_load_test);
 
@@ -1421,6 +1421,122 @@ MU_TEST(test_storage_rename) {
     mu_check(test_is_exists(TEST_DIR "dir2"));
 }
 
+#define BENCHMARK_DIR TEST_DIR "bench"
+#define BENCHMARK_LIST_FILES (1000)
+#define BENCHMARK_READ_SIZE (1024 * 1024)
+
+typedef struct {
+    size_t bytes;
+    size_t messages;
+    size_t messages_expected;
+    /* Delimited framing: length varint, then message body */
+    uint32_t length;
+    uint8_t length_shift;
+    uint32_t body_left;
+    SemaphoreHandle_t done_semaphore;
+} RpcBenchmarkOutput;
+
+static void test_rpc_benchmark_message_done(RpcBenchmarkOutput* output) {
+    if(++output->messages == output->messages_expected) {
+        xSemaphoreGive(output->done_semaphore);
+    }
+}
+
+/* Counts responses without decoding them, so that only RPC allocates */
+static void test_rpc_benchmark_output_callback(void* ctx, uint8_t* got_bytes, size_t got_size) {
+    RpcBenchmarkOutput* output = ctx;
+    output->bytes += got_size;
+
+    size_t i = 0;
+    while(i < got_size) {
+        if(output->body_left) {
+            size_t skip = MIN(output->body_left, got_size - i);
+            output->body_left -= skip;
+            i += skip;
+            if(!output->body_left) test_rpc_benchmark_message_done(output);
+        } else {
+            uint8_t byte = got_bytes[i++];
+            output->length |= (uint32_t)(byte & 0x7F) << output->length_shift;
+            output->length_shift += 7;
+            if(!(byte & 0x80)) {
+                output->body_left = output->length;
+                output->length = 0;
+                output->length_shift = 0;
+                if(!output->body_left) test_rpc_benchmark_message_done(output);
+            }
+        }
+    }
+}
+
+static void
+    test_rpc_benchmark_run(const char* name, PB_Main* request, size_t messages_expected) {
+    RpcBenchmarkOutput output = {
+        .messages_expected = messages_expected,
+        .done_semaphore = xSemaphoreCreateBinary(),
+    };
+    rpc_session_set_context(rpc_session[0].session, &output);
+    rpc_session_set_send_bytes_callback(
+        rpc_session[0].session, test_rpc_benchmark_output_callback);
+
+    // Profiler counts every allocation, sampling rate only affects attribution
+    MemmgrProfilerConfig config = {.sample_period = 1024, .stack_depth = 1};
+    bool profiling = memmgr_profiler_start(&config);
+
+    uint32_t start = furi_get_tick();
+    test_rpc_encode_and_feed_one(request, 0);
+    mu_check(xSemaphoreTake(output.done_semaphore, MAX_RECEIVE_OUTPUT_TIMEOUT * 10));
+    uint32_t time_ms = MAX(furi_get_tick() - start, 1UL);
+
+    MemmgrProfilerStats stats = {0};
+    if(profiling) {
+        memmgr_profiler_get_stats(&stats);
+        memmgr_profiler_stop();
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %u messages, %u bytes in %lu ms, %lu msg/s, %lu KiB/s, %lu allocations",
+        name,
+        output.messages,
+        output.bytes,
+        time_ms,
+        output.messages * 1000 / time_ms,
+        output.bytes * 1000 / 1024 / time_ms,
+        stats.allocations);
+
+    rpc_session_set_send_bytes_callback(rpc_session[0].session, output_bytes_callback);
+    rpc_session_set_context(rpc_session[0].session, &rpc_session[0]);
+    vSemaphoreDelete(output.done_semaphore);
+    mu_assert_int_eq(messages_expected, output.messages);
+}
+
+MU_TEST(test_storage_benchmark) {
+    test_create_dir(BENCHMARK_DIR);
+    Storage* fs_api = furi_record_open(RECORD_STORAGE);
+    FuriString* path = furi_string_alloc();
+    for(size_t i = 0; i < BENCHMARK_LIST_FILES; i++) {
+        furi_string_printf(path, BENCHMARK_DIR "/file%04u", i);
+        test_rpc_storage_create_file(fs_api, furi_string_get_cstr(path), 0);
+    }
+    furi_string_free(path);
+    test_rpc_storage_create_file(fs_api, TEST_DIR "bench.bin", BENCHMARK_READ_SIZE);
+    furi_record_close(RECORD_STORAGE);
+
+    PB_Main request;
+    const size_t files_per_message = COUNT_OF(((PB_Storage_ListResponse*)NULL)->file);
+    test_rpc_create_storage_list_request(&request, BENCHMARK_DIR, false, ++command_id, 0);
+    test_rpc_benchmark_run(
+        "List",
+        &request,
+        (BENCHMARK_LIST_FILES + files_per_message - 1) / files_per_message);
+    pb_release(&PB_Main_msg, &request);
+
+    test_rpc_create_simple_message(
+        &request, PB_Main_storage_read_request_tag, TEST_DIR "bench.bin", ++command_id);
+    test_rpc_benchmark_run("Read", &request, BENCHMARK_READ_SIZE / MAX_DATA_SIZE);
+    pb_release(&PB_Main_msg, &request);
+}
+
 MU_TEST(test_ping) {
     MsgList_t input_msg_list;
     MsgList_init(input_msg_list);
@@ -1504,6 +1620,12 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_interrupt_continuous_another_system);
 }
 
+MU_TEST_SUITE(test_rpc_storage_benchmark) {
+    MU_SUITE_CONFIGURE(&test_rpc_storage_setup, &test_rpc_storage_teardown);
+
+    MU_RUN_TEST(test_storage_benchmark);
+}
+
 static void test_app_create_request(
     PB_Main* request,
     const char* app_name,
@@ -1821,6 +1943,92 @@ MU_TEST(test_rpc_multisession_storage) {
     test_rpc_storage_teardown();
 }
 
+#define LATENCY_PINGS_MAX (1000)
+#define LATENCY_PING_MAX_MS (100)
+
+/* Pings on second session must not wait for bulk read on first one */
+MU_TEST(test_rpc_multisession_latency) {
+    test_rpc_storage_setup();
+    test_rpc_setup_second_session();
+
+    Storage* fs_api = furi_record_open(RECORD_STORAGE);
+    test_rpc_storage_create_file(fs_api, TEST_DIR "latency.bin", BENCHMARK_READ_SIZE);
+    furi_record_close(RECORD_STORAGE);
+
+    RpcBenchmarkOutput output = {
+        .messages_expected = BENCHMARK_READ_SIZE / MAX_DATA_SIZE,
+        .done_semaphore = xSemaphoreCreateBinary(),
+    };
+    rpc_session_set_context(rpc_session[0].session, &output);
+    rpc_session_set_send_bytes_callback(
+        rpc_session[0].session, test_rpc_benchmark_output_callback);
+
+    PB_Main request;
+    test_rpc_create_simple_message(
+        &request, PB_Main_storage_read_request_tag, TEST_DIR "latency.bin", ++command_id);
+    uint32_t start = furi_get_tick();
+    test_rpc_encode_and_feed_one(&request, 0);
+    pb_release(&PB_Main_msg, &request);
+
+    PB_Main ping = {
+        .command_status = PB_CommandStatus_OK,
+        .cb_content.funcs.encode = NULL,
+        .has_next = false,
+        .which_content = PB_Main_system_ping_request_tag,
+    };
+    uint32_t latency_max = 0;
+    uint32_t latency_total = 0;
+    size_t pings = 0;
+    bool bulk_done = false;
+
+    while(!bulk_done && (pings < LATENCY_PINGS_MAX)) {
+        MsgList_t expected;
+        MsgList_init(expected);
+        ping.command_id = ++command_id;
+        test_rpc_add_ping_to_list(expected, PING_RESPONSE, command_id);
+
+        uint32_t ping_start = furi_get_tick();
+        test_rpc_encode_and_feed_one(&ping, 1);
+        while(furi_stream_buffer_is_empty(rpc_session[1].output_stream) &&
+              (furi_get_tick() - ping_start < MAX_RECEIVE_OUTPUT_TIMEOUT)) {
+            furi_delay_tick(1);
+        }
+        uint32_t latency = furi_get_tick() - ping_start;
+        latency_max = MAX(latency_max, latency);
+        latency_total += latency;
+        ++pings;
+
+        test_rpc_decode_and_compare(expected, 1);
+        test_rpc_free_msg_list(expected);
+
+        bulk_done = xSemaphoreTake(output.done_semaphore, 0);
+    }
+
+    if(!bulk_done) {
+        bulk_done = xSemaphoreTake(output.done_semaphore, MAX_RECEIVE_OUTPUT_TIMEOUT * 10);
+    }
+    uint32_t time_ms = furi_get_tick() - start;
+
+    FURI_LOG_I(
+        TAG,
+        "Ping under bulk read: %u pings in %lu ms, latency avg %lu ms, max %lu ms",
+        pings,
+        time_ms,
+        latency_total / pings,
+        latency_max);
+
+    rpc_session_set_send_bytes_callback(rpc_session[0].session, output_bytes_callback);
+    rpc_session_set_context(rpc_session[0].session, &rpc_session[0]);
+    vSemaphoreDelete(output.done_semaphore);
+
+    mu_check(bulk_done);
+    mu_assert_int_eq(BENCHMARK_READ_SIZE / MAX_DATA_SIZE, output.messages);
+    mu_check(latency_max < LATENCY_PING_MAX_MS);
+
+    test_rpc_teardown_second_session();
+    test_rpc_storage_teardown();
+}
+
 MU_TEST_SUITE(test_rpc_session) {
     MU_RUN_TEST(test_rpc_feed_rubbish);
     MU_RUN_TEST(test_rpc_multisession_ping);
@@ -1830,6 +2038,7 @@ MU_TEST_SUITE(test_rpc_session) {
         FURI_LOG_E(TAG, "SD card not mounted - skip storage tests");
     } else {
         MU_RUN_TEST(test_rpc_multisession_storage);
+        MU_RUN_TEST(test_rpc_multisession_latency);
     }
     furi_record_close(RECORD_STORAGE);
 }
@@ -1849,6 +2058,18 @@ int run_minunit_test_rpc() {
     return MU_EXIT_CODE;
 }
 
+int run_minunit_test_rpc_benchmark() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(storage_sd_status(storage) != FSE_OK) {
+        FURI_LOG_E(TAG, "SD card not mounted - skip storage benchmark");
+    } else {
+        MU_RUN_SUITE(test_rpc_storage_benchmark);
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    return MU_EXIT_CODE;
+}
+
 int32_t delay_test_app(void* p) {
     int timeout = atoi((const char*)p);
 
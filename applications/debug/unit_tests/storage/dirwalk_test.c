@@ -3,6 +3,13 @@
 #include <m-dict.h>
 #include <toolbox/dir_walk.h>
 
+#define TAG "DirWalkTest"
+
+#define DIRWALK_DEEP_LEVELS (12)
+#define DIRWALK_BENCH_DIRS (100)
+#define DIRWALK_BENCH_FILES (99)
+#define DIRWALK_BENCH_BATCH (32)
+
 static const char* const storage_test_dirwalk_paths[] = {
     "1",
     "11",
@@ -254,6 +261,188 @@ MU_TEST_1(test_dirwalk_filter, Storage* storage) {
     storage_test_paths_free(paths);
 }
 
+static bool storage_test_paths_contents_visited(StorageTestPathDict_t* data, FuriString* dir) {
+    bool visited = true;
+    FuriString* prefix = furi_string_alloc_printf("%s/", furi_string_get_cstr(dir));
+
+    StorageTestPathDict_it_t it;
+    for(StorageTestPathDict_it(it, *data); !StorageTestPathDict_end_p(it);
+        StorageTestPathDict_next(it)) {
+        const StorageTestPathDict_itref_t* itref = StorageTestPathDict_cref(it);
+
+        if(furi_string_start_with(itref->key, prefix) && !itref->value.visited) {
+            visited = false;
+            break;
+        }
+    }
+
+    furi_string_free(prefix);
+    return visited;
+}
+
+MU_TEST_1(test_dirwalk_post_order, Storage* storage) {
+    FuriString* path;
+    path = furi_string_alloc();
+    FileInfo fileinfo;
+
+    StorageTestPathDict_t* paths =
+        storage_test_paths_alloc(storage_test_dirwalk_full, COUNT_OF(storage_test_dirwalk_full));
+
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    dir_walk_set_order(dir_walk, DirWalkOrderPost);
+    mu_check(dir_walk_open(dir_walk, EXT_PATH("dirwalk")));
+
+    while(dir_walk_read(dir_walk, path, &fileinfo) == DirWalkOK) {
+        furi_string_right(path, strlen(EXT_PATH("dirwalk/")));
+        if(file_info_is_dir(&fileinfo)) {
+            mu_check(storage_test_paths_contents_visited(paths, path));
+        }
+        mu_check(storage_test_paths_mark(paths, path, file_info_is_dir(&fileinfo)));
+    }
+
+    dir_walk_free(dir_walk);
+    furi_string_free(path);
+
+    mu_check(storage_test_paths_check(paths) == false);
+
+    storage_test_paths_free(paths);
+}
+
+static bool test_dirwalk_batch_cb(const DirWalkEntry* entries, size_t count, void* ctx) {
+    StorageTestPathDict_t* paths = ctx;
+    FuriString* path = furi_string_alloc();
+    bool success = true;
+
+    for(size_t i = 0; i < count; i++) {
+        furi_string_set(path, entries[i].path);
+        furi_string_right(path, strlen(EXT_PATH("dirwalk/")));
+        success &= storage_test_paths_mark(paths, path, file_info_is_dir(&entries[i].fileinfo));
+    }
+
+    furi_string_free(path);
+    return success;
+}
+
+MU_TEST_1(test_dirwalk_batch, Storage* storage) {
+    StorageTestPathDict_t* paths =
+        storage_test_paths_alloc(storage_test_dirwalk_full, COUNT_OF(storage_test_dirwalk_full));
+
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    mu_check(dir_walk_open(dir_walk, EXT_PATH("dirwalk")));
+    // Batch size is not a divider of element count on purpose
+    mu_assert_int_eq(DirWalkLast, dir_walk_read_batch(dir_walk, 4, test_dirwalk_batch_cb, paths));
+    dir_walk_free(dir_walk);
+
+    mu_check(storage_test_paths_check(paths) == false);
+
+    storage_test_paths_free(paths);
+}
+
+MU_TEST_1(test_dirwalk_deep, Storage* storage) {
+    // Deeper than open handle stack, with siblings on every level after the way down
+    FuriString* path = furi_string_alloc_set(EXT_PATH("dirwalk_deep"));
+    FuriString* file_path = furi_string_alloc();
+    mu_check(storage_simply_mkdir(storage, furi_string_get_cstr(path)));
+
+    for(size_t i = 0; i < DIRWALK_DEEP_LEVELS; i++) {
+        furi_string_printf(file_path, "%s/a.test", furi_string_get_cstr(path));
+        mu_check(write_file_13DA(storage, furi_string_get_cstr(file_path)));
+        furi_string_cat_printf(path, "/%u", i);
+        mu_check(storage_simply_mkdir(storage, furi_string_get_cstr(path)));
+        furi_string_printf(file_path, "%s_z.test", furi_string_get_cstr(path));
+        mu_check(write_file_13DA(storage, furi_string_get_cstr(file_path)));
+    }
+
+    const size_t expected = DIRWALK_DEEP_LEVELS * 3;
+    FileInfo fileinfo;
+    size_t dirs = 0, files = 0;
+
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    mu_check(dir_walk_open(dir_walk, EXT_PATH("dirwalk_deep")));
+    while(dir_walk_read(dir_walk, path, &fileinfo) == DirWalkOK) {
+        if(file_info_is_dir(&fileinfo)) {
+            dirs++;
+        } else {
+            files++;
+        }
+    }
+    dir_walk_free(dir_walk);
+
+    mu_assert_int_eq(DIRWALK_DEEP_LEVELS, dirs);
+    mu_assert_int_eq(expected - DIRWALK_DEEP_LEVELS, files);
+
+    mu_check(storage_simply_remove_recursive(storage, EXT_PATH("dirwalk_deep")));
+    mu_check(!storage_dir_exists(storage, EXT_PATH("dirwalk_deep")));
+
+    furi_string_free(file_path);
+    furi_string_free(path);
+}
+
+static bool test_dirwalk_bench_batch_cb(const DirWalkEntry* entries, size_t count, void* ctx) {
+    UNUSED(entries);
+    size_t* total = ctx;
+    *total += count;
+    return true;
+}
+
+static void test_dirwalk_bench_report(const char* name, size_t entries, uint32_t start) {
+    uint32_t time_ms = MAX(furi_get_tick() - start, 1UL);
+    FURI_LOG_I(
+        TAG,
+        "%s: %u entries in %lu ms, %lu entries/s",
+        name,
+        entries,
+        time_ms,
+        entries * 1000 / time_ms);
+}
+
+MU_TEST_1(test_dirwalk_benchmark, Storage* storage) {
+    FuriString* path = furi_string_alloc();
+    const size_t expected = DIRWALK_BENCH_DIRS * (DIRWALK_BENCH_FILES + 1);
+
+    uint32_t start = furi_get_tick();
+    mu_check(storage_simply_mkdir(storage, EXT_PATH("dirwalk_bench")));
+    for(size_t dir = 0; dir < DIRWALK_BENCH_DIRS; dir++) {
+        furi_string_printf(path, EXT_PATH("dirwalk_bench/dir%u"), dir);
+        mu_check(storage_simply_mkdir(storage, furi_string_get_cstr(path)));
+        for(size_t file = 0; file < DIRWALK_BENCH_FILES; file++) {
+            furi_string_printf(path, EXT_PATH("dirwalk_bench/dir%u/file%u.test"), dir, file);
+            mu_check(write_file_13DA(storage, furi_string_get_cstr(path)));
+        }
+    }
+    test_dirwalk_bench_report("Create", expected, start);
+
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    size_t total = 0;
+
+    start = furi_get_tick();
+    mu_check(dir_walk_open(dir_walk, EXT_PATH("dirwalk_bench")));
+    while(dir_walk_read(dir_walk, path, NULL) == DirWalkOK) {
+        total++;
+    }
+    test_dirwalk_bench_report("Pre-order", total, start);
+    mu_assert_int_eq(expected, total);
+
+    total = 0;
+    start = furi_get_tick();
+    dir_walk_set_order(dir_walk, DirWalkOrderPost);
+    mu_check(dir_walk_open(dir_walk, EXT_PATH("dirwalk_bench")));
+    mu_assert_int_eq(
+        DirWalkLast,
+        dir_walk_read_batch(dir_walk, DIRWALK_BENCH_BATCH, test_dirwalk_bench_batch_cb, &total));
+    test_dirwalk_bench_report("Post-order batch", total, start);
+    mu_assert_int_eq(expected, total);
+
+    dir_walk_free(dir_walk);
+
+    start = furi_get_tick();
+    mu_check(storage_simply_remove_recursive(storage, EXT_PATH("dirwalk_bench")));
+    test_dirwalk_bench_report("Remove", expected, start);
+    mu_check(!storage_dir_exists(storage, EXT_PATH("dirwalk_bench")));
+
+    furi_string_free(path);
+}
+
 MU_TEST_SUITE(test_dirwalk_suite) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     storage_dirs_create(storage, EXT_PATH("dirwalk"));
@@ -261,12 +450,26 @@ MU_TEST_SUITE(test_dirwalk_suite) {
     MU_RUN_TEST_1(test_dirwalk_full, storage);
     MU_RUN_TEST_1(test_dirwalk_no_recursive, storage);
     MU_RUN_TEST_1(test_dirwalk_filter, storage);
+    MU_RUN_TEST_1(test_dirwalk_post_order, storage);
+    MU_RUN_TEST_1(test_dirwalk_batch, storage);
+    MU_RUN_TEST_1(test_dirwalk_deep, storage);
 
     storage_simply_remove_recursive(storage, EXT_PATH("dirwalk"));
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_TEST_SUITE(test_dirwalk_benchmark_suite) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    MU_RUN_TEST_1(test_dirwalk_benchmark, storage);
+    furi_record_close(RECORD_STORAGE);
+}
+
 int run_minunit_test_dirwalk() {
     MU_RUN_SUITE(test_dirwalk_suite);
     return MU_EXIT_CODE;
+}
+
+int run_minunit_test_dirwalk_benchmark() {
+    MU_RUN_SUITE(test_dirwalk_benchmark_suite);
+    return MU_EXIT_CODE;
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <storage/storage.h>
 #include "../minunit.h"
 
+#define TAG "StreamTest"
+
 static const char* stream_test_data = "I write differently from what I speak, "
                                       "I speak differently from what I think, "
                                       "I think differently from the way I ought to think, "
@@ -518,6 +520,69 @@ MU_TEST(stream_buffered_large_file_test) {
     furi_string_free(output_data);
 }
 
+static uint32_t stream_read_line_benchmark(Stream* stream, size_t* lines, size_t* bytes) {
+    FuriString* line = furi_string_alloc();
+    *lines = 0;
+    *bytes = 0;
+
+    uint32_t start = furi_get_tick();
+    stream_rewind(stream);
+    while(stream_read_line(stream, line)) {
+        (*lines)++;
+        *bytes += furi_string_size(line);
+    }
+    uint32_t elapsed = furi_get_tick() - start;
+
+    furi_string_free(line);
+    return elapsed;
+}
+
+MU_TEST(stream_buffered_read_line_benchmark_test) {
+    // Infrared library like file: short keys, long raw data lines, CRLF endings
+    const size_t line_count = 2048;
+    const char* short_line = "name: Power\r\n";
+    const char* long_line =
+        "data: 9024 4512 579 552 579 552 579 1683 579 552 579 552 579 552 579 552 579 552 "
+        "579 1683 579 1683 579 552 579 1683 579 1683 579 1683 579 1683 579 1683\r\n";
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open(
+        stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    size_t file_size = 0;
+    for(size_t i = 0; i < line_count; i++) {
+        file_size += stream_write_cstring(stream, (i % 4) ? long_line : short_line);
+    }
+    mu_assert_int_eq(file_size, stream_size(stream));
+    stream_free(stream);
+
+    const size_t expected_bytes = file_size - line_count; // CRs are dropped
+    const size_t cache_sizes[] = {1024, 4096, 16384};
+
+    for(size_t i = 0; i < COUNT_OF(cache_sizes); i++) {
+        stream = buffered_file_stream_alloc_ex(storage, cache_sizes[i]);
+        mu_check(buffered_file_stream_open(
+            stream, EXT_PATH("filestream.str"), FSAM_READ, FSOM_OPEN_EXISTING));
+
+        size_t lines, bytes;
+        uint32_t elapsed = stream_read_line_benchmark(stream, &lines, &bytes);
+        mu_assert_int_eq(line_count, lines);
+        mu_assert_int_eq(expected_bytes, bytes);
+
+        FURI_LOG_I(
+            TAG,
+            "read_line, cache %u: %u bytes in %lu ms, %lu KiB/s",
+            cache_sizes[i],
+            file_size,
+            elapsed,
+            (uint32_t)(file_size * 1000 / 1024 / MAX(elapsed, 1UL)));
+
+        stream_free(stream);
+    }
+
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
@@ -526,7 +591,16 @@ MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_buffered_large_file_test);
 }
 
+MU_TEST_SUITE(stream_benchmark_suite) {
+    MU_RUN_TEST(stream_buffered_read_line_benchmark_test);
+}
+
 int run_minunit_test_stream() {
     MU_RUN_SUITE(stream_suite);
     return MU_EXIT_CODE;
 }
+
+int run_minunit_test_stream_benchmark() {
+    MU_RUN_SUITE(stream_benchmark_suite);
+    return MU_EXIT_CODE;
+}
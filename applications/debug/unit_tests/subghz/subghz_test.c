@@ -4,6 +4,7 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/subghz_keystore_cache.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <flipper_format/flipper_format_i.h>
@@ -217,6 +218,171 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+static void subghz_test_keystore_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    UNUSED(decoder_base);
+    uint32_t* decoded_at = context;
+    if(!*decoded_at) *decoded_at = furi_get_tick();
+}
+
+/* Feed capture to named decoder until it decodes, decoded_at is set by callback */
+static void subghz_test_keystore_decode(
+    SubGhzReceiver* receiver,
+    const char* path,
+    const char* name_decoder,
+    uint32_t* decoded_at) {
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver, name_decoder);
+    if(!decoder) return;
+
+    SubGhzFileEncoderWorker* worker = subghz_file_encoder_worker_alloc();
+    if(subghz_file_encoder_worker_start(worker, path, NULL)) {
+        // the worker needs a file in order to open and read part of the file
+        furi_delay_ms(100);
+
+        while(!*decoded_at) {
+            LevelDuration level_duration = subghz_file_encoder_worker_get_level_duration(worker);
+            if(level_duration_is_reset(level_duration)) break;
+            // Yield, to load data inside the worker
+            furi_thread_yield();
+            decoder->protocol->decoder->feed(
+                decoder,
+                level_duration_get_level(level_duration),
+                level_duration_get_duration(level_duration));
+        }
+    }
+    if(subghz_file_encoder_worker_is_running(worker)) {
+        subghz_file_encoder_worker_stop(worker);
+    }
+    subghz_file_encoder_worker_free(worker);
+}
+
+MU_TEST(subghz_keystore_shared_test) {
+    mu_assert(furi_record_exists(RECORD_SUBGHZ_KEYSTORE), "Keystore cache is missing");
+
+    // Same files as preloaded at system start, user file may be missing
+    const char* files[] = {SUBGHZ_KEYSTORE_DIR_NAME, SUBGHZ_KEYSTORE_DIR_USER_NAME};
+    SubGhzKeystoreCache* keystore_cache = furi_record_open(RECORD_SUBGHZ_KEYSTORE);
+    mu_assert(
+        subghz_keystore_cache_peek(keystore_cache, files, COUNT_OF(files), NULL),
+        "Keystore is not preloaded");
+    furi_record_close(RECORD_SUBGHZ_KEYSTORE);
+
+    // Every consumer had its own copy before
+    uint32_t start = furi_get_tick();
+    size_t free_heap = memmgr_get_free_heap();
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+    for(size_t i = 0; i < COUNT_OF(files); i++) {
+        subghz_keystore_load(keystore, files[i]);
+    }
+    size_t free_heap_after = memmgr_get_free_heap();
+    FURI_LOG_I(
+        TAG,
+        "Own keystore: %lu ms, %zu bytes",
+        furi_get_tick() - start,
+        free_heap > free_heap_after ? free_heap - free_heap_after : 0);
+    subghz_keystore_free(keystore);
+
+    SubGhzEnvironment* environment[2];
+    SubGhzReceiver* receiver[COUNT_OF(environment)];
+    SubGhzKeyArray_t* data[COUNT_OF(environment)];
+    uint32_t decoded_at[COUNT_OF(environment)] = {0};
+    for(size_t i = 0; i < COUNT_OF(environment); i++) {
+        start = furi_get_tick();
+        free_heap = memmgr_get_free_heap();
+
+        environment[i] = subghz_environment_alloc();
+        subghz_environment_set_protocol_registry(
+            environment[i], (void*)&subghz_protocol_registry);
+        mu_check(subghz_environment_load_keystore(environment[i], files[0]));
+        subghz_environment_load_keystore(environment[i], files[1]);
+        data[i] = subghz_keystore_get_data(subghz_environment_get_keystore(environment[i]));
+        free_heap_after = memmgr_get_free_heap();
+
+        receiver[i] = subghz_receiver_alloc_init(environment[i]);
+        subghz_receiver_set_rx_callback(
+            receiver[i], subghz_test_keystore_rx_callback, &decoded_at[i]);
+        subghz_test_keystore_decode(
+            receiver[i],
+            EXT_PATH("unit_tests/subghz/doorhan_raw.sub"),
+            SUBGHZ_PROTOCOL_KEELOQ_NAME,
+            &decoded_at[i]);
+        mu_check(decoded_at[i]);
+
+        FURI_LOG_I(
+            TAG,
+            "Environment %zu: first decode in %lu ms, keystore %zu bytes",
+            i,
+            decoded_at[i] - start,
+            free_heap > free_heap_after ? free_heap - free_heap_after : 0);
+    }
+
+    // Preloaded once, both see the same keys
+    mu_check(SubGhzKeyArray_size(*data[0]) > 0);
+    mu_check(data[0] == data[1]);
+
+    for(size_t i = 0; i < COUNT_OF(environment); i++) {
+        subghz_receiver_free(receiver[i]);
+        subghz_environment_free(environment[i]);
+    }
+}
+
+static size_t subghz_test_receiver_allocated(SubGhzReceiver* receiver, uint32_t* allocations) {
+    size_t count = subghz_receiver_get_footprint(receiver, NULL, 0);
+    SubGhzReceiverFootprint* footprint = malloc(count * sizeof(SubGhzReceiverFootprint));
+    subghz_receiver_get_footprint(receiver, footprint, count);
+
+    size_t allocated = 0;
+    if(allocations) *allocations = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(footprint[i].is_allocated) allocated++;
+        if(allocations) *allocations += footprint[i].allocations;
+    }
+
+    free(footprint);
+    return allocated;
+}
+
+MU_TEST(subghz_receiver_lazy_test) {
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment_handler);
+    uint32_t allocations = 0;
+    mu_assert_int_eq(0, subghz_test_receiver_allocated(receiver, &allocations));
+    mu_assert_int_eq(0, allocations);
+
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    size_t decodable = subghz_test_receiver_allocated(receiver, NULL);
+    mu_check(decodable > 0);
+
+    // Looked up decoder stays, the rest is released with filter
+    mu_check(
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_PRINCETON_NAME));
+    subghz_receiver_set_filter(receiver, 0);
+    mu_assert_int_eq(1, subghz_test_receiver_allocated(receiver, NULL));
+
+    // Idle decoders are released, skipped by decode and allocated again by restore
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    size_t free_heap = memmgr_get_free_heap();
+    mu_assert_int_eq(decodable - 1, subghz_receiver_release_idle(receiver, 0));
+    size_t free_heap_idle = memmgr_get_free_heap();
+    mu_assert_int_eq(1, subghz_test_receiver_allocated(receiver, NULL));
+    subghz_receiver_decode(receiver, true, 100);
+    mu_assert_int_eq(1, subghz_test_receiver_allocated(receiver, NULL));
+    mu_assert_int_eq(decodable - 1, subghz_receiver_restore(receiver));
+    mu_assert_int_eq(decodable, subghz_test_receiver_allocated(receiver, &allocations));
+    mu_assert_int_eq(decodable * 3 - 2, allocations);
+    FURI_LOG_I(
+        TAG,
+        "Receiver idle: %zu of %zu decoders released, %zu bytes",
+        decodable - 1,
+        decodable,
+        free_heap_idle > free_heap ? free_heap_idle - free_heap : 0);
+
+    subghz_receiver_free(receiver);
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -813,6 +979,8 @@ MU_TEST(subghz_random_test) {
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keystore_shared_test);
+    MU_RUN_TEST(subghz_receiver_lazy_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -13,14 +13,20 @@ int run_minunit_test_furi_hal();
 int run_minunit_test_furi_hal_crypto();
 int run_minunit_test_furi_string();
 int run_minunit_test_infrared();
+int run_minunit_test_infrared_benchmark();
 int run_minunit_test_rpc();
+int run_minunit_test_rpc_benchmark();
 int run_minunit_test_manifest();
 int run_minunit_test_flipper_format();
 int run_minunit_test_flipper_format_string();
 int run_minunit_test_stream();
+int run_minunit_test_stream_benchmark();
 int run_minunit_test_storage();
 int run_minunit_test_subghz();
 int run_minunit_test_dirwalk();
+int run_minunit_test_dirwalk_benchmark();
+int run_minunit_test_compress();
+int run_minunit_test_compress_benchmark();
 int run_minunit_test_power();
 int run_minunit_test_protocol_dict();
 int run_minunit_test_lfrfid_protocols();
@@ -29,12 +35,15 @@ int run_minunit_test_bit_lib();
 int run_minunit_test_float_tools();
 int run_minunit_test_bt();
 int run_minunit_test_dialogs_file_browser_options();
+int run_minunit_test_view_dispatcher();
 
 typedef int (*UnitTestEntry)();
 
 typedef struct {
     const char* name;
     const UnitTestEntry entry;
+    // Long running, only started when requested by name
+    const bool is_opt_in;
 } UnitTest;
 
 const UnitTest unit_tests[] = {
@@ -44,13 +53,23 @@ const UnitTest unit_tests[] = {
     {.name = "furi_string", .entry = run_minunit_test_furi_string},
     {.name = "storage", .entry = run_minunit_test_storage},
     {.name = "stream", .entry = run_minunit_test_stream},
+    {.name = "stream_benchmark", .entry = run_minunit_test_stream_benchmark, .is_opt_in = true},
     {.name = "dirwalk", .entry = run_minunit_test_dirwalk},
+    {.name = "dirwalk_benchmark", .entry = run_minunit_test_dirwalk_benchmark, .is_opt_in = true},
+    {.name = "compress", .entry = run_minunit_test_compress},
+    {.name = "compress_benchmark",
+     .entry = run_minunit_test_compress_benchmark,
+     .is_opt_in = true},
     {.name = "manifest", .entry = run_minunit_test_manifest},
     {.name = "flipper_format", .entry = run_minunit_test_flipper_format},
     {.name = "flipper_format_string", .entry = run_minunit_test_flipper_format_string},
     {.name = "rpc", .entry = run_minunit_test_rpc},
+    {.name = "rpc_benchmark", .entry = run_minunit_test_rpc_benchmark, .is_opt_in = true},
     {.name = "subghz", .entry = run_minunit_test_subghz},
     {.name = "infrared", .entry = run_minunit_test_infrared},
+    {.name = "infrared_benchmark",
+     .entry = run_minunit_test_infrared_benchmark,
+     .is_opt_in = true},
     {.name = "nfc", .entry = run_minunit_test_nfc},
     {.name = "power", .entry = run_minunit_test_power},
     {.name = "protocol_dict", .entry = run_minunit_test_protocol_dict},
@@ -60,6 +79,7 @@ const UnitTest unit_tests[] = {
     {.name = "bt", .entry = run_minunit_test_bt},
     {.name = "dialogs_file_browser_options",
      .entry = run_minunit_test_dialogs_file_browser_options},
+    {.name = "view_dispatcher", .entry = run_minunit_test_view_dispatcher},
 };
 
 void minunit_print_progress() {
@@ -111,7 +131,7 @@ void unit_tests_cli(Cli* cli, FuriString* args, void* context) {
                 } else {
                     printf("Skipping %s\r\n", unit_tests[i].name);
                 }
-            } else {
+            } else if(!unit_tests[i].is_opt_in) {
                 unit_tests[i].entry();
             }
         }
@@ -142,6 +142,14 @@ static Infrared* infrared_alloc() {
     infrared->received_signal = infrared_signal_alloc();
     infrared->brute_force = infrared_brute_force_alloc();
 
+    infrared->index = infrared_index_alloc(infrared->storage, INFRARED_INDEX_PATH);
+    infrared_index_add_source_dir(infrared->index, INFRARED_REMOTES_FOLDER);
+    infrared_index_add_source_dir(infrared->index, INFRARED_LIBRARY_FOLDER);
+    for(size_t i = 0; i < INFRARED_MATCH_COUNT_MAX; i++) {
+        infrared->matches[i].path = furi_string_alloc();
+        infrared->matches[i].name = furi_string_alloc();
+    }
+
     infrared->submenu = submenu_alloc();
     view_dispatcher_add_view(
         view_dispatcher, InfraredViewSubmenu, submenu_get_view(infrared->submenu));
@@ -228,6 +236,11 @@ static void infrared_free(Infrared* infrared) {
     view_dispatcher_free(view_dispatcher);
     scene_manager_free(infrared->scene_manager);
 
+    for(size_t i = 0; i < INFRARED_MATCH_COUNT_MAX; i++) {
+        furi_string_free(infrared->matches[i].path);
+        furi_string_free(infrared->matches[i].name);
+    }
+    infrared_index_free(infrared->index);
     infrared_brute_force_free(infrared->brute_force);
     infrared_signal_free(infrared->received_signal);
     infrared_remote_free(infrared->remote);
@@ -397,6 +410,58 @@ void infrared_show_loading_popup(Infrared* infrared, bool show) {
     }
 }
 
+bool infrared_sync_index(Infrared* infrared) {
+    ViewStack* view_stack = infrared->view_stack;
+    view_set_orientation(view_stack_get_view(view_stack), ViewOrientationHorizontal);
+    view_dispatcher_switch_to_view(infrared->view_dispatcher, InfraredViewStack);
+
+    infrared_show_loading_popup(infrared, true);
+    bool success = infrared_index_sync(infrared->index);
+    infrared_show_loading_popup(infrared, false);
+
+    return success;
+}
+
+static bool infrared_index_match_callback(const InfraredIndexMatch* match, void* context) {
+    Infrared* infrared = context;
+
+    // Libraries contain the same signal for many models, one suggestion per file is enough
+    for(size_t i = 0; i < infrared->match_count; i++) {
+        if(furi_string_equal(infrared->matches[i].path, match->path)) {
+            return true;
+        }
+    }
+
+    InfraredMatch* found = &infrared->matches[infrared->match_count++];
+    furi_string_set(found->path, match->path);
+    furi_string_set(found->name, match->name);
+
+    return infrared->match_count < INFRARED_MATCH_COUNT_MAX;
+}
+
+size_t infrared_find_received_signal(Infrared* infrared) {
+    InfraredSignal* signal = infrared->received_signal;
+    infrared->match_count = 0;
+
+    if(infrared_signal_is_raw(signal)) {
+        InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
+        infrared_index_lookup_raw(
+            infrared->index,
+            raw->timings,
+            raw->timings_size,
+            infrared_index_match_callback,
+            infrared);
+    } else {
+        infrared_index_lookup_message(
+            infrared->index,
+            infrared_signal_get_message(signal),
+            infrared_index_match_callback,
+            infrared);
+    }
+
+    return infrared->match_count;
+}
+
 void infrared_signal_received_callback(void* context, InfraredWorkerSignal* received_signal) {
     furi_assert(context);
     Infrared* infrared = context;
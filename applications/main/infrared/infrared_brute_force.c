@@ -6,6 +6,9 @@
 
 #include "infrared_signal.h"
 
+/* Universal remote libraries are big and always read from start to end */
+#define INFRARED_BRUTE_FORCE_CACHE_SIZE (4 * 1024)
+
 typedef struct {
     uint32_t index;
     uint32_t count;
@@ -56,7 +59,8 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
     bool success = false;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FlipperFormat* ff =
+        flipper_format_buffered_file_alloc_ex(storage, INFRARED_BRUTE_FORCE_CACHE_SIZE);
 
     success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
     if(success) {
@@ -101,7 +105,8 @@ bool infrared_brute_force_start(
 
     if(*record_count) {
         Storage* storage = furi_record_open(RECORD_STORAGE);
-        brute_force->ff = flipper_format_buffered_file_alloc(storage);
+        brute_force->ff =
+            flipper_format_buffered_file_alloc_ex(storage, INFRARED_BRUTE_FORCE_CACHE_SIZE);
         brute_force->current_signal = infrared_signal_alloc();
         brute_force->is_started = true;
         success =
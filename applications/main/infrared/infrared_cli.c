@@ -72,7 +72,8 @@ static void infrared_cli_print_usage(void) {
     printf("\tir tx <protocol> <address> <command>\r\n");
     printf("\t<command> and <address> are hex-formatted\r\n");
     printf("\tAvailable protocols:");
-    for(int i = 0; infrared_is_protocol_valid((InfraredProtocol)i); ++i) {
+    for(int i = 0; i < InfraredProtocolMAX; ++i) {
+        if(!infrared_is_protocol_valid((InfraredProtocol)i)) continue;
         printf(" %s", infrared_get_protocol_name((InfraredProtocol)i));
     }
     printf("\r\n");
@@ -21,6 +21,7 @@
 #include <notification/notification_messages.h>
 
 #include <infrared_worker.h>
+#include <infrared_index.h>
 
 #include "infrared.h"
 #include "infrared_remote.h"
@@ -44,6 +45,11 @@
 #define INFRARED_APP_FOLDER ANY_PATH("infrared")
 #define INFRARED_APP_EXTENSION ".ir"
 
+#define INFRARED_INDEX_PATH EXT_PATH("infrared/.index")
+#define INFRARED_REMOTES_FOLDER EXT_PATH("infrared")
+#define INFRARED_LIBRARY_FOLDER EXT_PATH("infrared/assets")
+#define INFRARED_MATCH_COUNT_MAX 4
+
 #define INFRARED_DEFAULT_REMOTE_NAME "Remote"
 #define INFRARED_LOG_TAG "InfraredApp"
 
@@ -63,6 +69,11 @@ typedef enum {
     InfraredEditModeDelete,
 } InfraredEditMode;
 
+typedef struct {
+    FuriString* path;
+    FuriString* name;
+} InfraredMatch;
+
 typedef struct {
     bool is_learning_new_remote;
     bool is_debug_enabled;
@@ -86,6 +97,7 @@ struct Infrared {
     InfraredRemote* remote;
     InfraredSignal* received_signal;
     InfraredBruteForce* brute_force;
+    InfraredIndex* index;
 
     Submenu* submenu;
     TextInput* text_input;
@@ -102,6 +114,8 @@ struct Infrared {
     InfraredProgressView* progress;
 
     FuriString* file_path;
+    InfraredMatch matches[INFRARED_MATCH_COUNT_MAX];
+    size_t match_count;
     char text_store[INFRARED_TEXT_STORE_NUM][INFRARED_TEXT_STORE_SIZE + 1];
     InfraredAppState app_state;
 
@@ -140,6 +154,8 @@ void infrared_text_store_set(Infrared* infrared, uint32_t bank, const char* text
 void infrared_text_store_clear(Infrared* infrared, uint32_t bank);
 void infrared_play_notification_message(Infrared* infrared, uint32_t message);
 void infrared_show_loading_popup(Infrared* infrared, bool show);
+bool infrared_sync_index(Infrared* infrared);
+size_t infrared_find_received_signal(Infrared* infrared);
 
 void infrared_signal_received_callback(void* context, InfraredWorkerSignal* received_signal);
 void infrared_text_input_callback(void* context);
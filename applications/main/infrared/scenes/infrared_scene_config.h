@@ -11,6 +11,7 @@ ADD_SCENE(infrared, edit_move, EditMove)
 ADD_SCENE(infrared, learn, Learn)
 ADD_SCENE(infrared, learn_done, LearnDone)
 ADD_SCENE(infrared, learn_enter_name, LearnEnterName)
+ADD_SCENE(infrared, learn_match, LearnMatch)
 ADD_SCENE(infrared, learn_success, LearnSuccess)
 ADD_SCENE(infrared, remote, Remote)
 ADD_SCENE(infrared, remote_list, RemoteList)
@@ -27,7 +27,13 @@ bool infrared_scene_learn_on_event(void* context, SceneManagerEvent event) {
     if(event.type == SceneManagerEventTypeCustom) {
         if(event.event == InfraredCustomEventTypeSignalReceived) {
             infrared_play_notification_message(infrared, InfraredNotificationMessageSuccess);
-            scene_manager_next_scene(infrared->scene_manager, InfraredSceneLearnSuccess);
+            if(infrared->app_state.is_learning_new_remote &&
+               infrared_find_received_signal(infrared)) {
+                scene_manager_set_scene_state(infrared->scene_manager, InfraredSceneLearnMatch, 0);
+                scene_manager_next_scene(infrared->scene_manager, InfraredSceneLearnMatch);
+            } else {
+                scene_manager_next_scene(infrared->scene_manager, InfraredSceneLearnSuccess);
+            }
             dolphin_deed(DolphinDeedIrLearnSuccess);
             consumed = true;
         }
@@ -0,0 +1,132 @@
+#include "../infrared_i.h"
+
+#include <toolbox/path.h>
+
+enum SubmenuIndex {
+    // Matches take indexes from 0 to INFRARED_MATCH_COUNT_MAX - 1
+    SubmenuIndexContinue = INFRARED_MATCH_COUNT_MAX,
+};
+
+typedef struct {
+    const char* name;
+    uint32_t scene;
+} InfraredLibraryScene;
+
+static const InfraredLibraryScene infrared_library_scenes[] = {
+    {.name = "tv", .scene = InfraredSceneUniversalTV},
+    {.name = "ac", .scene = InfraredSceneUniversalAC},
+    {.name = "audio", .scene = InfraredSceneUniversalAudio},
+    {.name = "projector", .scene = InfraredSceneUniversalProjector},
+};
+
+static void infrared_scene_learn_match_submenu_callback(void* context, uint32_t index) {
+    Infrared* infrared = context;
+    view_dispatcher_send_custom_event(infrared->view_dispatcher, index);
+}
+
+static const InfraredLibraryScene* infrared_scene_learn_match_get_library(FuriString* path) {
+    if(!furi_string_start_with_str(path, INFRARED_LIBRARY_FOLDER "/")) {
+        return NULL;
+    }
+
+    FuriString* name = furi_string_alloc();
+    path_extract_filename(path, name, true);
+
+    const InfraredLibraryScene* library = NULL;
+    for(size_t i = 0; i < COUNT_OF(infrared_library_scenes); i++) {
+        if(furi_string_equal(name, infrared_library_scenes[i].name)) {
+            library = &infrared_library_scenes[i];
+            break;
+        }
+    }
+
+    furi_string_free(name);
+    return library;
+}
+
+static bool infrared_scene_learn_match_open_remote(Infrared* infrared, FuriString* path) {
+    view_set_orientation(view_stack_get_view(infrared->view_stack), ViewOrientationVertical);
+    view_dispatcher_switch_to_view(infrared->view_dispatcher, InfraredViewStack);
+
+    infrared_show_loading_popup(infrared, true);
+    bool success = infrared_remote_load(infrared->remote, path);
+    infrared_show_loading_popup(infrared, false);
+
+    if(success) {
+        furi_string_set(infrared->file_path, path);
+        infrared->app_state.is_learning_new_remote = false;
+        scene_manager_next_scene(infrared->scene_manager, InfraredSceneRemote);
+    } else {
+        view_dispatcher_switch_to_view(infrared->view_dispatcher, InfraredViewSubmenu);
+    }
+
+    return success;
+}
+
+void infrared_scene_learn_match_on_enter(void* context) {
+    Infrared* infrared = context;
+    Submenu* submenu = infrared->submenu;
+    FuriString* label = furi_string_alloc();
+
+    infrared_play_notification_message(infrared, InfraredNotificationMessageGreenOn);
+    submenu_set_header(submenu, "Signal is known:");
+
+    for(size_t i = 0; i < infrared->match_count; i++) {
+        InfraredMatch* match = &infrared->matches[i];
+        path_extract_filename(match->path, label, true);
+        furi_string_cat_printf(label, ": %s", furi_string_get_cstr(match->name));
+        submenu_add_item(
+            submenu,
+            furi_string_get_cstr(label),
+            i,
+            infrared_scene_learn_match_submenu_callback,
+            infrared);
+    }
+
+    submenu_add_item(
+        submenu,
+        "Save as New Remote",
+        SubmenuIndexContinue,
+        infrared_scene_learn_match_submenu_callback,
+        infrared);
+
+    submenu_set_selected_item(
+        submenu, scene_manager_get_scene_state(infrared->scene_manager, InfraredSceneLearnMatch));
+    furi_string_free(label);
+
+    view_dispatcher_switch_to_view(infrared->view_dispatcher, InfraredViewSubmenu);
+}
+
+bool infrared_scene_learn_match_on_event(void* context, SceneManagerEvent event) {
+    Infrared* infrared = context;
+    SceneManager* scene_manager = infrared->scene_manager;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeBack) {
+        scene_manager_next_scene(scene_manager, InfraredSceneAskBack);
+        consumed = true;
+    } else if(event.type == SceneManagerEventTypeCustom) {
+        scene_manager_set_scene_state(scene_manager, InfraredSceneLearnMatch, event.event);
+        if(event.event == SubmenuIndexContinue) {
+            scene_manager_next_scene(scene_manager, InfraredSceneLearnSuccess);
+        } else if(event.event < infrared->match_count) {
+            FuriString* path = infrared->matches[event.event].path;
+            const InfraredLibraryScene* library = infrared_scene_learn_match_get_library(path);
+            if(library) {
+                // Universal remote has the rest of the buttons for this signal
+                scene_manager_next_scene(scene_manager, library->scene);
+            } else {
+                infrared_scene_learn_match_open_remote(infrared, path);
+            }
+        }
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+void infrared_scene_learn_match_on_exit(void* context) {
+    Infrared* infrared = context;
+    submenu_reset(infrared->submenu);
+    infrared_play_notification_message(infrared, InfraredNotificationMessageGreenOff);
+}
@@ -63,6 +63,8 @@ bool infrared_scene_start_on_event(void* context, SceneManagerEvent event) {
             consumed = true;
         } else if(submenu_index == SubmenuIndexLearnNewRemote) {
             infrared->app_state.is_learning_new_remote = true;
+            // Index is only rebuilt if remotes changed since the last time
+            infrared_sync_index(infrared);
             scene_manager_next_scene(scene_manager, InfraredSceneLearn);
             consumed = true;
         } else if(submenu_index == SubmenuIndexSavedRemotes) {
@@ -9,6 +9,14 @@ typedef enum {
     DictAttackStateFlipperDictInProgress,
 } DictAttackState;
 
+// Progress events, worker must not wait for GUI to draw each of them
+static const uint32_t nfc_scene_mf_classic_dict_attack_counted_events[] = {
+    NfcWorkerEventFoundKeyA,
+    NfcWorkerEventFoundKeyB,
+    NfcWorkerEventNewDictKeyBatch,
+    NfcWorkerEventKeyAttackNextSector,
+};
+
 bool nfc_dict_attack_worker_callback(NfcWorkerEvent event, void* context) {
     furi_assert(context);
     Nfc* nfc = context;
@@ -89,6 +97,13 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(Nfc* nfc, DictAttackSt
 
 void nfc_scene_mf_classic_dict_attack_on_enter(void* context) {
     Nfc* nfc = context;
+    for(size_t i = 0; i < COUNT_OF(nfc_scene_mf_classic_dict_attack_counted_events); i++) {
+        view_dispatcher_set_custom_event_mode(
+            nfc->view_dispatcher,
+            nfc_scene_mf_classic_dict_attack_counted_events[i],
+            ViewDispatcherCustomEventModeCount);
+    }
+    view_dispatcher_reset_custom_event_stats(nfc->view_dispatcher);
     nfc_scene_mf_classic_dict_attack_prepare_view(nfc, DictAttackStateIdle);
     view_dispatcher_switch_to_view(nfc->view_dispatcher, NfcViewDictAttack);
     nfc_blink_read_start(nfc);
@@ -99,6 +114,7 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
     Nfc* nfc = context;
     MfClassicData* data = &nfc->dev->dev_data.mf_classic_data;
     bool consumed = false;
+    uint32_t count = view_dispatcher_get_custom_event_value(nfc->view_dispatcher);
 
     uint32_t state =
         scene_manager_get_scene_state(nfc->scene_manager, NfcSceneMfClassicDictAttack);
@@ -133,10 +149,14 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
             dict_attack_set_card_removed(nfc->dict_attack);
             consumed = true;
         } else if(event.event == NfcWorkerEventFoundKeyA) {
-            dict_attack_inc_keys_found(nfc->dict_attack);
+            for(uint32_t i = 0; i < count; i++) {
+                dict_attack_inc_keys_found(nfc->dict_attack);
+            }
             consumed = true;
         } else if(event.event == NfcWorkerEventFoundKeyB) {
-            dict_attack_inc_keys_found(nfc->dict_attack);
+            for(uint32_t i = 0; i < count; i++) {
+                dict_attack_inc_keys_found(nfc->dict_attack);
+            }
             consumed = true;
         } else if(event.event == NfcWorkerEventNewSector) {
             nfc_scene_mf_classic_dict_attack_update_view(nfc);
@@ -144,7 +164,7 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
             consumed = true;
         } else if(event.event == NfcWorkerEventNewDictKeyBatch) {
             nfc_scene_mf_classic_dict_attack_update_view(nfc);
-            dict_attack_inc_current_dict_key(nfc->dict_attack, NFC_DICT_KEY_BATCH_SIZE);
+            dict_attack_inc_current_dict_key(nfc->dict_attack, NFC_DICT_KEY_BATCH_SIZE * count);
             consumed = true;
         } else if(event.event == NfcCustomEventDictAttackSkip) {
             if(state == DictAttackStateUserDictInProgress) {
@@ -162,7 +182,9 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
         } else if(event.event == NfcWorkerEventKeyAttackStop) {
             dict_attack_set_key_attack(nfc->dict_attack, false, 0);
         } else if(event.event == NfcWorkerEventKeyAttackNextSector) {
-            dict_attack_inc_key_attack_current_sector(nfc->dict_attack);
+            for(uint32_t i = 0; i < count; i++) {
+                dict_attack_inc_key_attack_current_sector(nfc->dict_attack);
+            }
         }
     } else if(event.type == SceneManagerEventTypeBack) {
         scene_manager_next_scene(nfc->scene_manager, NfcSceneExitConfirm);
@@ -176,6 +198,22 @@ void nfc_scene_mf_classic_dict_attack_on_exit(void* context) {
     NfcMfClassicDictAttackData* dict_attack_data = &nfc->dev->dev_data.mf_classic_dict_attack_data;
     // Stop worker
     nfc_worker_stop(nfc->worker);
+    for(size_t i = 0; i < COUNT_OF(nfc_scene_mf_classic_dict_attack_counted_events); i++) {
+        view_dispatcher_set_custom_event_mode(
+            nfc->view_dispatcher,
+            nfc_scene_mf_classic_dict_attack_counted_events[i],
+            ViewDispatcherCustomEventModeQueue);
+    }
+    ViewDispatcherCustomEventStats stats;
+    view_dispatcher_get_custom_event_stats(nfc->view_dispatcher, &stats);
+    FURI_LOG_D(
+        TAG,
+        "Events: %lu sent, %lu dispatched, %lu merged. Worker stalled %lu times, %lu us max",
+        stats.sent,
+        stats.dispatched,
+        stats.merged,
+        stats.stalls,
+        stats.stall_max);
     if(dict_attack_data->dict) {
         mf_classic_dict_free(dict_attack_data->dict);
         dict_attack_data->dict = NULL;
@@ -6,6 +6,8 @@
 
 #define TAG "SubGhz"
 
+#define SUBGHZ_TXRX_DECODER_IDLE_TIMEOUT (10000)
+
 static void subghz_txrx_radio_device_power_on(SubGhzTxRx* instance) {
     UNUSED(instance);
     uint8_t attempts = 5;
@@ -176,6 +178,18 @@ static uint32_t subghz_txrx_rx(SubGhzTxRx* instance, uint32_t frequency) {
     subghz_devices_flush_rx(instance->radio_device);
     subghz_txrx_speaker_on(instance);
 
+    // Decoders released while idle, RX thread does not allocate them
+    size_t free_heap = memmgr_get_free_heap();
+    size_t restored = subghz_receiver_restore(instance->receiver);
+    if(restored) {
+        size_t free_heap_after = memmgr_get_free_heap();
+        FURI_LOG_D(
+            TAG,
+            "Restored %zu decoders, %zu bytes",
+            restored,
+            free_heap > free_heap_after ? free_heap - free_heap_after : 0);
+    }
+
     subghz_devices_start_async_rx(
         instance->radio_device, subghz_worker_rx_callback, instance->worker);
     subghz_worker_start(instance->worker);
@@ -530,6 +544,24 @@ void subghz_txrx_receiver_set_filter(SubGhzTxRx* instance, SubGhzProtocolFlag fi
     subghz_receiver_set_filter(instance->receiver, filter);
 }
 
+void subghz_txrx_receiver_release_idle(SubGhzTxRx* instance) {
+    furi_assert(instance);
+    // Restored on RX start only, receiving decoders stay
+    if(instance->txrx_state == SubGhzTxRxStateRx) return;
+
+    size_t free_heap = memmgr_get_free_heap();
+    size_t released =
+        subghz_receiver_release_idle(instance->receiver, SUBGHZ_TXRX_DECODER_IDLE_TIMEOUT);
+    if(released) {
+        size_t free_heap_after = memmgr_get_free_heap();
+        FURI_LOG_D(
+            TAG,
+            "Released %zu idle decoders, %zu bytes",
+            released,
+            free_heap_after > free_heap ? free_heap_after - free_heap : 0);
+    }
+}
+
 void subghz_txrx_set_rx_calback(
     SubGhzTxRx* instance,
     SubGhzReceiverCallback callback,
@@ -266,6 +266,14 @@ bool subghz_txrx_protocol_is_transmittable(SubGhzTxRx* instance, bool check_type
  */
 void subghz_txrx_receiver_set_filter(SubGhzTxRx* instance, SubGhzProtocolFlag filter);
 
+/**
+ * Release decoders that didn't receive anything for a while, not while receiving.
+ * Released decoders are allocated again when receiving starts
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ */
+void subghz_txrx_receiver_release_idle(SubGhzTxRx* instance);
+
 /**
  * Set callback for receive data
  * 
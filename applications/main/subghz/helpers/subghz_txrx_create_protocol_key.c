@@ -108,8 +108,8 @@ SubGhzProtocolStatus subghz_txrx_gen_keeloq_protocol(
             name_sysmem,
             instance->preset);
         ret = SubGhzProtocolStatusOk;
+        subghz_transmitter_free(instance->transmitter);
     }
-    subghz_transmitter_free(instance->transmitter);
     return ret;
 }
 
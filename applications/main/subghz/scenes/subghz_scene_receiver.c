@@ -132,9 +132,8 @@ void subghz_scene_receiver_on_enter(void* context) {
     subghz_txrx_rx_start(subghz->txrx);
     subghz_view_receiver_set_idx_menu(subghz->subghz_receiver, subghz->idx_menu_chosen);
 
-    //to use a universal decoder, we are looking for a link to it
-    furi_check(
-        subghz_txrx_load_decoder_by_name_protocol(subghz->txrx, SUBGHZ_PROTOCOL_BIN_RAW_NAME));
+    //to use a universal decoder, we are looking for a link to it, it may be left out of the build
+    subghz_txrx_load_decoder_by_name_protocol(subghz->txrx, SUBGHZ_PROTOCOL_BIN_RAW_NAME);
 
     subghz_scene_receiver_update_statusbar(subghz);
 
@@ -198,8 +197,11 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
             subghz->threshold_rssi, subghz_txrx_radio_device_get_rssi(subghz->txrx));
 
         subghz_receiver_rssi(subghz->subghz_receiver, ret_rssi.rssi);
-        subghz_protocol_decoder_bin_raw_data_input_rssi(
-            (SubGhzProtocolDecoderBinRAW*)subghz_txrx_get_decoder(subghz->txrx), ret_rssi.rssi);
+        SubGhzProtocolDecoderBase* bin_raw = subghz_txrx_get_decoder(subghz->txrx);
+        if(bin_raw) {
+            subghz_protocol_decoder_bin_raw_data_input_rssi(
+                (SubGhzProtocolDecoderBinRAW*)bin_raw, ret_rssi.rssi);
+        }
 
         switch(subghz->state_notifications) {
         case SubGhzNotificationStateRx:
@@ -10,105 +10,62 @@ void subghz_scene_set_type_submenu_callback(void* context, uint32_t index) {
     view_dispatcher_send_custom_event(subghz->view_dispatcher, index);
 }
 
+// Protocols can be left out of the build, only offer the ones that are there
+static void subghz_scene_set_type_add_item(
+    SubGhz* subghz,
+    const char* label,
+    uint32_t index,
+    const char* protocol_name) {
+    if(subghz_protocol_registry_get_by_name(&subghz_protocol_registry, protocol_name)) {
+        submenu_add_item(
+            subghz->submenu, label, index, subghz_scene_set_type_submenu_callback, subghz);
+    }
+}
+
 void subghz_scene_set_type_on_enter(void* context) {
     SubGhz* subghz = context;
 
-    submenu_add_item(
-        subghz->submenu,
-        "Princeton_433",
-        SubmenuIndexPricenton_433,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "Princeton_315",
-        SubmenuIndexPricenton_315,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "Nice Flo 12bit_433",
-        SubmenuIndexNiceFlo12bit,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "Nice Flo 24bit_433",
-        SubmenuIndexNiceFlo24bit,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "CAME 12bit_433",
-        SubmenuIndexCAME12bit,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "CAME 24bit_433",
-        SubmenuIndexCAME24bit,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "Linear_300",
-        SubmenuIndexLinear_300_00,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "CAME TWEE",
-        SubmenuIndexCAMETwee,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "Gate TX_433",
-        SubmenuIndexGateTX,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "DoorHan_315",
-        SubmenuIndexDoorHan_315_00,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "DoorHan_433",
-        SubmenuIndexDoorHan_433_92,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "LiftMaster_315",
-        SubmenuIndexLiftMaster_315_00,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
-        "LiftMaster_390",
-        SubmenuIndexLiftMaster_390_00,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
+    subghz_scene_set_type_add_item(
+        subghz, "Princeton_433", SubmenuIndexPricenton_433, SUBGHZ_PROTOCOL_PRINCETON_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "Princeton_315", SubmenuIndexPricenton_315, SUBGHZ_PROTOCOL_PRINCETON_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "Nice Flo 12bit_433", SubmenuIndexNiceFlo12bit, SUBGHZ_PROTOCOL_NICE_FLO_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "Nice Flo 24bit_433", SubmenuIndexNiceFlo24bit, SUBGHZ_PROTOCOL_NICE_FLO_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "CAME 12bit_433", SubmenuIndexCAME12bit, SUBGHZ_PROTOCOL_CAME_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "CAME 24bit_433", SubmenuIndexCAME24bit, SUBGHZ_PROTOCOL_CAME_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "Linear_300", SubmenuIndexLinear_300_00, SUBGHZ_PROTOCOL_LINEAR_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "CAME TWEE", SubmenuIndexCAMETwee, SUBGHZ_PROTOCOL_CAME_TWEE_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "Gate TX_433", SubmenuIndexGateTX, SUBGHZ_PROTOCOL_GATE_TX_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "DoorHan_315", SubmenuIndexDoorHan_315_00, SUBGHZ_PROTOCOL_KEELOQ_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "DoorHan_433", SubmenuIndexDoorHan_433_92, SUBGHZ_PROTOCOL_KEELOQ_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "LiftMaster_315", SubmenuIndexLiftMaster_315_00, SUBGHZ_PROTOCOL_SECPLUS_V1_NAME);
+    subghz_scene_set_type_add_item(
+        subghz, "LiftMaster_390", SubmenuIndexLiftMaster_390_00, SUBGHZ_PROTOCOL_SECPLUS_V1_NAME);
+    subghz_scene_set_type_add_item(
+        subghz,
         "Security+2.0_310",
         SubmenuIndexSecPlus_v2_310_00,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
+        SUBGHZ_PROTOCOL_SECPLUS_V2_NAME);
+    subghz_scene_set_type_add_item(
+        subghz,
         "Security+2.0_315",
         SubmenuIndexSecPlus_v2_315_00,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
-    submenu_add_item(
-        subghz->submenu,
+        SUBGHZ_PROTOCOL_SECPLUS_V2_NAME);
+    subghz_scene_set_type_add_item(
+        subghz,
         "Security+2.0_390",
         SubmenuIndexSecPlus_v2_390_00,
-        subghz_scene_set_type_submenu_callback,
-        subghz);
+        SUBGHZ_PROTOCOL_SECPLUS_V2_NAME);
 
     submenu_set_selected_item(
         subghz->submenu, scene_manager_get_scene_state(subghz->scene_manager, SubGhzSceneSetType));
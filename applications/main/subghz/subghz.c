@@ -18,6 +18,7 @@ void subghz_tick_event_callback(void* context) {
     furi_assert(context);
     SubGhz* subghz = context;
     scene_manager_handle_tick_event(subghz->scene_manager);
+    subghz_txrx_receiver_release_idle(subghz->txrx);
 }
 
 static void subghz_rpc_command_callback(RpcAppSystemEvent event, void* context) {
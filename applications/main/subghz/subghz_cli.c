@@ -5,6 +5,7 @@
 
 #include <lib/toolbox/args.h>
 #include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/subghz_keystore_cache.h>
 
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
@@ -188,6 +189,12 @@ void subghz_cli_command_tx(Cli* cli, FuriString* args, void* context) {
             return;
         }
     }
+    // Protocols can be left out of the build
+    if(!subghz_protocol_registry_get_by_name(
+           &subghz_protocol_registry, SUBGHZ_PROTOCOL_PRINCETON_NAME)) {
+        printf("Protocol " SUBGHZ_PROTOCOL_PRINCETON_NAME " is not built in\r\n");
+        return;
+    }
     subghz_devices_init();
     const SubGhzDevice* device = subghz_cli_command_get_device(&device_ind);
     if(!subghz_devices_is_frequency_valid(device, frequency)) {
@@ -224,7 +231,8 @@ void subghz_cli_command_tx(Cli* cli, FuriString* args, void* context) {
     SubGhzEnvironment* environment = subghz_environment_alloc();
     subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
 
-    SubGhzTransmitter* transmitter = subghz_transmitter_alloc_init(environment, "Princeton");
+    SubGhzTransmitter* transmitter =
+        subghz_transmitter_alloc_init(environment, SUBGHZ_PROTOCOL_PRINCETON_NAME);
     subghz_transmitter_deserialize(transmitter, flipper_format);
 
     subghz_devices_begin(device);
@@ -291,6 +299,24 @@ static void subghz_cli_command_rx_callback(
     furi_string_free(text);
 }
 
+static void subghz_cli_print_decoder_footprint(SubGhzReceiver* receiver) {
+    size_t count = subghz_receiver_get_footprint(receiver, NULL, 0);
+    SubGhzReceiverFootprint* footprint = malloc(count * sizeof(SubGhzReceiverFootprint));
+    subghz_receiver_get_footprint(receiver, footprint, count);
+
+    size_t allocated = 0;
+    size_t total = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(!footprint[i].is_allocated) continue;
+        printf("%-24s %6zu bytes\r\n", footprint[i].name, footprint[i].size);
+        allocated++;
+        total += footprint[i].size;
+    }
+    printf("Decoders allocated %zu of %zu, %zu bytes\r\n", allocated, count, total);
+
+    free(footprint);
+}
+
 void subghz_cli_command_rx(Cli* cli, FuriString* args, void* context) {
     UNUSED(context);
     uint32_t frequency = 433920000;
@@ -381,6 +407,7 @@ void subghz_cli_command_rx(Cli* cli, FuriString* args, void* context) {
     furi_hal_power_suppress_charge_exit();
 
     printf("\r\nPackets received %zu\r\n", instance->packet_count);
+    subghz_cli_print_decoder_footprint(receiver);
 
     // Cleanup
     subghz_receiver_free(receiver);
@@ -1039,6 +1066,12 @@ void subghz_on_system_start() {
     pb_release(PB_Region_fields, &pb_region);
     storage_file_free(file);
     furi_record_close(RECORD_STORAGE);
+
+    // Keys are decrypted once and shared by SubGhz app, CLI and other apps
+    SubGhzKeystoreCache* keystore_cache = subghz_keystore_cache_alloc();
+    const char* keystore_files[] = {SUBGHZ_KEYSTORE_DIR_NAME, SUBGHZ_KEYSTORE_DIR_USER_NAME};
+    subghz_keystore_cache_preload(keystore_cache, keystore_files, COUNT_OF(keystore_files));
+    furi_record_create(RECORD_SUBGHZ_KEYSTORE, keystore_cache);
 #else
     UNUSED(subghz_cli_command);
     UNUSED(subghz_on_system_start_istream_decode_band);
@@ -178,6 +178,8 @@ static uint16_t bt_serial_event_callback(SerialServiceEvent event, void* context
 }
 
 // Called from RPC thread
+// Queues packets while serial service has TX credit and waits only when it runs out,
+// so several notifications are in flight. Last packets are delivered after return.
 static void bt_rpc_send_bytes_callback(void* context, uint8_t* bytes, size_t bytes_len) {
     furi_assert(context);
     Bt* bt = context;
@@ -186,25 +188,28 @@ static void bt_rpc_send_bytes_callback(void* context, uint8_t* bytes, size_t byt
         // Early stop from sending if we're already disconnected
         return;
     }
-    furi_event_flag_clear(bt->rpc_event, BT_RPC_EVENT_ALL & (~BT_RPC_EVENT_DISCONNECTED));
     size_t bytes_sent = 0;
     while(bytes_sent < bytes_len) {
-        size_t bytes_remain = bytes_len - bytes_sent;
-        if(bytes_remain > bt->max_packet_size) {
-            furi_hal_bt_serial_tx(&bytes[bytes_sent], bt->max_packet_size);
-            bytes_sent += bt->max_packet_size;
+        size_t packet_size = MIN(bytes_len - bytes_sent, bt->max_packet_size);
+        // Clear before queueing: credit may be returned before we start waiting
+        furi_event_flag_clear(bt->rpc_event, BT_RPC_EVENT_ALL & (~BT_RPC_EVENT_DISCONNECTED));
+        FuriHalBtSerialTxStatus status =
+            furi_hal_bt_serial_tx_queue(&bytes[bytes_sent], packet_size);
+        if(status == FuriHalBtSerialTxStatusOk) {
+            bytes_sent += packet_size;
+        } else if(status == FuriHalBtSerialTxStatusBusy) {
+            // We want BT_RPC_EVENT_DISCONNECTED to stick, so don't clear
+            uint32_t event_flag = furi_event_flag_wait(
+                bt->rpc_event,
+                BT_RPC_EVENT_ALL,
+                FuriFlagWaitAny | FuriFlagNoClear,
+                FuriWaitForever);
+            if(event_flag & BT_RPC_EVENT_DISCONNECTED) {
+                break;
+            }
         } else {
-            furi_hal_bt_serial_tx(&bytes[bytes_sent], bytes_remain);
-            bytes_sent += bytes_remain;
-        }
-        // We want BT_RPC_EVENT_DISCONNECTED to stick, so don't clear
-        uint32_t event_flag = furi_event_flag_wait(
-            bt->rpc_event, BT_RPC_EVENT_ALL, FuriFlagWaitAny | FuriFlagNoClear, FuriWaitForever);
-        if(event_flag & BT_RPC_EVENT_DISCONNECTED) {
+            FURI_LOG_E(TAG, "Failed to send %zu bytes", bytes_len - bytes_sent);
             break;
-        } else {
-            // If we didn't get BT_RPC_EVENT_DISCONNECTED, then clear everything else
-            furi_event_flag_clear(bt->rpc_event, BT_RPC_EVENT_ALL & (~BT_RPC_EVENT_DISCONNECTED));
         }
     }
 }
@@ -411,6 +411,7 @@ void cli_command_free(Cli* cli, FuriString* args, void* context) {
     UNUSED(args);
     UNUSED(context);
 
+    printf("Heap allocator: %s\r\n", memmgr_heap_get_allocator_name());
     printf("Free heap size: %zu\r\n", memmgr_get_free_heap());
     printf("Total heap size: %zu\r\n", memmgr_get_total_heap());
     printf("Minimum heap size: %zu\r\n", memmgr_get_minimum_free_heap());
@@ -418,6 +419,28 @@ void cli_command_free(Cli* cli, FuriString* args, void* context) {
 
     printf("Pool free: %zu\r\n", memmgr_pool_get_free());
     printf("Maximum pool block: %zu\r\n", memmgr_pool_get_max_block());
+
+    MemmgrSlabStats slab_stats;
+    memmgr_slab_get_stats(&slab_stats);
+    printf(
+        "Slab chunks peak: %zu x %zu, heap fallbacks: %lu, arena allocations: %lu\r\n",
+        slab_stats.chunks_peak,
+        slab_stats.chunk_size,
+        slab_stats.heap_fallbacks,
+        slab_stats.arena_allocations);
+    for(size_t i = 0; i < MEMMGR_SLAB_CLASSES; i++) {
+        const MemmgrSlabClassStats* class_stats = &slab_stats.classes[i];
+        size_t capacity = class_stats->objects_used + class_stats->objects_free;
+        printf(
+            "Slab %3zu: chunks %zu, used %zu/%zu (%zu%%), peak %zu, allocations %lu\r\n",
+            class_stats->object_size,
+            class_stats->chunks,
+            class_stats->objects_used,
+            capacity,
+            capacity ? class_stats->objects_used * 100 / capacity : 0,
+            class_stats->objects_peak,
+            class_stats->allocations);
+    }
 }
 
 void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
@@ -428,6 +451,89 @@ void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+static void cli_command_memprof_dump(void) {
+    MemmgrProfilerStats stats;
+    if(!memmgr_profiler_get_stats(&stats)) {
+        printf("Profiler is not running\r\n");
+        return;
+    }
+
+    MemmgrProfilerSite* sites = malloc(sizeof(MemmgrProfilerSite) * MEMMGR_PROFILER_SITES);
+    MemmgrProfilerSample* samples =
+        malloc(sizeof(MemmgrProfilerSample) * MEMMGR_PROFILER_RING_SIZE);
+    size_t sites_count = memmgr_profiler_get_sites(sites, MEMMGR_PROFILER_SITES);
+    size_t samples_count = memmgr_profiler_get_samples(samples, MEMMGR_PROFILER_RING_SIZE);
+
+    printf(
+        "memprof: period %lu depth %u time %lu ms allocations %lu samples %lu dropped %lu\r\n",
+        stats.config.sample_period,
+        stats.config.stack_depth,
+        (uint32_t)((uint64_t)stats.duration * 1000 / furi_kernel_get_tick_frequency()),
+        stats.allocations,
+        stats.samples,
+        stats.dropped);
+    for(size_t i = 0; i < sites_count; i++) {
+        printf(
+            "site 0x%08lx allocs %lu frees %lu bytes %lu live_bytes %lu\r\n",
+            (uint32_t)sites[i].pc,
+            sites[i].allocations,
+            sites[i].frees,
+            sites[i].bytes,
+            sites[i].live_bytes);
+    }
+    for(size_t i = 0; i < samples_count; i++) {
+        printf("sample %lu %lu", samples[i].tick, samples[i].size);
+        for(size_t j = 0; j < MEMMGR_PROFILER_STACK_DEPTH && samples[i].pc[j]; j++) {
+            printf(" 0x%08lx", (uint32_t)samples[i].pc[j]);
+        }
+        printf("\r\n");
+    }
+
+    free(samples);
+    free(sites);
+}
+
+void cli_command_memprof(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+    FuriString* cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_print_usage("memprof", "<start [period] [depth]|stop|dump>", "");
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "start") == 0) {
+            int period = 64;
+            int depth = 1;
+            args_read_int_and_trim(args, &period);
+            args_read_int_and_trim(args, &depth);
+            if(period < 1 || depth < 1 || depth > MEMMGR_PROFILER_STACK_DEPTH) {
+                cli_print_usage(
+                    "memprof start", "[period >= 1] [depth 1..4]", furi_string_get_cstr(args));
+                break;
+            }
+
+            MemmgrProfilerConfig config = {.sample_period = period, .stack_depth = depth};
+            if(memmgr_profiler_start(&config)) {
+                printf("Sampling 1 of %d allocations\r\n", period);
+            } else {
+                printf("Profiler is already running\r\n");
+            }
+        } else if(furi_string_cmp_str(cmd, "stop") == 0) {
+            memmgr_profiler_stop();
+        } else if(furi_string_cmp_str(cmd, "dump") == 0) {
+            cli_command_memprof_dump();
+        } else {
+            cli_print_usage(
+                "memprof", "<start [period] [depth]|stop|dump>", furi_string_get_cstr(cmd));
+        }
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
 void cli_command_i2c(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(args);
@@ -466,6 +572,7 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(cli, "memprof", CliCommandFlagParallelSafe, cli_command_memprof, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
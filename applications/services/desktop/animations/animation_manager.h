@@ -4,6 +4,7 @@
 #include <gui/icon_i.h>
 #include <stdint.h>
 #include <dolphin/dolphin.h>
+#include "animation_pack.h"
 
 typedef struct AnimationManager AnimationManager;
 
@@ -32,6 +33,7 @@ typedef struct {
     uint8_t active_cycles;
     uint16_t duration;
     uint16_t active_cooldown;
+    AnimationPack* pack; /**< Streamed frames, icon_animation has no frames if set */
 } BubbleAnimation;
 
 typedef void (*AnimationManagerSetNewIdleAnimationCallback)(void* context);
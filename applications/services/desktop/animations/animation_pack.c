@@ -0,0 +1,403 @@
+#include "animation_pack.h"
+
+#include <furi.h>
+
+#define TAG "AnimationPack"
+
+/* Drawn frame, prefetched next frame and one more for short loops */
+#define ANIMATION_PACK_RING_SIZE (3)
+#define ANIMATION_PACK_QUEUE_SIZE (2)
+/* Storage API calls go deep, same as in file browser worker */
+#define ANIMATION_PACK_WORKER_STACK_SIZE (2048)
+#define ANIMATION_PACK_WORKER_STOP (0xFFFF)
+
+/* PackBits: control below 0x80 is followed by (control + 1) literal bytes,
+ * otherwise by one byte repeated (control - 0x80 + 2) times */
+#define ANIMATION_PACK_RLE_LITERAL_MAX (0x80)
+#define ANIMATION_PACK_RLE_RUN_MIN (2)
+
+typedef struct {
+    uint8_t* data;
+    int16_t index;
+    uint32_t used_at;
+} AnimationPackSlot;
+
+struct AnimationPack {
+    File* file;
+    AnimationPackHeader header;
+    AnimationPackIndexEntry* index;
+    size_t frame_size;
+
+    uint8_t* data_buffer;
+    uint8_t* frame; /**< Last decoded frame, delta chain base */
+    int16_t frame_index;
+
+    AnimationPackSlot ring[ANIMATION_PACK_RING_SIZE];
+    AnimationPackSlot* pinned;
+    uint32_t use_counter;
+
+    /* Ring and stats, never held during storage access */
+    FuriMutex* mutex;
+    /* File, data buffer and delta chain base */
+    FuriMutex* decode_mutex;
+    FuriMessageQueue* queue;
+    FuriThread* thread;
+    AnimationPackStats stats;
+
+    AnimationPackFrameCallback frame_callback;
+    void* frame_callback_context;
+};
+
+static bool animation_pack_rle_decode(
+    const uint8_t* data,
+    size_t data_size,
+    uint8_t* frame,
+    size_t frame_size,
+    bool delta) {
+    size_t in = 0;
+    size_t out = 0;
+
+    while(in < data_size) {
+        uint8_t control = data[in++];
+
+        if(control < ANIMATION_PACK_RLE_LITERAL_MAX) {
+            size_t count = control + 1;
+            if((in + count > data_size) || (out + count > frame_size)) return false;
+            if(delta) {
+                for(size_t i = 0; i < count; i++) {
+                    frame[out++] ^= data[in++];
+                }
+            } else {
+                memcpy(&frame[out], &data[in], count);
+                in += count;
+                out += count;
+            }
+        } else {
+            size_t count = control - ANIMATION_PACK_RLE_LITERAL_MAX + ANIMATION_PACK_RLE_RUN_MIN;
+            if((in + 1 > data_size) || (out + count > frame_size)) return false;
+            uint8_t value = data[in++];
+            if(!delta) {
+                memset(&frame[out], value, count);
+            } else if(value) {
+                for(size_t i = 0; i < count; i++) {
+                    frame[out + i] ^= value;
+                }
+            }
+            // Unchanged area of delta frame is a run of zeros: nothing to do
+            out += count;
+        }
+    }
+
+    return out == frame_size;
+}
+
+static bool animation_pack_decode_single(AnimationPack* pack, uint8_t index) {
+    const AnimationPackIndexEntry* entry = &pack->index[index];
+
+    if(!storage_file_seek(pack->file, entry->offset, true)) return false;
+    if(storage_file_read(pack->file, pack->data_buffer, entry->size) != entry->size) return false;
+    pack->stats.bytes_read += entry->size;
+
+    return animation_pack_rle_decode(
+        pack->data_buffer,
+        entry->size,
+        pack->frame,
+        pack->frame_size,
+        entry->type == AnimationPackFrameTypeDelta);
+}
+
+/* Decode frame into pack->frame, must be called with decode mutex taken */
+static bool animation_pack_decode(AnimationPack* pack, uint8_t index) {
+    if(pack->frame_index == index) {
+        return true;
+    }
+
+    // Delta chain starts at the nearest key frame, or at already decoded frame
+    uint8_t start = index;
+    while((pack->index[start].type == AnimationPackFrameTypeDelta) &&
+          (start != pack->frame_index + 1)) {
+        start--;
+    }
+
+    pack->frame_index = -1;
+    for(uint8_t i = start; i <= index; i++) {
+        if(!animation_pack_decode_single(pack, i)) {
+            FURI_LOG_E(TAG, "Frame %u decode failed", i);
+            return false;
+        }
+    }
+    pack->frame_index = index;
+
+    return true;
+}
+
+static AnimationPackSlot* animation_pack_find_slot(AnimationPack* pack, uint8_t index) {
+    for(size_t i = 0; i < ANIMATION_PACK_RING_SIZE; i++) {
+        if(pack->ring[i].index == index) {
+            return &pack->ring[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Take least recently used slot, except the one being drawn.
+ * Must be called with mutex taken, slot is invisible until filled. */
+static AnimationPackSlot* animation_pack_take_slot(AnimationPack* pack) {
+    AnimationPackSlot* victim = NULL;
+    for(size_t i = 0; i < ANIMATION_PACK_RING_SIZE; i++) {
+        AnimationPackSlot* slot = &pack->ring[i];
+        if(slot == pack->pinned) continue;
+        if(!victim || (slot->used_at < victim->used_at)) {
+            victim = slot;
+        }
+    }
+
+    victim->index = -1;
+    return victim;
+}
+
+/* Decode frame into free slot, storage is accessed without ring lock */
+static bool animation_pack_fill_slot(AnimationPack* pack, uint8_t index) {
+    bool filled = false;
+    furi_check(furi_mutex_acquire(pack->decode_mutex, FuriWaitForever) == FuriStatusOk);
+
+    furi_check(furi_mutex_acquire(pack->mutex, FuriWaitForever) == FuriStatusOk);
+    AnimationPackSlot* slot = NULL;
+    if(!animation_pack_find_slot(pack, index)) {
+        slot = animation_pack_take_slot(pack);
+    }
+    furi_check(furi_mutex_release(pack->mutex) == FuriStatusOk);
+
+    if(slot && animation_pack_decode(pack, index)) {
+        furi_check(furi_mutex_acquire(pack->mutex, FuriWaitForever) == FuriStatusOk);
+        memcpy(slot->data, pack->frame, pack->frame_size);
+        slot->index = index;
+        slot->used_at = ++pack->use_counter;
+        pack->stats.prefetched++;
+        furi_check(furi_mutex_release(pack->mutex) == FuriStatusOk);
+        filled = true;
+    }
+
+    furi_check(furi_mutex_release(pack->decode_mutex) == FuriStatusOk);
+    return filled;
+}
+
+static int32_t animation_pack_worker(void* context) {
+    AnimationPack* pack = context;
+    uint16_t index;
+
+    while(true) {
+        furi_check(
+            furi_message_queue_get(pack->queue, &index, FuriWaitForever) == FuriStatusOk);
+        if(index == ANIMATION_PACK_WORKER_STOP) break;
+
+        // No locks are held here: callback may take view model
+        if(animation_pack_fill_slot(pack, index) && pack->frame_callback) {
+            pack->frame_callback(pack->frame_callback_context);
+        }
+    }
+
+    return 0;
+}
+
+static bool animation_pack_load_index(AnimationPack* pack) {
+    AnimationPackHeader* header = &pack->header;
+    const uint64_t file_size = storage_file_size(pack->file);
+
+    if(storage_file_read(pack->file, header, sizeof(AnimationPackHeader)) !=
+       sizeof(AnimationPackHeader)) {
+        return false;
+    }
+
+    if((header->magic != ANIMATION_PACK_MAGIC) || (header->version != ANIMATION_PACK_VERSION) ||
+       !header->width || !header->height || !header->frame_count) {
+        FURI_LOG_E(TAG, "Invalid header");
+        return false;
+    }
+
+    pack->frame_size = ((header->width + 7) / 8) * header->height;
+
+    size_t index_size = sizeof(AnimationPackIndexEntry) * header->frame_count;
+    pack->index = malloc(index_size);
+    if(storage_file_read(pack->file, pack->index, index_size) != index_size) {
+        return false;
+    }
+
+    // Every frame must be inside the file and fit the buffer, chain must start with key frame
+    if(pack->index[0].type != AnimationPackFrameTypeKey) {
+        FURI_LOG_E(TAG, "First frame is not a key frame");
+        return false;
+    }
+
+    for(size_t i = 0; i < header->frame_count; i++) {
+        const AnimationPackIndexEntry* entry = &pack->index[i];
+        if((entry->size > header->max_data_size) ||
+           ((uint64_t)entry->offset + entry->size > file_size) ||
+           (entry->type > AnimationPackFrameTypeDelta)) {
+            FURI_LOG_E(TAG, "Invalid frame %u", i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+AnimationPack* animation_pack_open(Storage* storage, const char* path) {
+    furi_assert(storage);
+    furi_assert(path);
+
+    AnimationPack* pack = malloc(sizeof(AnimationPack));
+    pack->file = storage_file_alloc(storage);
+    pack->frame_index = -1;
+
+    if(!storage_file_open(pack->file, path, FSAM_READ, FSOM_OPEN_EXISTING) ||
+       !animation_pack_load_index(pack)) {
+        storage_file_free(pack->file);
+        if(pack->index) {
+            free(pack->index);
+        }
+        free(pack);
+        return NULL;
+    }
+
+    pack->data_buffer = malloc(pack->header.max_data_size);
+    pack->frame = malloc(pack->frame_size);
+    for(size_t i = 0; i < ANIMATION_PACK_RING_SIZE; i++) {
+        pack->ring[i].data = malloc(pack->frame_size);
+        pack->ring[i].index = -1;
+    }
+
+    pack->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    pack->decode_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    pack->queue = furi_message_queue_alloc(ANIMATION_PACK_QUEUE_SIZE, sizeof(uint16_t));
+    pack->thread = furi_thread_alloc_ex(
+        "AnimPackWorker", ANIMATION_PACK_WORKER_STACK_SIZE, animation_pack_worker, pack);
+    furi_thread_start(pack->thread);
+
+    return pack;
+}
+
+void animation_pack_close(AnimationPack* pack) {
+    furi_assert(pack);
+
+    uint16_t stop = ANIMATION_PACK_WORKER_STOP;
+    furi_check(furi_message_queue_put(pack->queue, &stop, FuriWaitForever) == FuriStatusOk);
+    furi_thread_join(pack->thread);
+    furi_thread_free(pack->thread);
+    furi_message_queue_free(pack->queue);
+    furi_mutex_free(pack->decode_mutex);
+    furi_mutex_free(pack->mutex);
+
+    FURI_LOG_D(
+        TAG,
+        "Hits %lu, misses %lu, prefetched %lu, read %lu bytes",
+        pack->stats.hits,
+        pack->stats.misses,
+        pack->stats.prefetched,
+        pack->stats.bytes_read);
+
+    for(size_t i = 0; i < ANIMATION_PACK_RING_SIZE; i++) {
+        free(pack->ring[i].data);
+    }
+    free(pack->frame);
+    free(pack->data_buffer);
+    free(pack->index);
+    storage_file_free(pack->file);
+    free(pack);
+}
+
+uint8_t animation_pack_get_width(AnimationPack* pack) {
+    furi_assert(pack);
+    return pack->header.width;
+}
+
+uint8_t animation_pack_get_height(AnimationPack* pack) {
+    furi_assert(pack);
+    return pack->header.height;
+}
+
+uint8_t animation_pack_get_frame_count(AnimationPack* pack) {
+    furi_assert(pack);
+    return pack->header.frame_count;
+}
+
+size_t animation_pack_get_frame_size(AnimationPack* pack) {
+    furi_assert(pack);
+    return pack->frame_size;
+}
+
+void animation_pack_set_frame_callback(
+    AnimationPack* pack,
+    AnimationPackFrameCallback callback,
+    void* context) {
+    furi_assert(pack);
+    pack->frame_callback = callback;
+    pack->frame_callback_context = context;
+}
+
+const uint8_t* animation_pack_get_frame(AnimationPack* pack, uint8_t index) {
+    furi_assert(pack);
+    furi_check(index < pack->header.frame_count);
+
+    furi_check(furi_mutex_acquire(pack->mutex, FuriWaitForever) == FuriStatusOk);
+
+    AnimationPackSlot* slot = animation_pack_find_slot(pack, index);
+    if(slot) {
+        pack->stats.hits++;
+        slot->used_at = ++pack->use_counter;
+        // Worker never touches pinned slot, so it can be drawn without lock
+        pack->pinned = slot;
+    } else {
+        pack->stats.misses++;
+        animation_pack_prefetch(pack, index);
+        // Keep showing previous frame until worker is done
+        slot = pack->pinned;
+    }
+
+    furi_check(furi_mutex_release(pack->mutex) == FuriStatusOk);
+
+    return slot ? slot->data : NULL;
+}
+
+void animation_pack_prefetch(AnimationPack* pack, uint8_t index) {
+    furi_assert(pack);
+    furi_check(index < pack->header.frame_count);
+
+    uint16_t request = index;
+    // If worker is behind, frame is requested again on draw
+    furi_message_queue_put(pack->queue, &request, 0);
+}
+
+bool animation_pack_read_frame(AnimationPack* pack, uint8_t index, uint8_t* buffer) {
+    furi_assert(pack);
+    furi_assert(buffer);
+    furi_check(index < pack->header.frame_count);
+
+    furi_check(furi_mutex_acquire(pack->mutex, FuriWaitForever) == FuriStatusOk);
+    AnimationPackSlot* slot = animation_pack_find_slot(pack, index);
+    if(slot) {
+        memcpy(buffer, slot->data, pack->frame_size);
+    }
+    furi_check(furi_mutex_release(pack->mutex) == FuriStatusOk);
+
+    bool success = true;
+    if(!slot) {
+        furi_check(furi_mutex_acquire(pack->decode_mutex, FuriWaitForever) == FuriStatusOk);
+        if((success = animation_pack_decode(pack, index))) {
+            memcpy(buffer, pack->frame, pack->frame_size);
+        }
+        furi_check(furi_mutex_release(pack->decode_mutex) == FuriStatusOk);
+    }
+
+    return success;
+}
+
+void animation_pack_get_stats(AnimationPack* pack, AnimationPackStats* stats) {
+    furi_assert(pack);
+    furi_assert(stats);
+
+    furi_check(furi_mutex_acquire(pack->mutex, FuriWaitForever) == FuriStatusOk);
+    *stats = pack->stats;
+    furi_check(furi_mutex_release(pack->mutex) == FuriStatusOk);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file animation_pack.h
+ * Packed animation frames, streamed from storage
+ *
+ * All frames of animation are stored in a single file: header, frame index
+ * and frame data. Every frame is either a key frame (PackBits RLE of raw
+ * XBM bitmap) or a delta frame (PackBits RLE of XOR with previous frame).
+ * Pack is produced by scripts/animation_pack.py.
+ *
+ * Only a small ring of decoded frames is kept in RAM. Worker thread decodes
+ * frames ahead of time on prefetch request, so drawing doesn't wait for
+ * storage.
+ */
+#pragma once
+
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ANIMATION_PACK_FILE "frames.pack"
+
+/* File layout, all values little endian:
+ *  AnimationPackHeader
+ *  AnimationPackIndexEntry[frame_count]
+ *  frame data
+ */
+#define ANIMATION_PACK_MAGIC (0x50414246UL) /* "FBAP" */
+#define ANIMATION_PACK_VERSION (1)
+
+typedef enum {
+    AnimationPackFrameTypeKey = 0,
+    AnimationPackFrameTypeDelta = 1,
+} AnimationPackFrameType;
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t width;
+    uint8_t height;
+    uint8_t frame_count;
+    uint16_t max_data_size; /**< Biggest encoded frame */
+    uint16_t reserved;
+} __attribute__((packed)) AnimationPackHeader;
+
+typedef struct {
+    uint32_t offset; /**< From the beginning of file */
+    uint16_t size;
+    uint8_t type; /**< AnimationPackFrameType */
+    uint8_t reserved;
+} __attribute__((packed)) AnimationPackIndexEntry;
+
+typedef struct {
+    uint32_t hits; /**< Frame was found in ring */
+    uint32_t misses; /**< Frame was not ready, previous one was drawn */
+    uint32_t prefetched; /**< Frame was decoded by worker */
+    uint32_t bytes_read;
+} AnimationPackStats;
+
+typedef struct AnimationPack AnimationPack;
+
+/** Called from worker thread when requested frame is decoded */
+typedef void (*AnimationPackFrameCallback)(void* context);
+
+/** Open animation pack and start prefetch worker
+ *
+ * @param      storage  Storage instance
+ * @param      path     pack file path
+ *
+ * @return     AnimationPack instance, NULL if file is missing or invalid
+ */
+AnimationPack* animation_pack_open(Storage* storage, const char* path);
+
+/** Stop worker, close file and free all frames
+ *
+ * @param      pack  AnimationPack instance
+ */
+void animation_pack_close(AnimationPack* pack);
+
+uint8_t animation_pack_get_width(AnimationPack* pack);
+
+uint8_t animation_pack_get_height(AnimationPack* pack);
+
+uint8_t animation_pack_get_frame_count(AnimationPack* pack);
+
+/** Get decoded frame size in bytes: raw XBM bitmap
+ *
+ * @param      pack  AnimationPack instance
+ *
+ * @return     frame size
+ */
+size_t animation_pack_get_frame_size(AnimationPack* pack);
+
+/** Set callback for decoded frames, e.g. to request redraw
+ *
+ * @param      pack      AnimationPack instance
+ * @param      callback  called from worker thread, no pack locks held
+ * @param      context   callback context
+ */
+void animation_pack_set_frame_callback(
+    AnimationPack* pack,
+    AnimationPackFrameCallback callback,
+    void* context);
+
+/** Get decoded frame for drawing, never accesses storage
+ *
+ * If frame is not in ring yet, it's requested from worker and previously
+ * drawn frame is returned. Frame callback reports when it's ready.
+ * Returned bitmap stays valid until next call. Must be called from one
+ * thread only (GUI).
+ *
+ * @param      pack   AnimationPack instance
+ * @param      index  frame index
+ *
+ * @return     raw XBM bitmap, NULL if nothing was decoded yet
+ */
+const uint8_t* animation_pack_get_frame(AnimationPack* pack, uint8_t index);
+
+/** Request frame decoding in background. Doesn't block.
+ *
+ * @param      pack   AnimationPack instance
+ * @param      index  frame index that will be drawn soon
+ */
+void animation_pack_prefetch(AnimationPack* pack, uint8_t index);
+
+/** Decode frame into caller buffer, waits for storage
+ *
+ * @param      pack    AnimationPack instance
+ * @param      index   frame index
+ * @param      buffer  at least animation_pack_get_frame_size bytes
+ *
+ * @return     true on success
+ */
+bool animation_pack_read_frame(AnimationPack* pack, uint8_t index, uint8_t* buffer);
+
+/** Get ring and storage statistics
+ *
+ * @param      pack   AnimationPack instance
+ * @param      stats  output
+ */
+void animation_pack_get_stats(AnimationPack* pack, AnimationPackStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,6 +9,7 @@
 #include "animation_manager.h"
 #include "animation_storage.h"
 #include "animation_storage_i.h"
+#include "animation_pack.h"
 #include <assets_dolphin_internal.h>
 #include <assets_dolphin_blocking.h>
 
@@ -252,7 +253,17 @@ static bool animation_storage_cast_align(FuriString* align_str, Align* align) {
 static void animation_storage_free_frames(BubbleAnimation* animation) {
     furi_assert(animation);
 
-    const Icon* icon = &animation->icon_animation;
+    if(animation->pack) {
+        animation_pack_close(animation->pack);
+        animation->pack = NULL;
+        return;
+    }
+
+    Icon* icon = (Icon*)&animation->icon_animation;
+    if(!icon->frames) {
+        return;
+    }
+
     for(int i = 0; i < icon->frame_count; ++i) {
         if(icon->frames[i]) {
             free((void*)icon->frames[i]);
@@ -260,15 +271,13 @@ static void animation_storage_free_frames(BubbleAnimation* animation) {
     }
 
     free((void*)icon->frames);
+    icon->frames = NULL;
 }
 
-static bool animation_storage_load_frames(
-    Storage* storage,
-    const char* name,
+static bool animation_storage_check_frame_order(
     BubbleAnimation* animation,
     uint32_t* frame_order,
-    uint8_t width,
-    uint8_t height) {
+    size_t* frame_count) {
     uint16_t frame_order_count = animation->passive_frames + animation->active_frames;
 
     /* The frames should go in order (0...N), without omissions */
@@ -281,8 +290,59 @@ static bool animation_storage_load_frames(
         return false;
     }
 
+    *frame_count = max_frame_count + 1;
+    return true;
+}
+
+static bool animation_storage_load_pack(
+    AnimationPack* pack,
+    BubbleAnimation* animation,
+    uint32_t* frame_order,
+    uint8_t width,
+    uint8_t height) {
+    size_t frame_count = 0;
+    if(!animation_storage_check_frame_order(animation, frame_order, &frame_count)) {
+        return false;
+    }
+
+    if((animation_pack_get_width(pack) != width) ||
+       (animation_pack_get_height(pack) != height) ||
+       (animation_pack_get_frame_count(pack) < frame_count)) {
+        FURI_LOG_E(
+            TAG,
+            "Pack mismatch: %ux%u, %u frames",
+            animation_pack_get_width(pack),
+            animation_pack_get_height(pack),
+            animation_pack_get_frame_count(pack));
+        return false;
+    }
+
+    /* Frames are decoded on demand, icon only describes geometry */
     Icon* icon = (Icon*)&animation->icon_animation;
-    FURI_CONST_ASSIGN(icon->frame_count, max_frame_count + 1);
+    FURI_CONST_ASSIGN(icon->frame_count, frame_count);
+    FURI_CONST_ASSIGN(icon->frame_rate, 0);
+    FURI_CONST_ASSIGN(icon->height, height);
+    FURI_CONST_ASSIGN(icon->width, width);
+    icon->frames = NULL;
+    animation->pack = pack;
+
+    return true;
+}
+
+static bool animation_storage_load_frames(
+    Storage* storage,
+    const char* name,
+    BubbleAnimation* animation,
+    uint32_t* frame_order,
+    uint8_t width,
+    uint8_t height) {
+    size_t frame_count = 0;
+    if(!animation_storage_check_frame_order(animation, frame_order, &frame_count)) {
+        return false;
+    }
+
+    Icon* icon = (Icon*)&animation->icon_animation;
+    FURI_CONST_ASSIGN(icon->frame_count, frame_count);
     FURI_CONST_ASSIGN(icon->frame_rate, 0);
     FURI_CONST_ASSIGN(icon->height, height);
     FURI_CONST_ASSIGN(icon->width, width);
@@ -430,6 +490,8 @@ static bool animation_storage_load_bubbles(BubbleAnimation* animation, FlipperFo
 
 static BubbleAnimation* animation_storage_load_animation(const char* name) {
     furi_assert(name);
+    const uint32_t load_start = furi_get_tick();
+    const size_t heap_before = memmgr_get_free_heap();
     BubbleAnimation* animation = malloc(sizeof(BubbleAnimation));
 
     uint32_t height = 0;
@@ -477,8 +539,17 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
         }
 
         /* passive and active frames must be loaded up to this point */
-        if(!animation_storage_load_frames(storage, name, animation, u32array, width, height))
+        furi_string_printf(str, ANIMATION_DIR "/%s/" ANIMATION_PACK_FILE, name);
+        AnimationPack* pack = animation_pack_open(storage, furi_string_get_cstr(str));
+        if(pack) {
+            if(!animation_storage_load_pack(pack, animation, u32array, width, height)) {
+                animation_pack_close(pack);
+                break;
+            }
+        } else if(!animation_storage_load_frames(
+                      storage, name, animation, u32array, width, height)) {
             break;
+        }
 
         if(!flipper_format_read_uint32(ff, "Active cycles", &u32value, 1)) break; //-V779
         animation->active_cycles = u32value;
@@ -500,11 +571,21 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
     }
 
     if(!success) { //-V547
+        animation_storage_free_bubbles(animation);
+        animation_storage_free_frames(animation);
         if(animation->frame_order) {
             free((void*)animation->frame_order);
         }
         free(animation);
         animation = NULL;
+    } else {
+        FURI_LOG_I(
+            TAG,
+            "Loaded %s from %s: %lu ms, %u bytes of heap",
+            name,
+            animation->pack ? "pack" : "frame files",
+            furi_get_tick() - load_start,
+            heap_before - memmgr_get_free_heap());
     }
 
     return animation;
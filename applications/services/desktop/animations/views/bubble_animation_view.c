@@ -37,21 +37,54 @@ struct BubbleAnimationView {
 static void bubble_animation_activate(BubbleAnimationView* view, bool force);
 static void bubble_animation_activate_right_now(BubbleAnimationView* view);
 
+static uint8_t
+    bubble_animation_get_frame_index_at(const BubbleAnimation* animation, uint8_t position) {
+    furi_assert(animation);
+    uint8_t icon_index = 0;
+
+    if(position < animation->passive_frames) {
+        icon_index = position;
+    } else {
+        icon_index = (position - animation->passive_frames) % animation->active_frames +
+                     animation->passive_frames;
+    }
+    furi_assert(icon_index < (animation->passive_frames + animation->active_frames));
+
+    return animation->frame_order[icon_index];
+}
+
 static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model) {
     furi_assert(model);
-    uint8_t icon_index = 0;
+    return bubble_animation_get_frame_index_at(model->current, model->current_frame);
+}
+
+/* Ask pack worker to decode frame which will be shown after current one */
+static void bubble_animation_prefetch_next_frame(BubbleAnimationViewModel* model) {
     const BubbleAnimation* animation = model->current;
+    if(!animation || !animation->pack || model->freeze_frame) {
+        return;
+    }
 
+    uint8_t position = 0;
     if(model->current_frame < animation->passive_frames) {
-        icon_index = model->current_frame;
+        position = (model->current_frame + 1) % animation->passive_frames;
     } else {
-        icon_index =
-            (model->current_frame - animation->passive_frames) % animation->active_frames +
-            animation->passive_frames;
+        position = model->current_frame + 1;
+        bool cycle_end = !((position - animation->passive_frames) % animation->active_frames);
+        if(cycle_end && (model->active_cycle + 1 >= animation->active_cycles)) {
+            position = 0;
+        }
     }
-    furi_assert(icon_index < (animation->passive_frames + animation->active_frames));
 
-    return animation->frame_order[icon_index];
+    animation_pack_prefetch(
+        animation->pack, bubble_animation_get_frame_index_at(animation, position));
+}
+
+/* Frame requested while drawing is decoded: show it */
+static void bubble_animation_frame_ready_callback(void* context) {
+    BubbleAnimationView* view = context;
+    view_get_model(view->view);
+    view_commit_model(view->view, true);
 }
 
 static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
@@ -77,8 +110,16 @@ static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     uint8_t width = icon_get_width(&animation->icon_animation);
     uint8_t height = icon_get_height(&animation->icon_animation);
     uint8_t y_offset = canvas_height(canvas) - height;
-    canvas_draw_bitmap(
-        canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    if(animation->pack) {
+        /* Raw bitmap, decoded by pack */
+        const uint8_t* frame = animation_pack_get_frame(animation->pack, index);
+        if(frame) {
+            canvas_draw_xbm(canvas, 0, y_offset, width, height, frame);
+        }
+    } else {
+        canvas_draw_bitmap(
+            canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    }
 
     const FrameBubble* bubble = model->current_bubble;
     if(bubble) {
@@ -239,6 +280,7 @@ static void bubble_animation_timer_callback(void* context) {
 
     if(!model->freeze_frame && !activate) {
         bubble_animation_next_frame(model);
+        bubble_animation_prefetch_next_frame(model);
     }
 
     view_commit_model(view->view, !activate);
@@ -252,10 +294,9 @@ static void bubble_animation_timer_callback(void* context) {
  * animation is always activated at unfreezing and played
  * passive frame first, and 2 frames after - active
  */
-static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
-    furi_assert(icon_orig);
-    furi_assert(icon_orig->frames);
-    furi_assert(icon_orig->frames[0]);
+static Icon* bubble_animation_clone_first_frame(const BubbleAnimation* animation) {
+    furi_assert(animation);
+    const Icon* icon_orig = &animation->icon_animation;
 
     Icon* icon_clone = malloc(sizeof(Icon));
     memcpy(icon_clone, icon_orig, sizeof(Icon));
@@ -268,7 +309,16 @@ static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
      */
     size_t max_bitmap_size = ROUND_UP_TO(icon_orig->width, 8) * icon_orig->height + 1;
     FURI_CONST_ASSIGN_PTR(icon_clone->frames[0], malloc(max_bitmap_size));
-    memcpy((void*)icon_clone->frames[0], icon_orig->frames[0], max_bitmap_size);
+    if(animation->pack) {
+        /* uncompressed header, followed by raw bitmap */
+        uint8_t* bitmap = (uint8_t*)icon_clone->frames[0];
+        bitmap[0] = 0;
+        furi_check(animation_pack_read_frame(animation->pack, 0, &bitmap[1]));
+    } else {
+        furi_assert(icon_orig->frames);
+        furi_assert(icon_orig->frames[0]);
+        memcpy((void*)icon_clone->frames[0], icon_orig->frames[0], max_bitmap_size);
+    }
     FURI_CONST_ASSIGN(icon_clone->frame_count, 1);
 
     return icon_clone;
@@ -370,6 +420,12 @@ void bubble_animation_view_set_animation(
     model->current_bubble = bubble_animation_pick_bubble(model, false);
     model->current_frame = 0;
     model->active_cycle = 0;
+    if(new_animation->pack) {
+        animation_pack_set_frame_callback(
+            new_animation->pack, bubble_animation_frame_ready_callback, view);
+        animation_pack_prefetch(new_animation->pack, bubble_animation_get_frame_index(model));
+    }
+    bubble_animation_prefetch_next_frame(model);
     view_commit_model(view->view, true);
 
     furi_timer_start(view->timer, 1000 / new_animation->icon_animation.frame_rate);
@@ -381,7 +437,7 @@ void bubble_animation_freeze(BubbleAnimationView* view) {
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model->current);
     furi_assert(!model->freeze_frame);
-    model->freeze_frame = bubble_animation_clone_first_frame(&model->current->icon_animation);
+    model->freeze_frame = bubble_animation_clone_first_frame(model->current);
     model->current = NULL;
     view_commit_model(view->view, false);
     furi_timer_stop(view->timer);
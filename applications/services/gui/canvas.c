@@ -7,6 +7,9 @@
 #include <stdint.h>
 #include <u8g2_glue.h>
 
+/* Enough for a few full screen frames and menu icons */
+#define CANVAS_ICON_CACHE_SIZE (4 * 1024)
+
 const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
     [FontPrimary] = {.leading_default = 12, .leading_min = 11, .height = 8, .descender = 2},
     [FontSecondary] = {.leading_default = 11, .leading_min = 9, .height = 7, .descender = 2},
@@ -17,6 +20,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init() {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc();
+    compress_icon_set_cache_size(canvas->compress_icon, CANVAS_ICON_CACHE_SIZE);
 
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
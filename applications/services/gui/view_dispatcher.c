@@ -1,5 +1,7 @@
 #include "view_dispatcher_i.h"
 
+#include <furi_hal.h>
+
 #define TAG "ViewDispatcher"
 
 ViewDispatcher* view_dispatcher_alloc() {
@@ -28,18 +30,79 @@ void view_dispatcher_free(ViewDispatcher* view_dispatcher) {
     ViewDict_clear(view_dispatcher->views);
     // Free ViewPort
     view_port_free(view_dispatcher->view_port);
-    // Free internal queue
+    // Free internal queue and event loop
     if(view_dispatcher->queue) {
         furi_message_queue_free(view_dispatcher->queue);
+        furi_message_queue_free(view_dispatcher->coalesced_signal);
+        furi_event_loop_free(view_dispatcher->event_loop);
     }
     // Free dispatcher
     free(view_dispatcher);
 }
 
+static void view_dispatcher_queue_callback(FuriMessageQueue* queue, void* context) {
+    ViewDispatcher* view_dispatcher = context;
+
+    ViewDispatcherMessage message;
+    while(furi_message_queue_get(queue, &message, 0) == FuriStatusOk) {
+        if(message.type == ViewDispatcherMessageTypeStop) {
+            furi_event_loop_stop(view_dispatcher->event_loop);
+            return;
+        } else if(message.type == ViewDispatcherMessageTypeInput) {
+            view_dispatcher_handle_input(view_dispatcher, &message.input);
+        } else if(message.type == ViewDispatcherMessageTypeCustomEvent) {
+            // Progress merged before this event must not be delivered after it
+            view_dispatcher_handle_coalesced_events(view_dispatcher);
+            view_dispatcher->custom_event_value = message.custom_event_value;
+            view_dispatcher_handle_custom_event(view_dispatcher, message.custom_event);
+        }
+    }
+
+    // Tick is dispatched when there were no events for tick period
+    if(view_dispatcher->tick_timer) {
+        furi_event_loop_timer_start(view_dispatcher->tick_timer, view_dispatcher->tick_period);
+    }
+}
+
+static void view_dispatcher_coalesced_signal_callback(FuriMessageQueue* queue, void* context) {
+    ViewDispatcher* view_dispatcher = context;
+
+    uint8_t signal;
+    while(furi_message_queue_get(queue, &signal, 0) == FuriStatusOk) {
+    }
+
+    // Rate limit, so fast producer causes at most one redraw per period
+    uint32_t period = furi_ms_to_ticks(VIEW_DISPATCHER_COALESCE_PERIOD_MS);
+    uint32_t elapsed = furi_get_tick() - view_dispatcher->coalesced_dispatched_at;
+    if(elapsed >= period) {
+        view_dispatcher_handle_coalesced_events(view_dispatcher);
+    } else if(!furi_event_loop_timer_is_running(view_dispatcher->coalesced_timer)) {
+        furi_event_loop_timer_start(view_dispatcher->coalesced_timer, period - elapsed);
+    }
+}
+
+static void view_dispatcher_coalesced_timer_callback(void* context) {
+    ViewDispatcher* view_dispatcher = context;
+    view_dispatcher_handle_coalesced_events(view_dispatcher);
+}
+
+static void view_dispatcher_tick_callback(void* context) {
+    ViewDispatcher* view_dispatcher = context;
+    view_dispatcher_handle_tick_event(view_dispatcher);
+}
+
 void view_dispatcher_enable_queue(ViewDispatcher* view_dispatcher) {
     furi_assert(view_dispatcher);
     furi_assert(view_dispatcher->queue == NULL);
+    view_dispatcher->event_loop = furi_event_loop_alloc();
     view_dispatcher->queue = furi_message_queue_alloc(16, sizeof(ViewDispatcherMessage));
+    view_dispatcher->coalesced_signal = furi_message_queue_alloc(1, sizeof(uint8_t));
+}
+
+FuriEventLoop* view_dispatcher_get_event_loop(ViewDispatcher* view_dispatcher) {
+    furi_assert(view_dispatcher);
+    furi_assert(view_dispatcher->event_loop);
+    return view_dispatcher->event_loop;
 }
 
 void view_dispatcher_set_event_callback_context(ViewDispatcher* view_dispatcher, void* context) {
@@ -77,24 +140,52 @@ void view_dispatcher_run(ViewDispatcher* view_dispatcher) {
     furi_assert(view_dispatcher);
     furi_assert(view_dispatcher->queue);
 
-    uint32_t tick_period = view_dispatcher->tick_period == 0 ? FuriWaitForever :
-                                                               view_dispatcher->tick_period;
-    ViewDispatcherMessage message;
-    while(1) {
-        if(furi_message_queue_get(view_dispatcher->queue, &message, tick_period) != FuriStatusOk) {
-            view_dispatcher_handle_tick_event(view_dispatcher);
-            continue;
-        }
-        if(message.type == ViewDispatcherMessageTypeStop) {
-            break;
-        } else if(message.type == ViewDispatcherMessageTypeInput) {
-            view_dispatcher_handle_input(view_dispatcher, &message.input);
-        } else if(message.type == ViewDispatcherMessageTypeCustomEvent) {
-            view_dispatcher_handle_custom_event(view_dispatcher, message.custom_event);
-        }
+    // Messages left after previous stop are signaled on subscription
+    furi_event_loop_subscribe_message_queue(
+        view_dispatcher->event_loop,
+        view_dispatcher->queue,
+        FuriEventLoopEventIn,
+        view_dispatcher_queue_callback,
+        view_dispatcher);
+    furi_event_loop_subscribe_message_queue(
+        view_dispatcher->event_loop,
+        view_dispatcher->coalesced_signal,
+        FuriEventLoopEventIn,
+        view_dispatcher_coalesced_signal_callback,
+        view_dispatcher);
+    view_dispatcher->coalesced_timer = furi_event_loop_timer_alloc(
+        view_dispatcher->event_loop,
+        view_dispatcher_coalesced_timer_callback,
+        FuriEventLoopTimerTypeOnce,
+        view_dispatcher);
+
+    if(view_dispatcher->tick_period) {
+        view_dispatcher->tick_timer = furi_event_loop_timer_alloc(
+            view_dispatcher->event_loop,
+            view_dispatcher_tick_callback,
+            FuriEventLoopTimerTypePeriodic,
+            view_dispatcher);
+        furi_event_loop_timer_start(view_dispatcher->tick_timer, view_dispatcher->tick_period);
+    }
+
+    furi_event_loop_run(view_dispatcher->event_loop);
+
+    if(view_dispatcher->tick_timer) {
+        furi_event_loop_timer_free(view_dispatcher->tick_timer);
+        view_dispatcher->tick_timer = NULL;
     }
+    // Merged events left pending are signaled on next subscription
+    furi_event_loop_timer_free(view_dispatcher->coalesced_timer);
+    view_dispatcher->coalesced_timer = NULL;
+    if(view_dispatcher->coalesced_pending) {
+        uint8_t signal = 0;
+        furi_message_queue_put(view_dispatcher->coalesced_signal, &signal, 0);
+    }
+    furi_event_loop_unsubscribe(view_dispatcher->event_loop, view_dispatcher->coalesced_signal);
+    furi_event_loop_unsubscribe(view_dispatcher->event_loop, view_dispatcher->queue);
 
     // Wait till all input events delivered
+    ViewDispatcherMessage message;
     while(view_dispatcher->ongoing_input) {
         furi_message_queue_get(view_dispatcher->queue, &message, FuriWaitForever);
         if(message.type == ViewDispatcherMessageTypeInput) {
@@ -297,6 +388,8 @@ void view_dispatcher_handle_tick_event(ViewDispatcher* view_dispatcher) {
 }
 
 void view_dispatcher_handle_custom_event(ViewDispatcher* view_dispatcher, uint32_t event) {
+    view_dispatcher->stats.dispatched++;
+
     bool is_consumed = false;
     if(view_dispatcher->current_view) {
         is_consumed = view_custom(view_dispatcher->current_view, event);
@@ -307,16 +400,166 @@ void view_dispatcher_handle_custom_event(ViewDispatcher* view_dispatcher, uint32
     }
 }
 
+void view_dispatcher_handle_coalesced_events(ViewDispatcher* view_dispatcher) {
+    ViewDispatcherCoalescedEvent events[VIEW_DISPATCHER_COALESCED_EVENTS_MAX];
+    size_t count = 0;
+
+    FURI_CRITICAL_ENTER();
+    uint32_t pending = view_dispatcher->coalesced_pending;
+    view_dispatcher->coalesced_pending = 0;
+    for(size_t i = 0; i < view_dispatcher->coalesced_count; i++) {
+        if(pending & (1UL << i)) {
+            events[count++] = view_dispatcher->coalesced[i];
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    view_dispatcher->coalesced_dispatched_at = furi_get_tick();
+    for(size_t i = 0; i < count; i++) {
+        view_dispatcher->custom_event_value = events[i].value;
+        view_dispatcher_handle_custom_event(view_dispatcher, events[i].event);
+    }
+}
+
+static bool view_dispatcher_coalesce_custom_event(
+    ViewDispatcher* view_dispatcher,
+    uint32_t event,
+    uint32_t value) {
+    bool is_coalesced = false;
+    bool is_signal_needed = false;
+
+    FURI_CRITICAL_ENTER();
+    for(size_t i = 0; i < view_dispatcher->coalesced_count; i++) {
+        ViewDispatcherCoalescedEvent* coalesced = &view_dispatcher->coalesced[i];
+        if(coalesced->event != event) continue;
+
+        uint32_t bit = 1UL << i;
+        if(!(view_dispatcher->coalesced_pending & bit)) {
+            // First pending event wakes dispatcher, others ride along
+            is_signal_needed = !view_dispatcher->coalesced_pending;
+            view_dispatcher->coalesced_pending |= bit;
+            coalesced->value = value;
+        } else if(coalesced->mode == ViewDispatcherCustomEventModeCount) {
+            view_dispatcher->stats.merged++;
+            coalesced->value += value;
+        } else {
+            view_dispatcher->stats.dropped++;
+            coalesced->value = value;
+        }
+        view_dispatcher->stats.sent++;
+        is_coalesced = true;
+        break;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(is_signal_needed) {
+        // Queue is full only if dispatcher is already signaled
+        uint8_t signal = 0;
+        furi_message_queue_put(view_dispatcher->coalesced_signal, &signal, 0);
+    }
+
+    return is_coalesced;
+}
+
 void view_dispatcher_send_custom_event(ViewDispatcher* view_dispatcher, uint32_t event) {
+    view_dispatcher_send_custom_event_value(view_dispatcher, event, 1);
+}
+
+void view_dispatcher_send_custom_event_value(
+    ViewDispatcher* view_dispatcher,
+    uint32_t event,
+    uint32_t value) {
     furi_assert(view_dispatcher);
     furi_assert(view_dispatcher->queue);
 
+    if(view_dispatcher_coalesce_custom_event(view_dispatcher, event, value)) return;
+
     ViewDispatcherMessage message;
     message.type = ViewDispatcherMessageTypeCustomEvent;
     message.custom_event = event;
+    message.custom_event_value = value;
 
-    furi_check(
-        furi_message_queue_put(view_dispatcher->queue, &message, FuriWaitForever) == FuriStatusOk);
+    uint32_t stall = 0;
+    if(furi_message_queue_put(view_dispatcher->queue, &message, 0) != FuriStatusOk) {
+        uint32_t start = DWT->CYCCNT;
+        furi_check(
+            furi_message_queue_put(view_dispatcher->queue, &message, FuriWaitForever) ==
+            FuriStatusOk);
+        stall = (DWT->CYCCNT - start) / furi_hal_cortex_instructions_per_microsecond();
+    }
+
+    FURI_CRITICAL_ENTER();
+    view_dispatcher->stats.sent++;
+    if(stall) {
+        view_dispatcher->stats.stalls++;
+        view_dispatcher->stats.stall_total += stall;
+        view_dispatcher->stats.stall_max = MAX(view_dispatcher->stats.stall_max, stall);
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void view_dispatcher_set_custom_event_mode(
+    ViewDispatcher* view_dispatcher,
+    uint32_t event,
+    ViewDispatcherCustomEventMode mode) {
+    furi_assert(view_dispatcher);
+    furi_assert(view_dispatcher->queue);
+
+    FURI_CRITICAL_ENTER();
+    size_t index = 0;
+    while(index < view_dispatcher->coalesced_count &&
+          view_dispatcher->coalesced[index].event != event) {
+        index++;
+    }
+
+    if(mode != ViewDispatcherCustomEventModeQueue) {
+        if(index == view_dispatcher->coalesced_count) {
+            furi_check(index < VIEW_DISPATCHER_COALESCED_EVENTS_MAX);
+            view_dispatcher->coalesced[index].event = event;
+            view_dispatcher->coalesced[index].value = 0;
+            view_dispatcher->coalesced_count++;
+        }
+        view_dispatcher->coalesced[index].mode = mode;
+    } else if(index < view_dispatcher->coalesced_count) {
+        // Move last slot into released one, together with its pending bit
+        uint32_t pending = view_dispatcher->coalesced_pending;
+        size_t last = view_dispatcher->coalesced_count - 1;
+        if(pending & (1UL << index)) {
+            view_dispatcher->stats.dropped++;
+        }
+        pending &= ~(1UL << index);
+        if(index != last) {
+            view_dispatcher->coalesced[index] = view_dispatcher->coalesced[last];
+            if(pending & (1UL << last)) {
+                pending = (pending & ~(1UL << last)) | (1UL << index);
+            }
+        }
+        view_dispatcher->coalesced_pending = pending;
+        view_dispatcher->coalesced_count--;
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+uint32_t view_dispatcher_get_custom_event_value(ViewDispatcher* view_dispatcher) {
+    furi_assert(view_dispatcher);
+    return view_dispatcher->custom_event_value;
+}
+
+void view_dispatcher_get_custom_event_stats(
+    ViewDispatcher* view_dispatcher,
+    ViewDispatcherCustomEventStats* stats) {
+    furi_assert(view_dispatcher);
+    furi_assert(stats);
+    FURI_CRITICAL_ENTER();
+    *stats = view_dispatcher->stats;
+    FURI_CRITICAL_EXIT();
+}
+
+void view_dispatcher_reset_custom_event_stats(ViewDispatcher* view_dispatcher) {
+    furi_assert(view_dispatcher);
+    FURI_CRITICAL_ENTER();
+    memset(&view_dispatcher->stats, 0, sizeof(ViewDispatcherCustomEventStats));
+    FURI_CRITICAL_EXIT();
 }
 
 static const ViewPortOrientation view_dispatcher_view_port_orientation_table[] = {
@@ -20,8 +20,32 @@ typedef enum {
     ViewDispatcherTypeFullscreen /**< Fullscreen layer: without status bar */
 } ViewDispatcherType;
 
+/** Custom events that can be merged at the same time */
+#define VIEW_DISPATCHER_COALESCED_EVENTS_MAX (8)
+
+/** Minimal interval between dispatches of merged custom events */
+#define VIEW_DISPATCHER_COALESCE_PERIOD_MS (33)
+
 typedef struct ViewDispatcher ViewDispatcher;
 
+/** How custom event is delivered when it is sent again before dispatch */
+typedef enum {
+    ViewDispatcherCustomEventModeQueue, /**< Every event queued, sender waits for space in queue */
+    ViewDispatcherCustomEventModeLatest, /**< Pending event value replaced, latest value wins */
+    ViewDispatcherCustomEventModeCount, /**< Pending event value incremented by sent value */
+} ViewDispatcherCustomEventMode;
+
+/** Custom event statistics */
+typedef struct {
+    uint32_t sent; /**< Custom events sent */
+    uint32_t dispatched; /**< Custom events delivered to view or callback */
+    uint32_t merged; /**< Counting events merged into pending one */
+    uint32_t dropped; /**< Latest value events replaced before delivery */
+    uint32_t stalls; /**< Times sender had to wait for space in queue */
+    uint64_t stall_total; /**< Total time senders waited, us */
+    uint32_t stall_max; /**< Longest time sender waited, us */
+} ViewDispatcherCustomEventStats;
+
 /** Prototype for custom event callback */
 typedef bool (*ViewDispatcherCustomEventCallback)(void* context, uint32_t event);
 
@@ -46,19 +70,94 @@ void view_dispatcher_free(ViewDispatcher* view_dispatcher);
 /** Enable queue support
  *
  * If queue enabled all input and custom events will be dispatched throw
- * internal queue
+ * internal queue. Event loop for ViewDispatcher is allocated here, so this
+ * must be called from the thread that will run ViewDispatcher.
  *
  * @param      view_dispatcher  ViewDispatcher instance
  */
 void view_dispatcher_enable_queue(ViewDispatcher* view_dispatcher);
 
+/** Get event loop ViewDispatcher runs on
+ *
+ * Available after queue enabled. App can subscribe its own queues, stream
+ * buffers and timers, their callbacks are called in ViewDispatcher thread
+ * between input and custom events, without a custom event round trip.
+ * Unsubscribe them before freeing ViewDispatcher.
+ *
+ * @param      view_dispatcher  ViewDispatcher instance
+ *
+ * @return     FuriEventLoop instance
+ */
+FuriEventLoop* view_dispatcher_get_event_loop(ViewDispatcher* view_dispatcher);
+
 /** Send custom event
+ *
+ * Same as view_dispatcher_send_custom_event_value with value 1.
  *
  * @param      view_dispatcher  ViewDispatcher instance
  * @param[in]  event            The event
  */
 void view_dispatcher_send_custom_event(ViewDispatcher* view_dispatcher, uint32_t event);
 
+/** Send custom event with value
+ *
+ * Queued events block sender while queue is full. Latest and Count events
+ * never block and are safe to send from ISR: while event is pending it is
+ * merged in place, and pending events are dispatched at most once per
+ * VIEW_DISPATCHER_COALESCE_PERIOD_MS. Pending merged events are dispatched
+ * before next queued event, so they are never overtaken by it.
+ *
+ * @param      view_dispatcher  ViewDispatcher instance
+ * @param[in]  event            The event
+ * @param[in]  value            The value, get it in handler with
+ *                              view_dispatcher_get_custom_event_value
+ */
+void view_dispatcher_send_custom_event_value(
+    ViewDispatcher* view_dispatcher,
+    uint32_t event,
+    uint32_t value);
+
+/** Set how custom event is delivered
+ *
+ * Events are queued by default. Up to VIEW_DISPATCHER_COALESCED_EVENTS_MAX
+ * events can be merged at a time, set mode back to Queue to release slot,
+ * pending value is then dropped.
+ *
+ * @param      view_dispatcher  ViewDispatcher instance
+ * @param[in]  event            The event
+ * @param[in]  mode             ViewDispatcherCustomEventMode
+ */
+void view_dispatcher_set_custom_event_mode(
+    ViewDispatcher* view_dispatcher,
+    uint32_t event,
+    ViewDispatcherCustomEventMode mode);
+
+/** Get value of custom event that is being handled
+ *
+ * Call from view custom callback or custom event callback. For Count events
+ * it is sum of values sent since previous dispatch.
+ *
+ * @param      view_dispatcher  ViewDispatcher instance
+ *
+ * @return     event value
+ */
+uint32_t view_dispatcher_get_custom_event_value(ViewDispatcher* view_dispatcher);
+
+/** Get custom event statistics
+ *
+ * @param      view_dispatcher  ViewDispatcher instance
+ * @param      stats            statistics since last reset
+ */
+void view_dispatcher_get_custom_event_stats(
+    ViewDispatcher* view_dispatcher,
+    ViewDispatcherCustomEventStats* stats);
+
+/** Reset custom event statistics
+ *
+ * @param      view_dispatcher  ViewDispatcher instance
+ */
+void view_dispatcher_reset_custom_event_stats(ViewDispatcher* view_dispatcher);
+
 /** Set custom event handler
  *
  * Called on Custom Event, if it is not consumed by view
@@ -14,9 +14,28 @@
 
 DICT_DEF2(ViewDict, uint32_t, M_DEFAULT_OPLIST, View*, M_PTR_OPLIST)
 
+typedef struct {
+    uint32_t event;
+    ViewDispatcherCustomEventMode mode;
+    uint32_t value;
+} ViewDispatcherCoalescedEvent;
+
 struct ViewDispatcher {
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimer* tick_timer;
     FuriMessageQueue* queue;
     Gui* gui;
+
+    // Merged custom events, changed in critical section
+    FuriMessageQueue* coalesced_signal;
+    FuriEventLoopTimer* coalesced_timer;
+    ViewDispatcherCoalescedEvent coalesced[VIEW_DISPATCHER_COALESCED_EVENTS_MAX];
+    uint8_t coalesced_count;
+    volatile uint32_t coalesced_pending;
+    uint32_t coalesced_dispatched_at;
+    uint32_t custom_event_value;
+    ViewDispatcherCustomEventStats stats;
+
     ViewPort* view_port;
     ViewDict_t views;
 
@@ -42,7 +61,10 @@ typedef struct {
     ViewDispatcherMessageType type;
     union {
         InputEvent input;
-        uint32_t custom_event;
+        struct {
+            uint32_t custom_event;
+            uint32_t custom_event_value;
+        };
     };
 } ViewDispatcherMessage;
 
@@ -61,6 +83,9 @@ void view_dispatcher_handle_tick_event(ViewDispatcher* view_dispatcher);
 /** Custom event handler */
 void view_dispatcher_handle_custom_event(ViewDispatcher* view_dispatcher, uint32_t event);
 
+/** Dispatch pending merged custom events */
+void view_dispatcher_handle_coalesced_events(ViewDispatcher* view_dispatcher);
+
 /** Set current view, dispatches view enter and exit */
 void view_dispatcher_set_current_view(ViewDispatcher* view_dispatcher, View* view);
 
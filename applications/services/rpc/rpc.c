@@ -13,6 +13,7 @@
 #include <cli/cli.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <m-dict.h>
 
 #include <bt/bt_service/bt.h>
@@ -22,12 +23,25 @@
 typedef enum {
     RpcEvtNewData = (1 << 0),
     RpcEvtDisconnect = (1 << 1),
+    RpcEvtAsyncDone = (1 << 2),
 } RpcEvtFlags;
 
 #define RPC_ALL_EVENTS (RpcEvtNewData | RpcEvtDisconnect)
 
+/* Encoded output is handed to transport in segments of this size */
+#define RPC_TX_BUFFER_SIZE (512)
+
+/* Async requests queued to session async worker before decoding stalls */
+#define RPC_ASYNC_QUEUE_SIZE (4)
+
 DICT_DEF2(RpcHandlerDict, pb_size_t, M_DEFAULT_OPLIST, RpcHandler, M_POD_OPLIST)
 
+typedef struct {
+    RpcHandler handler;
+    /* Owned by job, NULL stops async worker */
+    PB_Main* message;
+} RpcAsyncJob;
+
 typedef struct {
     RpcSystemAlloc alloc;
     RpcSystemFree free;
@@ -77,6 +91,15 @@ struct RpcSession {
     void** system_contexts;
     bool decode_error;
 
+    /* Started on first async request, lives till session end */
+    FuriThread* async_thread;
+    FuriMessageQueue* async_queue;
+    volatile uint32_t async_pending[RpcHandlerClassCount];
+
+    /* Guarded by callbacks_mutex */
+    uint8_t* tx_buffer;
+    size_t tx_buffer_used;
+
     FuriMutex* callbacks_mutex;
     RpcSendBytesCallback send_bytes_callback;
     RpcBufferIsEmptyCallback buffer_is_empty_callback;
@@ -87,7 +110,7 @@ struct RpcSession {
 };
 
 struct Rpc {
-    FuriMutex* busy_mutex;
+    FuriMutex* class_mutex[RpcHandlerClassCount];
 };
 
 RpcOwner rpc_session_get_owner(RpcSession* session) {
@@ -244,10 +267,91 @@ static bool rpc_pb_content_callback(pb_istream_t* stream, const pb_field_t* fiel
     return true;
 }
 
+static PB_Main* rpc_session_message_alloc(RpcSession* session) {
+    PB_Main* message = malloc(sizeof(PB_Main));
+    message->cb_content.funcs.decode = rpc_pb_content_callback;
+    message->cb_content.arg = session;
+    return message;
+}
+
+static void
+    rpc_session_run_handler(RpcSession* session, const RpcHandler* handler, PB_Main* message) {
+    FuriMutex* mutex = session->rpc->class_mutex[handler->handler_class];
+
+    furi_check(furi_mutex_acquire(mutex, FuriWaitForever) == FuriStatusOk);
+    handler->message_handler(message, handler->context);
+    furi_check(furi_mutex_release(mutex) == FuriStatusOk);
+}
+
+static int32_t rpc_session_async_worker(void* context) {
+    furi_assert(context);
+    RpcSession* session = (RpcSession*)context;
+    RpcAsyncJob job;
+
+    while(1) {
+        furi_check(
+            furi_message_queue_get(session->async_queue, &job, FuriWaitForever) == FuriStatusOk);
+        if(!job.message) break;
+
+        rpc_session_run_handler(session, &job.handler, job.message);
+        pb_release(&PB_Main_msg, job.message);
+        free(job.message);
+
+        FURI_CRITICAL_ENTER();
+        session->async_pending[job.handler.handler_class]--;
+        FURI_CRITICAL_EXIT();
+        furi_thread_flags_set(furi_thread_get_id(session->thread), RpcEvtAsyncDone);
+    }
+
+    return 0;
+}
+
+/* Hand decoded message over to async worker, decoding continues into new one */
+static void rpc_session_dispatch_async(RpcSession* session, const RpcHandler* handler) {
+    if(!session->async_thread) {
+        session->async_queue =
+            furi_message_queue_alloc(RPC_ASYNC_QUEUE_SIZE, sizeof(RpcAsyncJob));
+        session->async_thread =
+            furi_thread_alloc_ex("RpcSessionAsync", 3072, rpc_session_async_worker, session);
+        furi_thread_start(session->async_thread);
+    }
+
+    RpcAsyncJob job = {
+        .handler = *handler,
+        .message = session->decoded_message,
+    };
+    session->decoded_message = rpc_session_message_alloc(session);
+
+    FURI_CRITICAL_ENTER();
+    session->async_pending[handler->handler_class]++;
+    FURI_CRITICAL_EXIT();
+    furi_check(
+        furi_message_queue_put(session->async_queue, &job, FuriWaitForever) == FuriStatusOk);
+}
+
+/* Keep requests of one class in order within session */
+static void rpc_session_wait_async(RpcSession* session, RpcHandlerClass handler_class) {
+    while(session->async_pending[handler_class]) {
+        furi_thread_flags_wait(RpcEvtAsyncDone, FuriFlagWaitAny, FuriWaitForever);
+    }
+}
+
+static void rpc_session_stop_async(RpcSession* session) {
+    if(session->async_thread) {
+        RpcAsyncJob job = {.message = NULL};
+        furi_check(
+            furi_message_queue_put(session->async_queue, &job, FuriWaitForever) == FuriStatusOk);
+        furi_thread_join(session->async_thread);
+        furi_thread_free(session->async_thread);
+        furi_message_queue_free(session->async_queue);
+        session->async_thread = NULL;
+        session->async_queue = NULL;
+    }
+}
+
 static int32_t rpc_session_worker(void* context) {
     furi_assert(context);
     RpcSession* session = (RpcSession*)context;
-    Rpc* rpc = session->rpc;
 
     FURI_LOG_D(TAG, "Session started");
 
@@ -270,9 +374,12 @@ static int32_t rpc_session_worker(void* context) {
                 RpcHandlerDict_get(session->handlers, session->decoded_message->which_content);
 
             if(handler && handler->message_handler) {
-                furi_check(furi_mutex_acquire(rpc->busy_mutex, FuriWaitForever) == FuriStatusOk);
-                handler->message_handler(session->decoded_message, handler->context);
-                furi_check(furi_mutex_release(rpc->busy_mutex) == FuriStatusOk);
+                if(handler->async) {
+                    rpc_session_dispatch_async(session, handler);
+                } else {
+                    rpc_session_wait_async(session, handler->handler_class);
+                    rpc_session_run_handler(session, handler, session->decoded_message);
+                }
             } else if(session->decoded_message->which_content == 0) {
                 /* Receiving zeroes means message is 0-length, which
                  * is valid for proto3: all fields are filled with default values.
@@ -333,6 +440,7 @@ static int32_t rpc_session_worker(void* context) {
         pb_release(&PB_Main_msg, session->decoded_message);
 
         if(session->terminate) {
+            rpc_session_stop_async(session);
             FURI_LOG_D(TAG, "Session terminated");
             break;
         }
@@ -352,6 +460,7 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
     }
     free(session->system_contexts);
     free(session->decoded_message);
+    free(session->tx_buffer);
     RpcHandlerDict_clear(session->handlers);
     furi_stream_buffer_free(session->stream);
 
@@ -379,15 +488,14 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     RpcSession* session = malloc(sizeof(RpcSession));
     session->callbacks_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     session->stream = furi_stream_buffer_alloc(RPC_BUFFER_SIZE, 1);
+    session->tx_buffer = malloc(RPC_TX_BUFFER_SIZE);
     session->rpc = rpc;
     session->terminate = false;
     session->decode_error = false;
     session->owner = owner;
     RpcHandlerDict_init(session->handlers);
 
-    session->decoded_message = malloc(sizeof(PB_Main));
-    session->decoded_message->cb_content.funcs.decode = rpc_pb_content_callback;
-    session->decoded_message->cb_content.arg = session;
+    session->decoded_message = rpc_session_message_alloc(session);
 
     session->system_contexts = malloc(COUNT_OF(rpc_systems) * sizeof(void*));
     for(size_t i = 0; i < COUNT_OF(rpc_systems); ++i) {
@@ -398,6 +506,7 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
         .message_handler = rpc_close_session_process,
         .decode_submessage = NULL,
         .context = session,
+        .handler_class = RpcHandlerClassSystem,
     };
     rpc_add_handler(session, PB_Main_stop_session_tag, &rpc_handler);
 
@@ -425,7 +534,9 @@ void rpc_on_system_start(void* p) {
     UNUSED(p);
     Rpc* rpc = malloc(sizeof(Rpc));
 
-    rpc->busy_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    for(size_t i = 0; i < RpcHandlerClassCount; ++i) {
+        rpc->class_mutex[i] = furi_mutex_alloc(FuriMutexTypeNormal);
+    }
 
     Cli* cli = furi_record_open(RECORD_CLI);
     cli_add_command(
@@ -440,36 +551,62 @@ void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* han
     RpcHandlerDict_set_at(session->handlers, message_tag, *handler);
 }
 
-void rpc_send(RpcSession* session, PB_Main* message) {
-    furi_assert(session);
-    furi_assert(message);
-
-    pb_ostream_t ostream = PB_OSTREAM_SIZING;
-
+static void rpc_session_tx_flush(RpcSession* session) {
+    if(session->tx_buffer_used) {
 #if SRV_RPC_DEBUG
-    FURI_LOG_I(TAG, "OUTPUT:");
-    rpc_debug_print_message(message);
+        rpc_debug_print_data("OUTPUT", session->tx_buffer, session->tx_buffer_used);
 #endif
+        session->send_bytes_callback(
+            session->context, session->tx_buffer, session->tx_buffer_used);
+        session->tx_buffer_used = 0;
+    }
+}
+
+static bool rpc_pb_stream_write(pb_ostream_t* ostream, const pb_byte_t* buf, size_t count) {
+    RpcSession* session = ostream->state;
+
+    while(count) {
+        size_t chunk = MIN(count, RPC_TX_BUFFER_SIZE - session->tx_buffer_used);
+        memcpy(session->tx_buffer + session->tx_buffer_used, buf, chunk);
+        session->tx_buffer_used += chunk;
+        buf += chunk;
+        count -= chunk;
 
-    bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
-    furi_check(result && ostream.bytes_written);
+        if(session->tx_buffer_used == RPC_TX_BUFFER_SIZE) {
+            rpc_session_tx_flush(session);
+        }
+    }
 
-    uint8_t* buffer = malloc(ostream.bytes_written);
-    ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
+    return true;
+}
 
-    pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+void rpc_send(RpcSession* session, PB_Main* message) {
+    furi_assert(session);
+    furi_assert(message);
 
 #if SRV_RPC_DEBUG
-    rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
+    FURI_LOG_I(TAG, "OUTPUT:");
+    rpc_debug_print_message(message);
 #endif
 
+    /* Encode straight into session TX buffer, full segments go to transport
+     * while encoding. Mutex keeps segments of one message together. */
     furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
     if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
+        pb_ostream_t ostream = {
+            .callback = rpc_pb_stream_write,
+            .state = session,
+            .max_size = SIZE_MAX,
+            .bytes_written = 0,
+            .errmsg = NULL,
+        };
+
+        bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+        furi_check(result && ostream.bytes_written);
+
+        rpc_session_tx_flush(session);
     }
     furi_mutex_release(session->callbacks_mutex);
-
-    free(buffer);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
@@ -384,6 +384,7 @@ void* rpc_system_gui_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = rpc_gui,
+        .handler_class = RpcHandlerClassGui,
     };
 
     rpc_handler.message_handler = rpc_system_gui_start_screen_stream_process;
@@ -11,10 +11,26 @@ typedef void* (*RpcSystemAlloc)(RpcSession* session);
 typedef void (*RpcSystemFree)(void* context);
 typedef void (*PBMessageHandler)(const PB_Main* msg_request, void* context);
 
+/** Concurrency class of a handler. Handlers of the same class share state
+ * and are serialized across all sessions, handlers of different classes run
+ * in parallel. */
+typedef enum {
+    RpcHandlerClassSystem,
+    RpcHandlerClassStorage,
+    RpcHandlerClassGui,
+    RpcHandlerClassApp,
+    RpcHandlerClassCount,
+} RpcHandlerClass;
+
 typedef struct {
     bool (*decode_submessage)(pb_istream_t* stream, const pb_field_t* field, void** arg);
     PBMessageHandler message_handler;
     void* context;
+    RpcHandlerClass handler_class;
+    /** Run on session async worker: session keeps processing requests of
+     * other classes, responses are matched by command_id. Requests of the
+     * same class still complete in order. */
+    bool async;
 } RpcHandler;
 
 void rpc_send(RpcSession* session, PB_Main* main_message);
@@ -99,6 +99,7 @@ void* rpc_system_property_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = session,
+        .handler_class = RpcHandlerClassSystem,
     };
 
     rpc_handler.message_handler = rpc_system_property_get_process;
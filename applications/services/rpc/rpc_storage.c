@@ -367,8 +367,10 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
-    /* use same message memory to send response */
+    /* use same message and data buffer memory to send every response */
     PB_Main* response = malloc(sizeof(PB_Main));
+    PB_Storage_ReadResponse* read_response = &response->content.storage_read_response;
+    read_response->file.data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MAX_DATA_SIZE));
     const char* path = request->content.storage_read_request.path;
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
     File* file = storage_file_alloc(fs_api);
@@ -380,14 +382,12 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
             response->command_id = request->command_id;
             response->which_content = PB_Main_storage_read_response_tag;
             response->command_status = PB_CommandStatus_OK;
+            read_response->has_file = true;
 
             size_t read_size = MIN(size_left, MAX_DATA_SIZE);
             if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
+                uint8_t* buffer = &read_response->file.data->bytes[0];
+                uint16_t* read_size_msg = &read_response->file.data->size;
 
                 *read_size_msg = storage_file_read(file, buffer, read_size);
                 size_left -= *read_size_msg;
@@ -395,16 +395,13 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
                 response->has_next = fs_operation_success && (size_left > 0);
             } else {
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-                response->content.storage_read_response.has_file = true;
+                read_response->file.data->size = 0;
                 response->has_next = false;
                 fs_operation_success = true;
             }
 
             if(fs_operation_success) {
-                rpc_send_and_release(session, response);
+                rpc_send(session, response);
             }
         } while((size_left != 0) && fs_operation_success);
     }
@@ -414,6 +411,7 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
             session, request->command_id, rpc_system_storage_get_file_error(file));
     }
 
+    free(read_response->file.data);
     free(response);
     storage_file_close(file);
     storage_file_free(file);
@@ -720,6 +718,7 @@ void* rpc_system_storage_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = rpc_storage,
+        .handler_class = RpcHandlerClassStorage,
     };
 
     rpc_handler.message_handler = rpc_system_storage_info_process;
@@ -734,8 +733,10 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     rpc_handler.message_handler = rpc_system_storage_list_process;
     rpc_add_handler(session, PB_Main_storage_list_request_tag, &rpc_handler);
 
+    rpc_handler.async = true;
     rpc_handler.message_handler = rpc_system_storage_read_process;
     rpc_add_handler(session, PB_Main_storage_read_request_tag, &rpc_handler);
+    rpc_handler.async = false;
 
     rpc_handler.message_handler = rpc_system_storage_write_process;
     rpc_add_handler(session, PB_Main_storage_write_request_tag, &rpc_handler);
@@ -746,8 +747,10 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     rpc_handler.message_handler = rpc_system_storage_mkdir_process;
     rpc_add_handler(session, PB_Main_storage_mkdir_request_tag, &rpc_handler);
 
+    rpc_handler.async = true;
     rpc_handler.message_handler = rpc_system_storage_md5sum_process;
     rpc_add_handler(session, PB_Main_storage_md5sum_request_tag, &rpc_handler);
+    rpc_handler.async = false;
 
     rpc_handler.message_handler = rpc_system_storage_rename_process;
     rpc_add_handler(session, PB_Main_storage_rename_request_tag, &rpc_handler);
@@ -304,6 +304,7 @@ void* rpc_system_system_alloc(RpcSession* session) {
         .message_handler = NULL,
         .decode_submessage = NULL,
         .context = session,
+        .handler_class = RpcHandlerClassSystem,
     };
 
     rpc_handler.message_handler = rpc_system_system_ping_process;
@@ -15,11 +15,12 @@ typedef enum {
 
 /** Structure that hold file index and returned api errors */
 struct File {
-    uint32_t file_id; /**< File ID for internal references */
+    uintptr_t file_id; /**< File ID for internal references */
     FileType type;
     FS_Error error_id; /**< Standard API error from FS_Error enum */
     int32_t internal_error_id; /**< Internal API error value */
     void* storage;
+    uint8_t storage_type; /**< Backing storage (StorageType), assigned on open */
 };
 
 /** File api structure
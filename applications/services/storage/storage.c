@@ -1,14 +1,11 @@
 #include "storage.h"
 #include "storage_i.h"
 #include "storage_message.h"
-#include "storage_processing.h"
 #include "storage/storage_glue.h"
 #include "storages/storage_int.h"
 #include "storages/storage_ext.h"
 #include <assets_icons.h>
 
-#define STORAGE_TICK 1000
-
 #define ICON_SD_MOUNTED &I_SDcardMounted_11x8
 #define ICON_SD_ERROR &I_SDcardFail_11x8
 
@@ -19,8 +16,7 @@ static void storage_app_sd_icon_draw_callback(Canvas* canvas, void* context) {
     furi_assert(context);
     Storage* app = context;
 
-    // here we don't care about thread race when reading / writing status
-    switch(app->storage[ST_EXT].status) {
+    switch(storage_data_status(&app->storage[ST_EXT])) {
     case StorageStatusNotReady:
         break;
     case StorageStatusOK:
@@ -34,7 +30,6 @@ static void storage_app_sd_icon_draw_callback(Canvas* canvas, void* context) {
 
 Storage* storage_app_alloc() {
     Storage* app = malloc(sizeof(Storage));
-    app->message_queue = furi_message_queue_alloc(8, sizeof(StorageMessage));
     app->pubsub = furi_pubsub_alloc();
 
     for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
@@ -42,8 +37,12 @@ Storage* storage_app_alloc() {
         storage_data_timestamp(&app->storage[i]);
     }
 
+    // SD card requests are served by storage service thread itself
+    storage_worker_init(&app->worker[ST_EXT]);
 #ifndef FURI_RAM_EXEC
+    storage_worker_init(&app->worker[ST_INT]);
     storage_int_init(&app->storage[ST_INT]);
+    storage_worker_start(app, ST_INT);
 #endif
     storage_ext_init(&app->storage[ST_EXT]);
 
@@ -70,7 +69,8 @@ void storage_tick(Storage* app) {
     }
 
     // storage not enabled but was enabled (sd card unmount)
-    if(app->storage[ST_EXT].status == StorageStatusNotReady && app->sd_gui.enabled == true) {
+    if(storage_data_status(&app->storage[ST_EXT]) == StorageStatusNotReady &&
+       app->sd_gui.enabled == true) {
         app->sd_gui.enabled = false;
         view_port_enabled_set(app->sd_gui.view_port, false);
 
@@ -80,16 +80,16 @@ void storage_tick(Storage* app) {
     }
 
     // storage enabled (or in error state) but was not enabled (sd card mount)
-    if((app->storage[ST_EXT].status == StorageStatusOK ||
-        app->storage[ST_EXT].status == StorageStatusNotMounted ||
-        app->storage[ST_EXT].status == StorageStatusNoFS ||
-        app->storage[ST_EXT].status == StorageStatusNotAccessible ||
-        app->storage[ST_EXT].status == StorageStatusErrorInternal) &&
+    if((storage_data_status(&app->storage[ST_EXT]) == StorageStatusOK ||
+        storage_data_status(&app->storage[ST_EXT]) == StorageStatusNotMounted ||
+        storage_data_status(&app->storage[ST_EXT]) == StorageStatusNoFS ||
+        storage_data_status(&app->storage[ST_EXT]) == StorageStatusNotAccessible ||
+        storage_data_status(&app->storage[ST_EXT]) == StorageStatusErrorInternal) &&
        app->sd_gui.enabled == false) {
         app->sd_gui.enabled = true;
         view_port_enabled_set(app->sd_gui.view_port, true);
 
-        if(app->storage[ST_EXT].status == StorageStatusOK) {
+        if(storage_data_status(&app->storage[ST_EXT]) == StorageStatusOK) {
             FURI_LOG_I(TAG, "SD card mount");
             StorageEvent event = {.type = StorageEventTypeCardMount};
             furi_pubsub_publish(app->pubsub, &event);
@@ -106,14 +106,8 @@ int32_t storage_srv(void* p) {
     Storage* app = storage_app_alloc();
     furi_record_create(RECORD_STORAGE, app);
 
-    StorageMessage message;
-    while(1) {
-        if(furi_message_queue_get(app->message_queue, &message, STORAGE_TICK) == FuriStatusOk) {
-            storage_process_message(app, &message);
-        } else {
-            storage_tick(app);
-        }
-    }
+    /* Service thread serves SD card, it also watches card insertion */
+    storage_worker_run(app, ST_EXT, storage_tick);
 
     return 0;
 }
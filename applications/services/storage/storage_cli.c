@@ -8,6 +8,7 @@
 #include <storage/storage.h>
 #include <storage/storage_sd_api.h>
 #include <power/power_service/power.h>
+#include "storage_i.h"
 
 #define MAX_NAME_LENGTH 255
 
@@ -33,6 +34,7 @@ static void storage_cli_print_usage() {
     printf("\tmd5\t - md5 hash of the file\r\n");
     printf("\tstat\t - info about file or dir\r\n");
     printf("\ttimestamp\t - last modification timestamp\r\n");
+    printf("\tstats\t - storage worker request statistics\r\n");
 };
 
 static void storage_cli_print_error(FS_Error error) {
@@ -412,6 +414,41 @@ static void storage_cli_timestamp(Cli* cli, FuriString* path) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static void storage_cli_stats(Cli* cli, FuriString* path) {
+    UNUSED(cli);
+    StorageType type;
+    if(furi_string_cmp_str(path, STORAGE_INT_PATH_PREFIX) == 0) {
+        type = ST_INT;
+    } else if(furi_string_cmp_str(path, STORAGE_EXT_PATH_PREFIX) == 0) {
+        type = ST_EXT;
+    } else {
+        storage_cli_print_usage();
+        return;
+    }
+
+    Storage* api = furi_record_open(RECORD_STORAGE);
+    StorageWorkerStats stats;
+    storage_worker_get_stats(api, type, &stats);
+    furi_record_close(RECORD_STORAGE);
+
+    printf("Requests: %lu, fast path: %lu\r\n", stats.requests, stats.fast_path_requests);
+
+    const char* depth_labels[STORAGE_WORKER_DEPTH_BUCKETS] = {"0", "1", "2", "3-4", "5-8", "9+"};
+    printf("Queue depth on arrival:\r\n");
+    for(size_t i = 0; i < STORAGE_WORKER_DEPTH_BUCKETS; i++) {
+        printf("\t%s\t%lu\r\n", depth_labels[i], stats.depth[i]);
+    }
+
+    printf("Latency:\r\n");
+    uint32_t limit = STORAGE_WORKER_LATENCY_BASE_US;
+    for(size_t i = 0; i < STORAGE_WORKER_LATENCY_BUCKETS - 1; i++) {
+        printf("\t<%luus\t%lu\r\n", limit, stats.latency[i]);
+        limit <<= 1;
+    }
+    printf("\t>=%luus\t%lu\r\n", limit >> 1, stats.latency[STORAGE_WORKER_LATENCY_BUCKETS - 1]);
+    printf("\tmax\t%luus\r\n", stats.latency_max_us);
+}
+
 static void storage_cli_copy(Cli* cli, FuriString* old_path, FuriString* args) {
     UNUSED(cli);
     Storage* api = furi_record_open(RECORD_STORAGE);
@@ -591,6 +628,11 @@ void storage_cli(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "stats") == 0) {
+            storage_cli_stats(cli, path);
+            break;
+        }
+
         storage_cli_print_usage();
     } while(false);
 
@@ -7,7 +7,6 @@
 #include <toolbox/dir_walk.h>
 #include "toolbox/path.h"
 
-#define MAX_NAME_LENGTH 256
 #define MAX_EXT_LEN 16
 #define FILE_BUFFER_SIZE 512
 
@@ -19,11 +18,7 @@
     Storage* storage = file->storage; \
     furi_assert(storage);
 
-#define S_API_EPILOGUE                                                               \
-    furi_check(                                                                      \
-        furi_message_queue_put(storage->message_queue, &message, FuriWaitForever) == \
-        FuriStatusOk);                                                               \
-    api_lock_wait_unlock_and_free(lock)
+#define S_API_EPILOGUE storage_worker_send(storage, &message)
 
 #define S_API_MESSAGE(_command)      \
     SAReturn return_data;            \
@@ -114,7 +109,7 @@ bool storage_file_open(
     FURI_LOG_T(
         TAG,
         "File %p - %p open (%s)",
-        (void*)((uint32_t)file - SRAM_BASE),
+        (void*)((uintptr_t)file - SRAM_BASE),
         (void*)(file->file_id - SRAM_BASE),
         path);
 
@@ -132,7 +127,7 @@ bool storage_file_close(File* file) {
     FURI_LOG_T(
         TAG,
         "File %p - %p closed",
-        (void*)((uint32_t)file - SRAM_BASE),
+        (void*)((uintptr_t)file - SRAM_BASE),
         (void*)(file->file_id - SRAM_BASE));
     file->type = FileTypeClosed;
 
@@ -315,7 +310,7 @@ bool storage_dir_open(File* file, const char* path) {
     FURI_LOG_T(
         TAG,
         "Dir %p - %p open (%s)",
-        (void*)((uint32_t)file - SRAM_BASE),
+        (void*)((uintptr_t)file - SRAM_BASE),
         (void*)(file->file_id - SRAM_BASE),
         path);
 
@@ -332,7 +327,7 @@ bool storage_dir_close(File* file) {
     FURI_LOG_T(
         TAG,
         "Dir %p - %p closed",
-        (void*)((uint32_t)file - SRAM_BASE),
+        (void*)((uintptr_t)file - SRAM_BASE),
         (void*)(file->file_id - SRAM_BASE));
 
     file->type = FileTypeClosed;
@@ -461,17 +456,52 @@ FS_Error storage_common_rename(Storage* storage, const char* old_path, const cha
     return error;
 }
 
+#define STORAGE_COPY_BATCH_SIZE (16)
+
+typedef struct {
+    Storage* storage;
+    size_t old_path_length;
+    const char* new_path;
+    FuriString* tmp_new_path;
+    FS_Error error;
+} StorageCopyContext;
+
+static bool storage_copy_recursive_batch(const DirWalkEntry* entries, size_t count, void* ctx) {
+    StorageCopyContext* context = ctx;
+
+    for(size_t i = 0; i < count; i++) {
+        const char* old_path = furi_string_get_cstr(entries[i].path);
+        furi_string_printf(
+            context->tmp_new_path, "%s%s", context->new_path, old_path + context->old_path_length);
+
+        if(file_info_is_dir(&entries[i].fileinfo)) {
+            context->error = storage_common_mkdir(
+                context->storage, furi_string_get_cstr(context->tmp_new_path));
+        } else {
+            context->error = storage_common_copy(
+                context->storage, old_path, furi_string_get_cstr(context->tmp_new_path));
+        }
+
+        if(context->error != FSE_OK) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static FS_Error
     storage_copy_recursive(Storage* storage, const char* old_path, const char* new_path) {
     FS_Error error = storage_common_mkdir(storage, new_path);
     DirWalk* dir_walk = dir_walk_alloc(storage);
-    FuriString* path;
-    FuriString* tmp_new_path;
-    FuriString* tmp_old_path;
-    FileInfo fileinfo;
-    path = furi_string_alloc();
-    tmp_new_path = furi_string_alloc();
-    tmp_old_path = furi_string_alloc();
+
+    StorageCopyContext context = {
+        .storage = storage,
+        .old_path_length = strlen(old_path),
+        .new_path = new_path,
+        .tmp_new_path = furi_string_alloc(),
+        .error = FSE_OK,
+    };
 
     do {
         if(error != FSE_OK) break;
@@ -481,37 +511,17 @@ static FS_Error
             break;
         }
 
-        while(1) {
-            DirWalkResult res = dir_walk_read(dir_walk, path, &fileinfo);
-
-            if(res == DirWalkError) {
-                error = dir_walk_get_error(dir_walk);
-                break;
-            } else if(res == DirWalkLast) {
-                break;
-            } else {
-                furi_string_set(tmp_old_path, path);
-                furi_string_right(path, strlen(old_path));
-                furi_string_printf(tmp_new_path, "%s%s", new_path, furi_string_get_cstr(path));
-
-                if(file_info_is_dir(&fileinfo)) {
-                    error = storage_common_mkdir(storage, furi_string_get_cstr(tmp_new_path));
-                } else {
-                    error = storage_common_copy(
-                        storage,
-                        furi_string_get_cstr(tmp_old_path),
-                        furi_string_get_cstr(tmp_new_path));
-                }
-
-                if(error != FSE_OK) break;
-            }
+        // Pre-order: directories are created before their contents
+        DirWalkResult res = dir_walk_read_batch(
+            dir_walk, STORAGE_COPY_BATCH_SIZE, storage_copy_recursive_batch, &context);
+        if(res == DirWalkError) {
+            error = dir_walk_get_error(dir_walk);
+        } else {
+            error = context.error;
         }
-
     } while(false);
 
-    furi_string_free(tmp_new_path);
-    furi_string_free(tmp_old_path);
-    furi_string_free(path);
+    furi_string_free(context.tmp_new_path);
     dir_walk_free(dir_walk);
     return error;
 }
@@ -812,8 +822,9 @@ File* storage_file_alloc(Storage* storage) {
     File* file = malloc(sizeof(File));
     file->type = FileTypeClosed;
     file->storage = storage;
+    file->storage_type = ST_EXT;
 
-    FURI_LOG_T(TAG, "File/Dir %p alloc", (void*)((uint32_t)file - SRAM_BASE));
+    FURI_LOG_T(TAG, "File/Dir %p alloc", (void*)((uintptr_t)file - SRAM_BASE));
 
     return file;
 }
@@ -835,7 +846,7 @@ void storage_file_free(File* file) {
         }
     }
 
-    FURI_LOG_T(TAG, "File/Dir %p free", (void*)((uint32_t)file - SRAM_BASE));
+    FURI_LOG_T(TAG, "File/Dir %p free", (void*)((uintptr_t)file - SRAM_BASE));
     free(file);
 }
 
@@ -847,63 +858,44 @@ FuriPubSub* storage_get_pubsub(Storage* storage) {
 bool storage_simply_remove_recursive(Storage* storage, const char* path) {
     furi_assert(storage);
     furi_assert(path);
-    FileInfo fileinfo;
-    bool result = false;
-    FuriString* fullname;
-    FuriString* cur_dir;
 
     if(storage_simply_remove(storage, path)) {
         return true;
     }
 
-    char* name = malloc(MAX_NAME_LENGTH + 1); //-V799
-    File* dir = storage_file_alloc(storage);
-    cur_dir = furi_string_alloc_set(path);
-    bool go_deeper = false;
-
-    while(1) {
-        if(!storage_dir_open(dir, furi_string_get_cstr(cur_dir))) {
-            storage_dir_close(dir);
-            break;
-        }
+    // Contents first: post-order walk keeps its position while returned elements are removed
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    FuriString* fullname = furi_string_alloc();
+    dir_walk_set_order(dir_walk, DirWalkOrderPost);
+    bool result = false;
 
-        while(storage_dir_read(dir, &fileinfo, name, MAX_NAME_LENGTH)) {
-            if(file_info_is_dir(&fileinfo)) {
-                furi_string_cat_printf(cur_dir, "/%s", name);
-                go_deeper = true;
+    if(dir_walk_open(dir_walk, path)) {
+        while(true) {
+            DirWalkResult res = dir_walk_read(dir_walk, fullname, NULL);
+            if(res == DirWalkLast) {
+                result = true;
+                break;
+            } else if(res == DirWalkError) {
                 break;
             }
 
-            fullname = furi_string_alloc_printf("%s/%s", furi_string_get_cstr(cur_dir), name);
             FS_Error error = storage_common_remove(storage, furi_string_get_cstr(fullname));
-            furi_check(error == FSE_OK);
-            furi_string_free(fullname);
-        }
-        storage_dir_close(dir);
-
-        if(go_deeper) {
-            go_deeper = false;
-            continue;
-        }
-
-        FS_Error error = storage_common_remove(storage, furi_string_get_cstr(cur_dir));
-        furi_check(error == FSE_OK);
-
-        if(furi_string_cmp(cur_dir, path)) {
-            size_t last_char = furi_string_search_rchar(cur_dir, '/');
-            furi_assert(last_char != FURI_STRING_FAILURE);
-            furi_string_left(cur_dir, last_char);
-        } else {
-            result = true;
-            break;
+            if(error != FSE_OK) {
+                FURI_LOG_E(
+                    TAG,
+                    "Remove %s: %s",
+                    furi_string_get_cstr(fullname),
+                    storage_error_get_desc(error));
+                break;
+            }
         }
     }
 
-    storage_file_free(dir);
-    furi_string_free(cur_dir);
-    free(name);
-    return result;
-} //-V773
+    dir_walk_free(dir_walk);
+    furi_string_free(fullname);
+
+    return result && (storage_common_remove(storage, path) == FSE_OK);
+}
 
 bool storage_simply_remove(Storage* storage, const char* path) {
     FS_Error result;
@@ -35,13 +35,18 @@ void storage_data_init(StorageData* storage) {
     StorageFileList_init(storage->files);
 }
 
+/* Status is changed by owning worker only, but read by clients routing /any paths */
+void storage_data_set_status(StorageData* storage, StorageStatus status) {
+    __atomic_store_n(&storage->status, status, __ATOMIC_RELEASE);
+}
+
 StorageStatus storage_data_status(StorageData* storage) {
-    return storage->status;
+    return __atomic_load_n(&storage->status, __ATOMIC_ACQUIRE);
 }
 
 const char* storage_data_status_text(StorageData* storage) {
     const char* result = "unknown";
-    switch(storage->status) {
+    switch(storage_data_status(storage)) {
     case StorageStatusOK:
         result = "ok";
         break;
@@ -128,7 +133,7 @@ void* storage_get_storage_file_data(const File* file, StorageData* storage) {
 
 void storage_push_storage_file(File* file, FuriString* path, StorageData* storage) {
     StorageFile* storage_file = StorageFileList_push_new(storage->files);
-    file->file_id = (uint32_t)storage_file;
+    file->file_id = (uintptr_t)storage_file;
     storage_file->file = file;
     furi_string_set(storage_file->path, path);
 }
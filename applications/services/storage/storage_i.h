@@ -4,6 +4,7 @@
 #include <gui/gui.h>
 #include "storage_glue.h"
 #include "storage_sd_api.h"
+#include "storage_worker.h"
 #include "filesystem_api_internal.h"
 
 #ifdef __cplusplus
@@ -21,7 +22,7 @@ typedef struct {
 } StorageSDGui;
 
 struct Storage {
-    FuriMessageQueue* message_queue;
+    StorageWorker worker[STORAGE_COUNT];
     StorageData storage[STORAGE_COUNT];
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
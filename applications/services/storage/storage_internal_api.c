@@ -7,6 +7,7 @@ FS_Error storage_int_backup(Storage* api, const char* dstname) {
     bool success = tar_archive_open(archive, dstname, TAR_OPEN_MODE_WRITE) &&
                    tar_archive_add_dir(archive, STORAGE_INT_PATH_PREFIX, "") &&
                    tar_archive_finalize(archive);
+    tar_archive_log_stats(archive, "Backup");
     tar_archive_free(archive);
     return success ? FSE_OK : FSE_INTERNAL;
 }
@@ -15,6 +16,7 @@ FS_Error storage_int_restore(Storage* api, const char* srcname, Storage_name_con
     TarArchive* archive = tar_archive_alloc(api);
     bool success = tar_archive_open(archive, srcname, TAR_OPEN_MODE_READ) &&
                    tar_archive_unpack_to(archive, STORAGE_INT_PATH_PREFIX, converter);
+    tar_archive_log_stats(archive, "Restore");
     tar_archive_free(archive);
     return success ? FSE_OK : FSE_INTERNAL;
 }
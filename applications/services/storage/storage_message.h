@@ -149,6 +149,8 @@ typedef struct {
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
+    uint32_t enqueued_at; /**< DWT cycle counter value at submission */
+    uint32_t queue_depth; /**< Requests pending in worker at submission */
 } StorageMessage;
 
 #ifdef __cplusplus
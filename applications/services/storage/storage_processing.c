@@ -26,10 +26,10 @@ static bool storage_type_is_valid(StorageType type) {
 static StorageData* get_storage_by_file(File* file, StorageData* storages) {
     StorageData* storage_data = NULL;
 
-    for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
-        if(storage_has_file(file, &storages[i])) {
-            storage_data = &storages[i];
-        }
+    /* Only the owning worker may walk storage file list */
+    if((file->storage_type < STORAGE_COUNT) &&
+       storage_has_file(file, &storages[file->storage_type])) {
+        storage_data = &storages[file->storage_type];
     }
 
     return storage_data;
@@ -671,8 +671,6 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
     if(path != NULL) { //-V547
         furi_string_free(path);
     }
-
-    api_lock_unlock(message->lock);
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
@@ -0,0 +1,279 @@
+#include "storage_worker.h"
+#include "storage_i.h"
+#include "storage_processing.h"
+
+#define TAG "StorageWorker"
+
+#define STORAGE_WORKER_QUEUE_SIZE (8)
+#define STORAGE_WORKER_TICK (1000)
+#define STORAGE_WORKER_STACK_SIZE (3 * 1024)
+
+/* Reads this small are served from the internal storage cache in a few microseconds,
+ * context switches to worker and back would cost more than the read itself */
+#define STORAGE_WORKER_FAST_PATH_READ_MAX (256)
+
+static const uint32_t storage_worker_depth_limits[STORAGE_WORKER_DEPTH_BUCKETS - 1] = {
+    0,
+    1,
+    2,
+    4,
+    8,
+};
+
+void storage_worker_init(StorageWorker* worker) {
+    worker->thread = NULL;
+    for(size_t i = 0; i < StorageMessagePriorityCount; i++) {
+        worker->queue[i] =
+            furi_message_queue_alloc(STORAGE_WORKER_QUEUE_SIZE, sizeof(StorageMessage));
+    }
+    worker->pending =
+        furi_semaphore_alloc(STORAGE_WORKER_QUEUE_SIZE * StorageMessagePriorityCount, 0);
+    worker->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    memset(&worker->stats, 0, sizeof(StorageWorkerStats));
+}
+
+/******************* Routing *******************/
+
+static bool storage_worker_path_has_prefix(const char* path, const char* prefix) {
+    size_t prefix_len = strlen(prefix);
+    return (strncmp(path, prefix, prefix_len) == 0) &&
+           ((path[prefix_len] == '\0') || (path[prefix_len] == '/'));
+}
+
+static const char** storage_worker_get_message_path(StorageMessage* message) {
+    switch(message->command) {
+    case StorageCommandFileOpen:
+        return &message->data->fopen.path;
+    case StorageCommandDirOpen:
+        return &message->data->dopen.path;
+    case StorageCommandCommonTimestamp:
+        return &message->data->ctimestamp.path;
+    case StorageCommandCommonStat:
+        return &message->data->cstat.path;
+    case StorageCommandCommonRemove:
+    case StorageCommandCommonMkDir:
+        return &message->data->path.path;
+    case StorageCommandCommonFSInfo:
+        return &message->data->cfsinfo.fs_path;
+    default:
+        return NULL;
+    }
+}
+
+static StorageType storage_worker_route_path(
+    Storage* app,
+    const char** path,
+    FuriString** resolved_path) {
+    if(storage_worker_path_has_prefix(*path, STORAGE_INT_PATH_PREFIX)) {
+        return ST_INT;
+    }
+
+    if(storage_worker_path_has_prefix(*path, STORAGE_ANY_PATH_PREFIX)) {
+        /* Resolve here, so that chosen worker is the one owning the storage */
+        StorageType type = ST_INT;
+        if(storage_data_status(&app->storage[ST_EXT]) == StorageStatusOK) {
+            type = ST_EXT;
+        }
+        *resolved_path = furi_string_alloc_set(*path);
+        furi_string_replace_at(
+            *resolved_path,
+            0,
+            strlen(STORAGE_ANY_PATH_PREFIX),
+            (type == ST_EXT) ? STORAGE_EXT_PATH_PREFIX : STORAGE_INT_PATH_PREFIX);
+        *path = furi_string_get_cstr(*resolved_path);
+        return type;
+    }
+
+    /* External storage, app aliases and invalid names */
+    return ST_EXT;
+}
+
+static StorageType
+    storage_worker_route(Storage* app, StorageMessage* message, FuriString** resolved_path) {
+#ifdef FURI_RAM_EXEC
+    UNUSED(app);
+    UNUSED(message);
+    UNUSED(resolved_path);
+    return ST_EXT;
+#else
+    const char** path = storage_worker_get_message_path(message);
+    if(path) {
+        StorageType type = storage_worker_route_path(app, path, resolved_path);
+        if(message->command == StorageCommandFileOpen) {
+            message->data->fopen.file->storage_type = type;
+        } else if(message->command == StorageCommandDirOpen) {
+            message->data->dopen.file->storage_type = type;
+        }
+        return type;
+    }
+
+    switch(message->command) {
+    case StorageCommandSDFormat:
+    case StorageCommandSDUnmount:
+    case StorageCommandSDMount:
+    case StorageCommandSDInfo:
+    case StorageCommandSDStatus:
+    case StorageCommandCommonResolvePath:
+        return ST_EXT;
+    default:
+        /* File and dir requests: all SAData file variants start with File pointer */
+        return message->data->file.file->storage_type;
+    }
+#endif
+}
+
+static StorageMessagePriority storage_worker_get_priority(StorageMessage* message) {
+    switch(message->command) {
+    case StorageCommandFileClose:
+    case StorageCommandFileSeek:
+    case StorageCommandFileTell:
+    case StorageCommandFileSize:
+    case StorageCommandFileEof:
+    case StorageCommandDirClose:
+    case StorageCommandCommonTimestamp:
+    case StorageCommandCommonStat:
+    case StorageCommandSDStatus:
+        return StorageMessagePriorityHigh;
+    default:
+        return StorageMessagePriorityNormal;
+    }
+}
+
+static bool storage_worker_is_fast_path(StorageType type, StorageMessage* message) {
+    return (type == ST_INT) && (message->command == StorageCommandFileRead) &&
+           (message->data->fread.bytes_to_read <= STORAGE_WORKER_FAST_PATH_READ_MAX);
+}
+
+/******************* Processing *******************/
+
+static void
+    storage_worker_account(StorageWorker* worker, StorageMessage* message, bool fast_path) {
+    StorageWorkerStats* stats = &worker->stats;
+    stats->requests++;
+    if(fast_path) {
+        stats->fast_path_requests++;
+    }
+
+    size_t depth_bucket = 0;
+    while((depth_bucket < COUNT_OF(storage_worker_depth_limits)) &&
+          (message->queue_depth > storage_worker_depth_limits[depth_bucket])) {
+        depth_bucket++;
+    }
+    stats->depth[depth_bucket]++;
+
+    uint32_t latency_us =
+        (DWT->CYCCNT - message->enqueued_at) / furi_hal_cortex_instructions_per_microsecond();
+    size_t latency_bucket = 0;
+    uint32_t latency_limit = STORAGE_WORKER_LATENCY_BASE_US;
+    while((latency_bucket < STORAGE_WORKER_LATENCY_BUCKETS - 1) && (latency_us >= latency_limit)) {
+        latency_bucket++;
+        latency_limit <<= 1;
+    }
+    stats->latency[latency_bucket]++;
+    stats->latency_max_us = MAX(stats->latency_max_us, latency_us);
+}
+
+/* Must be called with worker mutex held */
+static void storage_worker_process(
+    Storage* app,
+    StorageWorker* worker,
+    StorageMessage* message,
+    bool fast_path) {
+    storage_process_message(app, message);
+    storage_worker_account(worker, message, fast_path);
+    /* Message belongs to client and is invalid after unlock */
+    api_lock_unlock(message->lock);
+}
+
+static void storage_worker_get_next_message(StorageWorker* worker, StorageMessage* message) {
+    for(size_t i = 0; i < StorageMessagePriorityCount; i++) {
+        if(furi_message_queue_get(worker->queue[i], message, 0) == FuriStatusOk) {
+            return;
+        }
+    }
+    furi_crash("Storage queue is empty");
+}
+
+void storage_worker_run(Storage* app, StorageType type, StorageWorkerTickCallback tick) {
+    StorageWorker* worker = &app->worker[type];
+    const uint32_t timeout = tick ? STORAGE_WORKER_TICK : FuriWaitForever;
+    StorageMessage message;
+
+    while(1) {
+        if(furi_semaphore_acquire(worker->pending, timeout) == FuriStatusOk) {
+            storage_worker_get_next_message(worker, &message);
+            furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+            storage_worker_process(app, worker, &message, false);
+            furi_check(furi_mutex_release(worker->mutex) == FuriStatusOk);
+        } else {
+            furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+            tick(app);
+            furi_check(furi_mutex_release(worker->mutex) == FuriStatusOk);
+        }
+    }
+}
+
+typedef struct {
+    Storage* app;
+    StorageType type;
+} StorageWorkerThreadContext;
+
+static int32_t storage_worker_thread(void* context) {
+    StorageWorkerThreadContext* thread_context = context;
+    storage_worker_run(thread_context->app, thread_context->type, NULL);
+    return 0;
+}
+
+void storage_worker_start(Storage* app, StorageType type) {
+    StorageWorker* worker = &app->worker[type];
+    furi_check(worker->thread == NULL);
+
+    /* Lives as long as the service, which never stops */
+    StorageWorkerThreadContext* thread_context = malloc(sizeof(StorageWorkerThreadContext));
+    thread_context->app = app;
+    thread_context->type = type;
+
+    worker->thread = furi_thread_alloc_ex(
+        "StorageIntWorker", STORAGE_WORKER_STACK_SIZE, storage_worker_thread, thread_context);
+    /* Internal storage requests are short, let them pass ahead of SD card traffic */
+    furi_thread_set_priority(worker->thread, FuriThreadPriorityHigh);
+    furi_thread_mark_as_service(worker->thread);
+    furi_thread_start(worker->thread);
+}
+
+void storage_worker_send(Storage* app, StorageMessage* message) {
+    FuriString* resolved_path = NULL;
+    StorageType type = storage_worker_route(app, message, &resolved_path);
+    StorageWorker* worker = &app->worker[type];
+
+    message->enqueued_at = DWT->CYCCNT;
+    if(storage_worker_is_fast_path(type, message)) {
+        message->queue_depth = 0;
+        furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+        storage_worker_process(app, worker, message, true);
+        furi_check(furi_mutex_release(worker->mutex) == FuriStatusOk);
+    } else {
+        message->queue_depth = furi_semaphore_get_count(worker->pending);
+        StorageMessagePriority priority = storage_worker_get_priority(message);
+        furi_check(
+            furi_message_queue_put(worker->queue[priority], message, FuriWaitForever) ==
+            FuriStatusOk);
+        furi_check(furi_semaphore_release(worker->pending) == FuriStatusOk);
+    }
+
+    api_lock_wait_unlock_and_free(message->lock);
+
+    if(resolved_path) {
+        furi_string_free(resolved_path);
+    }
+}
+
+void storage_worker_get_stats(Storage* app, StorageType type, StorageWorkerStats* stats) {
+    furi_assert(type < STORAGE_COUNT);
+    StorageWorker* worker = &app->worker[type];
+    /* Internal storage worker doesn't exist in RAM exec builds */
+    furi_check(worker->mutex);
+    furi_check(furi_mutex_acquire(worker->mutex, FuriWaitForever) == FuriStatusOk);
+    *stats = worker->stats;
+    furi_check(furi_mutex_release(worker->mutex) == FuriStatusOk);
+}
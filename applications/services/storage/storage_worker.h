@@ -0,0 +1,71 @@
+#pragma once
+#include <furi.h>
+#include "storage_glue.h"
+#include "storage_sd_api.h"
+#include "storage_message.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Storage Storage;
+
+typedef void (*StorageWorkerTickCallback)(Storage* app);
+
+typedef enum {
+    StorageMessagePriorityHigh, /**< Short metadata requests: stat, seek, close, ... */
+    StorageMessagePriorityNormal, /**< Data transfer and tree-changing requests */
+    StorageMessagePriorityCount,
+} StorageMessagePriority;
+
+/** Queue depth seen by arriving request: 0, 1, 2, 3-4, 5-8, 9+ */
+#define STORAGE_WORKER_DEPTH_BUCKETS (6)
+
+/** Request latency, log2 scale starting at 64us: <64us ... >=4096us */
+#define STORAGE_WORKER_LATENCY_BUCKETS (8)
+#define STORAGE_WORKER_LATENCY_BASE_US (64)
+
+typedef struct {
+    uint32_t requests; /**< Requests processed, including fast path */
+    uint32_t fast_path_requests; /**< Requests processed in caller context */
+    uint32_t depth[STORAGE_WORKER_DEPTH_BUCKETS];
+    uint32_t latency[STORAGE_WORKER_LATENCY_BUCKETS];
+    uint32_t latency_max_us;
+} StorageWorkerStats;
+
+/** Per backing storage request processor */
+typedef struct {
+    FuriThread* thread; /**< NULL if worker runs on storage service thread */
+    FuriMessageQueue* queue[StorageMessagePriorityCount];
+    FuriSemaphore* pending; /**< Count of requests in all queues */
+    FuriMutex* mutex; /**< Owns StorageData, taken for every processed request */
+    StorageWorkerStats stats;
+} StorageWorker;
+
+/** Initialize worker queues and locks, does not start any thread */
+void storage_worker_init(StorageWorker* worker);
+
+/** Start dedicated thread for worker of given storage */
+void storage_worker_start(Storage* app, StorageType type);
+
+/** Run worker of given storage on current thread, never returns
+ *
+ * @param      app   Storage instance
+ * @param      type  storage to serve
+ * @param      tick  optional callback, invoked when worker is idle for a while
+ */
+void storage_worker_run(Storage* app, StorageType type, StorageWorkerTickCallback tick);
+
+/** Route message to worker of its backing storage and wait for completion
+ *
+ * Called in client context. Small reads from internal storage may be
+ * processed right here, without switching to worker thread.
+ */
+void storage_worker_send(Storage* app, StorageMessage* message);
+
+/** Get snapshot of worker statistics */
+void storage_worker_get_stats(Storage* app, StorageType type, StorageWorkerStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
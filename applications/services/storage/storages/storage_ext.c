@@ -46,7 +46,7 @@ static bool sd_mount_card_internal(StorageData* storage, bool notify) {
 
         if(bsp_result) {
             // bsp error
-            storage->status = StorageStatusErrorInternal;
+            storage_data_set_status(storage, StorageStatusErrorInternal);
         } else {
             SDError status = f_mount(sd_data->fs, sd_data->path, 1);
 
@@ -63,14 +63,14 @@ static bool sd_mount_card_internal(StorageData* storage, bool notify) {
                 }
 
                 if(status == FR_OK) {
-                    storage->status = StorageStatusOK;
+                    storage_data_set_status(storage, StorageStatusOK);
                 } else if(status == FR_NO_FILESYSTEM) {
-                    storage->status = StorageStatusNoFS;
+                    storage_data_set_status(storage, StorageStatusNoFS);
                 } else {
-                    storage->status = StorageStatusNotAccessible;
+                    storage_data_set_status(storage, StorageStatusNotAccessible);
                 }
             } else {
-                storage->status = StorageStatusNotMounted;
+                storage_data_set_status(storage, StorageStatusNotMounted);
             }
         }
 
@@ -97,7 +97,7 @@ FS_Error sd_unmount_card(StorageData* storage) {
     SDData* sd_data = storage->data;
     SDError error;
 
-    storage->status = StorageStatusNotReady;
+    storage_data_set_status(storage, StorageStatusNotReady);
     error = FR_DISK_ERR;
 
     // TODO FL-3522: do i need to close the files?
@@ -110,7 +110,7 @@ FS_Error sd_mount_card(StorageData* storage, bool notify) {
     sd_mount_card_internal(storage, notify);
     FS_Error error;
 
-    if(storage->status != StorageStatusOK) {
+    if(storage_data_status(storage) != StorageStatusOK) {
         FURI_LOG_E(TAG, "sd init error: %s", storage_data_status_text(storage));
         if(notify) {
             NotificationApp* notification = furi_record_open(RECORD_NOTIFICATION);
@@ -146,15 +146,15 @@ FS_Error sd_format_card(StorageData* storage) {
     free(work_area);
 
     do {
-        storage->status = StorageStatusNotAccessible;
+        storage_data_set_status(storage, StorageStatusNotAccessible);
         if(error != FR_OK) break;
-        storage->status = StorageStatusNoFS;
+        storage_data_set_status(storage, StorageStatusNoFS);
         error = f_setlabel("Flipper SD");
         if(error != FR_OK) break;
-        storage->status = StorageStatusNotMounted;
+        storage_data_set_status(storage, StorageStatusNotMounted);
         error = f_mount(sd_data->fs, sd_data->path, 1);
         if(error != FR_OK) break;
-        storage->status = StorageStatusOK;
+        storage_data_set_status(storage, StorageStatusOK);
     } while(false);
 
     return storage_ext_parse_error(error);
@@ -1,4 +1,5 @@
 #include "storage_int.h"
+#include "storage_int_profile.h"
 #include <lfs.h>
 #include <furi_hal.h>
 #include <toolbox/path.h>
@@ -11,11 +12,25 @@
  * modification of non-dot files is restricted */
 #define LFS_RESERVED_PAGES_COUNT 3
 
+/* Add STORAGE_INT_LFS_COMPACT to storage cdefines to trade speed for RAM */
+#ifdef STORAGE_INT_LFS_COMPACT
+static const StorageIntLfsProfile storage_int_lfs_profile = STORAGE_INT_LFS_PROFILE_COMPACT;
+#else
+static const StorageIntLfsProfile storage_int_lfs_profile = STORAGE_INT_LFS_PROFILE_PERFORMANCE;
+#endif
+
+#define LFS_BUFFER_ALIGNMENT 8
+
 typedef struct {
     const size_t start_address;
     const size_t start_page;
     struct lfs_config config;
     lfs_t lfs;
+    /* Upper bound of used blocks, negative if unknown.
+     * Every free block littlefs takes into use is erased first, so counting
+     * erases keeps the bound. Freed blocks are only noticed on recount. */
+    lfs_ssize_t used_blocks;
+    bool used_blocks_exact;
 } LFSData;
 
 typedef struct {
@@ -125,6 +140,12 @@ static int storage_int_device_erase(const struct lfs_config* c, lfs_block_t bloc
     FURI_LOG_D(TAG, "Device erase: page %lu, translated page: %zx", block, page);
 
     furi_hal_flash_erase(page);
+
+    if(lfs_data->used_blocks >= 0) {
+        /* Erased block may already be in use, e.g. metadata pair compaction */
+        lfs_data->used_blocks = MIN(lfs_data->used_blocks + 1, (lfs_ssize_t)c->block_count);
+        lfs_data->used_blocks_exact = false;
+    }
     return 0;
 }
 
@@ -156,8 +177,21 @@ static LFSData* storage_int_lfs_data_alloc() {
     lfs_data->config.block_size = furi_hal_flash_get_page_size();
     lfs_data->config.block_count = furi_hal_flash_get_free_page_count();
     lfs_data->config.block_cycles = furi_hal_flash_get_cycles_count();
-    lfs_data->config.cache_size = 16;
-    lfs_data->config.lookahead_size = 16;
+    lfs_data->config.cache_size = storage_int_lfs_profile.cache_size;
+    lfs_data->config.lookahead_size = storage_int_lfs_profile.lookahead_size;
+
+    // Read, prog and lookahead buffers live as long as the service, keep them in SRAM2 pool
+    size_t buffers_size = lfs_data->config.cache_size * 2 + lfs_data->config.lookahead_size;
+    uintptr_t buffers = (uintptr_t)memmgr_alloc_from_pool(buffers_size + LFS_BUFFER_ALIGNMENT);
+    buffers = (buffers + LFS_BUFFER_ALIGNMENT - 1) & ~(uintptr_t)(LFS_BUFFER_ALIGNMENT - 1);
+    lfs_data->config.lookahead_buffer = (void*)buffers;
+    buffers += lfs_data->config.lookahead_size;
+    lfs_data->config.read_buffer = (void*)buffers;
+    buffers += lfs_data->config.cache_size;
+    lfs_data->config.prog_buffer = (void*)buffers;
+
+    lfs_data->used_blocks = -1;
+    lfs_data->used_blocks_exact = false;
 
     return lfs_data;
 };
@@ -201,21 +235,21 @@ static void storage_int_lfs_mount(LFSData* lfs_data, StorageData* storage) {
             err = lfs_mount(lfs, &lfs_data->config);
             if(err == 0) {
                 FURI_LOG_I(TAG, "Factory reset: Mounted");
-                storage->status = StorageStatusOK;
+                storage_data_set_status(storage, StorageStatusOK);
             } else {
                 FURI_LOG_E(TAG, "Factory reset: Mount after format failed");
-                storage->status = StorageStatusNotMounted;
+                storage_data_set_status(storage, StorageStatusNotMounted);
             }
         } else {
             FURI_LOG_E(TAG, "Factory reset: Format failed");
-            storage->status = StorageStatusNoFS;
+            storage_data_set_status(storage, StorageStatusNoFS);
         }
     } else {
         // Normal
         err = lfs_mount(lfs, &lfs_data->config);
         if(err == 0) {
             FURI_LOG_I(TAG, "Mounted");
-            storage->status = StorageStatusOK;
+            storage_data_set_status(storage, StorageStatusOK);
         } else {
             FURI_LOG_E(TAG, "Mount failed, formatting");
             err = lfs_format(lfs, &lfs_data->config);
@@ -224,14 +258,14 @@ static void storage_int_lfs_mount(LFSData* lfs_data, StorageData* storage) {
                 err = lfs_mount(lfs, &lfs_data->config);
                 if(err == 0) {
                     FURI_LOG_I(TAG, "Mounted");
-                    storage->status = StorageStatusOK;
+                    storage_data_set_status(storage, StorageStatusOK);
                 } else {
                     FURI_LOG_E(TAG, "Mount after format failed");
-                    storage->status = StorageStatusNotMounted;
+                    storage_data_set_status(storage, StorageStatusNotMounted);
                 }
             } else {
                 FURI_LOG_E(TAG, "Format failed");
-                storage->status = StorageStatusNoFS;
+                storage_data_set_status(storage, StorageStatusNoFS);
             }
         }
     }
@@ -278,16 +312,46 @@ static FS_Error storage_int_parse_error(int error) {
     return result;
 }
 
+/* Blocks may have been freed: cached count is still an upper bound, but not exact */
+static void storage_int_used_blocks_invalidate(StorageData* storage) {
+    lfs_data_get_from_storage(storage)->used_blocks_exact = false;
+}
+
+/* Returns used block count or negative error code. Full traversal is done
+ * only if count is unknown or exact value is required and cache is stale. */
+static lfs_ssize_t storage_int_get_used_blocks(StorageData* storage, bool exact) {
+    LFSData* lfs_data = lfs_data_get_from_storage(storage);
+
+    if((lfs_data->used_blocks < 0) || (exact && !lfs_data->used_blocks_exact)) {
+        lfs_ssize_t result = lfs_fs_size(&lfs_data->lfs);
+        if(result < 0) {
+            return result;
+        }
+        lfs_data->used_blocks = result;
+        lfs_data->used_blocks_exact = true;
+    }
+
+    return lfs_data->used_blocks;
+}
+
+static bool storage_int_has_reserved_space(LFSData* lfs_data, lfs_ssize_t used_blocks) {
+    lfs_size_t free_space =
+        (lfs_data->config.block_count - used_blocks) * lfs_data->config.block_size;
+    return (free_space > LFS_RESERVED_PAGES_COUNT * furi_hal_flash_get_page_size());
+}
+
 /* Returns false if less than reserved space is left free */
 static bool storage_int_check_for_free_space(StorageData* storage) {
     LFSData* lfs_data = lfs_data_get_from_storage(storage);
 
-    lfs_ssize_t result = lfs_fs_size(lfs_get_from_storage(storage));
-    if(result >= 0) {
-        lfs_size_t free_space =
-            (lfs_data->config.block_count - result) * lfs_data->config.block_size;
+    // Estimate is pessimistic, recount only when it says that we are out of space
+    lfs_ssize_t result = storage_int_get_used_blocks(storage, false);
+    if((result >= 0) && !storage_int_has_reserved_space(lfs_data, result)) {
+        result = storage_int_get_used_blocks(storage, true);
+    }
 
-        return (free_space > LFS_RESERVED_PAGES_COUNT * furi_hal_flash_get_page_size());
+    if(result >= 0) {
+        return storage_int_has_reserved_space(lfs_data, result);
     }
 
     return false;
@@ -353,6 +417,10 @@ static bool storage_int_file_close(void* ctx, File* file) {
     LFSHandle* handle = storage_get_storage_file_data(file, storage);
 
     if(lfs_handle_is_open(handle)) {
+        // Rewritten file releases its old blocks on close
+        if(lfs_handle_get_file(handle)->flags & LFS_O_WRONLY) {
+            storage_int_used_blocks_invalidate(storage);
+        }
         file->internal_error_id = lfs_file_close(lfs, lfs_handle_get_file(handle));
     } else {
         file->internal_error_id = LFS_ERR_BADF;
@@ -469,6 +537,7 @@ static bool storage_int_file_truncate(void* ctx, File* file) {
             file->internal_error_id =
                 lfs_file_truncate(lfs, lfs_handle_get_file(handle), position);
             file->error_id = storage_int_parse_error(file->internal_error_id);
+            storage_int_used_blocks_invalidate(storage);
         }
     } else {
         file->internal_error_id = LFS_ERR_BADF;
@@ -653,6 +722,7 @@ static FS_Error storage_int_common_remove(void* ctx, const char* path) {
     StorageData* storage = ctx;
     lfs_t* lfs = lfs_get_from_storage(storage);
     int result = lfs_remove(lfs, path);
+    storage_int_used_blocks_invalidate(storage);
     return storage_int_parse_error(result);
 }
 
@@ -671,14 +741,13 @@ static FS_Error storage_int_common_fs_info(
     UNUSED(fs_path);
     StorageData* storage = ctx;
 
-    lfs_t* lfs = lfs_get_from_storage(storage);
     LFSData* lfs_data = lfs_data_get_from_storage(storage);
 
     if(total_space) {
         *total_space = lfs_data->config.block_size * lfs_data->config.block_count;
     }
 
-    lfs_ssize_t result = lfs_fs_size(lfs);
+    lfs_ssize_t result = storage_int_get_used_blocks(storage, true);
     if(free_space && (result >= 0)) {
         *free_space = (lfs_data->config.block_count - result) * lfs_data->config.block_size;
     }
@@ -722,13 +791,15 @@ void storage_int_init(StorageData* storage) {
     LFSData* lfs_data = storage_int_lfs_data_alloc();
     FURI_LOG_I(
         TAG,
-        "Config: start %p, read %lu, write %lu, page size: %lu, page count: %lu, cycles: %ld",
+        "Config: start %p, read %lu, write %lu, page size: %lu, page count: %lu, cycles: %ld, "
+        "profile: %s",
         (void*)lfs_data->start_address,
         lfs_data->config.read_size,
         lfs_data->config.prog_size,
         lfs_data->config.block_size,
         lfs_data->config.block_count,
-        lfs_data->config.block_cycles);
+        lfs_data->config.block_cycles,
+        storage_int_lfs_profile.name);
 
     storage_int_lfs_mount(lfs_data, storage);
 
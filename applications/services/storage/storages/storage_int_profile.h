@@ -0,0 +1,34 @@
+/**
+ * @file storage_int_profile.h
+ * Internal storage littlefs tuning profiles
+ *
+ * Plain C, shared by firmware and host side littlefs benchmark.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    const char* name;
+    /** Read and prog cache size, also allocated from heap for every opened file */
+    uint32_t cache_size;
+    /** Block allocator bitmap size, one byte tracks 8 blocks */
+    uint32_t lookahead_size;
+} StorageIntLfsProfile;
+
+/** Minimal RAM usage: metadata is walked in 16 byte steps */
+#define STORAGE_INT_LFS_PROFILE_COMPACT \
+    { .name = "compact", .cache_size = 16, .lookahead_size = 16 }
+
+/** Bigger caches: metadata blocks are walked in fewer, larger reads and
+ * lookahead window covers whole internal storage */
+#define STORAGE_INT_LFS_PROFILE_PERFORMANCE \
+    { .name = "performance", .cache_size = 256, .lookahead_size = 32 }
+
+#ifdef __cplusplus
+}
+#endif
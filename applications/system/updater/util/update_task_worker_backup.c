@@ -185,6 +185,7 @@ static bool update_task_post_update(UpdateTask* update_task) {
                 update_task_cleanup_resources(update_task, progress.total_files);
 
                 CHECK_RESULT(tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL));
+                tar_archive_log_stats(archive, "Resources");
             }
         }
 
@@ -143,9 +143,8 @@ static bool update_task_write_stack(UpdateTask* update_task) {
         FURI_LOG_W(TAG, "Writing stack");
         update_task_set_progress(update_task, UpdateTaskStageRadioImageValidate, 0);
         CHECK_RESULT(update_task_open_file(update_task, manifest->radio_image));
-        CHECK_RESULT(
-            crc32_calc_file(update_task->file, &update_task_file_progress, update_task) ==
-            manifest->radio_crc);
+        CHECK_RESULT(crc32_calc_file_check(
+            update_task->file, manifest->radio_crc, &update_task_file_progress, update_task));
 
         CHECK_RESULT(update_task_write_stack_data(update_task));
         update_task_set_progress(update_task, UpdateTaskStageRadioInstall, 10);
@@ -14,6 +14,15 @@ COMPACT = 0
 ## Optimize for debugging experience
 DEBUG = 1
 
+# Heap allocation policy: "first_fit" (FreeRTOS heap_4) or "tlsf"
+HEAP_ALLOCATOR = "first_fit"
+
+# Protocols built into firmware, all of them if empty. Names as in
+# lib/subghz/protocols/protocol_items.c and lib/infrared/encoder_decoder/infrared.c,
+# e.g. SUBGHZ_PROTOCOLS = ["raw", "princeton", "came", "bin_raw"]
+SUBGHZ_PROTOCOLS = []
+INFRARED_PROTOCOLS = []
+
 # Suffix to add to files when building distribution
 # If OS environment has DIST_SUFFIX set, it will be used instead
 DIST_SUFFIX = "local"
@@ -172,6 +172,14 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void *pckt)
 
 					break;
 
+				case HCI_LE_DATA_LENGTH_CHANGE_SUBEVT_CODE:
+					{
+						hci_le_data_length_change_event_rp0 *event =
+						(hci_le_data_length_change_event_rp0*) meta_evt->data;
+						FURI_LOG_I(TAG, "Data length TX %d, RX %d", event->MaxTxOctets, event->MaxRxOctets);
+						break;
+					}
+
 				case EVT_LE_CONN_COMPLETE:
 					{
 						hci_le_connection_complete_event_rp0 *event =
@@ -188,6 +196,12 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void *pckt)
 						gap->service.connection_handle = event->Connection_Handle;
 
 						gap_verify_connection_parameters(gap);
+						// Ask for longest link layer packets, so that one notification fits in one packet
+						ret = hci_le_set_data_length(event->Connection_Handle, 251, 2120);
+						if (ret)
+						{
+							FURI_LOG_W(TAG, "Set data length failed, status: %d", ret);
+						}
 						// Start pairing by sending security request
 						aci_gap_slave_security_req(event->Connection_Handle);
 					}
@@ -34,9 +34,9 @@ static const FlipperGattCharacteristicParams serial_svc_chars[SerialSvcGattChara
          .data.fixed.length = SERIAL_SVC_DATA_LEN_MAX,
          .uuid.Char_UUID_128 = SERIAL_SVC_TX_CHAR_UUID,
          .uuid_type = UUID_TYPE_128,
-         .char_properties = CHAR_PROP_READ | CHAR_PROP_INDICATE,
+         .char_properties = CHAR_PROP_READ | CHAR_PROP_INDICATE | CHAR_PROP_NOTIFY,
          .security_permissions = ATTR_PERMISSION_AUTHEN_READ,
-         .gatt_evt_mask = GATT_DONT_NOTIFY_EVENTS,
+         .gatt_evt_mask = GATT_NOTIFY_ATTRIBUTE_WRITE | GATT_NOTIFY_NOTIFICATION_COMPLETION,
          .is_variable = CHAR_VALUE_LEN_VARIABLE},
     [SerialSvcGattCharacteristicFlowCtrl] =
         {.name = "Flow control",
@@ -67,9 +67,34 @@ typedef struct {
     uint16_t bytes_ready_to_receive;
     SerialServiceEventCallback callback;
     void* context;
+    bool tx_notifications;
+    uint8_t tx_in_flight;
+    uint32_t tx_active_start;
 } SerialSvc;
 
 static SerialSvc* serial_svc = NULL;
+// Outlives service, so that statistics can be inspected after disconnect
+static SerialServiceTxStats serial_svc_tx_stats = {0};
+
+static void serial_svc_tx_complete() {
+    FURI_CRITICAL_ENTER();
+    if(serial_svc->tx_in_flight) {
+        serial_svc->tx_in_flight--;
+        if(!serial_svc->tx_in_flight) {
+            serial_svc_tx_stats.active_time += furi_get_tick() - serial_svc->tx_active_start;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+static void serial_svc_tx_notify_sent() {
+    if(serial_svc->callback) {
+        SerialServiceEvent event = {
+            .event = SerialServiceEventTypeDataSent,
+        };
+        serial_svc->callback(event, serial_svc->context);
+    }
+}
 
 static SVCCTL_EvtAckStatus_t serial_svc_event_handler(void* event) {
     SVCCTL_EvtAckStatus_t ret = SVCCTL_EvtNotAck;
@@ -112,6 +137,16 @@ static SVCCTL_EvtAckStatus_t serial_svc_event_handler(void* event) {
                     furi_check(furi_mutex_release(serial_svc->buff_size_mtx) == FuriStatusOk);
                 }
                 ret = SVCCTL_EvtAckFlowEnable;
+            } else if(
+                attribute_modified->Attr_Handle ==
+                serial_svc->chars[SerialSvcGattCharacteristicTx].handle + 2) {
+                // Client configuration descriptor: bit 0 notifications, bit 1 indications
+                serial_svc->tx_notifications = attribute_modified->Attr_Data[0] & 0x01;
+                FURI_LOG_D(
+                    TAG,
+                    "TX with %s",
+                    serial_svc->tx_notifications ? "notifications" : "indications");
+                ret = SVCCTL_EvtAckFlowEnable;
             } else if(
                 attribute_modified->Attr_Handle ==
                 serial_svc->chars[SerialSvcGattCharacteristicStatus].handle + 1) {
@@ -128,13 +163,22 @@ static SVCCTL_EvtAckStatus_t serial_svc_event_handler(void* event) {
             }
         } else if(blecore_evt->ecode == ACI_GATT_SERVER_CONFIRMATION_VSEVT_CODE) {
             FURI_LOG_T(TAG, "Ack received");
-            if(serial_svc->callback) {
-                SerialServiceEvent event = {
-                    .event = SerialServiceEventTypeDataSent,
-                };
-                serial_svc->callback(event, serial_svc->context);
-            }
+            serial_svc_tx_complete();
+            serial_svc_tx_notify_sent();
             ret = SVCCTL_EvtAckFlowEnable;
+        } else if(blecore_evt->ecode == ACI_GATT_NOTIFICATION_COMPLETE_VSEVT_CODE) {
+            aci_gatt_notification_complete_event_rp0* notification_complete =
+                (aci_gatt_notification_complete_event_rp0*)blecore_evt->data;
+            if(notification_complete->Attr_Handle ==
+               serial_svc->chars[SerialSvcGattCharacteristicTx].handle + 1) {
+                serial_svc_tx_complete();
+                serial_svc_tx_notify_sent();
+                ret = SVCCTL_EvtAckFlowEnable;
+            }
+        } else if(blecore_evt->ecode == ACI_GATT_TX_POOL_AVAILABLE_VSEVT_CODE) {
+            // Controller buffers freed after BLE_STATUS_INSUFFICIENT_RESOURCES, retry.
+            // Not acknowledged: other services may wait for it too.
+            serial_svc_tx_notify_sent();
         }
     }
     return ret;
@@ -175,8 +219,15 @@ void serial_svc_set_callbacks(
     SerialServiceEventCallback callback,
     void* context) {
     furi_assert(serial_svc);
+    FURI_CRITICAL_ENTER();
     serial_svc->callback = callback;
     serial_svc->context = context;
+    // New connection or disconnect: nothing is in flight anymore
+    if(!callback) {
+        serial_svc->tx_notifications = false;
+    }
+    serial_svc->tx_in_flight = 0;
+    FURI_CRITICAL_EXIT();
     serial_svc->buff_size = buff_size;
     serial_svc->bytes_ready_to_receive = buff_size;
 
@@ -227,9 +278,29 @@ bool serial_svc_is_started() {
     return serial_svc != NULL;
 }
 
-bool serial_svc_update_tx(uint8_t* data, uint16_t data_len) {
+SerialServiceTxStatus serial_svc_update_tx(uint8_t* data, uint16_t data_len) {
     if(data_len > SERIAL_SVC_DATA_LEN_MAX) {
-        return false;
+        return SerialServiceTxStatusError;
+    }
+
+    // Take credit before update: completion may come from BLE thread before we return
+    bool notifications = serial_svc->tx_notifications;
+    uint8_t window = notifications ? SERIAL_SVC_TX_WINDOW : 1;
+    bool has_credit = false;
+    FURI_CRITICAL_ENTER();
+    if(serial_svc->tx_in_flight < window) {
+        if(!serial_svc->tx_in_flight) {
+            serial_svc->tx_active_start = furi_get_tick();
+        }
+        serial_svc->tx_in_flight++;
+        has_credit = true;
+    } else {
+        serial_svc_tx_stats.busy++;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(!has_credit) {
+        return SerialServiceTxStatusBusy;
     }
 
     for(uint16_t remained = data_len; remained > 0;) {
@@ -241,19 +312,62 @@ bool serial_svc_update_tx(uint8_t* data, uint16_t data_len) {
             0,
             serial_svc->svc_handle,
             serial_svc->chars[SerialSvcGattCharacteristicTx].handle,
-            remained ? 0x00 : 0x02,
+            remained ? 0x00 : (notifications ? 0x01 : 0x02),
             data_len,
             value_offset,
             value_len,
             data + value_offset);
 
         if(result) {
+            FURI_CRITICAL_ENTER();
+            serial_svc->tx_in_flight--;
+            FURI_CRITICAL_EXIT();
+            if(result == BLE_STATUS_INSUFFICIENT_RESOURCES) {
+                // ACI_GATT_TX_POOL_AVAILABLE event follows when buffers are freed
+                FURI_CRITICAL_ENTER();
+                serial_svc_tx_stats.busy++;
+                FURI_CRITICAL_EXIT();
+                return SerialServiceTxStatusBusy;
+            }
             FURI_LOG_E(TAG, "Failed updating TX characteristic: %d", result);
-            return false;
+            return SerialServiceTxStatusError;
         }
     }
 
-    return true;
+    FURI_CRITICAL_ENTER();
+    serial_svc_tx_stats.packets++;
+    serial_svc_tx_stats.bytes += data_len;
+    serial_svc_tx_stats.in_flight_total += serial_svc->tx_in_flight;
+    serial_svc_tx_stats.in_flight_max =
+        MAX(serial_svc_tx_stats.in_flight_max, serial_svc->tx_in_flight);
+    FURI_CRITICAL_EXIT();
+
+    return SerialServiceTxStatusOk;
+}
+
+void serial_svc_get_tx_stats(SerialServiceTxStats* stats) {
+    furi_assert(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = serial_svc_tx_stats;
+    if(serial_svc) {
+        stats->notifications = serial_svc->tx_notifications;
+        stats->in_flight = serial_svc->tx_in_flight;
+        if(serial_svc->tx_in_flight) {
+            stats->active_time += furi_get_tick() - serial_svc->tx_active_start;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+    stats->window = stats->notifications ? SERIAL_SVC_TX_WINDOW : 1;
+}
+
+void serial_svc_reset_tx_stats() {
+    FURI_CRITICAL_ENTER();
+    serial_svc_tx_stats = (SerialServiceTxStats){0};
+    if(serial_svc && serial_svc->tx_in_flight) {
+        serial_svc->tx_active_start = furi_get_tick();
+    }
+    FURI_CRITICAL_EXIT();
 }
 
 void serial_svc_set_rpc_status(SerialServiceRpcStatus status) {
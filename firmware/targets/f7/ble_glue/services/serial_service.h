@@ -5,6 +5,8 @@
 
 #define SERIAL_SVC_DATA_LEN_MAX (486)
 #define SERIAL_SVC_CHAR_VALUE_LEN_MAX (243)
+/* Notifications queued at once, indications are always sent one by one */
+#define SERIAL_SVC_TX_WINDOW (8)
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +35,24 @@ typedef struct {
 
 typedef uint16_t (*SerialServiceEventCallback)(SerialServiceEvent event, void* context);
 
+typedef enum {
+    SerialServiceTxStatusOk, /**< Packet queued */
+    SerialServiceTxStatusBusy, /**< No TX credit, retry after SerialServiceEventTypeDataSent */
+    SerialServiceTxStatusError,
+} SerialServiceTxStatus;
+
+typedef struct {
+    bool notifications; /**< Client subscribed to notifications, TX is windowed */
+    uint8_t window; /**< Packets allowed in flight */
+    uint8_t in_flight; /**< Packets queued and not completed yet */
+    uint8_t in_flight_max; /**< Maximum of in_flight */
+    uint32_t in_flight_total; /**< Sum of in_flight after every queued packet */
+    uint32_t packets; /**< Packets queued */
+    uint32_t bytes; /**< Bytes queued */
+    uint32_t busy; /**< Packets deferred: window or controller buffers full */
+    uint32_t active_time; /**< Ticks with packets in flight */
+} SerialServiceTxStats;
+
 void serial_svc_start();
 
 void serial_svc_set_callbacks(
@@ -48,7 +68,11 @@ void serial_svc_stop();
 
 bool serial_svc_is_started();
 
-bool serial_svc_update_tx(uint8_t* data, uint16_t data_len);
+SerialServiceTxStatus serial_svc_update_tx(uint8_t* data, uint16_t data_len);
+
+void serial_svc_get_tx_stats(SerialServiceTxStats* stats);
+
+void serial_svc_reset_tx_stats();
 
 #ifdef __cplusplus
 }
@@ -7,6 +7,7 @@
 #include <furi_hal_version.h>
 #include <furi_hal_bt_hid.h>
 #include <furi_hal_bt_serial.h>
+#include <furi_hal_crc.h>
 #include <furi_hal_bus.c>
 #include <services/battery_service.h>
 #include <furi.h>
@@ -284,6 +285,8 @@ void furi_hal_bt_reinit() {
     furi_delay_ms(100);
     ble_glue_thread_stop();
 
+    // CRC unit is shared with hashing, keep it from being used while its bus is reset
+    furi_check(furi_hal_crc_acquire(FuriWaitForever));
     furi_hal_bus_disable(FuriHalBusHSEM);
     furi_hal_bus_disable(FuriHalBusIPCC);
     furi_hal_bus_disable(FuriHalBusAES2);
@@ -292,6 +295,7 @@ void furi_hal_bt_reinit() {
 
     FURI_LOG_I(TAG, "Start BT initialization");
     furi_hal_bt_init();
+    furi_hal_crc_release();
 
     furi_hal_bt_start_radio_stack();
 }
@@ -42,10 +42,30 @@ void furi_hal_bt_serial_set_rpc_status(FuriHalBtSerialRpcStatus status) {
 }
 
 bool furi_hal_bt_serial_tx(uint8_t* data, uint16_t size) {
+    return furi_hal_bt_serial_tx_queue(data, size) == FuriHalBtSerialTxStatusOk;
+}
+
+FuriHalBtSerialTxStatus furi_hal_bt_serial_tx_queue(uint8_t* data, uint16_t size) {
     if(size > FURI_HAL_BT_SERIAL_PACKET_SIZE_MAX) {
-        return false;
+        return FuriHalBtSerialTxStatusError;
+    }
+
+    SerialServiceTxStatus status = serial_svc_update_tx(data, size);
+    if(status == SerialServiceTxStatusOk) {
+        return FuriHalBtSerialTxStatusOk;
+    } else if(status == SerialServiceTxStatusBusy) {
+        return FuriHalBtSerialTxStatusBusy;
+    } else {
+        return FuriHalBtSerialTxStatusError;
     }
-    return serial_svc_update_tx(data, size);
+}
+
+void furi_hal_bt_serial_get_tx_stats(FuriHalBtSerialTxStats* stats) {
+    serial_svc_get_tx_stats(stats);
+}
+
+void furi_hal_bt_serial_reset_tx_stats() {
+    serial_svc_reset_tx_stats();
 }
 
 void furi_hal_bt_serial_stop() {
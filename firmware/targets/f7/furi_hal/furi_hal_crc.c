@@ -0,0 +1,62 @@
+#include <furi_hal_crc.h>
+#include <furi_hal_bus.h>
+#include <furi.h>
+
+#include <stm32wbxx_ll_crc.h>
+
+#define TAG "FuriHalCrc"
+
+static FuriMutex* furi_hal_crc_mutex = NULL;
+
+void furi_hal_crc_init() {
+    furi_hal_crc_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+}
+
+bool furi_hal_crc_acquire(uint32_t timeout) {
+    furi_assert(furi_hal_crc_mutex);
+
+    if(furi_mutex_acquire(furi_hal_crc_mutex, timeout) != FuriStatusOk) {
+        return false;
+    }
+
+    // Bus belongs to radio stack, enabled by furi_hal_bt_init: only registers are ours
+    furi_check(furi_hal_bus_is_enabled(FuriHalBusCRC));
+    LL_CRC_SetPolynomialSize(CRC, LL_CRC_POLYLENGTH_32B);
+    LL_CRC_SetPolynomialCoef(CRC, LL_CRC_DEFAULT_CRC32_POLY);
+    // Reflected CRC-32: bit order is reversed in every input byte and in result
+    LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_BYTE);
+    LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_BIT);
+
+    return true;
+}
+
+void furi_hal_crc_release() {
+    furi_check(furi_mutex_release(furi_hal_crc_mutex) == FuriStatusOk);
+}
+
+uint32_t furi_hal_crc_calc(uint32_t crc, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+
+    // Continue from previous value: it is inverted and stored reflected
+    LL_CRC_SetInitialData(CRC, __RBIT(~crc));
+    LL_CRC_ResetCRCCalculationUnit(CRC);
+
+    while(size && ((uintptr_t)bytes & (sizeof(uint32_t) - 1))) {
+        LL_CRC_FeedData8(CRC, *bytes++);
+        size--;
+    }
+
+    // Unit takes words MSB first, swap them to keep memory byte order
+    const uint32_t* words = (const uint32_t*)bytes;
+    while(size >= sizeof(uint32_t)) {
+        LL_CRC_FeedData32(CRC, __REV(*words++));
+        size -= sizeof(uint32_t);
+    }
+
+    bytes = (const uint8_t*)words;
+    while(size--) {
+        LL_CRC_FeedData8(CRC, *bytes++);
+    }
+
+    return ~LL_CRC_ReadData32(CRC);
+}
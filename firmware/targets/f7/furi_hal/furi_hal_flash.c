@@ -49,6 +49,10 @@ size_t furi_hal_flash_get_base() {
     return FLASH_BASE;
 }
 
+bool furi_hal_flash_contains_address(size_t address) {
+    return (address >= FLASH_BASE) && (address < (FLASH_BASE + FLASH_SIZE));
+}
+
 size_t furi_hal_flash_get_read_block_size() {
     return FURI_HAL_FLASH_READ_BLOCK;
 }
@@ -37,6 +37,14 @@ void furi_hal_flash_init();
  */
 size_t furi_hal_flash_get_base();
 
+/** Check if address belongs to internal flash
+ *
+ * @param      address  address to check
+ *
+ * @return     true if address is inside flash
+ */
+bool furi_hal_flash_contains_address(size_t address);
+
 /** Get flash read block size
  *
  * @return     size in bytes
@@ -16,6 +16,16 @@ typedef enum {
 /** Serial service callback type */
 typedef SerialServiceEventCallback FuriHalBtSerialCallback;
 
+/** Serial TX status */
+typedef enum {
+    FuriHalBtSerialTxStatusOk, /**< Packet queued */
+    FuriHalBtSerialTxStatusBusy, /**< No TX credit, retry after data sent event */
+    FuriHalBtSerialTxStatusError, /**< Packet is too big or was rejected by stack */
+} FuriHalBtSerialTxStatus;
+
+/** Serial TX statistics */
+typedef SerialServiceTxStats FuriHalBtSerialTxStats;
+
 /** Start Serial Profile
  */
 void furi_hal_bt_serial_start();
@@ -54,6 +64,30 @@ void furi_hal_bt_serial_notify_buffer_is_empty();
  */
 bool furi_hal_bt_serial_tx(uint8_t* data, uint16_t size);
 
+/** Queue data packet without waiting for previous ones to be delivered
+ *
+ * Up to SERIAL_SVC_TX_WINDOW packets are kept in flight if client subscribed
+ * to notifications, one if it uses indications. Data is copied, buffer can be
+ * reused right after return.
+ *
+ * @param data  data buffer
+ * @param size  data buffer size, no more than negotiated MTU - 3
+ *
+ * @return      FuriHalBtSerialTxStatusBusy if window or controller buffers
+ *              are full: retry after SerialServiceEventTypeDataSent event
+ */
+FuriHalBtSerialTxStatus furi_hal_bt_serial_tx_queue(uint8_t* data, uint16_t size);
+
+/** Get TX statistics, accumulated across connections
+ *
+ * @param stats  output
+ */
+void furi_hal_bt_serial_get_tx_stats(FuriHalBtSerialTxStats* stats);
+
+/** Reset TX statistics
+ */
+void furi_hal_bt_serial_reset_tx_stats();
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,48 @@
+/**
+ * @file furi_hal_crc.h
+ * CRC calculation unit HAL API
+ *
+ * Calculation unit is configured for CRC-32 (IEEE 802.3) and is shared
+ * between threads, so it must be acquired before use. Its bus clock is
+ * owned by radio stack HAL and enabled in furi_hal_bt_init.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initialize CRC subsystem */
+void furi_hal_crc_init();
+
+/** Acquire CRC calculation unit
+ *
+ * @param      timeout  in ticks, 0 to fail immediately if unit is busy
+ *
+ * @return     true if unit is acquired and ready
+ */
+bool furi_hal_crc_acquire(uint32_t timeout);
+
+/** Release CRC calculation unit */
+void furi_hal_crc_release();
+
+/** Calculate CRC-32 of data, unit must be acquired
+ *
+ * Same semantics as crc32_calc_buffer: start with 0, pass previous result
+ * to continue calculation over next chunk.
+ *
+ * @param      crc   CRC of preceding data
+ * @param      data  data pointer
+ * @param      size  data size in bytes
+ *
+ * @return     CRC of preceding data and given chunk
+ */
+uint32_t furi_hal_crc_calc(uint32_t crc, const void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
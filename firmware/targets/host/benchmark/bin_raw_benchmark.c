@@ -0,0 +1,298 @@
+/**
+ * @file bin_raw_benchmark.c
+ * Host build: BinRAW analyzer cost and output on captured signals
+ *
+ * RAW files carry no RSSI, so receiver is emulated: burst starts with the
+ * first sample and ends on silence longer than BIN_RAW_BENCHMARK_SILENCE_US,
+ * which is where BinRAW analyzes what it has collected. Reports time spent
+ * in feed and at the end of burst, and digest of everything BinRAW decoded,
+ * so output of two builds can be compared at a glance. With -o decoded
+ * signals are written out in .sub format for a full diff.
+ *
+ * Usage: bin_raw_benchmark [-r repeats] [-o output] file...
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <lib/subghz/protocols/bin_raw.h>
+#include <lib/toolbox/stream/stream.h>
+#include <storage_host.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#define TAG "BinRawBenchmark"
+
+#define BIN_RAW_BENCHMARK_REPEATS_DEFAULT (10U)
+#define BIN_RAW_BENCHMARK_INT_ROOT "build/host/int"
+#define BIN_RAW_BENCHMARK_SILENCE_US (20000)
+#define BIN_RAW_BENCHMARK_RSSI_SIGNAL (-30.0f)
+#define BIN_RAW_BENCHMARK_RSSI_NOISE (-100.0f)
+
+/* Signed durations, sign is level: same as RAW_Data in SubGhz files */
+typedef struct {
+    const char* name;
+    int32_t* samples;
+    size_t count;
+    size_t capacity;
+    SubGhzRadioPreset preset;
+} BinRawBenchmarkCapture;
+
+typedef struct {
+    BinRawBenchmarkCapture* capture;
+    FlipperFormat* serialized;
+    FuriString* line;
+    FILE* output;
+    uint32_t burst;
+    uint32_t decoded;
+    uint32_t digest;
+} BinRawBenchmarkContext;
+
+typedef struct {
+    uint64_t samples;
+    uint64_t feed_ns;
+    uint32_t bursts;
+    uint64_t analysis_ns;
+    uint64_t analysis_max_ns;
+} BinRawBenchmarkResult;
+
+static uint64_t bin_raw_benchmark_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static uint32_t bin_raw_benchmark_fnv1a(uint32_t digest, const char* data) {
+    while(*data) {
+        digest ^= (uint8_t)*data++;
+        digest *= 16777619UL;
+    }
+    return digest;
+}
+
+static bool
+    bin_raw_benchmark_load(FlipperFormat* flipper_format, BinRawBenchmarkCapture* capture) {
+    uint32_t count = 0;
+
+    if(!flipper_format_read_uint32(flipper_format, "Frequency", &capture->preset.frequency, 1) ||
+       !flipper_format_read_string(flipper_format, "Preset", capture->preset.name)) {
+        return false;
+    }
+
+    while(flipper_format_get_value_count(flipper_format, "RAW_Data", &count)) {
+        if(capture->count + count > capture->capacity) {
+            capture->capacity = MAX(capture->capacity * 2, capture->count + count);
+            capture->samples = realloc(capture->samples, capture->capacity * sizeof(int32_t));
+            furi_check(capture->samples);
+        }
+        if(!flipper_format_read_int32(
+               flipper_format, "RAW_Data", &capture->samples[capture->count], count)) {
+            return false;
+        }
+        capture->count += count;
+    }
+
+    return capture->count > 0;
+}
+
+static void bin_raw_benchmark_callback(SubGhzProtocolDecoderBase* decoder, void* context) {
+    BinRawBenchmarkContext* ctx = context;
+    ctx->decoded++;
+
+    // Everything that would be saved to file is compared, not only what is shown
+    subghz_protocol_decoder_bin_raw_serialize(decoder, ctx->serialized, &ctx->capture->preset);
+    Stream* stream = flipper_format_get_raw_stream(ctx->serialized);
+    stream_rewind(stream);
+
+    if(ctx->output) {
+        fprintf(ctx->output, "# %s burst %" PRIu32 "\n", ctx->capture->name, ctx->burst);
+    }
+    while(stream_read_line(stream, ctx->line)) {
+        const char* line = furi_string_get_cstr(ctx->line);
+        ctx->digest = bin_raw_benchmark_fnv1a(ctx->digest, line);
+        if(ctx->output) fputs(line, ctx->output);
+    }
+}
+
+static void bin_raw_benchmark_end_burst(
+    SubGhzProtocolDecoderBinRAW* decoder,
+    BinRawBenchmarkContext* ctx,
+    BinRawBenchmarkResult* result) {
+    // Analysis runs when signal is gone
+    uint64_t start = bin_raw_benchmark_now_ns();
+    subghz_protocol_decoder_bin_raw_data_input_rssi(decoder, BIN_RAW_BENCHMARK_RSSI_NOISE);
+    uint64_t time_ns = bin_raw_benchmark_now_ns() - start;
+
+    result->analysis_ns += time_ns;
+    result->analysis_max_ns = MAX(result->analysis_max_ns, time_ns);
+    result->bursts++;
+    ctx->burst++;
+}
+
+static void bin_raw_benchmark_run(
+    SubGhzProtocolDecoderBinRAW* decoder,
+    BinRawBenchmarkContext* ctx,
+    BinRawBenchmarkResult* result) {
+    const BinRawBenchmarkCapture* capture = ctx->capture;
+    ctx->burst = 0;
+
+    subghz_protocol_decoder_bin_raw_reset(decoder);
+    subghz_protocol_decoder_bin_raw_data_input_rssi(decoder, BIN_RAW_BENCHMARK_RSSI_NOISE);
+    subghz_protocol_decoder_bin_raw_data_input_rssi(decoder, BIN_RAW_BENCHMARK_RSSI_SIGNAL);
+
+    uint64_t feed_ns = 0;
+    size_t burst_start = 0;
+    for(size_t s = 0; s < capture->count; s++) {
+        int32_t sample = capture->samples[s];
+        bool is_last = (s == capture->count - 1);
+        if(sample < -BIN_RAW_BENCHMARK_SILENCE_US || is_last) {
+            uint64_t start = bin_raw_benchmark_now_ns();
+            for(size_t i = burst_start; i <= s; i++) {
+                int32_t duration = capture->samples[i];
+                subghz_protocol_decoder_bin_raw_feed(
+                    decoder, duration > 0, duration > 0 ? duration : -duration);
+            }
+            feed_ns += bin_raw_benchmark_now_ns() - start;
+            burst_start = s + 1;
+
+            bin_raw_benchmark_end_burst(decoder, ctx, result);
+            if(!is_last) {
+                subghz_protocol_decoder_bin_raw_data_input_rssi(
+                    decoder, BIN_RAW_BENCHMARK_RSSI_SIGNAL);
+            }
+        }
+    }
+
+    result->feed_ns += feed_ns;
+    result->samples += capture->count;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t repeats = BIN_RAW_BENCHMARK_REPEATS_DEFAULT;
+    const char* output_path = NULL;
+    int first_file = 1;
+
+    while(first_file + 1 < argc && argv[first_file][0] == '-') {
+        if(strcmp(argv[first_file], "-r") == 0) {
+            repeats = MAX(atoi(argv[first_file + 1]), 1);
+        } else if(strcmp(argv[first_file], "-o") == 0) {
+            output_path = argv[first_file + 1];
+        } else {
+            break;
+        }
+        first_file += 2;
+    }
+
+    if(first_file >= argc) {
+        fprintf(stderr, "Usage: %s [-r repeats] [-o output] file...\n", argv[0]);
+        return 1;
+    }
+
+    furi_init();
+    furi_hal_init();
+
+    // Host file system as is: SD card root is "/", files are opened by absolute path
+    StorageHostConfig config = {
+        .backend = StorageHostBackendPosix,
+        .ext_root = "/",
+        .int_root = BIN_RAW_BENCHMARK_INT_ROOT,
+    };
+    storage_host_start(&config);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    size_t files_count = argc - first_file;
+    BinRawBenchmarkCapture* captures = calloc(files_count, sizeof(BinRawBenchmarkCapture));
+    size_t captures_count = 0;
+
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    FuriString* file_type = furi_string_alloc();
+    FuriString* file_path = furi_string_alloc();
+    uint32_t version = 0;
+
+    for(int i = first_file; i < argc; i++) {
+        BinRawBenchmarkCapture* capture = &captures[captures_count];
+        capture->name = argv[i];
+        capture->preset.name = furi_string_alloc();
+
+        bool loaded = false;
+        char* real_path = realpath(argv[i], NULL);
+        furi_string_printf(file_path, "%s%s", STORAGE_EXT_PATH_PREFIX, real_path ? real_path : "");
+        free(real_path);
+
+        if(flipper_format_file_open_existing(flipper_format, furi_string_get_cstr(file_path)) &&
+           flipper_format_read_header(flipper_format, file_type, &version) &&
+           furi_string_equal(file_type, SUBGHZ_RAW_FILE_TYPE)) {
+            loaded = bin_raw_benchmark_load(flipper_format, capture);
+        }
+        flipper_format_file_close(flipper_format);
+
+        if(loaded) {
+            captures_count++;
+        } else {
+            FURI_LOG_W(TAG, "Skipping %s: not a SubGhz RAW capture", argv[i]);
+            furi_string_free(capture->preset.name);
+            free(capture->samples);
+            memset(capture, 0, sizeof(BinRawBenchmarkCapture));
+        }
+    }
+
+    furi_string_free(file_path);
+    furi_string_free(file_type);
+    flipper_format_free(flipper_format);
+
+    BinRawBenchmarkContext ctx = {
+        .serialized = flipper_format_string_alloc(),
+        .line = furi_string_alloc(),
+        .output = output_path ? fopen(output_path, "w") : NULL,
+        .digest = 2166136261UL,
+    };
+    if(output_path && !ctx.output) {
+        FURI_LOG_W(TAG, "Unable to open %s", output_path);
+    }
+
+    SubGhzProtocolDecoderBinRAW* decoder = subghz_protocol_bin_raw.decoder->alloc(NULL);
+    BinRawBenchmarkResult result = {0};
+
+    // First pass collects output, the rest only time
+    for(uint32_t r = 0; r < repeats; r++) {
+        subghz_protocol_decoder_base_set_decoder_callback(
+            (SubGhzProtocolDecoderBase*)decoder, r ? NULL : bin_raw_benchmark_callback, &ctx);
+        for(size_t c = 0; c < captures_count; c++) {
+            ctx.capture = &captures[c];
+            bin_raw_benchmark_run(decoder, &ctx, &result);
+        }
+    }
+
+    subghz_protocol_bin_raw.decoder->free(decoder);
+
+    double samples = result.samples ? (double)result.samples : 1.0;
+    double bursts = result.bursts ? (double)result.bursts : 1.0;
+    printf(
+        "%zu captures, %" PRIu32 " repeats, %" PRIu32 " bursts, %" PRIu32 " decoded\n",
+        captures_count,
+        repeats,
+        result.bursts / repeats,
+        ctx.decoded);
+    printf("feed:     %10.1f ns/sample\n", (double)result.feed_ns / samples);
+    printf(
+        "analysis: %10.1f us/burst, %.1f us max\n",
+        (double)result.analysis_ns / bursts / 1000.0,
+        (double)result.analysis_max_ns / 1000.0);
+    printf("digest:   %08" PRIx32 "\n", ctx.digest);
+
+    if(ctx.output) fclose(ctx.output);
+    furi_string_free(ctx.line);
+    flipper_format_free(ctx.serialized);
+
+    for(size_t i = 0; i < captures_count; i++) {
+        furi_string_free(captures[i].preset.name);
+        free(captures[i].samples);
+    }
+    free(captures);
+
+    furi_record_close(RECORD_STORAGE);
+
+    return 0;
+}
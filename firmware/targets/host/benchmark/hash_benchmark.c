@@ -0,0 +1,232 @@
+/**
+ * @file hash_benchmark.c
+ * Host build: toolbox hash throughput
+ *
+ * Feeds buffers of file hashing chunk sizes through the Hash API and
+ * compares CRC-32 with the nibble table implementation it replaced. Then
+ * hashes a file on RAM backed storage through the Storage API, the way
+ * update validation and md5sum do.
+ *
+ * Usage: hash_benchmark [-s megabytes]
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage_host.h>
+#include <toolbox/crc32_calc.h>
+#include <toolbox/hash/hash.h>
+#include <toolbox/md5_calc.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#define HASH_BENCHMARK_SIZE_DEFAULT (64U)
+#define HASH_BENCHMARK_FILE_SIZE (1024U * 1024U)
+#define HASH_BENCHMARK_FILE_CHUNK (4096U)
+#define HASH_BENCHMARK_SD_SIZE (16U * 1024U * 1024U)
+#define HASH_BENCHMARK_FILE_PATH EXT_PATH("hash_benchmark.bin")
+
+typedef struct {
+    const char* name;
+    HashType type;
+    bool is_nibble;
+} HashBenchmarkHash;
+
+static const HashBenchmarkHash hash_benchmark_hashes[] = {
+    {.name = "crc32 nibble", .type = HashTypeCrc32, .is_nibble = true},
+    {.name = "crc32", .type = HashTypeCrc32},
+    {.name = "md5", .type = HashTypeMd5},
+    {.name = "sha256", .type = HashTypeSha256},
+};
+
+static const size_t hash_benchmark_chunks[] = {64, 512, 4096};
+
+static uint64_t hash_benchmark_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/* Previous implementation: littlefs lfs_crc, 4 bits per step */
+static uint32_t hash_benchmark_crc32_nibble(uint32_t crc, const void* buffer, size_t size) {
+    static const uint32_t rtable[16] = {
+        0x00000000,
+        0x1db71064,
+        0x3b6e20c8,
+        0x26d930ac,
+        0x76dc4190,
+        0x6b6b51f4,
+        0x4db26158,
+        0x5005713c,
+        0xedb88320,
+        0xf00f9344,
+        0xd6d6a3e8,
+        0xcb61b38c,
+        0x9b64c2b0,
+        0x86d3d2d4,
+        0xa00ae278,
+        0xbdbdf21c,
+    };
+
+    const uint8_t* data = buffer;
+    crc = ~crc;
+    for(size_t i = 0; i < size; i++) {
+        crc = (crc >> 4) ^ rtable[(crc ^ (data[i] >> 0)) & 0xf];
+        crc = (crc >> 4) ^ rtable[(crc ^ (data[i] >> 4)) & 0xf];
+    }
+    return ~crc;
+}
+
+static bool hash_benchmark_self_test(void) {
+    static const char check[] = "123456789";
+    const uint32_t expected = 0xcbf43926;
+
+    Hash* hash = hash_alloc(HashTypeCrc32);
+    hash_update(hash, check, 5);
+    hash_update(hash, check + 5, 4);
+    uint32_t split = hash_get_crc32(hash);
+    hash_free(hash);
+
+    uint32_t nibble = hash_benchmark_crc32_nibble(0, check, 9);
+    uint32_t buffer = crc32_calc_buffer(0, check, 9);
+    if(nibble != expected || buffer != expected || split != expected) {
+        fprintf(
+            stderr,
+            "CRC self test failed: %08" PRIx32 " %08" PRIx32 " %08" PRIx32 "\n",
+            nibble,
+            buffer,
+            split);
+        return false;
+    }
+    return true;
+}
+
+static double hash_benchmark_run(
+    const HashBenchmarkHash* benchmark,
+    const uint8_t* data,
+    size_t chunk,
+    size_t total) {
+    Hash* hash = hash_alloc(benchmark->type);
+    uint32_t crc = 0;
+
+    uint64_t start = hash_benchmark_now_ns();
+    for(size_t done = 0; done < total; done += chunk) {
+        if(benchmark->is_nibble) {
+            crc = hash_benchmark_crc32_nibble(crc, data, chunk);
+        } else {
+            hash_update(hash, data, chunk);
+        }
+    }
+    uint64_t elapsed = hash_benchmark_now_ns() - start;
+
+    hash_free(hash);
+    return elapsed ? (double)total / elapsed * 1000.0 : 0.0;
+}
+
+static bool hash_benchmark_prepare_file(Storage* storage, const uint8_t* data, uint32_t* crc) {
+    File* file = storage_file_alloc(storage);
+    bool success =
+        storage_file_open(file, HASH_BENCHMARK_FILE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+
+    *crc = 0;
+    for(size_t done = 0; success && (done < HASH_BENCHMARK_FILE_SIZE);
+        done += HASH_BENCHMARK_FILE_CHUNK) {
+        success = storage_file_write(file, data, HASH_BENCHMARK_FILE_CHUNK) ==
+                  HASH_BENCHMARK_FILE_CHUNK;
+        *crc = crc32_calc_buffer(*crc, data, HASH_BENCHMARK_FILE_CHUNK);
+    }
+
+    success = storage_file_close(file) && success;
+    storage_file_free(file);
+    return success;
+}
+
+static bool hash_benchmark_file(Storage* storage, const uint8_t* data) {
+    uint32_t crc;
+    if(!hash_benchmark_prepare_file(storage, data, &crc)) {
+        fprintf(stderr, "Can't write %s\n", HASH_BENCHMARK_FILE_PATH);
+        return false;
+    }
+
+    File* file = storage_file_alloc(storage);
+    uint8_t digest[16];
+    bool success = true;
+
+    uint64_t start = hash_benchmark_now_ns();
+    if(storage_file_open(file, HASH_BENCHMARK_FILE_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        success = crc32_calc_file_check(file, crc, NULL, NULL);
+    } else {
+        success = false;
+    }
+    storage_file_close(file);
+    uint64_t crc_time = hash_benchmark_now_ns() - start;
+
+    start = hash_benchmark_now_ns();
+    success = md5_calc_file(file, HASH_BENCHMARK_FILE_PATH, digest, NULL) && success;
+    uint64_t md5_time = hash_benchmark_now_ns() - start;
+
+    printf(
+        "\nFile %u KiB through Storage API: crc32 %.1f MB/s, md5 %.1f MB/s%s\n",
+        HASH_BENCHMARK_FILE_SIZE / 1024,
+        crc_time ? HASH_BENCHMARK_FILE_SIZE * 1000.0 / crc_time : 0.0,
+        md5_time ? HASH_BENCHMARK_FILE_SIZE * 1000.0 / md5_time : 0.0,
+        success ? "" : ", FAILED");
+
+    storage_file_free(file);
+    storage_simply_remove(storage, HASH_BENCHMARK_FILE_PATH);
+    return success;
+}
+
+int main(int argc, char* argv[]) {
+    size_t total = HASH_BENCHMARK_SIZE_DEFAULT;
+
+    for(int i = 1; i < argc; i++) {
+        bool has_value = (i + 1 < argc);
+        if(has_value && strcmp(argv[i], "-s") == 0) {
+            total = MAX(atoi(argv[++i]), 1);
+        } else {
+            fprintf(stderr, "Usage: %s [-s megabytes]\n", argv[0]);
+            return 1;
+        }
+    }
+    total *= 1024 * 1024;
+
+    furi_init();
+    furi_hal_init();
+
+    if(!hash_benchmark_self_test()) {
+        return 1;
+    }
+
+    uint8_t* data = malloc(HASH_BENCHMARK_FILE_CHUNK);
+    for(size_t i = 0; i < HASH_BENCHMARK_FILE_CHUNK; i++) {
+        data[i] = i * 13 + 5;
+    }
+
+    printf("%-14s", "MB/s");
+    for(size_t c = 0; c < COUNT_OF(hash_benchmark_chunks); c++) {
+        printf("%10zu", hash_benchmark_chunks[c]);
+    }
+    printf("\n");
+
+    for(size_t h = 0; h < COUNT_OF(hash_benchmark_hashes); h++) {
+        printf("%-14s", hash_benchmark_hashes[h].name);
+        for(size_t c = 0; c < COUNT_OF(hash_benchmark_chunks); c++) {
+            printf(
+                "%10.1f",
+                hash_benchmark_run(
+                    &hash_benchmark_hashes[h], data, hash_benchmark_chunks[c], total));
+        }
+        printf("\n");
+    }
+
+    StorageHostConfig config = {
+        .backend = StorageHostBackendRam,
+        .sd_size = HASH_BENCHMARK_SD_SIZE,
+    };
+    Storage* storage = storage_host_start(&config);
+    bool success = hash_benchmark_file(storage, data);
+
+    free(data);
+    return success ? 0 : 1;
+}
@@ -0,0 +1,464 @@
+/**
+ * @file heap_benchmark.c
+ * Host build: heap allocation policies latency and fragmentation
+ *
+ * Replays one allocation trace against every heap allocation policy, each
+ * managing region of device heap size, and reports allocation and release
+ * latency percentiles, failed allocations and fragmentation of free memory.
+ *
+ * Trace is either synthetic firmware-like workload: services that live
+ * forever, applications that come and go with their working set, short
+ * lived strings, capture history and temporary buffers; or heap trace
+ * printed by firmware built with HEAP_PRINT_DEBUG:
+ *   {thread|m|0xaddress|size}
+ *   {thread|f|0xaddress}
+ *
+ * Usage: heap_benchmark [-t trace] [-w trace] [-s heap_size] [-n sessions] [-r seed]
+ */
+#include <furi.h>
+#include <core/memmgr_heap_allocator.h>
+
+#include <m-array.h>
+#include <m-dict.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HEAP_BENCHMARK_HEAP_SIZE_DEFAULT (160U * 1024U)
+#define HEAP_BENCHMARK_HEAP_SIZE_MAX (256 * 1024)
+#define HEAP_BENCHMARK_SESSIONS_DEFAULT (20U)
+#define HEAP_BENCHMARK_SESSION_STEPS (2000U)
+#define HEAP_BENCHMARK_SAMPLE_INTERVAL (64U)
+#define HEAP_BENCHMARK_FREE (0U)
+
+typedef struct {
+    uint32_t id; /**< Allocation this operation belongs to */
+    uint32_t size; /**< Requested size, HEAP_BENCHMARK_FREE for release */
+} HeapBenchmarkOp;
+
+ARRAY_DEF(HeapBenchmarkOpArray, HeapBenchmarkOp, M_POD_OPLIST)
+ARRAY_DEF(HeapBenchmarkIdArray, uint32_t, M_DEFAULT_OPLIST)
+DICT_DEF2(HeapBenchmarkAddressDict, uint64_t, M_DEFAULT_OPLIST, uint32_t, M_DEFAULT_OPLIST)
+
+typedef struct {
+    HeapBenchmarkOpArray_t ops;
+    uint32_t ids;
+    size_t live_bytes;
+    size_t live_peak;
+} HeapBenchmarkTrace;
+
+typedef struct {
+    uint32_t id;
+    uint32_t deadline;
+} HeapBenchmarkPending;
+
+ARRAY_DEF(HeapBenchmarkPendingArray, HeapBenchmarkPending, M_POD_OPLIST)
+
+typedef struct {
+    HeapBenchmarkTrace* trace;
+    uint32_t seed;
+    uint32_t step;
+    uint32_t* sizes; /**< Live allocation sizes by id, for peak accounting */
+    size_t sizes_count;
+} HeapBenchmarkGenerator;
+
+static uint64_t heap_benchmark_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void heap_benchmark_trace_alloc(HeapBenchmarkTrace* trace, uint32_t id, uint32_t size) {
+    HeapBenchmarkOp op = {.id = id, .size = size};
+    HeapBenchmarkOpArray_push_back(trace->ops, op);
+    trace->live_bytes += size;
+    trace->live_peak = MAX(trace->live_peak, trace->live_bytes);
+}
+
+static void heap_benchmark_trace_free(HeapBenchmarkTrace* trace, uint32_t id, uint32_t size) {
+    HeapBenchmarkOp op = {.id = id, .size = HEAP_BENCHMARK_FREE};
+    HeapBenchmarkOpArray_push_back(trace->ops, op);
+    trace->live_bytes -= size;
+}
+
+/* xorshift32: same trace on every host */
+static uint32_t
+    heap_benchmark_random(HeapBenchmarkGenerator* generator, uint32_t min, uint32_t max) {
+    uint32_t x = generator->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    generator->seed = x;
+    return min + x % (max - min + 1);
+}
+
+static uint32_t heap_benchmark_alloc(HeapBenchmarkGenerator* generator, uint32_t size) {
+    HeapBenchmarkTrace* trace = generator->trace;
+    uint32_t id = trace->ids++;
+    if(id >= generator->sizes_count) {
+        generator->sizes_count = MAX(generator->sizes_count * 2, 1024U);
+        generator->sizes = realloc(generator->sizes, generator->sizes_count * sizeof(uint32_t));
+    }
+    generator->sizes[id] = size;
+    heap_benchmark_trace_alloc(trace, id, size);
+    return id;
+}
+
+static void heap_benchmark_free(HeapBenchmarkGenerator* generator, uint32_t id) {
+    heap_benchmark_trace_free(generator->trace, id, generator->sizes[id]);
+}
+
+static void
+    heap_benchmark_free_all(HeapBenchmarkGenerator* generator, HeapBenchmarkIdArray_t ids) {
+    HeapBenchmarkIdArray_it_t it;
+    for(HeapBenchmarkIdArray_it(it, ids); !HeapBenchmarkIdArray_end_p(it);
+        HeapBenchmarkIdArray_next(it)) {
+        heap_benchmark_free(generator, *HeapBenchmarkIdArray_cref(it));
+    }
+    HeapBenchmarkIdArray_reset(ids);
+}
+
+static void heap_benchmark_schedule(
+    HeapBenchmarkGenerator* generator,
+    HeapBenchmarkPendingArray_t pending,
+    uint32_t size,
+    uint32_t lifetime) {
+    HeapBenchmarkPending entry = {
+        .id = heap_benchmark_alloc(generator, size),
+        .deadline = generator->step + lifetime,
+    };
+    HeapBenchmarkPendingArray_push_back(pending, entry);
+}
+
+/* Release scheduled allocations whose time has come, or all of them */
+static void heap_benchmark_expire(
+    HeapBenchmarkGenerator* generator,
+    HeapBenchmarkPendingArray_t pending,
+    bool all) {
+    size_t i = 0;
+    while(i < HeapBenchmarkPendingArray_size(pending)) {
+        const HeapBenchmarkPending* entry = HeapBenchmarkPendingArray_cget(pending, i);
+        if(all || entry->deadline <= generator->step) {
+            HeapBenchmarkPending expired;
+            HeapBenchmarkPendingArray_pop_at(&expired, pending, i);
+            heap_benchmark_free(generator, expired.id);
+        } else {
+            i++;
+        }
+    }
+}
+
+static void heap_benchmark_generate(HeapBenchmarkTrace* trace, uint32_t sessions, uint32_t seed) {
+    HeapBenchmarkGenerator generator = {
+        .trace = trace,
+        .seed = seed ? seed : 1,
+    };
+
+    HeapBenchmarkIdArray_t system, app, history;
+    HeapBenchmarkPendingArray_t temporary, services;
+    HeapBenchmarkIdArray_init(system);
+    HeapBenchmarkIdArray_init(app);
+    HeapBenchmarkIdArray_init(history);
+    HeapBenchmarkPendingArray_init(temporary);
+    HeapBenchmarkPendingArray_init(services);
+
+    // Services and their thread stacks stay for good
+    for(size_t i = 0; i < 40; i++) {
+        uint32_t id = heap_benchmark_alloc(&generator, heap_benchmark_random(&generator, 32, 768));
+        HeapBenchmarkIdArray_push_back(system, id);
+    }
+    for(size_t i = 0; i < 8; i++) {
+        uint32_t id =
+            heap_benchmark_alloc(&generator, heap_benchmark_random(&generator, 1, 4) * 1024);
+        HeapBenchmarkIdArray_push_back(system, id);
+    }
+
+    for(uint32_t session = 0; session < sessions; session++) {
+        // Application start: thread stack, views, models and buffers
+        HeapBenchmarkIdArray_push_back(
+            app, heap_benchmark_alloc(&generator, heap_benchmark_random(&generator, 2, 4) * 1024));
+        uint32_t working_set = heap_benchmark_random(&generator, 10, 40);
+        for(uint32_t i = 0; i < working_set; i++) {
+            uint32_t size = heap_benchmark_random(&generator, 0, 7) ?
+                                heap_benchmark_random(&generator, 24, 512) :
+                                heap_benchmark_random(&generator, 1024, 6 * 1024);
+            HeapBenchmarkIdArray_push_back(app, heap_benchmark_alloc(&generator, size));
+        }
+        uint32_t history_limit = heap_benchmark_random(&generator, 20, 80);
+
+        for(uint32_t step = 0; step < HEAP_BENCHMARK_SESSION_STEPS; step++) {
+            generator.step++;
+            heap_benchmark_expire(&generator, temporary, false);
+            heap_benchmark_expire(&generator, services, false);
+
+            uint32_t dice = heap_benchmark_random(&generator, 0, 99);
+            if(dice < 55) {
+                // Strings and container nodes
+                heap_benchmark_schedule(
+                    &generator,
+                    temporary,
+                    heap_benchmark_random(&generator, 16, 160),
+                    heap_benchmark_random(&generator, 0, 8));
+            } else if(dice < 80) {
+                // Capture history: kept up to the limit, oldest dropped
+                uint32_t id =
+                    heap_benchmark_alloc(&generator, heap_benchmark_random(&generator, 48, 512));
+                HeapBenchmarkIdArray_push_back(history, id);
+                if(HeapBenchmarkIdArray_size(history) > history_limit) {
+                    HeapBenchmarkIdArray_pop_at(&id, history, 0);
+                    heap_benchmark_free(&generator, id);
+                }
+            } else if(dice < 95) {
+                // Temporary file and protocol buffers
+                heap_benchmark_schedule(
+                    &generator,
+                    temporary,
+                    heap_benchmark_random(&generator, 256, 4096),
+                    heap_benchmark_random(&generator, 1, 50));
+            } else {
+                // Service allocations that outlive applications
+                heap_benchmark_schedule(
+                    &generator,
+                    services,
+                    heap_benchmark_random(&generator, 32, 512),
+                    heap_benchmark_random(&generator, 100, 2000));
+            }
+        }
+
+        // Application exit
+        heap_benchmark_expire(&generator, temporary, true);
+        heap_benchmark_free_all(&generator, history);
+        heap_benchmark_free_all(&generator, app);
+    }
+
+    heap_benchmark_expire(&generator, services, true);
+    heap_benchmark_free_all(&generator, system);
+
+    HeapBenchmarkIdArray_clear(system);
+    HeapBenchmarkIdArray_clear(app);
+    HeapBenchmarkIdArray_clear(history);
+    HeapBenchmarkPendingArray_clear(temporary);
+    HeapBenchmarkPendingArray_clear(services);
+    free(generator.sizes);
+}
+
+static bool heap_benchmark_load(HeapBenchmarkTrace* trace, const char* path) {
+    FILE* file = fopen(path, "r");
+    if(!file) return false;
+
+    // Addresses are reused after release: map live ones to allocation ids
+    HeapBenchmarkAddressDict_t live;
+    HeapBenchmarkAddressDict_init(live);
+    HeapBenchmarkIdArray_t sizes;
+    HeapBenchmarkIdArray_init(sizes);
+
+    char line[256];
+    while(fgets(line, sizeof(line), file)) {
+        uint64_t address;
+        uint32_t size;
+        const char* op = strchr(line, '|');
+        if(!op) continue;
+
+        if(sscanf(op, "|m|0x%" SCNx64 "|%" SCNu32 "}", &address, &size) == 2) {
+            if(!address || !size) continue;
+            HeapBenchmarkAddressDict_set_at(live, address, trace->ids);
+            HeapBenchmarkIdArray_push_back(sizes, size);
+            heap_benchmark_trace_alloc(trace, trace->ids++, size);
+        } else if(sscanf(op, "|f|0x%" SCNx64 "}", &address) == 1) {
+            uint32_t* id = HeapBenchmarkAddressDict_get(live, address);
+            // Memory allocated before tracing started
+            if(!id) continue;
+            heap_benchmark_trace_free(trace, *id, *HeapBenchmarkIdArray_get(sizes, *id));
+            HeapBenchmarkAddressDict_erase(live, address);
+        }
+    }
+
+    HeapBenchmarkAddressDict_clear(live);
+    HeapBenchmarkIdArray_clear(sizes);
+    fclose(file);
+
+    return true;
+}
+
+static bool heap_benchmark_save(HeapBenchmarkTrace* trace, const char* path) {
+    FILE* file = fopen(path, "w");
+    if(!file) return false;
+
+    // Allocation ids stand for addresses, unique while allocation is live
+    HeapBenchmarkOpArray_it_t it;
+    for(HeapBenchmarkOpArray_it(it, trace->ops); !HeapBenchmarkOpArray_end_p(it);
+        HeapBenchmarkOpArray_next(it)) {
+        const HeapBenchmarkOp* op = HeapBenchmarkOpArray_cref(it);
+        if(op->size == HEAP_BENCHMARK_FREE) {
+            fprintf(file, "{benchmark|f|0x%" PRIx32 "}\n", op->id + 1);
+        } else {
+            fprintf(file, "{benchmark|m|0x%" PRIx32 "|%" PRIu32 "}\n", op->id + 1, op->size);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+static int heap_benchmark_compare(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void heap_benchmark_print_latency(const char* name, uint32_t* latency, size_t count) {
+    static const uint32_t permille[] = {500, 900, 990, 999};
+
+    printf("  %-6s", name);
+    if(!count) {
+        printf(" no operations\n");
+        return;
+    }
+
+    qsort(latency, count, sizeof(uint32_t), heap_benchmark_compare);
+    for(size_t i = 0; i < COUNT_OF(permille); i++) {
+        printf(" %8" PRIu32, latency[(count - 1) * permille[i] / 1000]);
+    }
+    printf(" %8" PRIu32 "\n", latency[count - 1]);
+}
+
+static void heap_benchmark_run(
+    const MemmgrHeapAllocator* allocator,
+    HeapBenchmarkTrace* trace,
+    size_t heap_size) {
+    size_t ops_count = HeapBenchmarkOpArray_size(trace->ops);
+    uint8_t* region = malloc(heap_size);
+    void** pointers = calloc(MAX(trace->ids, 1U), sizeof(void*));
+    uint32_t* alloc_latency = malloc(MAX(ops_count, 1U) * sizeof(uint32_t));
+    uint32_t* free_latency = malloc(MAX(ops_count, 1U) * sizeof(uint32_t));
+    size_t alloc_count = 0, free_count = 0, failed = 0;
+
+    void* heap = allocator->init(region, heap_size);
+    size_t free_initial = allocator->get_free(heap);
+    size_t free_min = free_initial;
+    size_t largest_min = allocator->get_max_free_block(heap);
+    double fragmentation_sum = 0, fragmentation_max = 0;
+    size_t samples = 0;
+
+    for(size_t i = 0; i < ops_count; i++) {
+        const HeapBenchmarkOp* op = HeapBenchmarkOpArray_cget(trace->ops, i);
+        if(op->size != HEAP_BENCHMARK_FREE) {
+            uint64_t start = heap_benchmark_now_ns();
+            void* pointer = allocator->alloc(heap, op->size);
+            alloc_latency[alloc_count++] = heap_benchmark_now_ns() - start;
+            if(pointer) {
+                memset(pointer, 0xA5, MIN(op->size, 16U));
+            } else {
+                failed++;
+            }
+            pointers[op->id] = pointer;
+        } else if(pointers[op->id]) {
+            uint64_t start = heap_benchmark_now_ns();
+            allocator->free(heap, pointers[op->id]);
+            free_latency[free_count++] = heap_benchmark_now_ns() - start;
+            pointers[op->id] = NULL;
+        }
+
+        // Fragmentation: free memory not available as one block
+        if(i % HEAP_BENCHMARK_SAMPLE_INTERVAL == 0) {
+            size_t free_bytes = allocator->get_free(heap);
+            size_t largest = allocator->get_max_free_block(heap);
+            double fragmentation = free_bytes ? 1.0 - (double)largest / free_bytes : 0;
+            free_min = MIN(free_min, free_bytes);
+            largest_min = MIN(largest_min, largest);
+            fragmentation_sum += fragmentation;
+            fragmentation_max = MAX(fragmentation_max, fragmentation);
+            samples++;
+        }
+    }
+
+    printf("%s\n", allocator->name);
+    printf("  ns         p50      p90      p99    p99.9      max\n");
+    heap_benchmark_print_latency("alloc", alloc_latency, alloc_count);
+    heap_benchmark_print_latency("free", free_latency, free_count);
+    printf(
+        "  failed allocations: %zu, free: %zu initial, %zu minimum, %zu at the end\n",
+        failed,
+        free_initial,
+        free_min,
+        allocator->get_free(heap));
+    printf(
+        "  largest free block: %zu minimum, fragmentation: %.1f%% average, %.1f%% worst\n",
+        largest_min,
+        samples ? fragmentation_sum * 100 / samples : 0,
+        fragmentation_max * 100);
+
+    free(free_latency);
+    free(alloc_latency);
+    free(pointers);
+    free(region);
+}
+
+int main(int argc, char* argv[]) {
+    const char* trace_path = NULL;
+    const char* save_path = NULL;
+    size_t heap_size = HEAP_BENCHMARK_HEAP_SIZE_DEFAULT;
+    uint32_t sessions = HEAP_BENCHMARK_SESSIONS_DEFAULT;
+    uint32_t seed = 1;
+
+    for(int i = 1; i < argc; i++) {
+        bool has_value = (i + 1 < argc);
+        if(has_value && strcmp(argv[i], "-t") == 0) {
+            trace_path = argv[++i];
+        } else if(has_value && strcmp(argv[i], "-w") == 0) {
+            save_path = argv[++i];
+        } else if(has_value && strcmp(argv[i], "-s") == 0) {
+            // Device heap lives in 256K SRAM1, TLSF is configured for that
+            heap_size = CLAMP(atoi(argv[++i]), HEAP_BENCHMARK_HEAP_SIZE_MAX, 4096);
+        } else if(has_value && strcmp(argv[i], "-n") == 0) {
+            sessions = MAX(atoi(argv[++i]), 1);
+        } else if(has_value && strcmp(argv[i], "-r") == 0) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(
+                stderr,
+                "Usage: %s [-t trace] [-w trace] [-s heap_size] [-n sessions] [-r seed]\n",
+                argv[0]);
+            return 1;
+        }
+    }
+
+    HeapBenchmarkTrace trace = {0};
+    HeapBenchmarkOpArray_init(trace.ops);
+    if(trace_path) {
+        if(!heap_benchmark_load(&trace, trace_path)) {
+            fprintf(stderr, "Can't read %s\n", trace_path);
+            return 1;
+        }
+    } else {
+        heap_benchmark_generate(&trace, sessions, seed);
+    }
+
+    if(save_path && !heap_benchmark_save(&trace, save_path)) {
+        fprintf(stderr, "Can't write %s\n", save_path);
+        return 1;
+    }
+
+    printf(
+        "Trace: %s, %zu operations, %" PRIu32 " allocations, peak live %zu bytes\n",
+        trace_path ? trace_path : "synthetic",
+        HeapBenchmarkOpArray_size(trace.ops),
+        trace.ids,
+        trace.live_peak);
+    printf("Heap: %zu bytes\n\n", heap_size);
+
+    const MemmgrHeapAllocator* allocators[] = {
+        &memmgr_heap_allocator_first_fit,
+        &memmgr_heap_allocator_tlsf,
+    };
+    for(size_t i = 0; i < COUNT_OF(allocators); i++) {
+        heap_benchmark_run(allocators[i], &trace, heap_size);
+    }
+
+    HeapBenchmarkOpArray_clear(trace.ops);
+
+    return 0;
+}
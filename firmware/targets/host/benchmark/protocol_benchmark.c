@@ -0,0 +1,312 @@
+/**
+ * @file protocol_benchmark.c
+ * Host build: decoder throughput on captured signals
+ *
+ * Replays SubGhz RAW files (.sub) through every SubGhz decoder one by one
+ * and infrared test files (.irtest) through infrared decoder, then reports
+ * samples per second and decoded message count for each of them.
+ *
+ * Usage: protocol_benchmark [-r repeats] file...
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <flipper_format/flipper_format.h>
+#include <lib/subghz/environment.h>
+#include <lib/subghz/protocols/base.h>
+#include <lib/subghz/protocols/protocol_items.h>
+#include <lib/infrared/encoder_decoder/infrared.h>
+#include <storage_host.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#define TAG "ProtocolBenchmark"
+
+#define PROTOCOL_BENCHMARK_REPEATS_DEFAULT (10U)
+#define PROTOCOL_BENCHMARK_INFRARED_FILE_TYPE "IR tests file"
+#define PROTOCOL_BENCHMARK_INFRARED_INPUT_PREFIX "decoder_input"
+#define PROTOCOL_BENCHMARK_INT_ROOT "build/host/int"
+
+/* Signed durations, sign is level: same as RAW_Data in SubGhz files */
+typedef struct {
+    int32_t* samples;
+    size_t count;
+    size_t capacity;
+} ProtocolBenchmarkCapture;
+
+typedef struct {
+    uint64_t samples;
+    uint64_t time_ns;
+    uint32_t decoded;
+} ProtocolBenchmarkResult;
+
+static uint64_t protocol_benchmark_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void protocol_benchmark_capture_reserve(ProtocolBenchmarkCapture* capture, size_t count) {
+    if(capture->count + count > capture->capacity) {
+        capture->capacity = MAX(capture->capacity * 2, capture->count + count);
+        capture->samples = realloc(capture->samples, capture->capacity * sizeof(int32_t));
+        furi_check(capture->samples);
+    }
+}
+
+static bool protocol_benchmark_load_subghz(
+    FlipperFormat* flipper_format,
+    ProtocolBenchmarkCapture* capture) {
+    uint32_t count = 0;
+
+    while(flipper_format_get_value_count(flipper_format, "RAW_Data", &count)) {
+        protocol_benchmark_capture_reserve(capture, count);
+        if(!flipper_format_read_int32(
+               flipper_format, "RAW_Data", &capture->samples[capture->count], count)) {
+            return false;
+        }
+        capture->count += count;
+    }
+
+    return capture->count > 0;
+}
+
+static bool protocol_benchmark_load_infrared(
+    FlipperFormat* flipper_format,
+    ProtocolBenchmarkCapture* capture) {
+    FuriString* value = furi_string_alloc();
+    uint32_t count = 0;
+    bool success = true;
+
+    while(flipper_format_read_string(flipper_format, "name", value)) {
+        if(!furi_string_start_with_str(value, PROTOCOL_BENCHMARK_INFRARED_INPUT_PREFIX)) continue;
+        if(!flipper_format_read_string(flipper_format, "type", value) ||
+           !furi_string_equal(value, "raw") ||
+           !flipper_format_get_value_count(flipper_format, "data", &count)) {
+            success = false;
+            break;
+        }
+
+        uint32_t* timings = malloc(count * sizeof(uint32_t));
+        success = flipper_format_read_uint32(flipper_format, "data", timings, count);
+        if(success) {
+            // Test input starts with silence, then levels alternate
+            protocol_benchmark_capture_reserve(capture, count);
+            for(size_t i = 0; i < count; i++) {
+                int32_t duration = MIN(timings[i], (uint32_t)INT32_MAX);
+                capture->samples[capture->count++] = (i % 2) ? duration : -duration;
+            }
+        }
+        free(timings);
+        if(!success) break;
+    }
+
+    furi_string_free(value);
+    return success && capture->count > 0;
+}
+
+static void protocol_benchmark_print_header(const char* title) {
+    printf("\n%s\n", title);
+    printf(
+        "%-24s %12s %10s %12s %8s\n", "decoder", "samples", "Msamples/s", "ns/sample", "decoded");
+}
+
+static void
+    protocol_benchmark_print_result(const char* name, const ProtocolBenchmarkResult* result) {
+    double time_ns = result->time_ns ? (double)result->time_ns : 1.0;
+    double samples = result->samples ? (double)result->samples : 1.0;
+    printf(
+        "%-24s %12" PRIu64 " %10.2f %12.1f %8" PRIu32 "\n",
+        name,
+        result->samples,
+        samples * 1000.0 / time_ns,
+        time_ns / samples,
+        result->decoded);
+}
+
+static void protocol_benchmark_subghz_callback(SubGhzProtocolDecoderBase* decoder, void* context) {
+    UNUSED(decoder);
+    ProtocolBenchmarkResult* result = context;
+    result->decoded++;
+}
+
+static void protocol_benchmark_subghz(
+    const ProtocolBenchmarkCapture* captures,
+    size_t captures_count,
+    uint32_t repeats) {
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+
+    protocol_benchmark_print_header("SubGhz");
+    ProtocolBenchmarkResult total = {0};
+
+    for(size_t i = 0; i < subghz_protocol_registry_count(&subghz_protocol_registry); i++) {
+        const SubGhzProtocol* protocol =
+            subghz_protocol_registry_get_by_index(&subghz_protocol_registry, i);
+        // RAW decoder only records to file
+        if(protocol->type == SubGhzProtocolTypeRAW || !protocol->decoder ||
+           !protocol->decoder->alloc) {
+            continue;
+        }
+
+        ProtocolBenchmarkResult result = {0};
+        SubGhzProtocolDecoderBase* decoder = protocol->decoder->alloc(environment);
+        subghz_protocol_decoder_base_set_decoder_callback(
+            decoder, protocol_benchmark_subghz_callback, &result);
+
+        for(size_t c = 0; c < captures_count; c++) {
+            const ProtocolBenchmarkCapture* capture = &captures[c];
+            protocol->decoder->reset(decoder);
+
+            uint64_t start = protocol_benchmark_now_ns();
+            for(uint32_t r = 0; r < repeats; r++) {
+                for(size_t s = 0; s < capture->count; s++) {
+                    int32_t sample = capture->samples[s];
+                    protocol->decoder->feed(decoder, sample > 0, sample > 0 ? sample : -sample);
+                }
+            }
+            result.time_ns += protocol_benchmark_now_ns() - start;
+            result.samples += (uint64_t)capture->count * repeats;
+        }
+
+        protocol->decoder->free(decoder);
+        protocol_benchmark_print_result(protocol->name, &result);
+
+        // Receiver feeds every sample to every decoder: total is its cost per sample
+        total.time_ns += result.time_ns;
+        total.samples = result.samples;
+        total.decoded += result.decoded;
+    }
+
+    protocol_benchmark_print_result("all decoders", &total);
+
+    subghz_environment_free(environment);
+}
+
+static void protocol_benchmark_infrared(
+    const ProtocolBenchmarkCapture* captures,
+    size_t captures_count,
+    uint32_t repeats) {
+    InfraredDecoderHandler* decoder = infrared_alloc_decoder();
+    ProtocolBenchmarkResult result = {0};
+
+    protocol_benchmark_print_header("Infrared");
+
+    for(size_t c = 0; c < captures_count; c++) {
+        const ProtocolBenchmarkCapture* capture = &captures[c];
+        infrared_reset_decoder(decoder);
+
+        uint64_t start = protocol_benchmark_now_ns();
+        for(uint32_t r = 0; r < repeats; r++) {
+            for(size_t s = 0; s < capture->count; s++) {
+                int32_t sample = capture->samples[s];
+                if(infrared_decode(decoder, sample > 0, sample > 0 ? sample : -sample)) {
+                    result.decoded++;
+                }
+            }
+            if(infrared_check_decoder_ready(decoder)) {
+                result.decoded++;
+            }
+        }
+        result.time_ns += protocol_benchmark_now_ns() - start;
+        result.samples += (uint64_t)capture->count * repeats;
+    }
+
+    // Infrared decoder runs all protocols at once, no way to tell them apart
+    protocol_benchmark_print_result("all decoders", &result);
+
+    infrared_free_decoder(decoder);
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t repeats = PROTOCOL_BENCHMARK_REPEATS_DEFAULT;
+    int first_file = 1;
+
+    if(argc > 2 && strcmp(argv[1], "-r") == 0) {
+        repeats = MAX(atoi(argv[2]), 1);
+        first_file = 3;
+    }
+
+    if(first_file >= argc) {
+        fprintf(stderr, "Usage: %s [-r repeats] file...\n", argv[0]);
+        return 1;
+    }
+
+    furi_init();
+    furi_hal_init();
+
+    // Host file system as is: SD card root is "/", files are opened by absolute path
+    StorageHostConfig config = {
+        .backend = StorageHostBackendPosix,
+        .ext_root = "/",
+        .int_root = PROTOCOL_BENCHMARK_INT_ROOT,
+    };
+    storage_host_start(&config);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    size_t files_count = argc - first_file;
+    ProtocolBenchmarkCapture* subghz_captures =
+        calloc(files_count, sizeof(ProtocolBenchmarkCapture));
+    ProtocolBenchmarkCapture* infrared_captures =
+        calloc(files_count, sizeof(ProtocolBenchmarkCapture));
+    size_t subghz_count = 0;
+    size_t infrared_count = 0;
+
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    FuriString* file_type = furi_string_alloc();
+    FuriString* file_path = furi_string_alloc();
+    uint32_t version = 0;
+
+    for(int i = first_file; i < argc; i++) {
+        bool loaded = false;
+        char* real_path = realpath(argv[i], NULL);
+        furi_string_printf(file_path, "%s%s", STORAGE_EXT_PATH_PREFIX, real_path ? real_path : "");
+        free(real_path);
+
+        if(flipper_format_file_open_existing(flipper_format, furi_string_get_cstr(file_path)) &&
+           flipper_format_read_header(flipper_format, file_type, &version)) {
+            if(furi_string_equal(file_type, SUBGHZ_RAW_FILE_TYPE)) {
+                loaded = protocol_benchmark_load_subghz(
+                    flipper_format, &subghz_captures[subghz_count]);
+                if(loaded) subghz_count++;
+            } else if(furi_string_equal(file_type, PROTOCOL_BENCHMARK_INFRARED_FILE_TYPE)) {
+                loaded = protocol_benchmark_load_infrared(
+                    flipper_format, &infrared_captures[infrared_count]);
+                if(loaded) infrared_count++;
+            }
+        }
+        flipper_format_file_close(flipper_format);
+
+        if(!loaded) {
+            FURI_LOG_W(TAG, "Skipping %s: not a RAW capture", argv[i]);
+        }
+    }
+
+    furi_string_free(file_path);
+    furi_string_free(file_type);
+    flipper_format_free(flipper_format);
+
+    printf(
+        "%zu SubGhz and %zu infrared captures, %" PRIu32 " repeats\n",
+        subghz_count,
+        infrared_count,
+        repeats);
+    if(subghz_count) {
+        protocol_benchmark_subghz(subghz_captures, subghz_count, repeats);
+    }
+    if(infrared_count) {
+        protocol_benchmark_infrared(infrared_captures, infrared_count, repeats);
+    }
+
+    for(size_t i = 0; i < files_count; i++) {
+        free(subghz_captures[i].samples);
+        free(infrared_captures[i].samples);
+    }
+    free(subghz_captures);
+    free(infrared_captures);
+
+    furi_record_close(RECORD_STORAGE);
+
+    return 0;
+}
@@ -0,0 +1,337 @@
+/**
+ * @file storage_benchmark.c
+ * Host build: storage service latency and throughput
+ *
+ * Runs storage service with chosen backend and lets concurrent clients
+ * open, read, stat and list files through the public Storage API, same
+ * path as applications take on device: message queue, API lock, worker.
+ *
+ * Usage: storage_benchmark [-b posix|ram] [-d dir] [-c clients] [-i iterations]
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage_i.h>
+#include <storage_host.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define TAG "StorageBenchmark"
+
+#define STORAGE_BENCHMARK_CLIENTS_DEFAULT (4U)
+#define STORAGE_BENCHMARK_ITERATIONS_DEFAULT (200U)
+#define STORAGE_BENCHMARK_FILES_PER_CLIENT (8U)
+#define STORAGE_BENCHMARK_FILE_SIZE (4096U)
+#define STORAGE_BENCHMARK_READ_CHUNK (512U)
+#define STORAGE_BENCHMARK_DIR_READ_INTERVAL (4U)
+#define STORAGE_BENCHMARK_SD_SIZE (64U * 1024U * 1024U)
+#define STORAGE_BENCHMARK_DIR_DEFAULT "build/host/storage_benchmark"
+#define STORAGE_BENCHMARK_STACK_SIZE (4 * 1024)
+
+typedef enum {
+    StorageBenchmarkOpOpen,
+    StorageBenchmarkOpRead,
+    StorageBenchmarkOpStat,
+    StorageBenchmarkOpDirRead,
+    StorageBenchmarkOpCount,
+} StorageBenchmarkOp;
+
+static const char* const storage_benchmark_op_names[StorageBenchmarkOpCount] = {
+    "open+close",
+    "read 512",
+    "stat",
+    "dir_read",
+};
+
+typedef struct {
+    uint32_t count;
+    uint64_t time_ns;
+    uint64_t max_ns;
+} StorageBenchmarkOpResult;
+
+typedef struct {
+    const char* path;
+    uint32_t index;
+    uint32_t clients;
+    uint32_t files;
+    uint32_t iterations;
+    StorageBenchmarkOpResult ops[StorageBenchmarkOpCount];
+    uint32_t errors;
+} StorageBenchmarkClient;
+
+static uint64_t storage_benchmark_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void storage_benchmark_account(StorageBenchmarkOpResult* result, uint64_t start) {
+    uint64_t time_ns = storage_benchmark_now_ns() - start;
+    result->count++;
+    result->time_ns += time_ns;
+    result->max_ns = MAX(result->max_ns, time_ns);
+}
+
+static bool storage_benchmark_prepare(Storage* storage, const char* path, uint32_t files) {
+    uint8_t* data = malloc(STORAGE_BENCHMARK_FILE_SIZE);
+    for(size_t i = 0; i < STORAGE_BENCHMARK_FILE_SIZE; i++) {
+        data[i] = i & 0xFF;
+    }
+
+    FuriString* file_path = furi_string_alloc();
+    File* file = storage_file_alloc(storage);
+    bool success = storage_simply_mkdir(storage, path);
+
+    for(uint32_t i = 0; success && (i < files); i++) {
+        furi_string_printf(file_path, "%s/file_%03lu.bin", path, i);
+        success = storage_file_open(
+                      file, furi_string_get_cstr(file_path), FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                  storage_file_write(file, data, STORAGE_BENCHMARK_FILE_SIZE) ==
+                      STORAGE_BENCHMARK_FILE_SIZE;
+        storage_file_close(file);
+    }
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Can't prepare %s: %s", path, storage_file_get_error_desc(file));
+    }
+
+    storage_file_free(file);
+    furi_string_free(file_path);
+    free(data);
+    return success;
+}
+
+static int32_t storage_benchmark_client(void* context) {
+    StorageBenchmarkClient* client = context;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* file_path = furi_string_alloc();
+    uint8_t* buffer = malloc(STORAGE_BENCHMARK_READ_CHUNK);
+    FileInfo fileinfo;
+    uint64_t start;
+
+    for(uint32_t i = 0; i < client->iterations; i++) {
+        // Clients never share a file, storage allows only one open handle per path
+        uint32_t index = (i * client->clients + client->index) % client->files;
+        furi_string_printf(file_path, "%s/file_%03lu.bin", client->path, index);
+        const char* path = furi_string_get_cstr(file_path);
+
+        start = storage_benchmark_now_ns();
+        if(storage_common_stat(storage, path, &fileinfo) != FSE_OK) client->errors++;
+        storage_benchmark_account(&client->ops[StorageBenchmarkOpStat], start);
+
+        start = storage_benchmark_now_ns();
+        bool opened = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
+        storage_file_close(file);
+        storage_benchmark_account(&client->ops[StorageBenchmarkOpOpen], start);
+        if(!opened) client->errors++;
+
+        if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            while(true) {
+                start = storage_benchmark_now_ns();
+                uint16_t read = storage_file_read(file, buffer, STORAGE_BENCHMARK_READ_CHUNK);
+                if(!read) break;
+                storage_benchmark_account(&client->ops[StorageBenchmarkOpRead], start);
+            }
+        } else {
+            client->errors++;
+        }
+        storage_file_close(file);
+
+        // Directory can be open only once at a time, so only first client lists it
+        if(client->index == 0 && (i % STORAGE_BENCHMARK_DIR_READ_INTERVAL) == 0) {
+            if(storage_dir_open(file, client->path)) {
+                while(true) {
+                    start = storage_benchmark_now_ns();
+                    if(!storage_dir_read(file, &fileinfo, NULL, 0)) break;
+                    storage_benchmark_account(&client->ops[StorageBenchmarkOpDirRead], start);
+                }
+            } else {
+                client->errors++;
+            }
+            storage_dir_close(file);
+        }
+    }
+
+    free(buffer);
+    furi_string_free(file_path);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return 0;
+}
+
+static void storage_benchmark_print_worker(Storage* storage, StorageType type) {
+    StorageWorkerStats stats;
+    storage_worker_get_stats(storage, type, &stats);
+
+    printf(
+        "  worker: %lu requests, %lu fast path, max latency %lu us, queue depth:",
+        stats.requests,
+        stats.fast_path_requests,
+        stats.latency_max_us);
+    for(size_t i = 0; i < STORAGE_WORKER_DEPTH_BUCKETS; i++) {
+        printf(" %lu", stats.depth[i]);
+    }
+    printf(", latency from %uus:", STORAGE_WORKER_LATENCY_BASE_US);
+    for(size_t i = 0; i < STORAGE_WORKER_LATENCY_BUCKETS; i++) {
+        printf(" %lu", stats.latency[i]);
+    }
+    printf("\n");
+}
+
+static void storage_benchmark_run(
+    Storage* storage,
+    const char* path,
+    StorageType type,
+    uint32_t clients,
+    uint32_t iterations) {
+    StorageBenchmarkClient* context = calloc(clients, sizeof(StorageBenchmarkClient));
+    FuriThread** threads = malloc(clients * sizeof(FuriThread*));
+    uint32_t files = clients * STORAGE_BENCHMARK_FILES_PER_CLIENT;
+
+    if(!storage_benchmark_prepare(storage, path, files)) {
+        free(threads);
+        free(context);
+        return;
+    }
+
+    StorageWorkerStats stats_before;
+    storage_worker_get_stats(storage, type, &stats_before);
+
+    uint64_t start = storage_benchmark_now_ns();
+    for(uint32_t i = 0; i < clients; i++) {
+        context[i].path = path;
+        context[i].index = i;
+        context[i].clients = clients;
+        context[i].files = files;
+        context[i].iterations = iterations;
+        threads[i] = furi_thread_alloc_ex(
+            "StorageBenchmark", STORAGE_BENCHMARK_STACK_SIZE, storage_benchmark_client, &context[i]);
+        furi_thread_start(threads[i]);
+    }
+
+    for(uint32_t i = 0; i < clients; i++) {
+        furi_thread_join(threads[i]);
+        furi_thread_free(threads[i]);
+    }
+    uint64_t time_ns = storage_benchmark_now_ns() - start;
+
+    StorageBenchmarkOpResult total[StorageBenchmarkOpCount] = {0};
+    uint32_t errors = 0;
+    for(uint32_t i = 0; i < clients; i++) {
+        for(size_t op = 0; op < StorageBenchmarkOpCount; op++) {
+            total[op].count += context[i].ops[op].count;
+            total[op].time_ns += context[i].ops[op].time_ns;
+            total[op].max_ns = MAX(total[op].max_ns, context[i].ops[op].max_ns);
+        }
+        errors += context[i].errors;
+    }
+
+    uint64_t read_bytes = (uint64_t)total[StorageBenchmarkOpRead].count *
+                          STORAGE_BENCHMARK_READ_CHUNK;
+    printf(
+        "\n%s, %lu client(s): %.1f ms, read %.2f MB/s, %lu errors\n",
+        path,
+        clients,
+        time_ns / 1000000.0,
+        time_ns ? read_bytes * 1000.0 / time_ns : 0.0,
+        errors);
+    printf("  %-12s %10s %12s %12s %12s\n", "operation", "count", "avg us", "max us", "ops/s");
+    for(size_t op = 0; op < StorageBenchmarkOpCount; op++) {
+        const StorageBenchmarkOpResult* result = &total[op];
+        double count = result->count ? (double)result->count : 1.0;
+        printf(
+            "  %-12s %10" PRIu32 " %12.1f %12.1f %12.0f\n",
+            storage_benchmark_op_names[op],
+            result->count,
+            result->time_ns / count / 1000.0,
+            result->max_ns / 1000.0,
+            time_ns ? result->count * 1000000000.0 / time_ns : 0.0);
+    }
+
+    StorageWorkerStats stats;
+    storage_worker_get_stats(storage, type, &stats);
+    printf(
+        "  worker: %lu requests, %lu in caller context\n",
+        stats.requests - stats_before.requests,
+        stats.fast_path_requests - stats_before.fast_path_requests);
+
+    free(threads);
+    free(context);
+}
+
+int main(int argc, char* argv[]) {
+    StorageHostConfig config = {
+        .backend = StorageHostBackendPosix,
+        .sd_size = STORAGE_BENCHMARK_SD_SIZE,
+    };
+    const char* dir = STORAGE_BENCHMARK_DIR_DEFAULT;
+    uint32_t clients = STORAGE_BENCHMARK_CLIENTS_DEFAULT;
+    uint32_t iterations = STORAGE_BENCHMARK_ITERATIONS_DEFAULT;
+
+    for(int i = 1; i < argc; i++) {
+        bool has_value = (i + 1 < argc);
+        if(has_value && strcmp(argv[i], "-b") == 0) {
+            i++;
+            if(strcmp(argv[i], "ram") == 0) {
+                config.backend = StorageHostBackendRam;
+            } else if(strcmp(argv[i], "posix") != 0) {
+                break;
+            }
+        } else if(has_value && strcmp(argv[i], "-d") == 0) {
+            dir = argv[++i];
+        } else if(has_value && strcmp(argv[i], "-c") == 0) {
+            clients = MAX(atoi(argv[++i]), 1);
+        } else if(has_value && strcmp(argv[i], "-i") == 0) {
+            iterations = MAX(atoi(argv[++i]), 1);
+        } else {
+            fprintf(
+                stderr,
+                "Usage: %s [-b posix|ram] [-d dir] [-c clients] [-i iterations]\n",
+                argv[0]);
+            return 1;
+        }
+    }
+
+    furi_init();
+    furi_hal_init();
+
+    FuriString* ext_root = furi_string_alloc_printf("%s/ext", dir);
+    FuriString* int_root = furi_string_alloc_printf("%s/int", dir);
+    if(config.backend == StorageHostBackendPosix) {
+        mkdir(dir, 0755);
+        config.ext_root = furi_string_get_cstr(ext_root);
+        config.int_root = furi_string_get_cstr(int_root);
+    }
+
+    Storage* storage = storage_host_start(&config);
+
+    printf(
+        "Backend: %s, %lu iterations per client\n",
+        config.backend == StorageHostBackendRam ? "FatFS and littlefs on RAM" : dir,
+        iterations);
+
+    const struct {
+        const char* path;
+        StorageType type;
+    } targets[] = {
+        {EXT_PATH("benchmark"), ST_EXT},
+        {INT_PATH("benchmark"), ST_INT},
+    };
+
+    for(size_t i = 0; i < COUNT_OF(targets); i++) {
+        storage_benchmark_run(storage, targets[i].path, targets[i].type, 1, iterations);
+        if(clients > 1) {
+            storage_benchmark_run(storage, targets[i].path, targets[i].type, clients, iterations);
+        }
+        storage_benchmark_print_worker(storage, targets[i].type);
+        storage_simply_remove_recursive(storage, targets[i].path);
+    }
+
+    furi_string_free(ext_root);
+    furi_string_free(int_root);
+
+    return 0;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file storage_int_benchmark.c
+ * Host build: internal storage littlefs profile benchmark
+ *
+ * Runs storage service with littlefs on RAM flash of internal storage
+ * geometry and measures file operations through the public Storage API.
+ * Writes go through the free space check on open and fs_info through used
+ * block count, so the cached used block path is what gets measured.
+ *
+ * Built once per littlefs profile, compact one with STORAGE_INT_LFS_COMPACT.
+ *
+ * Usage: storage_int_benchmark [-f files] [-r rounds]
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage_i.h>
+#include <storage/storages/storage_int_profile.h>
+#include <storage_host.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#define TAG "StorageIntBenchmark"
+
+#define STORAGE_INT_BENCHMARK_FILES_DEFAULT (48U)
+#define STORAGE_INT_BENCHMARK_ROUNDS_DEFAULT (20U)
+#define STORAGE_INT_BENCHMARK_DIRS (4U)
+#define STORAGE_INT_BENCHMARK_FILE_SIZE_MAX (2048U)
+#define STORAGE_INT_BENCHMARK_WRITE_SIZE (512U)
+#define STORAGE_INT_BENCHMARK_PATH INT_PATH("benchmark")
+
+#ifdef STORAGE_INT_LFS_COMPACT
+static const StorageIntLfsProfile storage_int_benchmark_profile = STORAGE_INT_LFS_PROFILE_COMPACT;
+#else
+static const StorageIntLfsProfile storage_int_benchmark_profile =
+    STORAGE_INT_LFS_PROFILE_PERFORMANCE;
+#endif
+
+typedef enum {
+    StorageIntBenchmarkOpOpen,
+    StorageIntBenchmarkOpRead,
+    StorageIntBenchmarkOpStat,
+    StorageIntBenchmarkOpWrite,
+    StorageIntBenchmarkOpFsInfo,
+    StorageIntBenchmarkOpCount,
+} StorageIntBenchmarkOp;
+
+static const char* const storage_int_benchmark_op_names[StorageIntBenchmarkOpCount] = {
+    "open+close",
+    "read",
+    "stat",
+    "write",
+    "fs_info",
+};
+
+typedef struct {
+    uint32_t count;
+    uint64_t time_ns;
+    uint64_t max_ns;
+} StorageIntBenchmarkOpResult;
+
+static uint64_t storage_int_benchmark_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+static void storage_int_benchmark_account(StorageIntBenchmarkOpResult* result, uint64_t start) {
+    uint64_t time_ns = storage_int_benchmark_now_ns() - start;
+    result->count++;
+    result->time_ns += time_ns;
+    result->max_ns = MAX(result->max_ns, time_ns);
+}
+
+static void storage_int_benchmark_file_path(FuriString* path, uint32_t index) {
+    furi_string_printf(
+        path,
+        "%s/dir%lu/file%lu.txt",
+        STORAGE_INT_BENCHMARK_PATH,
+        index % STORAGE_INT_BENCHMARK_DIRS,
+        index);
+}
+
+static bool storage_int_benchmark_write(
+    File* file,
+    const char* path,
+    const uint8_t* data,
+    size_t size) {
+    bool success = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, data, size) == size;
+    return storage_file_close(file) && success;
+}
+
+static bool storage_int_benchmark_populate(
+    Storage* storage,
+    File* file,
+    FuriString* path,
+    const uint8_t* data,
+    uint32_t files) {
+    bool success = storage_simply_mkdir(storage, STORAGE_INT_BENCHMARK_PATH);
+    for(uint32_t i = 0; success && (i < STORAGE_INT_BENCHMARK_DIRS); i++) {
+        furi_string_printf(path, "%s/dir%lu", STORAGE_INT_BENCHMARK_PATH, i);
+        success = storage_simply_mkdir(storage, furi_string_get_cstr(path));
+    }
+
+    for(uint32_t i = 0; success && (i < files); i++) {
+        storage_int_benchmark_file_path(path, i);
+        // Mix of inline and block backed files, like settings and keys on device
+        size_t size = MIN(64U << (i % 6), STORAGE_INT_BENCHMARK_FILE_SIZE_MAX);
+        success = storage_int_benchmark_write(file, furi_string_get_cstr(path), data, size);
+    }
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Can't populate: %s", storage_file_get_error_desc(file));
+    }
+    return success;
+}
+
+static uint32_t storage_int_benchmark_run(Storage* storage, uint32_t files, uint32_t rounds) {
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    uint8_t* data = malloc(STORAGE_INT_BENCHMARK_FILE_SIZE_MAX);
+    uint8_t* buffer = malloc(STORAGE_INT_BENCHMARK_FILE_SIZE_MAX);
+    for(size_t i = 0; i < STORAGE_INT_BENCHMARK_FILE_SIZE_MAX; i++) {
+        data[i] = i * 7;
+    }
+
+    StorageIntBenchmarkOpResult results[StorageIntBenchmarkOpCount] = {0};
+    uint32_t errors = 0;
+    uint64_t start;
+    FileInfo fileinfo;
+    uint64_t total_space = 0, free_space = 0;
+
+    if(!storage_int_benchmark_populate(storage, file, path, data, files)) {
+        errors++;
+        rounds = 0;
+    }
+
+    for(uint32_t round = 0; round < rounds; round++) {
+        for(uint32_t i = 0; i < files; i++) {
+            storage_int_benchmark_file_path(path, i);
+            const char* file_path = furi_string_get_cstr(path);
+
+            start = storage_int_benchmark_now_ns();
+            if(!storage_file_open(file, file_path, FSAM_READ, FSOM_OPEN_EXISTING)) errors++;
+            storage_file_close(file);
+            storage_int_benchmark_account(&results[StorageIntBenchmarkOpOpen], start);
+
+            if(storage_file_open(file, file_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+                start = storage_int_benchmark_now_ns();
+                if(!storage_file_read(file, buffer, STORAGE_INT_BENCHMARK_FILE_SIZE_MAX)) {
+                    errors++;
+                }
+                storage_int_benchmark_account(&results[StorageIntBenchmarkOpRead], start);
+            } else {
+                errors++;
+            }
+            storage_file_close(file);
+
+            start = storage_int_benchmark_now_ns();
+            if(storage_common_stat(storage, file_path, &fileinfo) != FSE_OK) errors++;
+            storage_int_benchmark_account(&results[StorageIntBenchmarkOpStat], start);
+        }
+
+        // Rewrite a quarter of files every round, as settings saves do
+        for(uint32_t i = round % 4; i < files; i += 4) {
+            storage_int_benchmark_file_path(path, i);
+            start = storage_int_benchmark_now_ns();
+            if(!storage_int_benchmark_write(
+                   file, furi_string_get_cstr(path), data, STORAGE_INT_BENCHMARK_WRITE_SIZE)) {
+                errors++;
+            }
+            storage_int_benchmark_account(&results[StorageIntBenchmarkOpWrite], start);
+        }
+
+        // Rewrites released blocks, so this one recounts
+        start = storage_int_benchmark_now_ns();
+        if(storage_common_fs_info(storage, STORAGE_INT_PATH_PREFIX, &total_space, &free_space) !=
+           FSE_OK) {
+            errors++;
+        }
+        storage_int_benchmark_account(&results[StorageIntBenchmarkOpFsInfo], start);
+    }
+
+    printf(
+        "Profile %s: cache %lu, lookahead %lu, RAM %lu + %lu per file\n",
+        storage_int_benchmark_profile.name,
+        storage_int_benchmark_profile.cache_size,
+        storage_int_benchmark_profile.lookahead_size,
+        storage_int_benchmark_profile.cache_size * 2 +
+            storage_int_benchmark_profile.lookahead_size,
+        storage_int_benchmark_profile.cache_size);
+    printf("  %-12s %10s %12s %12s\n", "operation", "count", "avg us", "max us");
+    for(size_t op = 0; op < StorageIntBenchmarkOpCount; op++) {
+        const StorageIntBenchmarkOpResult* result = &results[op];
+        double count = result->count ? (double)result->count : 1.0;
+        printf(
+            "  %-12s %10" PRIu32 " %12.1f %12.1f\n",
+            storage_int_benchmark_op_names[op],
+            result->count,
+            result->time_ns / count / 1000.0,
+            result->max_ns / 1000.0);
+    }
+    printf(
+        "  %llu of %llu bytes free, %lu errors\n",
+        (unsigned long long)free_space,
+        (unsigned long long)total_space,
+        errors);
+
+    storage_simply_remove_recursive(storage, STORAGE_INT_BENCHMARK_PATH);
+
+    free(buffer);
+    free(data);
+    furi_string_free(path);
+    storage_file_free(file);
+    return errors;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t files = STORAGE_INT_BENCHMARK_FILES_DEFAULT;
+    uint32_t rounds = STORAGE_INT_BENCHMARK_ROUNDS_DEFAULT;
+
+    for(int i = 1; i < argc; i++) {
+        bool has_value = (i + 1 < argc);
+        if(has_value && strcmp(argv[i], "-f") == 0) {
+            files = MAX(atoi(argv[++i]), 1);
+        } else if(has_value && strcmp(argv[i], "-r") == 0) {
+            rounds = MAX(atoi(argv[++i]), 1);
+        } else {
+            fprintf(stderr, "Usage: %s [-f files] [-r rounds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    furi_init();
+    furi_hal_init();
+
+    // No SD card: only internal storage is served
+    StorageHostConfig config = {
+        .backend = StorageHostBackendRam,
+        .sd_size = 0,
+    };
+    Storage* storage = storage_host_start(&config);
+
+    printf("Files: %lu, rounds: %lu\n", files, rounds);
+    uint32_t errors = storage_int_benchmark_run(storage, files, rounds);
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file sd_host.h
+ * Host build: SD card emulated in RAM
+ *
+ * Implements SD SPI driver API, so FatFS runs on top of the same disk IO
+ * and sector cache as on device. Card is blank when inserted.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Insert blank card, replaces the one inserted before
+ *
+ * @param      size  card size in bytes, rounded down to SD block size
+ */
+void sd_host_insert(size_t size);
+
+/** Remove card, its content is lost */
+void sd_host_eject();
+
+/** Check if card is inserted
+ *
+ * @return     true if card is inserted
+ */
+bool sd_host_is_inserted();
+
+#ifdef __cplusplus
+}
+#endif
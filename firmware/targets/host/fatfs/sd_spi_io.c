@@ -0,0 +1,90 @@
+#include "sd_spi_io.h"
+#include "sd_host.h"
+#include <furi.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TAG "SdHost"
+
+typedef struct {
+    uint8_t* data;
+    uint32_t blocks;
+    bool initialized;
+} SdHostCard;
+
+static SdHostCard sd_host_card = {0};
+
+void sd_host_insert(size_t size) {
+    sd_host_eject();
+    sd_host_card.blocks = size / SD_BLOCK_SIZE;
+    furi_check(sd_host_card.blocks);
+    sd_host_card.data = calloc(sd_host_card.blocks, SD_BLOCK_SIZE);
+    furi_check(sd_host_card.data);
+}
+
+void sd_host_eject() {
+    free(sd_host_card.data);
+    memset(&sd_host_card, 0, sizeof(SdHostCard));
+}
+
+bool sd_host_is_inserted() {
+    return sd_host_card.data != NULL;
+}
+
+uint8_t sd_max_mount_retry_count() {
+    return 1;
+}
+
+SdSpiStatus sd_init(bool power_reset) {
+    UNUSED(power_reset);
+    sd_host_card.initialized = sd_host_is_inserted();
+    return sd_host_card.initialized ? SdSpiStatusOK : SdSpiStatusError;
+}
+
+SdSpiStatus sd_get_card_state(void) {
+    return sd_host_card.initialized ? SdSpiStatusOK : SdSpiStatusError;
+}
+
+SdSpiStatus sd_get_card_info(SD_CardInfo* card_info) {
+    if(!sd_host_card.initialized) return SdSpiStatusError;
+
+    memset(card_info, 0, sizeof(SD_CardInfo));
+    card_info->CardCapacity = (uint64_t)sd_host_card.blocks * SD_BLOCK_SIZE;
+    card_info->CardBlockSize = SD_BLOCK_SIZE;
+    card_info->LogBlockNbr = sd_host_card.blocks;
+    card_info->LogBlockSize = SD_BLOCK_SIZE;
+    return sd_get_cid(&card_info->Cid);
+}
+
+static bool sd_host_check_range(uint32_t address, uint32_t blocks) {
+    return sd_host_card.initialized && (address < sd_host_card.blocks) &&
+           (blocks <= sd_host_card.blocks - address);
+}
+
+SdSpiStatus sd_read_blocks(uint32_t* data, uint32_t address, uint32_t blocks, uint32_t timeout_ms) {
+    UNUSED(timeout_ms);
+    if(!sd_host_check_range(address, blocks)) return SdSpiStatusError;
+
+    memcpy(data, sd_host_card.data + (size_t)address * SD_BLOCK_SIZE, blocks * SD_BLOCK_SIZE);
+    return SdSpiStatusOK;
+}
+
+SdSpiStatus
+    sd_write_blocks(uint32_t* data, uint32_t address, uint32_t blocks, uint32_t timeout_ms) {
+    UNUSED(timeout_ms);
+    if(!sd_host_check_range(address, blocks)) return SdSpiStatusError;
+
+    memcpy(sd_host_card.data + (size_t)address * SD_BLOCK_SIZE, data, blocks * SD_BLOCK_SIZE);
+    return SdSpiStatusOK;
+}
+
+SdSpiStatus sd_get_cid(SD_CID* cid) {
+    if(!sd_host_card.initialized) return SdSpiStatusError;
+
+    memset(cid, 0, sizeof(SD_CID));
+    memcpy(cid->OEM_AppliID, "FH", sizeof(cid->OEM_AppliID));
+    memcpy(cid->ProdName, "RAMSD", sizeof(cid->ProdName));
+    cid->ProdRev = 0x10;
+    return SdSpiStatusOK;
+}
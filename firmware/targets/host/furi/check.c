@@ -0,0 +1,48 @@
+#include <core/check.h>
+#include <core/thread.h>
+#include <furi_hal_console.h>
+
+#include <stdlib.h>
+
+static const char* __furi_host_message(const void* message, const char* fallback) {
+    if(message == NULL) {
+        return fallback;
+    } else if(message == (void*)__FURI_ASSERT_MESSAGE_FLAG) {
+        return "furi_assert failed";
+    } else if(message == (void*)__FURI_CHECK_MESSAGE_FLAG) {
+        return "furi_check failed";
+    } else {
+        return message;
+    }
+}
+
+static void __furi_host_print(const char* kind, const char* message) {
+    const char* name = furi_thread_get_name(furi_thread_get_current_id());
+
+    furi_hal_console_puts("\r\n\033[0;31m[");
+    furi_hal_console_puts(kind);
+    furi_hal_console_puts("][");
+    furi_hal_console_puts(name ? name : "main");
+    furi_hal_console_puts("] ");
+    furi_hal_console_puts(message);
+    furi_hal_console_puts("\033[0m\r\n");
+}
+
+FURI_NORETURN void __furi_crash_host(const void* message) {
+    __furi_host_print("CRASH", __furi_host_message(message, "Fatal Error"));
+    // Leave core dump and debugger stop behind, same as crash on device with debugger
+    abort();
+}
+
+FURI_NORETURN void __furi_halt_host(const void* message) {
+    __furi_host_print("HALT", __furi_host_message(message, "System halt requested."));
+    exit(EXIT_FAILURE);
+}
+
+FURI_NORETURN void __furi_crash() {
+    __furi_crash_host(NULL);
+}
+
+FURI_NORETURN void __furi_halt() {
+    __furi_halt_host(NULL);
+}
@@ -0,0 +1,33 @@
+#include <core/common_defines.h>
+
+#include <pthread.h>
+
+/* No interrupts on host: critical section is a process wide recursive lock */
+static pthread_mutex_t furi_critical_mutex;
+static pthread_once_t furi_critical_once = PTHREAD_ONCE_INIT;
+
+static void furi_critical_init(void) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&furi_critical_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+__FuriCriticalInfo __furi_critical_enter(void) {
+    __FuriCriticalInfo info = {
+        .isrm = 0,
+        .from_isr = false,
+        .kernel_running = true,
+    };
+
+    pthread_once(&furi_critical_once, furi_critical_init);
+    pthread_mutex_lock(&furi_critical_mutex);
+
+    return info;
+}
+
+void __furi_critical_exit(__FuriCriticalInfo info) {
+    UNUSED(info);
+    pthread_mutex_unlock(&furi_critical_mutex);
+}
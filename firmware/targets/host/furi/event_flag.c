@@ -0,0 +1,132 @@
+#include <core/event_flag.h>
+#include <core/check.h>
+#include "host_i.h"
+
+#include <stdlib.h>
+
+#define FURI_EVENT_FLAG_MAX_BITS_EVENT_GROUPS 24U
+#define FURI_EVENT_FLAG_INVALID_BITS (~((1UL << FURI_EVENT_FLAG_MAX_BITS_EVENT_GROUPS) - 1U))
+
+void furi_host_flags_init(FuriHostFlags* instance) {
+    furi_check(pthread_mutex_init(&instance->mutex, NULL) == 0);
+    furi_check(pthread_cond_init(&instance->cond, NULL) == 0);
+    instance->flags = 0;
+}
+
+void furi_host_flags_deinit(FuriHostFlags* instance) {
+    pthread_cond_destroy(&instance->cond);
+    pthread_mutex_destroy(&instance->mutex);
+}
+
+uint32_t furi_host_flags_set(FuriHostFlags* instance, uint32_t flags) {
+    pthread_mutex_lock(&instance->mutex);
+    instance->flags |= flags;
+    uint32_t rflags = instance->flags;
+    pthread_cond_broadcast(&instance->cond);
+    pthread_mutex_unlock(&instance->mutex);
+
+    return rflags;
+}
+
+uint32_t furi_host_flags_clear(FuriHostFlags* instance, uint32_t flags) {
+    pthread_mutex_lock(&instance->mutex);
+    uint32_t rflags = instance->flags;
+    instance->flags &= ~flags;
+    pthread_mutex_unlock(&instance->mutex);
+
+    return rflags;
+}
+
+uint32_t furi_host_flags_get(FuriHostFlags* instance) {
+    pthread_mutex_lock(&instance->mutex);
+    uint32_t rflags = instance->flags;
+    pthread_mutex_unlock(&instance->mutex);
+
+    return rflags;
+}
+
+uint32_t furi_host_flags_wait(
+    FuriHostFlags* instance,
+    uint32_t flags,
+    uint32_t options,
+    uint32_t timeout) {
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) {
+        furi_host_deadline(timeout, &deadline);
+    }
+
+    uint32_t rflags;
+    pthread_mutex_lock(&instance->mutex);
+    while(true) {
+        rflags = instance->flags;
+        bool ready = (options & FuriFlagWaitAll) ? ((rflags & flags) == flags) :
+                                                   ((rflags & flags) != 0U);
+        if(ready) {
+            if(!(options & FuriFlagNoClear)) {
+                instance->flags &= ~flags;
+            }
+            break;
+        }
+
+        if(timeout == 0U) {
+            rflags = (uint32_t)FuriStatusErrorResource;
+            break;
+        }
+
+        if(!furi_host_cond_wait(
+               &instance->cond,
+               &instance->mutex,
+               (timeout == FuriWaitForever) ? NULL : &deadline)) {
+            rflags = (uint32_t)FuriStatusErrorTimeout;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&instance->mutex);
+
+    return rflags;
+}
+
+FuriEventFlag* furi_event_flag_alloc() {
+    FuriHostFlags* instance = malloc(sizeof(FuriHostFlags));
+    furi_host_flags_init(instance);
+    return instance;
+}
+
+void furi_event_flag_free(FuriEventFlag* instance) {
+    furi_assert(instance);
+    furi_host_flags_deinit(instance);
+    free(instance);
+}
+
+uint32_t furi_event_flag_set(FuriEventFlag* instance, uint32_t flags) {
+    furi_assert(instance);
+    furi_assert((flags & FURI_EVENT_FLAG_INVALID_BITS) == 0U);
+
+    /* Return event flags after setting */
+    return furi_host_flags_set(instance, flags);
+}
+
+uint32_t furi_event_flag_clear(FuriEventFlag* instance, uint32_t flags) {
+    furi_assert(instance);
+    furi_assert((flags & FURI_EVENT_FLAG_INVALID_BITS) == 0U);
+
+    /* Return event flags before clearing */
+    return furi_host_flags_clear(instance, flags);
+}
+
+uint32_t furi_event_flag_get(FuriEventFlag* instance) {
+    furi_assert(instance);
+    return furi_host_flags_get(instance);
+}
+
+uint32_t furi_event_flag_wait(
+    FuriEventFlag* instance,
+    uint32_t flags,
+    uint32_t options,
+    uint32_t timeout) {
+    furi_assert(instance);
+    furi_assert((flags & FURI_EVENT_FLAG_INVALID_BITS) == 0U);
+
+    /* Return event flags before clearing */
+    return furi_host_flags_wait(instance, flags, options, timeout);
+}
@@ -0,0 +1,10 @@
+#include <furi.h>
+
+void furi_init() {
+    furi_log_init();
+    furi_record_init();
+}
+
+void furi_run() {
+    // Nothing to start: host threads run as soon as they are started
+}
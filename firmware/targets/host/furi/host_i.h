@@ -0,0 +1,64 @@
+/**
+ * @file host_i.h
+ * Host build: helpers shared by POSIX implementations of furi primitives
+ */
+#pragma once
+
+#include <core/base.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Convert furi timeout in ticks to absolute deadline for pthread timed calls
+ *
+ * @param      timeout   timeout in ticks, must not be FuriWaitForever
+ * @param      deadline  output, CLOCK_REALTIME based
+ */
+void furi_host_deadline(uint32_t timeout, struct timespec* deadline);
+
+/** Wait on condition variable the way furi primitives wait
+ *
+ * @param      cond      condition variable
+ * @param      mutex     locked mutex protecting the condition
+ * @param      deadline  deadline from furi_host_deadline, NULL to wait forever
+ *
+ * @return     false on timeout
+ */
+bool furi_host_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex, struct timespec* deadline);
+
+/** Flag set behind event flags and thread flags */
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t flags;
+} FuriHostFlags;
+
+void furi_host_flags_init(FuriHostFlags* instance);
+
+void furi_host_flags_deinit(FuriHostFlags* instance);
+
+/** @return flags after setting */
+uint32_t furi_host_flags_set(FuriHostFlags* instance, uint32_t flags);
+
+/** @return flags before clearing */
+uint32_t furi_host_flags_clear(FuriHostFlags* instance, uint32_t flags);
+
+uint32_t furi_host_flags_get(FuriHostFlags* instance);
+
+/** Wait for flags, FuriFlag options and return values
+ *
+ * @return     flags before clearing or FuriStatus error
+ */
+uint32_t furi_host_flags_wait(
+    FuriHostFlags* instance,
+    uint32_t flags,
+    uint32_t options,
+    uint32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
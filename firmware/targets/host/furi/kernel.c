@@ -0,0 +1,99 @@
+#include <core/kernel.h>
+#include <core/check.h>
+#include "host_i.h"
+
+#include <errno.h>
+
+/* Ticks are milliseconds since the first call, same as on device */
+#define FURI_HOST_TICK_FREQUENCY (1000U)
+
+static struct timespec furi_kernel_start;
+static pthread_once_t furi_kernel_start_once = PTHREAD_ONCE_INIT;
+
+static void furi_kernel_start_init(void) {
+    clock_gettime(CLOCK_MONOTONIC, &furi_kernel_start);
+}
+
+static uint64_t furi_kernel_get_time_us(void) {
+    pthread_once(&furi_kernel_start_once, furi_kernel_start_init);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - furi_kernel_start.tv_sec) * 1000000ULL +
+           (now.tv_nsec - furi_kernel_start.tv_nsec) / 1000;
+}
+
+void furi_host_deadline(uint32_t timeout, struct timespec* deadline) {
+    furi_assert(timeout != FuriWaitForever);
+
+    clock_gettime(CLOCK_REALTIME, deadline);
+    uint64_t nsec = (uint64_t)deadline->tv_nsec +
+                    (uint64_t)timeout * (1000000000ULL / FURI_HOST_TICK_FREQUENCY);
+    deadline->tv_sec += nsec / 1000000000ULL;
+    deadline->tv_nsec = nsec % 1000000000ULL;
+}
+
+bool furi_host_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex, struct timespec* deadline) {
+    if(deadline) {
+        return pthread_cond_timedwait(cond, mutex, deadline) != ETIMEDOUT;
+    } else {
+        furi_check(pthread_cond_wait(cond, mutex) == 0);
+        return true;
+    }
+}
+
+bool furi_kernel_is_irq_or_masked() {
+    return false;
+}
+
+int32_t furi_kernel_lock() {
+    // No scheduler to suspend: threads are preemptive system threads
+    return 0;
+}
+
+int32_t furi_kernel_unlock() {
+    return 0;
+}
+
+int32_t furi_kernel_restore_lock(int32_t lock) {
+    return lock;
+}
+
+uint32_t furi_kernel_get_tick_frequency() {
+    return FURI_HOST_TICK_FREQUENCY;
+}
+
+void furi_delay_tick(uint32_t ticks) {
+    furi_delay_us(ticks * (1000000U / FURI_HOST_TICK_FREQUENCY));
+}
+
+FuriStatus furi_delay_until_tick(uint32_t tick) {
+    uint32_t delay = tick - furi_get_tick();
+    if(delay == 0 || delay > INT32_MAX) {
+        return FuriStatusErrorParameter;
+    }
+
+    furi_delay_tick(delay);
+    return FuriStatusOk;
+}
+
+uint32_t furi_get_tick() {
+    return furi_kernel_get_time_us() / (1000000U / FURI_HOST_TICK_FREQUENCY);
+}
+
+uint32_t furi_ms_to_ticks(uint32_t milliseconds) {
+    return milliseconds;
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    furi_delay_tick(furi_ms_to_ticks(milliseconds));
+}
+
+void furi_delay_us(uint32_t microseconds) {
+    struct timespec delay = {
+        .tv_sec = microseconds / 1000000U,
+        .tv_nsec = (microseconds % 1000000U) * 1000U,
+    };
+    while(nanosleep(&delay, &delay) != 0 && errno == EINTR) {
+    }
+}
@@ -0,0 +1,125 @@
+#include <core/memmgr.h>
+#include <core/memmgr_heap.h>
+#include <core/memmgr_slab.h>
+#include <core/memmgr_profiler.h>
+#include <core/common_defines.h>
+
+#include <stdlib.h>
+
+/* Host build uses libc heap directly: heap statistics are not tracked */
+
+/* Firmware takes zeroed heap memory for granted, and free() and realloc()
+ * must recognize slab pointers, same as on device. glibc allows the
+ * executable to replace its allocator entry points. */
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    void* p = __libc_calloc(1, size);
+    memmgr_profiler_on_alloc(p, size, __builtin_return_address(0));
+    return p;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* p = __libc_calloc(count, size);
+    memmgr_profiler_on_alloc(p, count * size, __builtin_return_address(0));
+    return p;
+}
+
+void free(void* ptr) {
+    memmgr_profiler_on_free(ptr);
+    if(ptr && memmgr_slab_release(ptr)) return;
+    __libc_free(ptr);
+}
+
+void* realloc(void* ptr, size_t size) {
+    if(ptr && memmgr_slab_owns(ptr)) {
+        return memmgr_slab_realloc(ptr, size);
+    }
+    memmgr_profiler_on_free(ptr);
+    void* p = __libc_realloc(ptr, size);
+    memmgr_profiler_on_alloc(p, size, __builtin_return_address(0));
+    return p;
+}
+
+void* memmgr_malloc_unprofiled(size_t size) {
+    return __libc_calloc(1, size);
+}
+
+size_t memmgr_get_free_heap(void) {
+    return 0;
+}
+
+size_t memmgr_get_total_heap(void) {
+    return 0;
+}
+
+size_t memmgr_get_minimum_free_heap(void) {
+    return 0;
+}
+
+void* aligned_malloc(size_t size, size_t alignment) {
+    void* p = NULL;
+    // posix_memalign wants at least pointer size alignment
+    furi_check(posix_memalign(&p, MAX(alignment, sizeof(void*)), size) == 0);
+    return p;
+}
+
+void aligned_free(void* p) {
+    free(p);
+}
+
+void* memmgr_alloc_from_pool(size_t size) {
+    void* p = malloc(size);
+    furi_check(p);
+    memset(p, 0, size);
+    return p;
+}
+
+size_t memmgr_pool_get_free(void) {
+    return 0;
+}
+
+size_t memmgr_pool_get_max_block(void) {
+    return 0;
+}
+
+void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+}
+
+void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+}
+
+size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    return MEMMGR_HEAP_UNKNOWN;
+}
+
+void* memmgr_heap_alloc_untraced(size_t size) {
+    void* p = malloc(size);
+    furi_check(p);
+    return p;
+}
+
+void memmgr_heap_trace_alloc(void* pointer, size_t size) {
+    UNUSED(pointer);
+    UNUSED(size);
+}
+
+void memmgr_heap_trace_free(void* pointer) {
+    UNUSED(pointer);
+}
+
+size_t memmgr_heap_get_max_free_block() {
+    return 0;
+}
+
+void memmgr_heap_printf_free_blocks() {
+}
+
+const char* memmgr_heap_get_allocator_name() {
+    return "libc";
+}
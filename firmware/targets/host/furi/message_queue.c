@@ -0,0 +1,158 @@
+#include <core/message_queue.h>
+#include <core/check.h>
+#include "host_i.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    uint32_t msg_count;
+    uint32_t msg_size;
+    uint32_t head;
+    uint32_t count;
+    uint8_t buffer[];
+} FuriMessageQueueHost;
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
+    furi_assert((msg_count > 0U) && (msg_size > 0U));
+
+    FuriMessageQueueHost* instance = malloc(sizeof(FuriMessageQueueHost) + msg_count * msg_size);
+    furi_check(pthread_mutex_init(&instance->mutex, NULL) == 0);
+    furi_check(pthread_cond_init(&instance->not_empty, NULL) == 0);
+    furi_check(pthread_cond_init(&instance->not_full, NULL) == 0);
+    instance->msg_count = msg_count;
+    instance->msg_size = msg_size;
+    instance->head = 0;
+    instance->count = 0;
+    return instance;
+}
+
+void furi_message_queue_free(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    FuriMessageQueueHost* queue = instance;
+    pthread_cond_destroy(&queue->not_full);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_mutex_destroy(&queue->mutex);
+    free(queue);
+}
+
+/* Wait until predicate is true, queue mutex must be held */
+static FuriStatus furi_message_queue_wait(
+    FuriMessageQueueHost* queue,
+    pthread_cond_t* cond,
+    bool (*predicate)(FuriMessageQueueHost* queue),
+    uint32_t timeout) {
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) {
+        furi_host_deadline(timeout, &deadline);
+    }
+
+    while(!predicate(queue)) {
+        if(timeout == 0U) {
+            return FuriStatusErrorResource;
+        }
+        if(!furi_host_cond_wait(
+               cond, &queue->mutex, (timeout == FuriWaitForever) ? NULL : &deadline)) {
+            return FuriStatusErrorTimeout;
+        }
+    }
+
+    return FuriStatusOk;
+}
+
+static bool furi_message_queue_has_space(FuriMessageQueueHost* queue) {
+    return queue->count < queue->msg_count;
+}
+
+static bool furi_message_queue_has_message(FuriMessageQueueHost* queue) {
+    return queue->count > 0;
+}
+
+FuriStatus
+    furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
+    furi_assert(instance);
+    furi_assert(msg_ptr);
+    FuriMessageQueueHost* queue = instance;
+
+    pthread_mutex_lock(&queue->mutex);
+    FuriStatus status = furi_message_queue_wait(
+        queue, &queue->not_full, furi_message_queue_has_space, timeout);
+    if(status == FuriStatusOk) {
+        uint32_t tail = (queue->head + queue->count) % queue->msg_count;
+        memcpy(&queue->buffer[tail * queue->msg_size], msg_ptr, queue->msg_size);
+        queue->count++;
+        pthread_cond_signal(&queue->not_empty);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    return status;
+}
+
+FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
+    furi_assert(instance);
+    furi_assert(msg_ptr);
+    FuriMessageQueueHost* queue = instance;
+
+    pthread_mutex_lock(&queue->mutex);
+    FuriStatus status = furi_message_queue_wait(
+        queue, &queue->not_empty, furi_message_queue_has_message, timeout);
+    if(status == FuriStatusOk) {
+        memcpy(msg_ptr, &queue->buffer[queue->head * queue->msg_size], queue->msg_size);
+        queue->head = (queue->head + 1) % queue->msg_count;
+        queue->count--;
+        pthread_cond_signal(&queue->not_full);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    return status;
+}
+
+uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    FuriMessageQueueHost* queue = instance;
+    return queue->msg_count;
+}
+
+uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    FuriMessageQueueHost* queue = instance;
+    return queue->msg_size;
+}
+
+uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    FuriMessageQueueHost* queue = instance;
+
+    pthread_mutex_lock(&queue->mutex);
+    uint32_t count = queue->count;
+    pthread_mutex_unlock(&queue->mutex);
+
+    return count;
+}
+
+uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    FuriMessageQueueHost* queue = instance;
+
+    pthread_mutex_lock(&queue->mutex);
+    uint32_t space = queue->msg_count - queue->count;
+    pthread_mutex_unlock(&queue->mutex);
+
+    return space;
+}
+
+FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    FuriMessageQueueHost* queue = instance;
+
+    pthread_mutex_lock(&queue->mutex);
+    queue->head = 0;
+    queue->count = 0;
+    pthread_cond_broadcast(&queue->not_full);
+    pthread_mutex_unlock(&queue->mutex);
+
+    return FuriStatusOk;
+}
@@ -0,0 +1,105 @@
+#include <core/mutex.h>
+#include <core/check.h>
+#include "host_i.h"
+
+#include <stdlib.h>
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    FuriMutexType type;
+    FuriThreadId owner;
+    uint32_t count;
+} FuriMutexHost;
+
+/* Built on condition variable: owner is a furi thread id, which is what
+ * recursion and furi_mutex_get_owner are checked against */
+
+FuriMutex* furi_mutex_alloc(FuriMutexType type) {
+    furi_assert(type == FuriMutexTypeNormal || type == FuriMutexTypeRecursive);
+
+    FuriMutexHost* instance = malloc(sizeof(FuriMutexHost));
+    furi_check(pthread_mutex_init(&instance->mutex, NULL) == 0);
+    furi_check(pthread_cond_init(&instance->cond, NULL) == 0);
+    instance->type = type;
+    instance->owner = NULL;
+    instance->count = 0;
+    return instance;
+}
+
+void furi_mutex_free(FuriMutex* instance) {
+    furi_assert(instance);
+    FuriMutexHost* mutex = instance;
+    pthread_cond_destroy(&mutex->cond);
+    pthread_mutex_destroy(&mutex->mutex);
+    free(mutex);
+}
+
+FuriStatus furi_mutex_acquire(FuriMutex* instance, uint32_t timeout) {
+    furi_assert(instance);
+    FuriMutexHost* mutex = instance;
+    FuriThreadId current = furi_thread_get_current_id();
+    FuriStatus status = FuriStatusOk;
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) {
+        furi_host_deadline(timeout, &deadline);
+    }
+
+    pthread_mutex_lock(&mutex->mutex);
+    if(mutex->count && mutex->owner == current) {
+        // Taking normal mutex twice is a deadlock on device too
+        furi_check(mutex->type == FuriMutexTypeRecursive);
+        mutex->count++;
+    } else {
+        while(mutex->count) {
+            if(timeout == 0U) {
+                status = FuriStatusErrorResource;
+                break;
+            }
+            if(!furi_host_cond_wait(
+                   &mutex->cond,
+                   &mutex->mutex,
+                   (timeout == FuriWaitForever) ? NULL : &deadline)) {
+                status = FuriStatusErrorTimeout;
+                break;
+            }
+        }
+
+        if(status == FuriStatusOk) {
+            mutex->owner = current;
+            mutex->count = 1;
+        }
+    }
+    pthread_mutex_unlock(&mutex->mutex);
+
+    return status;
+}
+
+FuriStatus furi_mutex_release(FuriMutex* instance) {
+    furi_assert(instance);
+    FuriMutexHost* mutex = instance;
+    FuriStatus status = FuriStatusOk;
+
+    pthread_mutex_lock(&mutex->mutex);
+    if(!mutex->count || mutex->owner != furi_thread_get_current_id()) {
+        status = FuriStatusErrorResource;
+    } else if(--mutex->count == 0) {
+        mutex->owner = NULL;
+        pthread_cond_signal(&mutex->cond);
+    }
+    pthread_mutex_unlock(&mutex->mutex);
+
+    return status;
+}
+
+FuriThreadId furi_mutex_get_owner(FuriMutex* instance) {
+    furi_assert(instance);
+    FuriMutexHost* mutex = instance;
+
+    pthread_mutex_lock(&mutex->mutex);
+    FuriThreadId owner = mutex->count ? mutex->owner : NULL;
+    pthread_mutex_unlock(&mutex->mutex);
+
+    return owner;
+}
@@ -0,0 +1,91 @@
+#include <core/semaphore.h>
+#include <core/check.h>
+#include "host_i.h"
+
+#include <stdlib.h>
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t max_count;
+    uint32_t count;
+} FuriSemaphoreHost;
+
+FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count) {
+    furi_assert((max_count > 0U) && (initial_count <= max_count));
+
+    FuriSemaphoreHost* instance = malloc(sizeof(FuriSemaphoreHost));
+    furi_check(pthread_mutex_init(&instance->mutex, NULL) == 0);
+    furi_check(pthread_cond_init(&instance->cond, NULL) == 0);
+    instance->max_count = max_count;
+    instance->count = initial_count;
+    return instance;
+}
+
+void furi_semaphore_free(FuriSemaphore* instance) {
+    furi_assert(instance);
+    FuriSemaphoreHost* semaphore = instance;
+    pthread_cond_destroy(&semaphore->cond);
+    pthread_mutex_destroy(&semaphore->mutex);
+    free(semaphore);
+}
+
+FuriStatus furi_semaphore_acquire(FuriSemaphore* instance, uint32_t timeout) {
+    furi_assert(instance);
+    FuriSemaphoreHost* semaphore = instance;
+    FuriStatus status = FuriStatusOk;
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) {
+        furi_host_deadline(timeout, &deadline);
+    }
+
+    pthread_mutex_lock(&semaphore->mutex);
+    while(semaphore->count == 0) {
+        if(timeout == 0U) {
+            status = FuriStatusErrorResource;
+            break;
+        }
+        if(!furi_host_cond_wait(
+               &semaphore->cond,
+               &semaphore->mutex,
+               (timeout == FuriWaitForever) ? NULL : &deadline)) {
+            status = FuriStatusErrorTimeout;
+            break;
+        }
+    }
+    if(status == FuriStatusOk) {
+        semaphore->count--;
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    return status;
+}
+
+FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
+    furi_assert(instance);
+    FuriSemaphoreHost* semaphore = instance;
+    FuriStatus status = FuriStatusOk;
+
+    pthread_mutex_lock(&semaphore->mutex);
+    if(semaphore->count < semaphore->max_count) {
+        semaphore->count++;
+        pthread_cond_signal(&semaphore->cond);
+    } else {
+        status = FuriStatusErrorResource;
+    }
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    return status;
+}
+
+uint32_t furi_semaphore_get_count(FuriSemaphore* instance) {
+    furi_assert(instance);
+    FuriSemaphoreHost* semaphore = instance;
+
+    pthread_mutex_lock(&semaphore->mutex);
+    uint32_t count = semaphore->count;
+    pthread_mutex_unlock(&semaphore->mutex);
+
+    return count;
+}
@@ -0,0 +1,168 @@
+#include <core/base.h>
+#include <core/stream_buffer.h>
+#include <core/check.h>
+#include <core/common_defines.h>
+#include "host_i.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    size_t size;
+    size_t trigger_level;
+    size_t head;
+    size_t count;
+    uint8_t buffer[];
+} FuriStreamBufferHost;
+
+FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level) {
+    furi_assert(size != 0);
+    furi_assert(trigger_level <= size);
+
+    FuriStreamBufferHost* instance = malloc(sizeof(FuriStreamBufferHost) + size);
+    furi_check(pthread_mutex_init(&instance->mutex, NULL) == 0);
+    furi_check(pthread_cond_init(&instance->cond, NULL) == 0);
+    instance->size = size;
+    instance->trigger_level = trigger_level ? trigger_level : 1;
+    instance->head = 0;
+    instance->count = 0;
+    return instance;
+}
+
+void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    FuriStreamBufferHost* stream = stream_buffer;
+    pthread_cond_destroy(&stream->cond);
+    pthread_mutex_destroy(&stream->mutex);
+    free(stream);
+}
+
+bool furi_stream_set_trigger_level(FuriStreamBuffer* stream_buffer, size_t trigger_level) {
+    furi_assert(stream_buffer);
+    FuriStreamBufferHost* stream = stream_buffer;
+
+    if(trigger_level > stream->size) return false;
+
+    pthread_mutex_lock(&stream->mutex);
+    stream->trigger_level = trigger_level ? trigger_level : 1;
+    pthread_mutex_unlock(&stream->mutex);
+    return true;
+}
+
+/* Same as FreeRTOS: sender blocks while buffer is full and writes as much as fits,
+ * receiver blocks while buffer is empty and wakes up on trigger level */
+
+size_t furi_stream_buffer_send(
+    FuriStreamBuffer* stream_buffer,
+    const void* data,
+    size_t length,
+    uint32_t timeout) {
+    furi_assert(stream_buffer);
+    FuriStreamBufferHost* stream = stream_buffer;
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) {
+        furi_host_deadline(timeout, &deadline);
+    }
+
+    pthread_mutex_lock(&stream->mutex);
+    while(stream->count == stream->size && timeout != 0U) {
+        if(!furi_host_cond_wait(
+               &stream->cond, &stream->mutex, (timeout == FuriWaitForever) ? NULL : &deadline)) {
+            break;
+        }
+    }
+
+    size_t sent = MIN(length, stream->size - stream->count);
+    const uint8_t* src = data;
+    for(size_t i = 0; i < sent; i++) {
+        stream->buffer[(stream->head + stream->count + i) % stream->size] = src[i];
+    }
+    stream->count += sent;
+    if(stream->count >= stream->trigger_level) {
+        pthread_cond_broadcast(&stream->cond);
+    }
+    pthread_mutex_unlock(&stream->mutex);
+
+    return sent;
+}
+
+size_t furi_stream_buffer_receive(
+    FuriStreamBuffer* stream_buffer,
+    void* data,
+    size_t length,
+    uint32_t timeout) {
+    furi_assert(stream_buffer);
+    FuriStreamBufferHost* stream = stream_buffer;
+
+    struct timespec deadline;
+    if(timeout != FuriWaitForever) {
+        furi_host_deadline(timeout, &deadline);
+    }
+
+    pthread_mutex_lock(&stream->mutex);
+    if(stream->count == 0) {
+        while(stream->count < stream->trigger_level && timeout != 0U) {
+            if(!furi_host_cond_wait(
+                   &stream->cond,
+                   &stream->mutex,
+                   (timeout == FuriWaitForever) ? NULL : &deadline)) {
+                break;
+            }
+        }
+    }
+
+    size_t received = MIN(length, stream->count);
+    uint8_t* dst = data;
+    for(size_t i = 0; i < received; i++) {
+        dst[i] = stream->buffer[(stream->head + i) % stream->size];
+    }
+    stream->head = (stream->head + received) % stream->size;
+    stream->count -= received;
+    if(received) {
+        pthread_cond_broadcast(&stream->cond);
+    }
+    pthread_mutex_unlock(&stream->mutex);
+
+    return received;
+}
+
+size_t furi_stream_buffer_bytes_available(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    FuriStreamBufferHost* stream = stream_buffer;
+
+    pthread_mutex_lock(&stream->mutex);
+    size_t count = stream->count;
+    pthread_mutex_unlock(&stream->mutex);
+
+    return count;
+}
+
+size_t furi_stream_buffer_spaces_available(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    FuriStreamBufferHost* stream = stream_buffer;
+    return stream->size - furi_stream_buffer_bytes_available(stream_buffer);
+}
+
+bool furi_stream_buffer_is_full(FuriStreamBuffer* stream_buffer) {
+    return furi_stream_buffer_spaces_available(stream_buffer) == 0;
+}
+
+bool furi_stream_buffer_is_empty(FuriStreamBuffer* stream_buffer) {
+    return furi_stream_buffer_bytes_available(stream_buffer) == 0;
+}
+
+FuriStatus furi_stream_buffer_reset(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    FuriStreamBufferHost* stream = stream_buffer;
+
+    pthread_mutex_lock(&stream->mutex);
+    stream->head = 0;
+    stream->count = 0;
+    pthread_cond_broadcast(&stream->cond);
+    pthread_mutex_unlock(&stream->mutex);
+
+    return FuriStatusOk;
+}
@@ -0,0 +1,296 @@
+#include <core/thread.h>
+#include <core/check.h>
+#include <core/log.h>
+#include "host_i.h"
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAG "FuriThread"
+
+/* Same limit as task notifications on device */
+#define MAX_BITS_TASK_NOTIFY 31U
+#define THREAD_FLAGS_INVALID_BITS (~((1UL << MAX_BITS_TASK_NOTIFY) - 1U))
+
+struct FuriThread {
+    FuriThreadState state;
+    int32_t ret;
+
+    FuriThreadCallback callback;
+    void* context;
+
+    FuriThreadStateCallback state_callback;
+    void* state_context;
+
+    char* name;
+    char* appid;
+
+    FuriThreadPriority priority;
+    size_t stack_size;
+
+    pthread_t pthread;
+    FuriHostFlags flags;
+
+    bool is_joinable;
+    bool is_adopted;
+};
+
+static pthread_key_t furi_thread_key;
+static pthread_once_t furi_thread_key_once = PTHREAD_ONCE_INIT;
+
+static void furi_thread_adopted_free(void* context) {
+    FuriThread* thread = context;
+    furi_thread_free(thread);
+}
+
+static void furi_thread_key_init(void) {
+    furi_check(pthread_key_create(&furi_thread_key, furi_thread_adopted_free) == 0);
+}
+
+static void furi_thread_set_state(FuriThread* thread, FuriThreadState state) {
+    furi_assert(thread);
+    thread->state = state;
+    if(thread->state_callback) {
+        thread->state_callback(state, thread->state_context);
+    }
+}
+
+static void* furi_thread_body(void* context) {
+    furi_assert(context);
+    FuriThread* thread = context;
+
+    furi_check(pthread_setspecific(furi_thread_key, thread) == 0);
+
+    furi_assert(thread->state == FuriThreadStateStarting);
+    furi_thread_set_state(thread, FuriThreadStateRunning);
+
+    thread->ret = thread->callback(thread->context);
+
+    furi_assert(thread->state == FuriThreadStateRunning);
+    furi_thread_set_state(thread, FuriThreadStateStopped);
+
+    // Instance is owned by whoever allocated it, not by TLS destructor
+    pthread_setspecific(furi_thread_key, NULL);
+    return NULL;
+}
+
+FuriThread* furi_thread_alloc() {
+    pthread_once(&furi_thread_key_once, furi_thread_key_init);
+
+    FuriThread* thread = malloc(sizeof(FuriThread));
+    memset(thread, 0, sizeof(FuriThread));
+    furi_host_flags_init(&thread->flags);
+
+    FuriThread* parent = pthread_getspecific(furi_thread_key);
+    furi_thread_set_appid(thread, (parent && parent->appid) ? parent->appid : "host");
+
+    return thread;
+}
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    FuriThread* thread = furi_thread_alloc();
+    furi_thread_set_name(thread, name);
+    furi_thread_set_stack_size(thread, stack_size);
+    furi_thread_set_callback(thread, callback);
+    furi_thread_set_context(thread, context);
+    return thread;
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->is_adopted || thread->state == FuriThreadStateStopped);
+
+    if(thread->is_joinable) {
+        pthread_join(thread->pthread, NULL);
+    }
+    if(thread->name) free(thread->name);
+    if(thread->appid) free(thread->appid);
+    furi_host_flags_deinit(&thread->flags);
+
+    free(thread);
+}
+
+void furi_thread_set_name(FuriThread* thread, const char* name) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    if(thread->name) free(thread->name);
+    thread->name = name ? strdup(name) : NULL;
+}
+
+void furi_thread_set_appid(FuriThread* thread, const char* appid) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    if(thread->appid) free(thread->appid);
+    thread->appid = appid ? strdup(appid) : NULL;
+}
+
+void furi_thread_mark_as_service(FuriThread* thread) {
+    UNUSED(thread);
+}
+
+void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    furi_assert(stack_size % 4 == 0);
+    // Only recorded: host stacks are much bigger than device ones anyway
+    thread->stack_size = stack_size;
+}
+
+void furi_thread_set_callback(FuriThread* thread, FuriThreadCallback callback) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->callback = callback;
+}
+
+void furi_thread_set_context(FuriThread* thread, void* context) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->context = context;
+}
+
+void furi_thread_set_priority(FuriThread* thread, FuriThreadPriority priority) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    // Only recorded: host scheduler is not real time
+    thread->priority = priority;
+}
+
+void furi_thread_set_current_priority(FuriThreadPriority priority) {
+    furi_thread_get_current()->priority = priority;
+}
+
+FuriThreadPriority furi_thread_get_current_priority() {
+    return furi_thread_get_current()->priority;
+}
+
+void furi_thread_set_state_callback(FuriThread* thread, FuriThreadStateCallback callback) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->state_callback = callback;
+}
+
+void furi_thread_set_state_context(FuriThread* thread, void* context) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->state_context = context;
+}
+
+FuriThreadState furi_thread_get_state(FuriThread* thread) {
+    furi_assert(thread);
+    return thread->state;
+}
+
+void furi_thread_start(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->callback);
+    furi_assert(thread->state == FuriThreadStateStopped);
+
+    furi_thread_set_state(thread, FuriThreadStateStarting);
+    furi_check(pthread_create(&thread->pthread, NULL, furi_thread_body, thread) == 0);
+    thread->is_joinable = true;
+}
+
+bool furi_thread_join(FuriThread* thread) {
+    furi_assert(thread);
+    furi_check(furi_thread_get_current() != thread);
+
+    if(thread->is_joinable) {
+        furi_check(pthread_join(thread->pthread, NULL) == 0);
+        thread->is_joinable = false;
+    }
+
+    return true;
+}
+
+FuriThreadId furi_thread_get_id(FuriThread* thread) {
+    furi_assert(thread);
+    return thread;
+}
+
+void furi_thread_enable_heap_trace(FuriThread* thread) {
+    UNUSED(thread);
+}
+
+void furi_thread_disable_heap_trace(FuriThread* thread) {
+    UNUSED(thread);
+}
+
+size_t furi_thread_get_heap_size(FuriThread* thread) {
+    UNUSED(thread);
+    return 0;
+}
+
+int32_t furi_thread_get_return_code(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    return thread->ret;
+}
+
+FuriThreadId furi_thread_get_current_id() {
+    return furi_thread_get_current();
+}
+
+FuriThread* furi_thread_get_current() {
+    pthread_once(&furi_thread_key_once, furi_thread_key_init);
+
+    FuriThread* thread = pthread_getspecific(furi_thread_key);
+    if(!thread) {
+        // Thread not started by furi, main one for example: give it nameless instance
+        thread = furi_thread_alloc();
+        thread->is_adopted = true;
+        thread->state = FuriThreadStateRunning;
+        furi_check(pthread_setspecific(furi_thread_key, thread) == 0);
+    }
+
+    return thread;
+}
+
+void furi_thread_yield() {
+    sched_yield();
+}
+
+uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags) {
+    FuriThread* thread = thread_id;
+    if((thread == NULL) || ((flags & THREAD_FLAGS_INVALID_BITS) != 0U)) {
+        return (uint32_t)FuriStatusErrorParameter;
+    }
+
+    /* Return flags after setting */
+    return furi_host_flags_set(&thread->flags, flags);
+}
+
+uint32_t furi_thread_flags_clear(uint32_t flags) {
+    if((flags & THREAD_FLAGS_INVALID_BITS) != 0U) {
+        return (uint32_t)FuriStatusErrorParameter;
+    }
+
+    /* Return flags before clearing */
+    return furi_host_flags_clear(&furi_thread_get_current()->flags, flags);
+}
+
+uint32_t furi_thread_flags_get(void) {
+    return furi_host_flags_get(&furi_thread_get_current()->flags);
+}
+
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout) {
+    if((flags & THREAD_FLAGS_INVALID_BITS) != 0U) {
+        return (uint32_t)FuriStatusErrorParameter;
+    }
+
+    return furi_host_flags_wait(&furi_thread_get_current()->flags, flags, options, timeout);
+}
+
+const char* furi_thread_get_name(FuriThreadId thread_id) {
+    FuriThread* thread = thread_id;
+    return thread ? thread->name : NULL;
+}
+
+const char* furi_thread_get_appid(FuriThreadId thread_id) {
+    FuriThread* thread = thread_id;
+    return thread ? thread->appid : NULL;
+}
@@ -0,0 +1,8 @@
+#include <furi_hal.h>
+
+void furi_hal_init() {
+    furi_hal_random_init();
+    furi_hal_rtc_init();
+    furi_hal_crypto_init();
+    furi_hal_crc_init();
+}
@@ -0,0 +1,7 @@
+#include <furi_hal_console.h>
+
+#include <stdio.h>
+
+void furi_hal_console_puts(const char* data) {
+    fputs(data, stderr);
+}
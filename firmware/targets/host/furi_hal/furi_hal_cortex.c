@@ -0,0 +1,50 @@
+#include <furi_hal.h>
+#include <furi.h>
+
+#include <time.h>
+
+/* Cycle counter is emulated with monotonic clock, running at device CPU frequency */
+#define FURI_HAL_CORTEX_CPU_FREQUENCY (64000000U)
+#define FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND (FURI_HAL_CORTEX_CPU_FREQUENCY / 1000000U)
+
+static __thread FuriHalCortexHostDwt furi_hal_cortex_dwt;
+
+static uint32_t furi_hal_cortex_get_cycles(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t time_ns = (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+    // Wraps around, same as the real one
+    return (uint32_t)(time_ns * FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND / 1000U);
+}
+
+const FuriHalCortexHostDwt* furi_hal_cortex_host_dwt() {
+    furi_hal_cortex_dwt.CYCCNT = furi_hal_cortex_get_cycles();
+    return &furi_hal_cortex_dwt;
+}
+
+void furi_hal_cortex_init_early() {
+}
+
+void furi_hal_cortex_delay_us(uint32_t microseconds) {
+    furi_delay_us(microseconds);
+}
+
+uint32_t furi_hal_cortex_instructions_per_microsecond() {
+    return FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND;
+}
+
+FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us) {
+    FuriHalCortexTimer cortex_timer = {0};
+    cortex_timer.start = furi_hal_cortex_get_cycles();
+    cortex_timer.value = timeout_us * FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND;
+    return cortex_timer;
+}
+
+bool furi_hal_cortex_timer_is_expired(FuriHalCortexTimer cortex_timer) {
+    return !((furi_hal_cortex_get_cycles() - cortex_timer.start) < cortex_timer.value);
+}
+
+void furi_hal_cortex_timer_wait(FuriHalCortexTimer cortex_timer) {
+    while(!furi_hal_cortex_timer_is_expired(cortex_timer))
+        ;
+}
@@ -0,0 +1,23 @@
+#include <furi_hal_crc.h>
+#include <furi.h>
+
+/* No CRC unit on host: it's always busy, so callers take software path */
+
+void furi_hal_crc_init() {
+}
+
+bool furi_hal_crc_acquire(uint32_t timeout) {
+    UNUSED(timeout);
+    return false;
+}
+
+void furi_hal_crc_release() {
+    furi_crash("CRC unit is not acquired");
+}
+
+uint32_t furi_hal_crc_calc(uint32_t crc, const void* data, size_t size) {
+    UNUSED(crc);
+    UNUSED(data);
+    UNUSED(size);
+    furi_crash("CRC unit is not acquired");
+}
@@ -0,0 +1,62 @@
+#include <furi_hal_crypto.h>
+#include <furi.h>
+
+#define TAG "FuriHalCrypto"
+
+/* No secure enclave on host: key slots can't be loaded, so encrypted
+ * resources (keystores) fail to load same way as on a device without keys */
+
+void furi_hal_crypto_init() {
+}
+
+bool furi_hal_crypto_enclave_verify(uint8_t* keys_nb, uint8_t* valid_keys_nb) {
+    if(keys_nb) *keys_nb = 0;
+    if(valid_keys_nb) *valid_keys_nb = 0;
+    return false;
+}
+
+bool furi_hal_crypto_enclave_ensure_key(uint8_t key_slot) {
+    UNUSED(key_slot);
+    return false;
+}
+
+bool furi_hal_crypto_enclave_store_key(FuriHalCryptoKey* key, uint8_t* slot) {
+    UNUSED(key);
+    UNUSED(slot);
+    return false;
+}
+
+bool furi_hal_crypto_enclave_load_key(uint8_t slot, const uint8_t* iv) {
+    UNUSED(iv);
+    FURI_LOG_D(TAG, "Key slot %u is not available on host", slot);
+    return false;
+}
+
+bool furi_hal_crypto_enclave_unload_key(uint8_t slot) {
+    UNUSED(slot);
+    return false;
+}
+
+bool furi_hal_crypto_load_key(const uint8_t* key, const uint8_t* iv) {
+    UNUSED(key);
+    UNUSED(iv);
+    return false;
+}
+
+bool furi_hal_crypto_unload_key(void) {
+    return false;
+}
+
+bool furi_hal_crypto_encrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
+
+bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
@@ -0,0 +1,119 @@
+#include <furi_hal_flash.h>
+#include <furi.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define TAG "FuriHalFlash"
+
+/* Same geometry as on device, free region size is close to a typical firmware build */
+#define FURI_HAL_FLASH_READ_BLOCK 8
+#define FURI_HAL_FLASH_WRITE_BLOCK 8
+#define FURI_HAL_FLASH_PAGE_SIZE 4096
+#define FURI_HAL_FLASH_CYCLES_COUNT 10000
+#define FURI_HAL_FLASH_FREE_PAGE_COUNT 64
+#define FURI_HAL_FLASH_ERASED_BYTE 0xFF
+
+static uint8_t* furi_hal_flash_memory = NULL;
+
+void furi_hal_flash_init() {
+    if(furi_hal_flash_memory) return;
+
+    // Page aligned, storage computes page numbers from addresses
+    furi_hal_flash_memory = aligned_alloc(
+        FURI_HAL_FLASH_PAGE_SIZE, FURI_HAL_FLASH_PAGE_SIZE * FURI_HAL_FLASH_FREE_PAGE_COUNT);
+    furi_check(furi_hal_flash_memory);
+    memset(
+        furi_hal_flash_memory,
+        FURI_HAL_FLASH_ERASED_BYTE,
+        FURI_HAL_FLASH_PAGE_SIZE * FURI_HAL_FLASH_FREE_PAGE_COUNT);
+}
+
+size_t furi_hal_flash_get_base() {
+    return (size_t)furi_hal_flash_memory;
+}
+
+/* Only emulated free pages: firmware image is not in flash on host */
+bool furi_hal_flash_contains_address(size_t address) {
+    const size_t base = (size_t)furi_hal_flash_memory;
+    return base && (address >= base) &&
+           (address < base + FURI_HAL_FLASH_PAGE_SIZE * FURI_HAL_FLASH_FREE_PAGE_COUNT);
+}
+
+size_t furi_hal_flash_get_read_block_size() {
+    return FURI_HAL_FLASH_READ_BLOCK;
+}
+
+size_t furi_hal_flash_get_write_block_size() {
+    return FURI_HAL_FLASH_WRITE_BLOCK;
+}
+
+size_t furi_hal_flash_get_page_size() {
+    return FURI_HAL_FLASH_PAGE_SIZE;
+}
+
+size_t furi_hal_flash_get_cycles_count() {
+    return FURI_HAL_FLASH_CYCLES_COUNT;
+}
+
+const void* furi_hal_flash_get_free_start_address() {
+    return furi_hal_flash_memory;
+}
+
+const void* furi_hal_flash_get_free_end_address() {
+    return furi_hal_flash_memory + FURI_HAL_FLASH_PAGE_SIZE * FURI_HAL_FLASH_FREE_PAGE_COUNT;
+}
+
+size_t furi_hal_flash_get_free_page_start_address() {
+    return (size_t)furi_hal_flash_memory;
+}
+
+size_t furi_hal_flash_get_free_page_count() {
+    return FURI_HAL_FLASH_FREE_PAGE_COUNT;
+}
+
+void furi_hal_flash_erase(uint8_t page) {
+    furi_check(furi_hal_flash_memory);
+    furi_check(page < FURI_HAL_FLASH_FREE_PAGE_COUNT);
+    memset(
+        furi_hal_flash_memory + page * FURI_HAL_FLASH_PAGE_SIZE,
+        FURI_HAL_FLASH_ERASED_BYTE,
+        FURI_HAL_FLASH_PAGE_SIZE);
+}
+
+static void furi_hal_flash_check_range(size_t address, size_t size) {
+    furi_check(furi_hal_flash_memory);
+    furi_check(address >= (size_t)furi_hal_flash_memory);
+    furi_check(
+        address + size <= (size_t)furi_hal_flash_memory +
+                              FURI_HAL_FLASH_PAGE_SIZE * FURI_HAL_FLASH_FREE_PAGE_COUNT);
+}
+
+void furi_hal_flash_write_dword(size_t address, uint64_t data) {
+    furi_check((address % FURI_HAL_FLASH_WRITE_BLOCK) == 0);
+    furi_hal_flash_check_range(address, sizeof(uint64_t));
+
+    // Same as on device: programming is only allowed into erased double word
+    uint64_t* destination = (uint64_t*)address;
+    if(*destination != UINT64_MAX) {
+        furi_crash("Flash write to programmed area");
+    }
+    *destination = data;
+}
+
+void furi_hal_flash_program_page(const uint8_t page, const uint8_t* data, uint16_t length) {
+    size_t address = (size_t)furi_hal_flash_memory + page * FURI_HAL_FLASH_PAGE_SIZE;
+    furi_check(length <= FURI_HAL_FLASH_PAGE_SIZE);
+    furi_hal_flash_erase(page);
+    memcpy((void*)address, data, length);
+}
+
+int16_t furi_hal_flash_get_page_number(size_t address) {
+    const size_t base = (size_t)furi_hal_flash_memory;
+    if((address < base) ||
+       (address >= base + FURI_HAL_FLASH_PAGE_SIZE * FURI_HAL_FLASH_FREE_PAGE_COUNT)) {
+        return -1;
+    }
+
+    return (address - base) / FURI_HAL_FLASH_PAGE_SIZE;
+}
@@ -0,0 +1,21 @@
+#include <furi_hal_random.h>
+
+#include <stdlib.h>
+#include <time.h>
+
+/* Not cryptographically strong, same as libraries expect from it off device */
+
+void furi_hal_random_init() {
+    srandom(time(NULL));
+}
+
+uint32_t furi_hal_random_get() {
+    // random() gives 31 bits
+    return ((uint32_t)random() << 16) ^ (uint32_t)random();
+}
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    for(uint32_t i = 0; i < len; i++) {
+        buf[i] = random() & 0xFF;
+    }
+}
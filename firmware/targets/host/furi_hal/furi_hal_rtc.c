@@ -0,0 +1,185 @@
+#include <furi_hal_rtc.h>
+#include <furi.h>
+
+#include <time.h>
+
+/* Backup registers live in process memory, clock is system local time */
+
+typedef struct {
+    uint32_t registers[FuriHalRtcRegisterMAX];
+    uint32_t flags;
+    uint8_t log_level;
+    FuriHalRtcBootMode boot_mode;
+    FuriHalRtcHeapTrackMode heap_track_mode;
+    FuriHalRtcLocaleUnits locale_units;
+    FuriHalRtcLocaleTimeFormat locale_timeformat;
+    FuriHalRtcLocaleDateFormat locale_dateformat;
+    uint32_t fault_data;
+    uint32_t pin_fails;
+} FuriHalRtc;
+
+static FuriHalRtc furi_hal_rtc = {0};
+
+void furi_hal_rtc_init_early() {
+}
+
+void furi_hal_rtc_deinit_early() {
+}
+
+void furi_hal_rtc_init() {
+}
+
+void furi_hal_rtc_sync_shadow() {
+}
+
+uint32_t furi_hal_rtc_get_register(FuriHalRtcRegister reg) {
+    furi_check(reg < FuriHalRtcRegisterMAX);
+    return furi_hal_rtc.registers[reg];
+}
+
+void furi_hal_rtc_set_register(FuriHalRtcRegister reg, uint32_t value) {
+    furi_check(reg < FuriHalRtcRegisterMAX);
+    furi_hal_rtc.registers[reg] = value;
+}
+
+void furi_hal_rtc_set_log_level(uint8_t level) {
+    furi_hal_rtc.log_level = level;
+    furi_log_set_level(level);
+}
+
+uint8_t furi_hal_rtc_get_log_level() {
+    return furi_hal_rtc.log_level;
+}
+
+void furi_hal_rtc_set_flag(FuriHalRtcFlag flag) {
+    furi_hal_rtc.flags |= flag;
+}
+
+void furi_hal_rtc_reset_flag(FuriHalRtcFlag flag) {
+    furi_hal_rtc.flags &= ~flag;
+}
+
+bool furi_hal_rtc_is_flag_set(FuriHalRtcFlag flag) {
+    return furi_hal_rtc.flags & flag;
+}
+
+void furi_hal_rtc_set_boot_mode(FuriHalRtcBootMode mode) {
+    furi_hal_rtc.boot_mode = mode;
+}
+
+FuriHalRtcBootMode furi_hal_rtc_get_boot_mode() {
+    return furi_hal_rtc.boot_mode;
+}
+
+void furi_hal_rtc_set_heap_track_mode(FuriHalRtcHeapTrackMode mode) {
+    furi_hal_rtc.heap_track_mode = mode;
+}
+
+FuriHalRtcHeapTrackMode furi_hal_rtc_get_heap_track_mode() {
+    return furi_hal_rtc.heap_track_mode;
+}
+
+void furi_hal_rtc_set_locale_units(FuriHalRtcLocaleUnits value) {
+    furi_hal_rtc.locale_units = value;
+}
+
+FuriHalRtcLocaleUnits furi_hal_rtc_get_locale_units() {
+    return furi_hal_rtc.locale_units;
+}
+
+void furi_hal_rtc_set_locale_timeformat(FuriHalRtcLocaleTimeFormat value) {
+    furi_hal_rtc.locale_timeformat = value;
+}
+
+FuriHalRtcLocaleTimeFormat furi_hal_rtc_get_locale_timeformat() {
+    return furi_hal_rtc.locale_timeformat;
+}
+
+void furi_hal_rtc_set_locale_dateformat(FuriHalRtcLocaleDateFormat value) {
+    furi_hal_rtc.locale_dateformat = value;
+}
+
+FuriHalRtcLocaleDateFormat furi_hal_rtc_get_locale_dateformat() {
+    return furi_hal_rtc.locale_dateformat;
+}
+
+void furi_hal_rtc_set_datetime(FuriHalRtcDateTime* datetime) {
+    UNUSED(datetime);
+    // System clock belongs to the host
+}
+
+void furi_hal_rtc_get_datetime(FuriHalRtcDateTime* datetime) {
+    furi_assert(datetime);
+
+    time_t now = time(NULL);
+    struct tm local;
+    localtime_r(&now, &local);
+
+    datetime->hour = local.tm_hour;
+    datetime->minute = local.tm_min;
+    datetime->second = local.tm_sec;
+    datetime->day = local.tm_mday;
+    datetime->month = local.tm_mon + 1;
+    datetime->year = local.tm_year + 1900;
+    datetime->weekday = local.tm_wday ? local.tm_wday : 7;
+}
+
+bool furi_hal_rtc_validate_datetime(FuriHalRtcDateTime* datetime) {
+    furi_assert(datetime);
+
+    return datetime->second < 60 && datetime->minute < 60 && datetime->hour < 24 &&
+           datetime->day >= 1 && datetime->month >= 1 && datetime->month <= 12 &&
+           datetime->day <= furi_hal_rtc_get_days_per_month(
+                                 furi_hal_rtc_is_leap_year(datetime->year), datetime->month) &&
+           datetime->year >= 2000 && datetime->year <= 2099 && datetime->weekday >= 1 &&
+           datetime->weekday <= 7;
+}
+
+void furi_hal_rtc_set_fault_data(uint32_t value) {
+    furi_hal_rtc.fault_data = value;
+}
+
+uint32_t furi_hal_rtc_get_fault_data() {
+    return furi_hal_rtc.fault_data;
+}
+
+void furi_hal_rtc_set_pin_fails(uint32_t value) {
+    furi_hal_rtc.pin_fails = value;
+}
+
+uint32_t furi_hal_rtc_get_pin_fails() {
+    return furi_hal_rtc.pin_fails;
+}
+
+uint32_t furi_hal_rtc_get_timestamp() {
+    FuriHalRtcDateTime datetime = {0};
+    furi_hal_rtc_get_datetime(&datetime);
+    return furi_hal_rtc_datetime_to_timestamp(&datetime);
+}
+
+uint32_t furi_hal_rtc_datetime_to_timestamp(FuriHalRtcDateTime* datetime) {
+    // Same as on device: local time counted as if it was UTC
+    struct tm tm = {
+        .tm_sec = datetime->second,
+        .tm_min = datetime->minute,
+        .tm_hour = datetime->hour,
+        .tm_mday = datetime->day,
+        .tm_mon = datetime->month - 1,
+        .tm_year = datetime->year - 1900,
+    };
+    return (uint32_t)timegm(&tm);
+}
+
+uint16_t furi_hal_rtc_get_days_per_year(uint16_t year) {
+    return furi_hal_rtc_is_leap_year(year) ? 366 : 365;
+}
+
+bool furi_hal_rtc_is_leap_year(uint16_t year) {
+    return (((year) % 4 == 0) && ((year) % 100 != 0)) || ((year) % 400 == 0);
+}
+
+uint8_t furi_hal_rtc_get_days_per_month(bool leap_year, uint8_t month) {
+    static const uint8_t days_per_month[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    furi_check(month >= 1 && month <= 12);
+    return days_per_month[month - 1] + ((leap_year && month == 2) ? 1 : 0);
+}
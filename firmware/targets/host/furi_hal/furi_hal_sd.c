@@ -0,0 +1,14 @@
+#include <furi_hal_sd.h>
+#include <sd_host.h>
+
+FuriHalSpiBusHandle* furi_hal_sd_spi_handle = NULL;
+
+void hal_sd_detect_init(void) {
+}
+
+void hal_sd_detect_set_low(void) {
+}
+
+bool hal_sd_detect(void) {
+    return sd_host_is_inserted();
+}
@@ -0,0 +1,20 @@
+#include <furi_hal_spi.h>
+#include <furi.h>
+
+/* No bus on host: handles only exist to be acquired, storage worker serializes SD access */
+struct FuriHalSpiBusHandle {
+    const char* name;
+};
+
+FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_fast = {.name = "sd_fast"};
+FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_slow = {.name = "sd_slow"};
+
+void furi_hal_spi_acquire(FuriHalSpiBusHandle* handle) {
+    furi_assert(handle);
+    UNUSED(handle);
+}
+
+void furi_hal_spi_release(FuriHalSpiBusHandle* handle) {
+    furi_assert(handle);
+    UNUSED(handle);
+}
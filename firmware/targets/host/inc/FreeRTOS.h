@@ -0,0 +1,7 @@
+/**
+ * @file FreeRTOS.h
+ * Host build: stands in for the kernel configuration pulled by furi headers
+ */
+#pragma once
+
+#define configMAX_PRIORITIES (32)
@@ -0,0 +1,17 @@
+/**
+ * @file cmsis_compiler.h
+ * Host build: core register accessors used by furi headers
+ *
+ * Host code never runs in interrupt context and never masks interrupts.
+ */
+#pragma once
+
+#include <stdint.h>
+
+static inline uint32_t __get_PRIMASK(void) {
+    return 0;
+}
+
+static inline uint32_t __get_IPSR(void) {
+    return 0;
+}
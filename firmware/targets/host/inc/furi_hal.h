@@ -0,0 +1,47 @@
+/**
+ * @file furi_hal.h
+ * Host build: subset of Furi HAL that libraries can use off device
+ *
+ * Declarations come from the target independent headers, implementations
+ * from firmware/targets/host/furi_hal.
+ */
+#pragma once
+
+#include <furi_hal_cortex.h>
+#include <furi_hal_console.h>
+#include <furi_hal_crc.h>
+#include <furi_hal_crypto.h>
+#include <furi_hal_flash.h>
+#include <furi_hal_gpio.h>
+#include <furi_hal_memory.h>
+#include <furi_hal_random.h>
+#include <furi_hal_rtc.h>
+#include <furi_hal_sd.h>
+#include <furi_hal_spi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Init host HAL: must be called before anything else */
+void furi_hal_init();
+
+/** Cycle counter registers, as far as code outside of HAL uses them */
+typedef struct {
+    uint32_t CYCCNT;
+} FuriHalCortexHostDwt;
+
+/** Get cycle counter snapshot, counts at CPU frequency of the device
+ *
+ * @return     thread local snapshot, taken on every call
+ */
+const FuriHalCortexHostDwt* furi_hal_cortex_host_dwt();
+
+#define DWT (furi_hal_cortex_host_dwt())
+
+/** No fixed RAM region on host: addresses in traces are absolute */
+#define SRAM_BASE ((uintptr_t)0)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,15 @@
+/**
+ * @file furi_hal_console.h
+ * Host build: console output goes to stderr
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void furi_hal_console_puts(const char* data);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,41 @@
+/**
+ * @file furi_hal_gpio.h
+ * Host build: GPIO types referenced by library headers, no GPIO access
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    void* port;
+    uint16_t pin;
+} GpioPin;
+
+typedef enum {
+    GpioModeInput,
+    GpioModeOutputPushPull,
+    GpioModeOutputOpenDrain,
+    GpioModeAnalog,
+} GpioMode;
+
+typedef enum {
+    GpioPullNo,
+    GpioPullUp,
+    GpioPullDown,
+} GpioPull;
+
+typedef enum {
+    GpioSpeedLow,
+    GpioSpeedMedium,
+    GpioSpeedHigh,
+    GpioSpeedVeryHigh,
+} GpioSpeed;
+
+#ifdef __cplusplus
+}
+#endif
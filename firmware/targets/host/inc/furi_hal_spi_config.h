@@ -0,0 +1,21 @@
+/**
+ * @file furi_hal_spi_config.h
+ * Host build: SPI handles used by storage, acquiring them only serializes callers
+ */
+#pragma once
+
+#include <furi_hal_spi_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** SD Card in fast mode */
+extern FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_fast;
+
+/** SD Card in slow mode */
+extern FuriHalSpiBusHandle furi_hal_spi_bus_handle_sd_slow;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file furi_hal_spi_types.h
+ * Host build: SPI bus and handle are opaque, there is no bus to configure
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriHalSpiBus FuriHalSpiBus;
+typedef struct FuriHalSpiBusHandle FuriHalSpiBusHandle;
+
+#ifdef __cplusplus
+}
+#endif
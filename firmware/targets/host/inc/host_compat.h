@@ -0,0 +1,15 @@
+/**
+ * @file host_compat.h
+ * Host build: newlib definitions that firmware headers take for granted
+ *
+ * Force included into every host translation unit. On device stdint.h
+ * comes from newlib and brings size_t and _ATTRIBUTE along, glibc does not.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <sys/cdefs.h>
+
+#ifndef _ATTRIBUTE
+#define _ATTRIBUTE(attrs) __attribute__(attrs)
+#endif
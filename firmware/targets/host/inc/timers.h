@@ -0,0 +1,5 @@
+/**
+ * @file timers.h
+ * Host build: furi headers include it, furi core on host doesn't need it
+ */
+#pragma once
@@ -0,0 +1,57 @@
+#include <furi.h>
+#include <lib/toolbox/level_duration.h>
+#include <lib/subghz/subghz_file_encoder_worker.h>
+
+#define TAG "SubGhzFileEncoderWorker"
+
+/* Host build: RAW transmission needs radio device, worker never starts */
+
+struct SubGhzFileEncoderWorker {
+    SubGhzFileEncoderWorkerCallbackEnd callback_end;
+    void* context_end;
+};
+
+void subghz_file_encoder_worker_callback_end(
+    SubGhzFileEncoderWorker* instance,
+    SubGhzFileEncoderWorkerCallbackEnd callback_end,
+    void* context_end) {
+    furi_assert(instance);
+    instance->callback_end = callback_end;
+    instance->context_end = context_end;
+}
+
+SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc() {
+    SubGhzFileEncoderWorker* instance = malloc(sizeof(SubGhzFileEncoderWorker));
+    instance->callback_end = NULL;
+    instance->context_end = NULL;
+    return instance;
+}
+
+void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
+    furi_assert(instance);
+    free(instance);
+}
+
+LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
+    UNUSED(context);
+    return level_duration_reset();
+}
+
+bool subghz_file_encoder_worker_start(
+    SubGhzFileEncoderWorker* instance,
+    const char* file_path,
+    const char* radio_device_name) {
+    furi_assert(instance);
+    UNUSED(file_path);
+    FURI_LOG_E(TAG, "No radio device %s on host", radio_device_name);
+    return false;
+}
+
+void subghz_file_encoder_worker_stop(SubGhzFileEncoderWorker* instance) {
+    furi_assert(instance);
+}
+
+bool subghz_file_encoder_worker_is_running(SubGhzFileEncoderWorker* instance) {
+    furi_assert(instance);
+    return false;
+}
@@ -0,0 +1,23 @@
+#include <storages/sd_notify.h>
+
+/* Host build: no LED to blink, card events are only logged by storage */
+
+void sd_notify_wait(NotificationApp* notifications) {
+    UNUSED(notifications);
+}
+
+void sd_notify_wait_off(NotificationApp* notifications) {
+    UNUSED(notifications);
+}
+
+void sd_notify_success(NotificationApp* notifications) {
+    UNUSED(notifications);
+}
+
+void sd_notify_eject(NotificationApp* notifications) {
+    UNUSED(notifications);
+}
+
+void sd_notify_error(NotificationApp* notifications) {
+    UNUSED(notifications);
+}
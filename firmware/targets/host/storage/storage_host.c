@@ -0,0 +1,97 @@
+#include "storage_host.h"
+#include "storage_posix.h"
+
+#include <storage/storage_i.h>
+#include <storage/storages/storage_ext.h>
+#include <storage/storages/storage_int.h>
+#include <notification/notification.h>
+#include <sd_host.h>
+
+#define TAG "StorageHost"
+
+#define STORAGE_HOST_STACK_SIZE (3 * 1024)
+
+/* Stands for notification service, only SD card notifications open it and they do nothing */
+static uint8_t storage_host_notification_stub;
+
+/* Same as on device, minus status bar icon */
+static void storage_host_tick(Storage* app) {
+    StorageStatus status = app->storage[ST_EXT].status;
+
+    for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
+        StorageApi api = app->storage[i].api;
+        if(api.tick != NULL) {
+            api.tick(&app->storage[i]);
+        }
+    }
+
+    if(status != app->storage[ST_EXT].status) {
+        StorageEvent event = {.type = StorageEventTypeCardMountError};
+        if(app->storage[ST_EXT].status == StorageStatusNotReady) {
+            FURI_LOG_I(TAG, "SD card unmount");
+            event.type = StorageEventTypeCardUnmount;
+        } else if(app->storage[ST_EXT].status == StorageStatusOK) {
+            FURI_LOG_I(TAG, "SD card mount");
+            event.type = StorageEventTypeCardMount;
+        }
+        furi_pubsub_publish(app->pubsub, &event);
+    }
+}
+
+static int32_t storage_host_srv(void* context) {
+    Storage* app = context;
+    storage_worker_run(app, ST_EXT, storage_host_tick);
+    return 0;
+}
+
+static void storage_host_ram_init(Storage* app, const StorageHostConfig* config) {
+    furi_hal_flash_init();
+    storage_int_init(&app->storage[ST_INT]);
+
+    if(config->sd_size) {
+        sd_host_insert(config->sd_size);
+    }
+    storage_ext_init(&app->storage[ST_EXT]);
+
+    // Card is blank
+    if(storage_data_status(&app->storage[ST_EXT]) == StorageStatusNoFS) {
+        FS_Error error = sd_format_card(&app->storage[ST_EXT]);
+        FURI_LOG_I(TAG, "SD card format: %s", filesystem_api_error_get_desc(error));
+    }
+}
+
+Storage* storage_host_start(const StorageHostConfig* config) {
+    furi_assert(config);
+
+    Storage* app = malloc(sizeof(Storage));
+    app->pubsub = furi_pubsub_alloc();
+
+    for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
+        storage_worker_init(&app->worker[i]);
+        storage_data_init(&app->storage[i]);
+        storage_data_timestamp(&app->storage[i]);
+    }
+
+    if(!furi_record_exists(RECORD_NOTIFICATION)) {
+        furi_record_create(RECORD_NOTIFICATION, &storage_host_notification_stub);
+    }
+
+    if(config->backend == StorageHostBackendRam) {
+        storage_host_ram_init(app, config);
+    } else {
+        furi_check(config->ext_root && config->int_root);
+        storage_posix_init(&app->storage[ST_INT], config->int_root);
+        storage_posix_init(&app->storage[ST_EXT], config->ext_root);
+    }
+
+    storage_worker_start(app, ST_INT);
+
+    // Service thread serves external storage, same as on device
+    FuriThread* thread =
+        furi_thread_alloc_ex("StorageSrv", STORAGE_HOST_STACK_SIZE, storage_host_srv, app);
+    furi_thread_start(thread);
+
+    furi_record_create(RECORD_STORAGE, app);
+
+    return app;
+}
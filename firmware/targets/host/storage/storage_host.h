@@ -0,0 +1,41 @@
+/**
+ * @file storage_host.h
+ * Host build: storage service
+ *
+ * Runs the same storage service as on device: message processing, workers
+ * and backends behind FS_Api. Backing storage is either a host directory
+ * or real FatFS and littlefs on RAM block devices.
+ */
+#pragma once
+
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    StorageHostBackendPosix, /**< /ext and /int are host directories */
+    StorageHostBackendRam, /**< FatFS on RAM SD card for /ext, littlefs on RAM flash for /int */
+} StorageHostBackend;
+
+typedef struct {
+    StorageHostBackend backend;
+    const char* ext_root; /**< Posix: directory served as /ext */
+    const char* int_root; /**< Posix: directory served as /int */
+    size_t sd_size; /**< Ram: SD card size in bytes, 0 for no card */
+} StorageHostConfig;
+
+/** Start storage service and publish it as RECORD_STORAGE
+ *
+ * Service runs until process exits, same as on device.
+ *
+ * @param      config  backing storage configuration
+ *
+ * @return     Storage instance
+ */
+Storage* storage_host_start(const StorageHostConfig* config);
+
+#ifdef __cplusplus
+}
+#endif
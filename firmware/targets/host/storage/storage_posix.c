@@ -0,0 +1,448 @@
+#include "storage_posix.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#define TAG "StoragePosix"
+
+typedef struct {
+    FuriString* root;
+} PosixData;
+
+typedef struct {
+    int fd;
+    DIR* dir;
+    FuriString* path; /**< Host path of open dir, entries are stat'ed relative to it */
+} PosixFile;
+
+/******************* Core Functions *******************/
+
+static FS_Error storage_posix_parse_error(int error) {
+    switch(error) {
+    case 0:
+        return FSE_OK;
+    case ENOENT:
+    case ENOTDIR:
+        return FSE_NOT_EXIST;
+    case EEXIST:
+        return FSE_EXIST;
+    case EACCES:
+    case EPERM:
+    case EISDIR:
+    case EROFS:
+    case ENOTEMPTY:
+        return FSE_DENIED;
+    case ENAMETOOLONG:
+    case EINVAL:
+        return FSE_INVALID_NAME;
+    default:
+        return FSE_INTERNAL;
+    }
+}
+
+static void storage_posix_set_error(File* file, int error) {
+    file->internal_error_id = error;
+    file->error_id = storage_posix_parse_error(error);
+}
+
+/* Path comes without storage prefix: empty or starting with slash */
+static FuriString* storage_posix_host_path(StorageData* storage, const char* path) {
+    PosixData* posix_data = storage->data;
+    FuriString* host_path =
+        furi_string_alloc_printf("%s%s", furi_string_get_cstr(posix_data->root), path);
+    if(furi_string_empty(host_path)) {
+        furi_string_set(host_path, "/");
+    }
+    return host_path;
+}
+
+static PosixFile* storage_posix_file_alloc() {
+    PosixFile* file_data = malloc(sizeof(PosixFile));
+    file_data->fd = -1;
+    file_data->dir = NULL;
+    file_data->path = NULL;
+    return file_data;
+}
+
+static void storage_posix_file_free(PosixFile* file_data) {
+    if(file_data->path) {
+        furi_string_free(file_data->path);
+    }
+    free(file_data);
+}
+
+static void storage_posix_fill_info(FileInfo* fileinfo, const struct stat* st) {
+    fileinfo->flags = S_ISDIR(st->st_mode) ? FSF_DIRECTORY : 0;
+    fileinfo->size = st->st_size;
+}
+
+/******************* File Functions *******************/
+
+static bool storage_posix_file_open(
+    void* ctx,
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    StorageData* storage = ctx;
+    int flags = 0;
+
+    if((access_mode & FSAM_READ_WRITE) == FSAM_READ_WRITE) {
+        flags = O_RDWR;
+    } else if(access_mode & FSAM_WRITE) {
+        flags = O_WRONLY;
+    } else {
+        flags = O_RDONLY;
+    }
+
+    if(open_mode & FSOM_CREATE_NEW) {
+        flags |= O_CREAT | O_EXCL;
+    } else if(open_mode & FSOM_CREATE_ALWAYS) {
+        flags |= O_CREAT | O_TRUNC;
+    } else if(open_mode & (FSOM_OPEN_ALWAYS | FSOM_OPEN_APPEND)) {
+        flags |= O_CREAT;
+    }
+
+    PosixFile* file_data = storage_posix_file_alloc();
+    storage_set_storage_file_data(file, file_data, storage);
+
+    FuriString* host_path = storage_posix_host_path(storage, path);
+    file_data->fd = open(furi_string_get_cstr(host_path), flags, 0644);
+    furi_string_free(host_path);
+
+    if(file_data->fd < 0) {
+        storage_posix_set_error(file, errno);
+        return false;
+    }
+
+    // Directories can't be opened as files, same as with FatFS
+    struct stat st;
+    if(fstat(file_data->fd, &st) == 0 && S_ISDIR(st.st_mode)) {
+        storage_posix_set_error(file, ENOENT);
+        return false;
+    }
+
+    if(open_mode & FSOM_OPEN_APPEND) {
+        lseek(file_data->fd, 0, SEEK_END);
+    }
+
+    storage_posix_set_error(file, 0);
+    return true;
+}
+
+static bool storage_posix_file_close(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+
+    int result = 0;
+    if(file_data->fd >= 0) {
+        result = close(file_data->fd);
+    }
+    storage_posix_set_error(file, result ? errno : 0);
+
+    storage_posix_file_free(file_data);
+    storage_set_storage_file_data(file, NULL, storage);
+    return (file->error_id == FSE_OK);
+}
+
+static uint16_t
+    storage_posix_file_read(void* ctx, File* file, void* buff, uint16_t const bytes_to_read) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+    uint16_t bytes_read = 0;
+    int error = 0;
+
+    while(bytes_read < bytes_to_read) {
+        ssize_t result =
+            read(file_data->fd, (uint8_t*)buff + bytes_read, bytes_to_read - bytes_read);
+        if(result < 0 && errno == EINTR) continue;
+        if(result <= 0) {
+            error = (result < 0) ? errno : 0;
+            break;
+        }
+        bytes_read += result;
+    }
+
+    storage_posix_set_error(file, error);
+    return bytes_read;
+}
+
+static uint16_t storage_posix_file_write(
+    void* ctx,
+    File* file,
+    const void* buff,
+    uint16_t const bytes_to_write) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+    uint16_t bytes_written = 0;
+    int error = 0;
+
+    while(bytes_written < bytes_to_write) {
+        ssize_t result = write(
+            file_data->fd, (const uint8_t*)buff + bytes_written, bytes_to_write - bytes_written);
+        if(result < 0 && errno == EINTR) continue;
+        if(result < 0) {
+            error = errno;
+            break;
+        }
+        bytes_written += result;
+    }
+
+    storage_posix_set_error(file, error);
+    return bytes_written;
+}
+
+static bool
+    storage_posix_file_seek(void* ctx, File* file, const uint32_t offset, const bool from_start) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+
+    off_t result = lseek(file_data->fd, offset, from_start ? SEEK_SET : SEEK_CUR);
+    storage_posix_set_error(file, (result < 0) ? errno : 0);
+    return (file->error_id == FSE_OK);
+}
+
+static uint64_t storage_posix_file_tell(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+
+    off_t result = lseek(file_data->fd, 0, SEEK_CUR);
+    storage_posix_set_error(file, (result < 0) ? errno : 0);
+    return (result < 0) ? 0 : (uint64_t)result;
+}
+
+static bool storage_posix_file_truncate(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+
+    // Truncated at current position, same as with FatFS
+    off_t position = lseek(file_data->fd, 0, SEEK_CUR);
+    int result = (position < 0) ? -1 : ftruncate(file_data->fd, position);
+    storage_posix_set_error(file, result ? errno : 0);
+    return (file->error_id == FSE_OK);
+}
+
+static bool storage_posix_file_sync(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+
+    int result = fsync(file_data->fd);
+    storage_posix_set_error(file, result ? errno : 0);
+    return (file->error_id == FSE_OK);
+}
+
+static uint64_t storage_posix_file_size(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+
+    struct stat st;
+    int result = fstat(file_data->fd, &st);
+    storage_posix_set_error(file, result ? errno : 0);
+    return result ? 0 : (uint64_t)st.st_size;
+}
+
+static bool storage_posix_file_eof(void* ctx, File* file) {
+    uint64_t position = storage_posix_file_tell(ctx, file);
+    return position >= storage_posix_file_size(ctx, file);
+}
+
+/******************* Dir Functions *******************/
+
+static bool storage_posix_dir_open(void* ctx, File* file, const char* path) {
+    StorageData* storage = ctx;
+
+    PosixFile* file_data = storage_posix_file_alloc();
+    storage_set_storage_file_data(file, file_data, storage);
+
+    file_data->path = storage_posix_host_path(storage, path);
+    file_data->dir = opendir(furi_string_get_cstr(file_data->path));
+    storage_posix_set_error(file, file_data->dir ? 0 : errno);
+    return (file->error_id == FSE_OK);
+}
+
+static bool storage_posix_dir_close(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+
+    int result = 0;
+    if(file_data->dir) {
+        result = closedir(file_data->dir);
+    }
+    storage_posix_set_error(file, result ? errno : 0);
+
+    storage_posix_file_free(file_data);
+    storage_set_storage_file_data(file, NULL, storage);
+    return (file->error_id == FSE_OK);
+}
+
+static bool storage_posix_dir_read(
+    void* ctx,
+    File* file,
+    FileInfo* fileinfo,
+    char* name,
+    const uint16_t name_length) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+
+    struct dirent* entry;
+    do {
+        errno = 0;
+        entry = readdir(file_data->dir);
+    } while(entry && (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")));
+
+    if(!entry) {
+        // End of directory is reported as FSE_NOT_EXIST, same as with FatFS
+        storage_posix_set_error(file, errno);
+        if(file->error_id == FSE_OK) {
+            file->error_id = FSE_NOT_EXIST;
+        }
+        return false;
+    }
+
+    if(name != NULL) {
+        snprintf(name, name_length, "%s", entry->d_name);
+    }
+
+    if(fileinfo != NULL) {
+        struct stat st;
+        if(fstatat(dirfd(file_data->dir), entry->d_name, &st, 0) == 0) {
+            storage_posix_fill_info(fileinfo, &st);
+        } else {
+            fileinfo->flags = 0;
+            fileinfo->size = 0;
+        }
+    }
+
+    storage_posix_set_error(file, 0);
+    return true;
+}
+
+static bool storage_posix_dir_rewind(void* ctx, File* file) {
+    StorageData* storage = ctx;
+    PosixFile* file_data = storage_get_storage_file_data(file, storage);
+
+    rewinddir(file_data->dir);
+    storage_posix_set_error(file, 0);
+    return true;
+}
+
+/******************* Common FS Functions *******************/
+
+static FS_Error storage_posix_common_stat(void* ctx, const char* path, FileInfo* fileinfo) {
+    FuriString* host_path = storage_posix_host_path(ctx, path);
+
+    struct stat st;
+    int result = stat(furi_string_get_cstr(host_path), &st);
+    if(result == 0 && fileinfo != NULL) {
+        storage_posix_fill_info(fileinfo, &st);
+    }
+
+    furi_string_free(host_path);
+    return storage_posix_parse_error(result ? errno : 0);
+}
+
+static FS_Error storage_posix_common_remove(void* ctx, const char* path) {
+    FuriString* host_path = storage_posix_host_path(ctx, path);
+
+    int result = remove(furi_string_get_cstr(host_path));
+
+    furi_string_free(host_path);
+    return storage_posix_parse_error(result ? errno : 0);
+}
+
+static FS_Error storage_posix_common_mkdir(void* ctx, const char* path) {
+    FuriString* host_path = storage_posix_host_path(ctx, path);
+
+    int result = mkdir(furi_string_get_cstr(host_path), 0755);
+
+    furi_string_free(host_path);
+    return storage_posix_parse_error(result ? errno : 0);
+}
+
+static FS_Error storage_posix_common_fs_info(
+    void* ctx,
+    const char* fs_path,
+    uint64_t* total_space,
+    uint64_t* free_space) {
+    UNUSED(fs_path);
+    StorageData* storage = ctx;
+    PosixData* posix_data = storage->data;
+
+    struct statvfs st;
+    int result = statvfs(furi_string_get_cstr(posix_data->root), &st);
+    if(result == 0) {
+        if(total_space != NULL) {
+            *total_space = (uint64_t)st.f_blocks * st.f_frsize;
+        }
+
+        if(free_space != NULL) {
+            *free_space = (uint64_t)st.f_bavail * st.f_frsize;
+        }
+    }
+
+    return storage_posix_parse_error(result ? errno : 0);
+}
+
+/******************* Init Storage *******************/
+
+static const FS_Api fs_api = {
+    .file =
+        {
+            .open = storage_posix_file_open,
+            .close = storage_posix_file_close,
+            .read = storage_posix_file_read,
+            .write = storage_posix_file_write,
+            .seek = storage_posix_file_seek,
+            .tell = storage_posix_file_tell,
+            .truncate = storage_posix_file_truncate,
+            .size = storage_posix_file_size,
+            .sync = storage_posix_file_sync,
+            .eof = storage_posix_file_eof,
+        },
+    .dir =
+        {
+            .open = storage_posix_dir_open,
+            .close = storage_posix_dir_close,
+            .read = storage_posix_dir_read,
+            .rewind = storage_posix_dir_rewind,
+        },
+    .common =
+        {
+            .stat = storage_posix_common_stat,
+            .mkdir = storage_posix_common_mkdir,
+            .remove = storage_posix_common_remove,
+            .fs_info = storage_posix_common_fs_info,
+        },
+};
+
+void storage_posix_init(StorageData* storage, const char* root) {
+    furi_assert(root);
+
+    PosixData* posix_data = malloc(sizeof(PosixData));
+    posix_data->root = furi_string_alloc_set(root);
+    // Paths from storage start with slash, root "/" becomes empty string
+    while(furi_string_end_with(posix_data->root, "/")) {
+        furi_string_left(posix_data->root, furi_string_size(posix_data->root) - 1);
+    }
+
+    storage->data = posix_data;
+    storage->api.tick = NULL;
+    storage->fs_api = &fs_api;
+
+    struct stat st;
+    if(stat(root, &st) != 0 && mkdir(root, 0755) != 0) {
+        FURI_LOG_E(TAG, "Can't create %s: %s", root, strerror(errno));
+    }
+
+    if(stat(root, &st) == 0 && S_ISDIR(st.st_mode)) {
+        FURI_LOG_I(TAG, "Serving %s", root);
+        storage->status = StorageStatusOK;
+    } else {
+        storage->status = StorageStatusNotAccessible;
+    }
+}
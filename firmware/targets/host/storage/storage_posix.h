@@ -0,0 +1,26 @@
+/**
+ * @file storage_posix.h
+ * Host build: storage backend on a directory of host file system
+ *
+ * Implements FS_Api with POSIX calls, so the storage service, its workers
+ * and everything on top of them run unchanged, with the backing file system
+ * being the only difference from the device.
+ */
+#pragma once
+
+#include <storage/storage_glue.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Init storage with POSIX backend
+ *
+ * @param      storage  StorageData instance
+ * @param      root     host directory to serve, created if it doesn't exist
+ */
+void storage_posix_init(StorageData* storage, const char* root);
+
+#ifdef __cplusplus
+}
+#endif
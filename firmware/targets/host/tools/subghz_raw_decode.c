@@ -0,0 +1,496 @@
+/**
+ * @file subghz_raw_decode.c
+ * Host build: decode SubGhz RAW recordings with firmware decoders
+ *
+ * Every file is replayed through SubGhzReceiver with the whole protocol
+ * registry, the way SubGhz app receives on device: Decodable filter,
+ * receiver reset after each decoded signal, repeats of the last key within
+ * SUBGHZ_RAW_DECODE_REPEAT_US of signal time are counted but not saved, as
+ * history does. Samples are checked for level alternation like file encoder
+ * worker does when RAW file is played back.
+ *
+ * Files are split between worker threads, each with its own receiver.
+ * Environment and keystores are loaded once and only read by decoders.
+ * Decoded keys are written in .sub key format, one file per key, named
+ * <index>_<name>_<key>.sub: index of the input on command line keeps names
+ * unique when captures in different directories share a name.
+ *
+ * Usage: subghz_raw_decode [-j jobs] [-a assets] [-o output] file...
+ */
+#include <furi.h>
+#include <furi_hal.h>
+#include <flipper_format/flipper_format.h>
+#include <lib/subghz/environment.h>
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/protocols/base.h>
+#include <lib/subghz/protocols/protocol_items.h>
+#include <storage_host.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TAG "SubGhzRawDecode"
+
+#define SUBGHZ_RAW_DECODE_INT_ROOT "build/host/int"
+#define SUBGHZ_RAW_DECODE_STACK_SIZE (16 * 1024)
+#define SUBGHZ_RAW_DECODE_REPEAT_US (500000U)
+#define SUBGHZ_RAW_DECODE_CUSTOM_PRESET "CUSTOM"
+
+/* Presets as stored in files and as named by SubGhz app */
+static const char* const subghz_raw_decode_presets[][2] = {
+    {"FuriHalSubGhzPresetOok270Async", "AM270"},
+    {"FuriHalSubGhzPresetOok650Async", "AM650"},
+    {"FuriHalSubGhzPreset2FSKDev238Async", "FM238"},
+    {"FuriHalSubGhzPreset2FSKDev476Async", "FM476"},
+};
+
+typedef enum {
+    SubGhzRawDecodeTableCameAtomo,
+    SubGhzRawDecodeTableNiceFlorS,
+    SubGhzRawDecodeTableAlutechAt4n,
+    SubGhzRawDecodeTableCount,
+} SubGhzRawDecodeTable;
+
+/* Rainbow tables in assets directory, opened by decoders */
+static const struct {
+    const char* name;
+    void (*set)(SubGhzEnvironment* environment, const char* filename);
+} subghz_raw_decode_tables[SubGhzRawDecodeTableCount] = {
+    {"came_atomo", subghz_environment_set_came_atomo_rainbow_table_file_name},
+    {"nice_flor_s", subghz_environment_set_nice_flor_s_rainbow_table_file_name},
+    {"alutech_at_4n", subghz_environment_set_alutech_at_4n_rainbow_table_file_name},
+};
+
+typedef struct {
+    SubGhzEnvironment* environment;
+    FuriString* tables[SubGhzRawDecodeTableCount];
+    Storage* storage;
+    char* const* files;
+    size_t files_count;
+    size_t next_file;
+    FuriString* output_dir;
+} SubGhzRawDecode;
+
+typedef struct {
+    SubGhzRawDecode* app;
+    FuriThread* thread;
+    SubGhzReceiver* receiver;
+    FlipperFormat* input;
+    FlipperFormat* output;
+    FuriString* path;
+    FuriString* name;
+    SubGhzRadioPreset preset;
+    int32_t* samples;
+    size_t samples_capacity;
+
+    /* Current file */
+    size_t file_index;
+    uint64_t time_us;
+    uint64_t last_key_us;
+    uint8_t last_hash;
+    bool has_last_key;
+    uint32_t file_keys;
+
+    /* Totals, per protocol ones are indexed as in registry */
+    uint32_t* hits;
+    uint32_t* keys;
+    uint64_t samples_count;
+    uint64_t decode_ns;
+    uint32_t files;
+    uint32_t skipped;
+    uint32_t level_errors;
+    uint32_t write_errors;
+} SubGhzRawDecodeWorker;
+
+static uint64_t subghz_raw_decode_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/* Host file system as is: absolute path under SD card root */
+static bool subghz_raw_decode_ext_path(FuriString* ext_path, const char* path) {
+    char* real_path = realpath(path, NULL);
+    if(!real_path) return false;
+    furi_string_printf(ext_path, "%s%s", STORAGE_EXT_PATH_PREFIX, real_path);
+    free(real_path);
+    return true;
+}
+
+static size_t subghz_raw_decode_protocol_index(const SubGhzProtocol* protocol) {
+    size_t count = subghz_protocol_registry_count(&subghz_protocol_registry);
+    for(size_t i = 0; i < count; i++) {
+        if(subghz_protocol_registry_get_by_index(&subghz_protocol_registry, i) == protocol) {
+            return i;
+        }
+    }
+    furi_crash("Protocol not in registry");
+}
+
+static void subghz_raw_decode_save(
+    SubGhzRawDecodeWorker* worker,
+    SubGhzProtocolDecoderBase* decoder_base) {
+    furi_string_printf(
+        worker->path,
+        "%s/%04zu_%s_%" PRIu32 ".sub",
+        furi_string_get_cstr(worker->app->output_dir),
+        worker->file_index,
+        furi_string_get_cstr(worker->name),
+        worker->file_keys);
+
+    // Serializer writes header itself, same as when key is saved from history
+    if(!flipper_format_file_open_always(worker->output, furi_string_get_cstr(worker->path)) ||
+       subghz_protocol_decoder_base_serialize(decoder_base, worker->output, &worker->preset) !=
+           SubGhzProtocolStatusOk) {
+        FURI_LOG_E(TAG, "Unable to write %s", furi_string_get_cstr(worker->path));
+        worker->write_errors++;
+    }
+    flipper_format_file_close(worker->output);
+}
+
+static void subghz_raw_decode_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzRawDecodeWorker* worker = context;
+    size_t index = subghz_raw_decode_protocol_index(decoder_base->protocol);
+    worker->hits[index]++;
+
+    uint8_t hash = subghz_protocol_decoder_base_get_hash_data(decoder_base);
+    bool is_repeat = worker->has_last_key && worker->last_hash == hash &&
+                     worker->time_us - worker->last_key_us < SUBGHZ_RAW_DECODE_REPEAT_US;
+    worker->last_hash = hash;
+    worker->last_key_us = worker->time_us;
+    worker->has_last_key = true;
+
+    if(!is_repeat) {
+        worker->keys[index]++;
+        worker->file_keys++;
+        if(worker->app->output_dir) {
+            subghz_raw_decode_save(worker, decoder_base);
+        }
+    }
+
+    subghz_receiver_reset(receiver);
+}
+
+static bool subghz_raw_decode_load_preset(SubGhzRawDecodeWorker* worker, FuriString* value) {
+    FlipperFormat* input = worker->input;
+    SubGhzRadioPreset* preset = &worker->preset;
+
+    if(!flipper_format_read_uint32(input, "Frequency", &preset->frequency, 1) ||
+       !flipper_format_read_string(input, "Preset", value)) {
+        return false;
+    }
+
+    for(size_t i = 0; i < COUNT_OF(subghz_raw_decode_presets); i++) {
+        if(furi_string_equal(value, subghz_raw_decode_presets[i][0])) {
+            furi_string_set(preset->name, subghz_raw_decode_presets[i][1]);
+            return true;
+        }
+    }
+
+    // Anything else is custom register set stored next to it
+    uint32_t size = 0;
+    furi_string_set(preset->name, SUBGHZ_RAW_DECODE_CUSTOM_PRESET);
+    if(!flipper_format_get_value_count(input, "Custom_preset_data", &size) || !size) {
+        return false;
+    }
+    preset->data = malloc(size);
+    preset->data_size = size;
+    return flipper_format_read_hex(input, "Custom_preset_data", preset->data, size);
+}
+
+/* Returns false once end of transmission is reached */
+static bool subghz_raw_decode_feed(SubGhzRawDecodeWorker* worker, size_t count, bool* level) {
+    for(size_t i = 0; i < count; i++) {
+        int32_t sample = worker->samples[i];
+        // Same rules as file encoder worker: levels must alternate starting with high,
+        // zero duration stops transmission
+        if(sample == 0) {
+            worker->samples_count += i;
+            return false;
+        } else if((sample > 0) == *level) {
+            worker->level_errors++;
+            continue;
+        }
+        *level = !*level;
+
+        uint32_t duration = sample > 0 ? sample : -sample;
+        worker->time_us += duration;
+        subghz_receiver_decode(worker->receiver, sample > 0, duration);
+    }
+    worker->samples_count += count;
+    return true;
+}
+
+static bool subghz_raw_decode_file(SubGhzRawDecodeWorker* worker, size_t index) {
+    const char* file = worker->app->files[index];
+    FlipperFormat* input = worker->input;
+    FuriString* value = furi_string_alloc();
+    uint32_t version = 0;
+    uint32_t count = 0;
+    bool level = false;
+    bool success = false;
+
+    const char* name = strrchr(file, '/');
+    furi_string_set(worker->name, name ? name + 1 : file);
+    if(furi_string_end_with(worker->name, ".sub")) {
+        furi_string_left(worker->name, furi_string_size(worker->name) - strlen(".sub"));
+    }
+
+    worker->file_index = index;
+    worker->time_us = 0;
+    worker->has_last_key = false;
+    worker->file_keys = 0;
+    subghz_receiver_reset(worker->receiver);
+
+    do {
+        if(!subghz_raw_decode_ext_path(worker->path, file) ||
+           !flipper_format_file_open_existing(input, furi_string_get_cstr(worker->path)) ||
+           !flipper_format_read_header(input, value, &version) ||
+           !furi_string_equal(value, SUBGHZ_RAW_FILE_TYPE) ||
+           !subghz_raw_decode_load_preset(worker, value)) {
+            break;
+        }
+
+        // RAW_Data is read line by line, whole recordings are not kept in memory
+        success = true;
+        while(flipper_format_get_value_count(input, "RAW_Data", &count)) {
+            if(count > worker->samples_capacity) {
+                worker->samples_capacity = count;
+                worker->samples = realloc(worker->samples, count * sizeof(int32_t));
+                furi_check(worker->samples);
+            }
+            if(!flipper_format_read_int32(input, "RAW_Data", worker->samples, count)) {
+                success = false;
+                break;
+            }
+
+            uint64_t start = subghz_raw_decode_now_ns();
+            bool is_running = subghz_raw_decode_feed(worker, count, &level);
+            worker->decode_ns += subghz_raw_decode_now_ns() - start;
+            if(!is_running) break;
+        }
+    } while(false);
+
+    flipper_format_file_close(input);
+    free(worker->preset.data);
+    worker->preset.data = NULL;
+    worker->preset.data_size = 0;
+    furi_string_free(value);
+
+    return success;
+}
+
+static int32_t subghz_raw_decode_worker(void* context) {
+    SubGhzRawDecodeWorker* worker = context;
+    SubGhzRawDecode* app = worker->app;
+
+    for(;;) {
+        size_t index = __atomic_fetch_add(&app->next_file, 1, __ATOMIC_RELAXED);
+        if(index >= app->files_count) break;
+
+        if(subghz_raw_decode_file(worker, index)) {
+            worker->files++;
+        } else {
+            FURI_LOG_W(TAG, "Skipping %s: not a SubGhz RAW capture", app->files[index]);
+            worker->skipped++;
+        }
+    }
+
+    return 0;
+}
+
+static void subghz_raw_decode_load_assets(SubGhzRawDecode* app, const char* dir) {
+    FuriString* path = furi_string_alloc();
+    FuriString* keystore = furi_string_alloc();
+
+    // Same layout as subghz/assets on SD card, encrypted keystores need device keys
+    if(subghz_raw_decode_ext_path(path, dir)) {
+        furi_string_printf(keystore, "%s/keeloq_mfcodes", furi_string_get_cstr(path));
+        subghz_environment_load_keystore(app->environment, furi_string_get_cstr(keystore));
+        furi_string_printf(keystore, "%s/keeloq_mfcodes_user", furi_string_get_cstr(path));
+        subghz_environment_load_keystore(app->environment, furi_string_get_cstr(keystore));
+
+        // Environment keeps pointers to names
+        for(size_t i = 0; i < SubGhzRawDecodeTableCount; i++) {
+            app->tables[i] = furi_string_alloc_printf(
+                "%s/%s", furi_string_get_cstr(path), subghz_raw_decode_tables[i].name);
+            subghz_raw_decode_tables[i].set(
+                app->environment, furi_string_get_cstr(app->tables[i]));
+        }
+    } else {
+        FURI_LOG_W(TAG, "No assets in %s", dir);
+    }
+
+    furi_string_free(keystore);
+    furi_string_free(path);
+}
+
+static void subghz_raw_decode_print(
+    const SubGhzRawDecodeWorker* workers,
+    uint32_t jobs,
+    uint64_t time_ns) {
+    size_t count = subghz_protocol_registry_count(&subghz_protocol_registry);
+    SubGhzRawDecodeWorker total = {0};
+
+    printf("\n%-24s %10s %10s\n", "protocol", "decoded", "keys");
+    for(size_t i = 0; i < count; i++) {
+        uint32_t hits = 0;
+        uint32_t keys = 0;
+        for(uint32_t j = 0; j < jobs; j++) {
+            hits += workers[j].hits[i];
+            keys += workers[j].keys[i];
+        }
+        if(hits) {
+            const SubGhzProtocol* protocol =
+                subghz_protocol_registry_get_by_index(&subghz_protocol_registry, i);
+            printf("%-24s %10" PRIu32 " %10" PRIu32 "\n", protocol->name, hits, keys);
+        }
+    }
+
+    for(uint32_t j = 0; j < jobs; j++) {
+        total.samples_count += workers[j].samples_count;
+        total.decode_ns += workers[j].decode_ns;
+        total.files += workers[j].files;
+        total.skipped += workers[j].skipped;
+        total.level_errors += workers[j].level_errors;
+        total.write_errors += workers[j].write_errors;
+    }
+
+    double samples = (double)total.samples_count;
+    printf(
+        "\n%" PRIu32 " files, %" PRIu32 " skipped, %" PRIu32 " jobs, %.1f ms\n",
+        total.files,
+        total.skipped,
+        jobs,
+        time_ns / 1000000.0);
+    printf(
+        "%" PRIu64 " samples: %.2f Msamples/s, %.2f Msamples/s per job in receiver\n",
+        total.samples_count,
+        time_ns ? samples * 1000.0 / time_ns : 0.0,
+        total.decode_ns ? samples * 1000.0 / total.decode_ns : 0.0);
+    if(total.level_errors || total.write_errors) {
+        printf(
+            "%" PRIu32 " samples dropped on level errors, %" PRIu32 " keys not written\n",
+            total.level_errors,
+            total.write_errors);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t jobs = cpus > 0 ? cpus : 1;
+    const char* assets_dir = NULL;
+    const char* output_dir = NULL;
+    int first_file = 1;
+
+    while(first_file + 1 < argc && argv[first_file][0] == '-') {
+        if(strcmp(argv[first_file], "-j") == 0) {
+            jobs = MAX(atoi(argv[first_file + 1]), 1);
+        } else if(strcmp(argv[first_file], "-a") == 0) {
+            assets_dir = argv[first_file + 1];
+        } else if(strcmp(argv[first_file], "-o") == 0) {
+            output_dir = argv[first_file + 1];
+        } else {
+            break;
+        }
+        first_file += 2;
+    }
+
+    if(first_file >= argc) {
+        fprintf(stderr, "Usage: %s [-j jobs] [-a assets] [-o output] file...\n", argv[0]);
+        return 1;
+    }
+
+    furi_init();
+    furi_hal_init();
+
+    StorageHostConfig config = {
+        .backend = StorageHostBackendPosix,
+        .ext_root = "/",
+        .int_root = SUBGHZ_RAW_DECODE_INT_ROOT,
+    };
+    storage_host_start(&config);
+
+    SubGhzRawDecode app = {
+        .environment = subghz_environment_alloc(),
+        .storage = furi_record_open(RECORD_STORAGE),
+        .files = &argv[first_file],
+        .files_count = argc - first_file,
+    };
+    subghz_environment_set_protocol_registry(app.environment, (void*)&subghz_protocol_registry);
+    if(assets_dir) {
+        subghz_raw_decode_load_assets(&app, assets_dir);
+    }
+
+    if(output_dir) {
+        mkdir(output_dir, 0755);
+        app.output_dir = furi_string_alloc();
+        if(!subghz_raw_decode_ext_path(app.output_dir, output_dir)) {
+            FURI_LOG_E(TAG, "Unable to create %s", output_dir);
+            furi_string_free(app.output_dir);
+            app.output_dir = NULL;
+        }
+    }
+
+    size_t protocols_count = subghz_protocol_registry_count(&subghz_protocol_registry);
+    jobs = MIN(jobs, app.files_count);
+    SubGhzRawDecodeWorker* workers = calloc(jobs, sizeof(SubGhzRawDecodeWorker));
+
+    for(uint32_t i = 0; i < jobs; i++) {
+        SubGhzRawDecodeWorker* worker = &workers[i];
+        worker->app = &app;
+        worker->receiver = subghz_receiver_alloc_init(app.environment);
+        subghz_receiver_set_filter(worker->receiver, SubGhzProtocolFlag_Decodable);
+        subghz_receiver_set_rx_callback(worker->receiver, subghz_raw_decode_rx_callback, worker);
+        worker->input = flipper_format_file_alloc(app.storage);
+        worker->output = flipper_format_file_alloc(app.storage);
+        worker->path = furi_string_alloc();
+        worker->name = furi_string_alloc();
+        worker->preset.name = furi_string_alloc();
+        worker->hits = calloc(protocols_count, sizeof(uint32_t));
+        worker->keys = calloc(protocols_count, sizeof(uint32_t));
+        worker->thread = furi_thread_alloc_ex(
+            "SubGhzRawDecode", SUBGHZ_RAW_DECODE_STACK_SIZE, subghz_raw_decode_worker, worker);
+    }
+
+    uint64_t start = subghz_raw_decode_now_ns();
+    for(uint32_t i = 0; i < jobs; i++) {
+        furi_thread_start(workers[i].thread);
+    }
+    for(uint32_t i = 0; i < jobs; i++) {
+        furi_thread_join(workers[i].thread);
+    }
+    uint64_t time_ns = subghz_raw_decode_now_ns() - start;
+
+    subghz_raw_decode_print(workers, jobs, time_ns);
+
+    for(uint32_t i = 0; i < jobs; i++) {
+        SubGhzRawDecodeWorker* worker = &workers[i];
+        furi_thread_free(worker->thread);
+        subghz_receiver_free(worker->receiver);
+        flipper_format_free(worker->input);
+        flipper_format_free(worker->output);
+        furi_string_free(worker->path);
+        furi_string_free(worker->name);
+        furi_string_free(worker->preset.name);
+        free(worker->samples);
+        free(worker->hits);
+        free(worker->keys);
+    }
+    free(workers);
+
+    if(app.output_dir) furi_string_free(app.output_dir);
+    subghz_environment_free(app.environment);
+    for(size_t i = 0; i < SubGhzRawDecodeTableCount; i++) {
+        if(app.tables[i]) furi_string_free(app.tables[i]);
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    return 0;
+}
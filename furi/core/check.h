@@ -33,6 +33,17 @@ FURI_NORETURN void __furi_crash();
 /** Halt system */
 FURI_NORETURN void __furi_halt();
 
+#ifdef FURI_HOST
+/** Host build: print message and abort the process */
+FURI_NORETURN void __furi_crash_host(const void* message);
+
+/** Host build: print message and stop the process */
+FURI_NORETURN void __furi_halt_host(const void* message);
+
+#define furi_crash(message) __furi_crash_host((const void*)(message))
+
+#define furi_halt(message) __furi_halt_host((const void*)(message))
+#else
 /** Crash system with message. Show message after reboot. */
 #define furi_crash(message)                                   \
     do {                                                      \
@@ -48,6 +59,7 @@ FURI_NORETURN void __furi_halt();
         asm volatile("sukima%=:" : : "r"(r12));               \
         __furi_halt();                                        \
     } while(0)
+#endif
 
 /** Check condition and crash if check failed */
 #define __furi_check(__e, __m) \
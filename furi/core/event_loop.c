@@ -0,0 +1,440 @@
+#include "event_loop_link_i.h"
+#include "check.h"
+#include "common_defines.h"
+#include "kernel.h"
+#include "memmgr.h"
+#include "thread.h"
+
+#include <furi_hal.h>
+
+#define FURI_EVENT_LOOP_FLAG_EVENT (1UL << 30)
+#define FURI_EVENT_LOOP_FLAG_STOP (1UL << 29)
+
+typedef void (*FuriEventLoopItemCallback)(void* object, void* context);
+
+typedef enum {
+    FuriEventLoopObjectTypeMessageQueue,
+    FuriEventLoopObjectTypeStreamBuffer,
+} FuriEventLoopObjectType;
+
+struct FuriEventLoopItem {
+    FuriEventLoop* owner;
+    FuriEventLoopObjectType type;
+    void* object;
+    FuriEventLoopLink* link;
+    FuriEventLoopEvent event;
+    FuriEventLoopItemCallback callback;
+    void* context;
+    /* Set by notifier, cleared by loop before dispatch */
+    volatile bool pending;
+    /* DWT cycle counter value on first event since last dispatch */
+    uint32_t pending_since;
+    /* Unsubscribed while loop was dispatching, freed after */
+    bool removed;
+    FuriEventLoopItem* next;
+};
+
+struct FuriEventLoopTimer {
+    FuriEventLoop* owner;
+    FuriEventLoopTimerCallback callback;
+    FuriEventLoopTimerType type;
+    void* context;
+    uint32_t interval;
+    uint32_t start;
+    bool running;
+    bool removed;
+    FuriEventLoopTimer* next;
+};
+
+struct FuriEventLoop {
+    FuriThreadId thread_id;
+    FuriEventLoopItem* items;
+    FuriEventLoopTimer* timers;
+
+    uint32_t thread_flags;
+    FuriEventLoopThreadFlagsCallback thread_flags_callback;
+    void* thread_flags_context;
+
+    bool running;
+    bool dispatching;
+
+    uint32_t stats_start;
+    FuriEventLoopStats stats;
+};
+
+FuriEventLoop* furi_event_loop_alloc(void) {
+    FuriEventLoop* instance = malloc(sizeof(FuriEventLoop));
+    instance->thread_id = furi_thread_get_current_id();
+    furi_event_loop_reset_stats(instance);
+    return instance;
+}
+
+void furi_event_loop_free(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(!instance->dispatching);
+    furi_check(instance->items == NULL);
+    furi_check(instance->timers == NULL);
+
+    furi_thread_flags_clear(FURI_EVENT_LOOP_RESERVED_FLAGS);
+    free(instance);
+}
+
+void furi_event_loop_link_notify(FuriEventLoopLink* link, FuriEventLoopEvent event) {
+    /* Objects without subscribers only pay for this check */
+    if(!link->item_in && !link->item_out) return;
+
+    FURI_CRITICAL_ENTER();
+    FuriEventLoopItem* item = (event == FuriEventLoopEventIn) ? link->item_in : link->item_out;
+    if(item && !item->pending) {
+        item->pending = true;
+        item->pending_since = DWT->CYCCNT;
+        furi_thread_flags_set(item->owner->thread_id, FURI_EVENT_LOOP_FLAG_EVENT);
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+static bool furi_event_loop_item_is_ready(FuriEventLoopItem* item) {
+    if(item->type == FuriEventLoopObjectTypeMessageQueue) {
+        return (item->event == FuriEventLoopEventIn) ?
+                   furi_message_queue_get_count(item->object) > 0 :
+                   furi_message_queue_get_space(item->object) > 0;
+    } else {
+        return (item->event == FuriEventLoopEventIn) ?
+                   !furi_stream_buffer_is_empty(item->object) :
+                   !furi_stream_buffer_is_full(item->object);
+    }
+}
+
+static void furi_event_loop_subscribe(
+    FuriEventLoop* instance,
+    FuriEventLoopObjectType type,
+    void* object,
+    FuriEventLoopLink* link,
+    FuriEventLoopEvent event,
+    FuriEventLoopItemCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(object);
+    furi_check(callback);
+
+    FuriEventLoopItem* item = malloc(sizeof(FuriEventLoopItem));
+    item->owner = instance;
+    item->type = type;
+    item->object = object;
+    item->link = link;
+    item->event = event;
+    item->callback = callback;
+    item->context = context;
+    item->next = instance->items;
+    instance->items = item;
+
+    FURI_CRITICAL_ENTER();
+    if(event == FuriEventLoopEventIn) {
+        furi_check(link->item_in == NULL);
+        link->item_in = item;
+    } else {
+        furi_check(link->item_out == NULL);
+        link->item_out = item;
+    }
+    FURI_CRITICAL_EXIT();
+
+    /* Edge was missed if object became ready before subscription */
+    if(furi_event_loop_item_is_ready(item)) {
+        furi_event_loop_link_notify(link, event);
+    }
+}
+
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* queue,
+    FuriEventLoopEvent event,
+    FuriEventLoopMessageQueueCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance,
+        FuriEventLoopObjectTypeMessageQueue,
+        queue,
+        furi_message_queue_get_event_loop_link(queue),
+        event,
+        (FuriEventLoopItemCallback)callback,
+        context);
+}
+
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEvent event,
+    FuriEventLoopStreamBufferCallback callback,
+    void* context) {
+    furi_event_loop_subscribe(
+        instance,
+        FuriEventLoopObjectTypeStreamBuffer,
+        stream_buffer,
+        furi_stream_buffer_get_event_loop_link(stream_buffer),
+        event,
+        (FuriEventLoopItemCallback)callback,
+        context);
+}
+
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    FuriEventLoopItem** item_ptr = &instance->items;
+    while(*item_ptr) {
+        FuriEventLoopItem* item = *item_ptr;
+        if(item->object != object || item->removed) {
+            item_ptr = &item->next;
+            continue;
+        }
+
+        FURI_CRITICAL_ENTER();
+        if(item->link->item_in == item) item->link->item_in = NULL;
+        if(item->link->item_out == item) item->link->item_out = NULL;
+        item->pending = false;
+        FURI_CRITICAL_EXIT();
+
+        if(instance->dispatching) {
+            item->removed = true;
+            item_ptr = &item->next;
+        } else {
+            *item_ptr = item->next;
+            free(item);
+        }
+    }
+}
+
+void furi_event_loop_subscribe_thread_flags(
+    FuriEventLoop* instance,
+    uint32_t flags,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check((flags & FURI_EVENT_LOOP_RESERVED_FLAGS) == 0);
+    furi_check(!flags || callback);
+
+    instance->thread_flags = flags;
+    instance->thread_flags_callback = callback;
+    instance->thread_flags_context = context;
+}
+
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(callback);
+
+    FuriEventLoopTimer* timer = malloc(sizeof(FuriEventLoopTimer));
+    timer->owner = instance;
+    timer->callback = callback;
+    timer->type = type;
+    timer->context = context;
+    timer->next = instance->timers;
+    instance->timers = timer;
+
+    return timer;
+}
+
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    FuriEventLoop* instance = timer->owner;
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    timer->running = false;
+    if(instance->dispatching) {
+        timer->removed = true;
+        return;
+    }
+
+    FuriEventLoopTimer** timer_ptr = &instance->timers;
+    while(*timer_ptr != timer) {
+        timer_ptr = &(*timer_ptr)->next;
+    }
+    *timer_ptr = timer->next;
+    free(timer);
+}
+
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval) {
+    furi_check(timer);
+    furi_check(timer->owner->thread_id == furi_thread_get_current_id());
+    furi_check(interval > 0);
+    furi_check(!timer->removed);
+
+    timer->interval = interval;
+    timer->start = furi_get_tick();
+    timer->running = true;
+}
+
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    furi_check(timer->owner->thread_id == furi_thread_get_current_id());
+
+    timer->running = false;
+}
+
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    return timer->running;
+}
+
+/* Ticks till nearest timer expires */
+static uint32_t furi_event_loop_timers_timeout(FuriEventLoop* instance) {
+    uint32_t timeout = FuriWaitForever;
+    uint32_t now = furi_get_tick();
+
+    for(FuriEventLoopTimer* timer = instance->timers; timer; timer = timer->next) {
+        if(!timer->running) continue;
+        uint32_t elapsed = now - timer->start;
+        uint32_t left = (elapsed < timer->interval) ? timer->interval - elapsed : 0;
+        timeout = MIN(timeout, left);
+    }
+
+    return timeout;
+}
+
+static void furi_event_loop_process_timers(FuriEventLoop* instance) {
+    uint32_t now = furi_get_tick();
+
+    for(FuriEventLoopTimer* timer = instance->timers; timer && instance->running;
+        timer = timer->next) {
+        if(!timer->running || (now - timer->start) < timer->interval) continue;
+
+        if(timer->type == FuriEventLoopTimerTypePeriodic) {
+            /* Keep period stable, skip periods missed while loop was busy */
+            timer->start += ((now - timer->start) / timer->interval) * timer->interval;
+        } else {
+            timer->running = false;
+        }
+
+        instance->stats.dispatches++;
+        timer->callback(timer->context);
+    }
+}
+
+static void furi_event_loop_process_items(FuriEventLoop* instance) {
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    for(FuriEventLoopItem* item = instance->items; item && instance->running;
+        item = item->next) {
+        if(!item->pending) continue;
+
+        FURI_CRITICAL_ENTER();
+        bool pending = item->pending;
+        uint32_t pending_since = item->pending_since;
+        item->pending = false;
+        FURI_CRITICAL_EXIT();
+
+        if(!pending) continue;
+
+        uint32_t latency = (DWT->CYCCNT - pending_since) / cycles_per_us;
+        instance->stats.latency_total += latency;
+        instance->stats.latency_max = MAX(instance->stats.latency_max, latency);
+        instance->stats.events++;
+        instance->stats.dispatches++;
+
+        item->callback(item->object, item->context);
+    }
+}
+
+static void furi_event_loop_sweep(FuriEventLoop* instance) {
+    FuriEventLoopItem** item_ptr = &instance->items;
+    while(*item_ptr) {
+        FuriEventLoopItem* item = *item_ptr;
+        if(item->removed) {
+            *item_ptr = item->next;
+            free(item);
+        } else {
+            item_ptr = &item->next;
+        }
+    }
+
+    FuriEventLoopTimer** timer_ptr = &instance->timers;
+    while(*timer_ptr) {
+        FuriEventLoopTimer* timer = *timer_ptr;
+        if(timer->removed) {
+            *timer_ptr = timer->next;
+            free(timer);
+        } else {
+            timer_ptr = &timer->next;
+        }
+    }
+}
+
+void furi_event_loop_run(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+    furi_check(!instance->running);
+
+    instance->running = true;
+
+    while(instance->running) {
+        uint32_t timeout = furi_event_loop_timers_timeout(instance);
+        uint32_t flags = 0;
+        if(timeout) {
+            flags = furi_thread_flags_wait(
+                FURI_EVENT_LOOP_RESERVED_FLAGS | instance->thread_flags,
+                FuriFlagWaitAny,
+                timeout);
+            instance->stats.wakeups++;
+            if(flags & FuriFlagError) flags = 0;
+        }
+
+        if(flags & FURI_EVENT_LOOP_FLAG_STOP) {
+            /* Leave events for next run */
+            if(flags & FURI_EVENT_LOOP_FLAG_EVENT) {
+                furi_thread_flags_set(instance->thread_id, FURI_EVENT_LOOP_FLAG_EVENT);
+            }
+            break;
+        }
+
+        instance->dispatching = true;
+
+        if(flags & FURI_EVENT_LOOP_FLAG_EVENT) {
+            furi_event_loop_process_items(instance);
+        }
+
+        uint32_t thread_flags = flags & instance->thread_flags;
+        if(thread_flags && instance->running) {
+            instance->stats.dispatches++;
+            instance->thread_flags_callback(thread_flags, instance->thread_flags_context);
+        }
+
+        furi_event_loop_process_timers(instance);
+
+        instance->dispatching = false;
+        furi_event_loop_sweep(instance);
+    }
+
+    instance->running = false;
+}
+
+void furi_event_loop_stop(FuriEventLoop* instance) {
+    furi_check(instance);
+
+    if(instance->thread_id == furi_thread_get_current_id()) {
+        instance->running = false;
+    } else {
+        furi_thread_flags_set(instance->thread_id, FURI_EVENT_LOOP_FLAG_STOP);
+    }
+}
+
+void furi_event_loop_get_stats(FuriEventLoop* instance, FuriEventLoopStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+
+    *stats = instance->stats;
+    stats->duration = furi_get_tick() - instance->stats_start;
+}
+
+void furi_event_loop_reset_stats(FuriEventLoop* instance) {
+    furi_check(instance);
+
+    instance->stats = (FuriEventLoopStats){0};
+    instance->stats_start = furi_get_tick();
+}
@@ -0,0 +1,209 @@
+/**
+ * @file event_loop.h
+ * Furi: event loop
+ *
+ * Lets one thread wait on several message queues, stream buffers, its own
+ * thread flags and timers at once. Queues and stream buffers notify the loop
+ * directly from put, send, get and receive, timers are kept by the loop
+ * itself, so nothing is polled and no timer daemon is involved.
+ *
+ * Callbacks are edge triggered: callback is called once after one or more
+ * events happened on the object, it must drain the object (e.g. get messages
+ * with 0 timeout until queue is empty) or the rest will wait for next event.
+ * Object is also signaled on subscription if it's already readable/writable.
+ *
+ * Event loop belongs to the thread that allocated it. Everything except
+ * furi_event_loop_stop must be called from that thread, callbacks are called
+ * in it. Thread flags listed in FURI_EVENT_LOOP_RESERVED_FLAGS are used by the
+ * loop to wake up and can't be used by the thread for anything else.
+ */
+#pragma once
+
+#include "base.h"
+#include "message_queue.h"
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Thread flags used by event loop internally */
+#define FURI_EVENT_LOOP_RESERVED_FLAGS ((1UL << 29) | (1UL << 30))
+
+typedef enum {
+    /** Data available: message put into queue, bytes sent into stream buffer */
+    FuriEventLoopEventIn,
+    /** Space available: message taken from queue, bytes received from stream buffer */
+    FuriEventLoopEventOut,
+} FuriEventLoopEvent;
+
+typedef enum {
+    FuriEventLoopTimerTypeOnce,
+    FuriEventLoopTimerTypePeriodic,
+} FuriEventLoopTimerType;
+
+typedef struct FuriEventLoop FuriEventLoop;
+
+typedef struct FuriEventLoopTimer FuriEventLoopTimer;
+
+typedef void (*FuriEventLoopMessageQueueCallback)(FuriMessageQueue* queue, void* context);
+
+typedef void (*FuriEventLoopStreamBufferCallback)(FuriStreamBuffer* stream_buffer, void* context);
+
+/** Called with subscribed thread flags that were set, flags are cleared */
+typedef void (*FuriEventLoopThreadFlagsCallback)(uint32_t flags, void* context);
+
+typedef void (*FuriEventLoopTimerCallback)(void* context);
+
+typedef struct {
+    uint32_t duration; /**< Ticks since stats reset */
+    uint32_t wakeups; /**< Times loop thread woke up */
+    uint32_t dispatches; /**< Callbacks called, timers included */
+    uint32_t events; /**< Queue and stream buffer callbacks */
+    uint64_t latency_total; /**< Sum of event to callback latencies, us */
+    uint32_t latency_max; /**< Worst event to callback latency, us */
+} FuriEventLoopStats;
+
+/** Allocate event loop owned by current thread
+ *
+ * @return     FuriEventLoop instance
+ */
+FuriEventLoop* furi_event_loop_alloc(void);
+
+/** Free event loop, all objects must be unsubscribed and timers freed
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_free(FuriEventLoop* instance);
+
+/** Dispatch events until furi_event_loop_stop is called
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_run(FuriEventLoop* instance);
+
+/** Stop event loop, safe to call from any thread
+ *
+ * Callback that is running when stop is requested completes, loop returns
+ * before dispatching anything else.
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_stop(FuriEventLoop* instance);
+
+/** Subscribe to message queue event
+ *
+ * Queue can have one In and one Out subscriber at a time.
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      queue     FuriMessageQueue instance
+ * @param      event     event to wait for
+ * @param      callback  called when event happened
+ * @param      context   callback context
+ */
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* queue,
+    FuriEventLoopEvent event,
+    FuriEventLoopMessageQueueCallback callback,
+    void* context);
+
+/** Subscribe to stream buffer event
+ *
+ * Trigger level is not taken into account, In is signaled on every send.
+ * Stream buffer can have one In and one Out subscriber at a time.
+ *
+ * @param      instance       FuriEventLoop instance
+ * @param      stream_buffer  FuriStreamBuffer instance
+ * @param      event          event to wait for
+ * @param      callback       called when event happened
+ * @param      context        callback context
+ */
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopEvent event,
+    FuriEventLoopStreamBufferCallback callback,
+    void* context);
+
+/** Unsubscribe from all events of message queue or stream buffer
+ *
+ * Safe to call from callbacks, object is not signaled after this call.
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      object    FuriMessageQueue or FuriStreamBuffer instance
+ */
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object);
+
+/** Subscribe to loop thread flags
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      flags     flags to wait for, must not intersect with
+ *                       FURI_EVENT_LOOP_RESERVED_FLAGS, 0 to unsubscribe
+ * @param      callback  called with flags that were set
+ * @param      context   callback context
+ */
+void furi_event_loop_subscribe_thread_flags(
+    FuriEventLoop* instance,
+    uint32_t flags,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context);
+
+/** Allocate timer dispatched by event loop
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      callback  called when timer expires
+ * @param      type      one shot or periodic
+ * @param      context   callback context
+ *
+ * @return     FuriEventLoopTimer instance, stopped
+ */
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context);
+
+/** Free timer, safe to call from callbacks
+ *
+ * @param      timer  FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer);
+
+/** Start or restart timer
+ *
+ * @param      timer     FuriEventLoopTimer instance
+ * @param      interval  interval in ticks, must be greater than 0
+ */
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval);
+
+/** Stop timer
+ *
+ * @param      timer  FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer);
+
+/** Check if timer is running
+ *
+ * @param      timer  FuriEventLoopTimer instance
+ *
+ * @return     true if running
+ */
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer);
+
+/** Get event loop statistics
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      stats     statistics since last reset
+ */
+void furi_event_loop_get_stats(FuriEventLoop* instance, FuriEventLoopStats* stats);
+
+/** Reset event loop statistics
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_reset_stats(FuriEventLoop* instance);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,30 @@
+/**
+ * @file event_loop_link_i.h
+ * Furi: event loop link, embedded into objects event loop can wait on
+ */
+#pragma once
+
+#include "event_loop.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriEventLoopItem FuriEventLoopItem;
+
+/** Subscribers of object, changed by event loop in critical section */
+typedef struct {
+    FuriEventLoopItem* item_in;
+    FuriEventLoopItem* item_out;
+} FuriEventLoopLink;
+
+/** Signal event on object, safe to call from ISR */
+void furi_event_loop_link_notify(FuriEventLoopLink* link, FuriEventLoopEvent event);
+
+FuriEventLoopLink* furi_message_queue_get_event_loop_link(FuriMessageQueue* instance);
+
+FuriEventLoopLink* furi_stream_buffer_get_event_loop_link(FuriStreamBuffer* stream_buffer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,6 @@
 #include "memmgr.h"
+#include "memmgr_slab.h"
+#include "memmgr_profiler.h"
 #include "common_defines.h"
 #include <string.h>
 #include <furi_hal_memory.h>
@@ -9,21 +11,30 @@ extern size_t xPortGetFreeHeapSize(void);
 extern size_t xPortGetTotalHeapSize(void);
 extern size_t xPortGetMinimumEverFreeHeapSize(void);
 
-void* malloc(size_t size) {
-    return pvPortMalloc(size);
+static void* memmgr_malloc_from(size_t size, const void* caller) {
+    void* p = pvPortMalloc(size);
+    memmgr_profiler_on_alloc(p, size, caller);
+    return p;
 }
 
-void free(void* ptr) {
+static void memmgr_free(void* ptr) {
+    memmgr_profiler_on_free(ptr);
+    if(ptr && memmgr_slab_release(ptr)) return;
     vPortFree(ptr);
 }
 
-void* realloc(void* ptr, size_t size) {
+static void* memmgr_realloc_from(void* ptr, size_t size, const void* caller) {
     if(size == 0) {
-        vPortFree(ptr);
+        memmgr_free(ptr);
         return NULL;
     }
 
-    void* p = pvPortMalloc(size);
+    if(ptr && memmgr_slab_owns(ptr)) {
+        return memmgr_slab_realloc(ptr, size);
+    }
+
+    memmgr_profiler_on_free(ptr);
+    void* p = memmgr_malloc_from(size, caller);
     if(ptr != NULL) {
         memcpy(p, ptr, size);
         vPortFree(ptr);
@@ -32,8 +43,24 @@ void* realloc(void* ptr, size_t size) {
     return p;
 }
 
+void* malloc(size_t size) {
+    return memmgr_malloc_from(size, __builtin_return_address(0));
+}
+
+void free(void* ptr) {
+    memmgr_free(ptr);
+}
+
+void* realloc(void* ptr, size_t size) {
+    return memmgr_realloc_from(ptr, size, __builtin_return_address(0));
+}
+
 void* calloc(size_t count, size_t size) {
-    return pvPortMalloc(count * size);
+    return memmgr_malloc_from(count * size, __builtin_return_address(0));
+}
+
+void* memmgr_malloc_unprofiled(size_t size) {
+    return pvPortMalloc(size);
 }
 
 char* strdup(const char* s) {
@@ -41,7 +68,7 @@ char* strdup(const char* s) {
     furi_check(((uint32_t)s << 2) != 0);
 
     size_t siz = strlen(s) + 1;
-    char* y = pvPortMalloc(siz);
+    char* y = memmgr_malloc_from(siz, __builtin_return_address(0));
     memcpy(y, s, siz);
 
     return y;
@@ -61,22 +88,22 @@ size_t memmgr_get_minimum_free_heap(void) {
 
 void* __wrap__malloc_r(struct _reent* r, size_t size) {
     UNUSED(r);
-    return pvPortMalloc(size);
+    return memmgr_malloc_from(size, __builtin_return_address(0));
 }
 
 void __wrap__free_r(struct _reent* r, void* ptr) {
     UNUSED(r);
-    vPortFree(ptr);
+    memmgr_free(ptr);
 }
 
 void* __wrap__calloc_r(struct _reent* r, size_t count, size_t size) {
     UNUSED(r);
-    return calloc(count, size);
+    return memmgr_malloc_from(count * size, __builtin_return_address(0));
 }
 
 void* __wrap__realloc_r(struct _reent* r, void* ptr, size_t size) {
     UNUSED(r);
-    return realloc(ptr, size);
+    return memmgr_realloc_from(ptr, size, __builtin_return_address(0));
 }
 
 void* memmgr_alloc_from_pool(size_t size) {
@@ -34,6 +34,29 @@ void memmgr_heap_disable_thread_trace(FuriThreadId taks_handle);
  */
 size_t memmgr_heap_get_thread_memory(FuriThreadId taks_handle);
 
+/** Memmgr heap allocate block that is not accounted to current thread
+ *
+ * For allocators built on top of heap: their blocks are shared by threads.
+ *
+ * @param      size  size in bytes
+ *
+ * @return     pointer to allocated memory
+ */
+void* memmgr_heap_alloc_untraced(size_t size);
+
+/** Memmgr heap account allocation made outside of heap to current thread
+ *
+ * @param      pointer  allocated memory
+ * @param      size     allocated size
+ */
+void memmgr_heap_trace_alloc(void* pointer, size_t size);
+
+/** Memmgr heap account release of memory allocated outside of heap
+ *
+ * @param      pointer  released memory
+ */
+void memmgr_heap_trace_free(void* pointer);
+
 /** Memmgr heap get the max contiguous block size on the heap
  *
  * @return     size_t max contiguous block size
@@ -44,6 +67,12 @@ size_t memmgr_heap_get_max_free_block();
  */
 void memmgr_heap_printf_free_blocks();
 
+/** Memmgr heap get name of allocation policy in use
+ *
+ * @return     "first_fit" or "tlsf", see HEAP_ALLOCATOR build option
+ */
+const char* memmgr_heap_get_allocator_name();
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,58 @@
+/**
+ * @file memmgr_heap_allocator.h
+ * Furi: heap allocation policies
+ *
+ * Region allocators behind pvPortMalloc. Each one manages memory region given
+ * on init and keeps its bookkeeping inside of that region. Allocators are not
+ * thread safe: memmgr_heap suspends scheduler around every call, and wipes
+ * memory itself.
+ *
+ * - first fit: FreeRTOS heap_4, address ordered free list, O(n) allocation
+ *   and release
+ * - TLSF: two level segregated fit, free lists per size range found with
+ *   bitmap lookups, O(1) allocation and release
+ *
+ * Firmware uses one of them, selected with HEAP_ALLOCATOR build option.
+ * Host heap benchmark replays allocation traces against both.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alignment of memory returned by allocators, matches portBYTE_ALIGNMENT */
+#define MEMMGR_HEAP_ALIGNMENT (8U)
+
+typedef void (*MemmgrHeapWalkCallback)(const void* block, size_t size, void* context);
+
+typedef struct {
+    const char* name;
+    /** Take over memory region, returns allocator instance */
+    void* (*init)(void* memory, size_t size);
+    /** Allocate size bytes, NULL if no block fits or size is 0 */
+    void* (*alloc)(void* heap, size_t size);
+    /** Release allocated memory */
+    void (*free)(void* heap, void* pointer);
+    /** Usable size of allocated memory, bytes */
+    size_t (*get_size)(void* heap, const void* pointer);
+    /** Check if header in front of pointer describes allocated block */
+    bool (*is_allocated)(void* heap, const void* pointer);
+    /** Free memory including block headers, bytes */
+    size_t (*get_free)(void* heap);
+    /** Usable size of the largest free block, bytes */
+    size_t (*get_max_free_block)(void* heap);
+    /** Call callback for every free block */
+    void (*walk_free)(void* heap, MemmgrHeapWalkCallback callback, void* context);
+} MemmgrHeapAllocator;
+
+extern const MemmgrHeapAllocator memmgr_heap_allocator_first_fit;
+extern const MemmgrHeapAllocator memmgr_heap_allocator_tlsf;
+
+#ifdef __cplusplus
+}
+#endif
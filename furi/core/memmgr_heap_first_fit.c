@@ -0,0 +1,323 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * heap_4 allocation policy: combines (coalescences) adjacent memory blocks as
+ * they are freed, and in so doing limits memory fragmentation.
+ *
+ * Free list is kept in address order, allocation takes the first block that
+ * is large enough. Both allocation and release walk the list.
+ *
+ * Furi: state lives at the start of managed region instead of globals, so
+ * the policy can be instantiated on host. Locking, wiping and tracing are done
+ * by memmgr_heap.
+ */
+
+#include "memmgr_heap_allocator.h"
+#include "common_defines.h"
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE ((size_t)8)
+
+#define heapBYTE_ALIGNMENT_MASK ((size_t)(MEMMGR_HEAP_ALIGNMENT - 1))
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an BlockLink_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+#define heapBLOCK_ALLOCATED_BIT ((size_t)1 << ((sizeof(size_t) * heapBITS_PER_BYTE) - 1))
+
+/* Define the linked list structure.  This is used to link free blocks in order
+of their memory address. */
+typedef struct A_BLOCK_LINK {
+    struct A_BLOCK_LINK* pxNextFreeBlock; /*<< The next free block in the list. */
+    size_t xBlockSize; /*<< The size of the free block. */
+} BlockLink_t;
+
+typedef struct {
+    /* A couple of list links to mark the start and end of the list. */
+    BlockLink_t xStart;
+    BlockLink_t* pxEnd;
+    /* Keeps track of the number of free bytes remaining, but says nothing
+    about fragmentation. */
+    size_t xFreeBytesRemaining;
+} HeapFirstFit_t;
+
+/* The size of the structure placed at the beginning of each allocated memory
+block must by correctly byte aligned. */
+static const size_t xHeapStructSize = (sizeof(BlockLink_t) + heapBYTE_ALIGNMENT_MASK) &
+                                      ~heapBYTE_ALIGNMENT_MASK;
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE ((size_t)(xHeapStructSize << 1))
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the list of free memory blocks.  The block being freed will be merged with
+ * the block in front it and/or the block behind it if the memory blocks are
+ * adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList(HeapFirstFit_t* pxHeap, BlockLink_t* pxBlockToInsert) {
+    BlockLink_t* pxIterator;
+    uint8_t* puc;
+
+    /* Iterate through the list until a block is found that has a higher address
+    than the block being inserted. */
+    for(pxIterator = &pxHeap->xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert;
+        pxIterator = pxIterator->pxNextFreeBlock) {
+        /* Nothing to do here, just iterate to the right position. */
+    }
+
+    /* Do the block being inserted, and the block it is being inserted after
+    make a contiguous block of memory? */
+    puc = (uint8_t*)pxIterator;
+    if((puc + pxIterator->xBlockSize) == (uint8_t*)pxBlockToInsert) {
+        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+        pxBlockToInsert = pxIterator;
+    }
+
+    /* Do the block being inserted, and the block it is being inserted before
+    make a contiguous block of memory? */
+    puc = (uint8_t*)pxBlockToInsert;
+    if((puc + pxBlockToInsert->xBlockSize) == (uint8_t*)pxIterator->pxNextFreeBlock) {
+        if(pxIterator->pxNextFreeBlock != pxHeap->pxEnd) {
+            /* Form one big block from the two blocks. */
+            pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+            pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+        } else {
+            pxBlockToInsert->pxNextFreeBlock = pxHeap->pxEnd;
+        }
+    } else {
+        pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+    }
+
+    /* If the block being inserted plugged a gab, so was merged with the block
+    before and the block after, then it's pxNextFreeBlock pointer will have
+    already been set, and should not be set here as that would make it point
+    to itself. */
+    if(pxIterator != pxBlockToInsert) {
+        pxIterator->pxNextFreeBlock = pxBlockToInsert;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void* memmgr_heap_first_fit_init(void* memory, size_t size) {
+    BlockLink_t* pxFirstFreeBlock;
+    size_t uxAddress;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxAddress = (size_t)memory;
+    uxAddress += heapBYTE_ALIGNMENT_MASK;
+    uxAddress &= ~heapBYTE_ALIGNMENT_MASK;
+    size -= uxAddress - (size_t)memory;
+
+    HeapFirstFit_t* pxHeap = (void*)uxAddress;
+    uxAddress += (sizeof(HeapFirstFit_t) + heapBYTE_ALIGNMENT_MASK) & ~heapBYTE_ALIGNMENT_MASK;
+    size -= uxAddress - (size_t)pxHeap;
+    uint8_t* pucAlignedHeap = (uint8_t*)uxAddress;
+
+    /* xStart is used to hold a pointer to the first item in the list of free
+    blocks.  The void cast is used to prevent compiler warnings. */
+    pxHeap->xStart.pxNextFreeBlock = (void*)pucAlignedHeap;
+    pxHeap->xStart.xBlockSize = (size_t)0;
+
+    /* pxEnd is used to mark the end of the list of free blocks and is inserted
+    at the end of the heap space. */
+    uxAddress = ((size_t)pucAlignedHeap) + size;
+    uxAddress -= xHeapStructSize;
+    uxAddress &= ~heapBYTE_ALIGNMENT_MASK;
+    pxHeap->pxEnd = (void*)uxAddress;
+    pxHeap->pxEnd->xBlockSize = 0;
+    pxHeap->pxEnd->pxNextFreeBlock = NULL;
+
+    /* To start with there is a single free block that is sized to take up the
+    entire heap space, minus the space taken by pxEnd. */
+    pxFirstFreeBlock = (void*)pucAlignedHeap;
+    pxFirstFreeBlock->xBlockSize = uxAddress - (size_t)pxFirstFreeBlock;
+    pxFirstFreeBlock->pxNextFreeBlock = pxHeap->pxEnd;
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    pxHeap->xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+
+    return pxHeap;
+}
+/*-----------------------------------------------------------*/
+
+static void* memmgr_heap_first_fit_alloc(void* heap, size_t xWantedSize) {
+    HeapFirstFit_t* pxHeap = heap;
+    BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+    void* pvReturn = NULL;
+
+    /* Check the requested block size is not so large that the top bit is
+    set.  The top bit of the block size member of the BlockLink_t structure
+    is used to determine who owns the block - the application or the
+    kernel, so it must be free. */
+    if((xWantedSize & heapBLOCK_ALLOCATED_BIT) != 0 || xWantedSize == 0) {
+        return NULL;
+    }
+
+    /* The wanted size is increased so it can contain a BlockLink_t
+    structure in addition to the requested amount of bytes. */
+    xWantedSize += xHeapStructSize;
+
+    /* Ensure that blocks are always aligned to the required number
+    of bytes. */
+    if((xWantedSize & heapBYTE_ALIGNMENT_MASK) != 0x00) {
+        /* Byte alignment required. */
+        xWantedSize += (MEMMGR_HEAP_ALIGNMENT - (xWantedSize & heapBYTE_ALIGNMENT_MASK));
+    }
+
+    if(xWantedSize > pxHeap->xFreeBytesRemaining) {
+        return NULL;
+    }
+
+    /* Traverse the list from the start (lowest address) block until
+    one of adequate size is found. */
+    pxPreviousBlock = &pxHeap->xStart;
+    pxBlock = pxHeap->xStart.pxNextFreeBlock;
+    while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
+        pxPreviousBlock = pxBlock;
+        pxBlock = pxBlock->pxNextFreeBlock;
+    }
+
+    /* If the end marker was reached then a block of adequate size
+    was not found. */
+    if(pxBlock != pxHeap->pxEnd) {
+        /* Return the memory space pointed to - jumping over the
+        BlockLink_t structure at its start. */
+        pvReturn = (void*)(((uint8_t*)pxPreviousBlock->pxNextFreeBlock) + xHeapStructSize);
+
+        /* This block is being returned for use so must be taken out
+        of the list of free blocks. */
+        pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+        /* If the block is larger than required it can be split into
+        two. */
+        if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+            /* This block is to be split into two.  Create a new
+            block following the number of bytes requested. The void
+            cast is used to prevent byte alignment warnings from the
+            compiler. */
+            pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
+
+            /* Calculate the sizes of two blocks split from the
+            single block. */
+            pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+            pxBlock->xBlockSize = xWantedSize;
+
+            /* Insert the new block into the list of free blocks. */
+            prvInsertBlockIntoFreeList(pxHeap, pxNewBlockLink);
+        }
+
+        pxHeap->xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+        /* The block is being returned - it is allocated and owned
+        by the application and has no "next" block. */
+        pxBlock->xBlockSize |= heapBLOCK_ALLOCATED_BIT;
+        pxBlock->pxNextFreeBlock = NULL;
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void memmgr_heap_first_fit_free(void* heap, void* pv) {
+    HeapFirstFit_t* pxHeap = heap;
+
+    /* The memory being freed will have an BlockLink_t structure immediately
+    before it. */
+    BlockLink_t* pxLink = (void*)((uint8_t*)pv - xHeapStructSize);
+
+    /* The block is being returned to the heap - it is no longer
+    allocated. */
+    pxLink->xBlockSize &= ~heapBLOCK_ALLOCATED_BIT;
+
+    /* Add this block to the list of free blocks. */
+    pxHeap->xFreeBytesRemaining += pxLink->xBlockSize;
+    prvInsertBlockIntoFreeList(pxHeap, pxLink);
+}
+/*-----------------------------------------------------------*/
+
+static size_t memmgr_heap_first_fit_get_size(void* heap, const void* pv) {
+    UNUSED(heap);
+    const BlockLink_t* pxLink = (const void*)((const uint8_t*)pv - xHeapStructSize);
+    return (pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BIT) - xHeapStructSize;
+}
+
+static bool memmgr_heap_first_fit_is_allocated(void* heap, const void* pv) {
+    UNUSED(heap);
+    const BlockLink_t* pxLink = (const void*)((const uint8_t*)pv - xHeapStructSize);
+    return (pxLink->xBlockSize & heapBLOCK_ALLOCATED_BIT) != 0 &&
+           pxLink->pxNextFreeBlock == NULL;
+}
+
+static size_t memmgr_heap_first_fit_get_free(void* heap) {
+    HeapFirstFit_t* pxHeap = heap;
+    return pxHeap->xFreeBytesRemaining;
+}
+
+static size_t memmgr_heap_first_fit_get_max_free_block(void* heap) {
+    HeapFirstFit_t* pxHeap = heap;
+    size_t xMaxFreeSize = 0;
+
+    BlockLink_t* pxBlock = pxHeap->xStart.pxNextFreeBlock;
+    while(pxBlock->pxNextFreeBlock != NULL) {
+        if(pxBlock->xBlockSize > xMaxFreeSize) {
+            xMaxFreeSize = pxBlock->xBlockSize;
+        }
+        pxBlock = pxBlock->pxNextFreeBlock;
+    }
+
+    return xMaxFreeSize ? xMaxFreeSize - xHeapStructSize : 0;
+}
+
+static void memmgr_heap_first_fit_walk_free(
+    void* heap,
+    MemmgrHeapWalkCallback callback,
+    void* context) {
+    HeapFirstFit_t* pxHeap = heap;
+
+    BlockLink_t* pxBlock = pxHeap->xStart.pxNextFreeBlock;
+    while(pxBlock->pxNextFreeBlock != NULL) {
+        callback(pxBlock, pxBlock->xBlockSize, context);
+        pxBlock = pxBlock->pxNextFreeBlock;
+    }
+}
+
+const MemmgrHeapAllocator memmgr_heap_allocator_first_fit = {
+    .name = "first_fit",
+    .init = memmgr_heap_first_fit_init,
+    .alloc = memmgr_heap_first_fit_alloc,
+    .free = memmgr_heap_first_fit_free,
+    .get_size = memmgr_heap_first_fit_get_size,
+    .is_allocated = memmgr_heap_first_fit_is_allocated,
+    .get_free = memmgr_heap_first_fit_get_free,
+    .get_max_free_block = memmgr_heap_first_fit_get_max_free_block,
+    .walk_free = memmgr_heap_first_fit_walk_free,
+};
@@ -0,0 +1,321 @@
+/*
+ * TLSF allocation policy: two level segregated fit
+ *
+ * Free blocks are kept in lists by size range. First level splits sizes by
+ * power of two, second level splits every first level range into
+ * MEMMGR_TLSF_SL_COUNT equal parts, small sizes get one list per alignment
+ * step. Non-empty lists are marked in bitmaps, so suitable list is found with
+ * two bit scans, without walking any list.
+ *
+ * Every block header links to the physically previous block, and next block
+ * is found by size, so released blocks are merged with free neighbours in
+ * constant time.
+ *
+ * Allocation rounds request up to the start of the next list range and takes
+ * the head of any list at or above it: no search inside lists, any block
+ * found fits. Only when no such list is left, the list of request own range
+ * is searched, so the largest free block can still be allocated.
+ */
+
+#include "memmgr_heap_allocator.h"
+#include "common_defines.h"
+#include "check.h"
+
+#include <string.h>
+
+/** Second level lists per first level range, log2 */
+#define MEMMGR_TLSF_SL_LOG2 (4U)
+#define MEMMGR_TLSF_SL_COUNT (1U << MEMMGR_TLSF_SL_LOG2)
+/** Sizes below this have first level 0 and one list per alignment step */
+#define MEMMGR_TLSF_ALIGNMENT_LOG2 (3U)
+#define MEMMGR_TLSF_FL_SHIFT (MEMMGR_TLSF_SL_LOG2 + MEMMGR_TLSF_ALIGNMENT_LOG2)
+#define MEMMGR_TLSF_SMALL_BLOCK (1U << MEMMGR_TLSF_FL_SHIFT)
+/** Blocks are smaller than 1 << FL_MAX: SRAM1 is 192K */
+#define MEMMGR_TLSF_FL_MAX (18U)
+#define MEMMGR_TLSF_FL_COUNT (MEMMGR_TLSF_FL_MAX - MEMMGR_TLSF_FL_SHIFT + 1)
+
+#define MEMMGR_TLSF_BLOCK_FREE (1U)
+#define MEMMGR_TLSF_SIZE_MASK (~(size_t)(MEMMGR_HEAP_ALIGNMENT - 1))
+
+typedef struct MemmgrTlsfBlock MemmgrTlsfBlock;
+
+struct MemmgrTlsfBlock {
+    MemmgrTlsfBlock* prev_phys; /**< Physically previous block, NULL for first one */
+    size_t size; /**< Usable size, low bits are flags */
+    /* Rest is valid only for free blocks, allocated ones keep data here */
+    MemmgrTlsfBlock* next_free;
+    MemmgrTlsfBlock* prev_free;
+};
+
+#define MEMMGR_TLSF_HEADER_SIZE (offsetof(MemmgrTlsfBlock, next_free))
+/** Free block must hold its list links */
+#define MEMMGR_TLSF_MIN_SIZE (sizeof(MemmgrTlsfBlock) - MEMMGR_TLSF_HEADER_SIZE)
+#define MEMMGR_TLSF_MAX_SIZE ((size_t)1 << MEMMGR_TLSF_FL_MAX)
+
+typedef struct {
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[MEMMGR_TLSF_FL_COUNT];
+    MemmgrTlsfBlock* free_lists[MEMMGR_TLSF_FL_COUNT][MEMMGR_TLSF_SL_COUNT];
+    MemmgrTlsfBlock* first; /**< First block of the region */
+    MemmgrTlsfBlock* last; /**< Zero size allocated sentinel */
+    size_t free_bytes;
+} MemmgrTlsf;
+
+_Static_assert(
+    MEMMGR_TLSF_HEADER_SIZE % MEMMGR_HEAP_ALIGNMENT == 0,
+    "Block header breaks alignment");
+_Static_assert(
+    MEMMGR_HEAP_ALIGNMENT == (1U << MEMMGR_TLSF_ALIGNMENT_LOG2),
+    "Small block lists don't match alignment");
+
+static inline size_t memmgr_tlsf_align_up(size_t value) {
+    return (value + MEMMGR_HEAP_ALIGNMENT - 1) & MEMMGR_TLSF_SIZE_MASK;
+}
+
+static inline uint32_t memmgr_tlsf_fls(size_t value) {
+    return (sizeof(unsigned long) * 8 - 1) - __builtin_clzl(value);
+}
+
+static inline size_t memmgr_tlsf_block_size(const MemmgrTlsfBlock* block) {
+    return block->size & MEMMGR_TLSF_SIZE_MASK;
+}
+
+static inline bool memmgr_tlsf_block_is_free(const MemmgrTlsfBlock* block) {
+    return block->size & MEMMGR_TLSF_BLOCK_FREE;
+}
+
+static inline MemmgrTlsfBlock* memmgr_tlsf_block_next(const MemmgrTlsfBlock* block) {
+    return (MemmgrTlsfBlock*)((uint8_t*)block + MEMMGR_TLSF_HEADER_SIZE +
+                              memmgr_tlsf_block_size(block));
+}
+
+static inline void* memmgr_tlsf_block_to_ptr(const MemmgrTlsfBlock* block) {
+    return (uint8_t*)block + MEMMGR_TLSF_HEADER_SIZE;
+}
+
+static inline MemmgrTlsfBlock* memmgr_tlsf_ptr_to_block(const void* pointer) {
+    return (MemmgrTlsfBlock*)((uint8_t*)pointer - MEMMGR_TLSF_HEADER_SIZE);
+}
+
+/* List that holds blocks of this size */
+static void memmgr_tlsf_mapping(size_t size, uint32_t* fl, uint32_t* sl) {
+    if(size < MEMMGR_TLSF_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = size >> MEMMGR_TLSF_ALIGNMENT_LOG2;
+    } else {
+        uint32_t bit = memmgr_tlsf_fls(size);
+        *sl = (size >> (bit - MEMMGR_TLSF_SL_LOG2)) ^ MEMMGR_TLSF_SL_COUNT;
+        *fl = bit - MEMMGR_TLSF_FL_SHIFT + 1;
+    }
+}
+
+/* First list where every block fits this size */
+static void memmgr_tlsf_mapping_search(size_t size, uint32_t* fl, uint32_t* sl) {
+    if(size >= MEMMGR_TLSF_SMALL_BLOCK) {
+        size += (1U << (memmgr_tlsf_fls(size) - MEMMGR_TLSF_SL_LOG2)) - 1;
+    }
+    memmgr_tlsf_mapping(size, fl, sl);
+}
+
+static MemmgrTlsfBlock*
+    memmgr_tlsf_find_suitable(MemmgrTlsf* tlsf, uint32_t* fl, uint32_t* sl) {
+    if(*fl >= MEMMGR_TLSF_FL_COUNT) return NULL;
+
+    uint32_t sl_map = tlsf->sl_bitmap[*fl] & (~0UL << *sl);
+    if(!sl_map) {
+        // Nothing in this range, take smallest non-empty range above
+        uint32_t fl_map = tlsf->fl_bitmap & (~0UL << (*fl + 1));
+        if(!fl_map) return NULL;
+        *fl = __builtin_ctz(fl_map);
+        sl_map = tlsf->sl_bitmap[*fl];
+    }
+    *sl = __builtin_ctz(sl_map);
+
+    return tlsf->free_lists[*fl][*sl];
+}
+
+static void memmgr_tlsf_remove_free(MemmgrTlsf* tlsf, MemmgrTlsfBlock* block) {
+    uint32_t fl, sl;
+    memmgr_tlsf_mapping(memmgr_tlsf_block_size(block), &fl, &sl);
+
+    if(block->next_free) block->next_free->prev_free = block->prev_free;
+    if(block->prev_free) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        tlsf->free_lists[fl][sl] = block->next_free;
+        if(!block->next_free) {
+            tlsf->sl_bitmap[fl] &= ~(1UL << sl);
+            if(!tlsf->sl_bitmap[fl]) tlsf->fl_bitmap &= ~(1UL << fl);
+        }
+    }
+}
+
+static void memmgr_tlsf_insert_free(MemmgrTlsf* tlsf, MemmgrTlsfBlock* block) {
+    uint32_t fl, sl;
+    memmgr_tlsf_mapping(memmgr_tlsf_block_size(block), &fl, &sl);
+
+    MemmgrTlsfBlock* head = tlsf->free_lists[fl][sl];
+    block->prev_free = NULL;
+    block->next_free = head;
+    if(head) head->prev_free = block;
+    tlsf->free_lists[fl][sl] = block;
+    tlsf->fl_bitmap |= 1UL << fl;
+    tlsf->sl_bitmap[fl] |= 1UL << sl;
+}
+
+/* Merge next block into block, both are out of free lists */
+static void memmgr_tlsf_absorb(MemmgrTlsfBlock* block, MemmgrTlsfBlock* next) {
+    block->size += MEMMGR_TLSF_HEADER_SIZE + memmgr_tlsf_block_size(next);
+    memmgr_tlsf_block_next(block)->prev_phys = block;
+}
+
+static void* memmgr_heap_tlsf_init(void* memory, size_t size) {
+    uintptr_t address = memmgr_tlsf_align_up((uintptr_t)memory);
+    size -= address - (uintptr_t)memory;
+
+    MemmgrTlsf* tlsf = (MemmgrTlsf*)address;
+    memset(tlsf, 0, sizeof(MemmgrTlsf));
+    size_t control_size = memmgr_tlsf_align_up(sizeof(MemmgrTlsf));
+    furi_check(size > control_size + MEMMGR_TLSF_HEADER_SIZE * 2 + MEMMGR_TLSF_MIN_SIZE);
+
+    // One free block over the whole region, followed by sentinel header
+    size_t block_size = (size - control_size - MEMMGR_TLSF_HEADER_SIZE * 2) &
+                        MEMMGR_TLSF_SIZE_MASK;
+    block_size = MIN(block_size, MEMMGR_TLSF_MAX_SIZE - MEMMGR_HEAP_ALIGNMENT);
+
+    MemmgrTlsfBlock* block = (MemmgrTlsfBlock*)(address + control_size);
+    block->prev_phys = NULL;
+    block->size = block_size | MEMMGR_TLSF_BLOCK_FREE;
+    MemmgrTlsfBlock* sentinel = memmgr_tlsf_block_next(block);
+    sentinel->prev_phys = block;
+    sentinel->size = 0;
+
+    tlsf->first = block;
+    tlsf->last = sentinel;
+    tlsf->free_bytes = block_size + MEMMGR_TLSF_HEADER_SIZE;
+    memmgr_tlsf_insert_free(tlsf, block);
+
+    return tlsf;
+}
+
+static void* memmgr_heap_tlsf_alloc(void* heap, size_t size) {
+    MemmgrTlsf* tlsf = heap;
+    if(size == 0 || size >= MEMMGR_TLSF_MAX_SIZE) return NULL;
+
+    size = MAX(memmgr_tlsf_align_up(size), MEMMGR_TLSF_MIN_SIZE);
+
+    uint32_t fl, sl;
+    memmgr_tlsf_mapping_search(size, &fl, &sl);
+    MemmgrTlsfBlock* block = memmgr_tlsf_find_suitable(tlsf, &fl, &sl);
+    if(!block) {
+        // Heap is almost exhausted: look for fitting block in its own list
+        memmgr_tlsf_mapping(size, &fl, &sl);
+        block = tlsf->free_lists[fl][sl];
+        while(block && memmgr_tlsf_block_size(block) < size) {
+            block = block->next_free;
+        }
+        if(!block) return NULL;
+    }
+    memmgr_tlsf_remove_free(tlsf, block);
+
+    // Return the tail to free lists if it can hold a block
+    size_t block_size = memmgr_tlsf_block_size(block);
+    if(block_size >= size + MEMMGR_TLSF_HEADER_SIZE + MEMMGR_TLSF_MIN_SIZE) {
+        MemmgrTlsfBlock* rest =
+            (MemmgrTlsfBlock*)((uint8_t*)memmgr_tlsf_block_to_ptr(block) + size);
+        rest->prev_phys = block;
+        rest->size = (block_size - size - MEMMGR_TLSF_HEADER_SIZE) | MEMMGR_TLSF_BLOCK_FREE;
+        memmgr_tlsf_block_next(rest)->prev_phys = rest;
+        memmgr_tlsf_insert_free(tlsf, rest);
+        block_size = size;
+    }
+
+    block->size = block_size;
+    tlsf->free_bytes -= block_size + MEMMGR_TLSF_HEADER_SIZE;
+
+    return memmgr_tlsf_block_to_ptr(block);
+}
+
+static void memmgr_heap_tlsf_free(void* heap, void* pointer) {
+    MemmgrTlsf* tlsf = heap;
+    MemmgrTlsfBlock* block = memmgr_tlsf_ptr_to_block(pointer);
+
+    tlsf->free_bytes += memmgr_tlsf_block_size(block) + MEMMGR_TLSF_HEADER_SIZE;
+    block->size |= MEMMGR_TLSF_BLOCK_FREE;
+
+    MemmgrTlsfBlock* prev = block->prev_phys;
+    if(prev && memmgr_tlsf_block_is_free(prev)) {
+        memmgr_tlsf_remove_free(tlsf, prev);
+        memmgr_tlsf_absorb(prev, block);
+        block = prev;
+    }
+
+    // Sentinel is never free, next always exists
+    MemmgrTlsfBlock* next = memmgr_tlsf_block_next(block);
+    if(memmgr_tlsf_block_is_free(next)) {
+        memmgr_tlsf_remove_free(tlsf, next);
+        memmgr_tlsf_absorb(block, next);
+    }
+
+    memmgr_tlsf_insert_free(tlsf, block);
+}
+
+static size_t memmgr_heap_tlsf_get_size(void* heap, const void* pointer) {
+    UNUSED(heap);
+    return memmgr_tlsf_block_size(memmgr_tlsf_ptr_to_block(pointer));
+}
+
+static bool memmgr_heap_tlsf_is_allocated(void* heap, const void* pointer) {
+    MemmgrTlsf* tlsf = heap;
+    const MemmgrTlsfBlock* block = memmgr_tlsf_ptr_to_block(pointer);
+    if(block < tlsf->first || block >= tlsf->last) return false;
+    if(memmgr_tlsf_block_is_free(block)) return false;
+    // Header must be consistent with its neighbour
+    const MemmgrTlsfBlock* next = memmgr_tlsf_block_next(block);
+    return next > block && next <= tlsf->last && next->prev_phys == block;
+}
+
+static size_t memmgr_heap_tlsf_get_free(void* heap) {
+    MemmgrTlsf* tlsf = heap;
+    return tlsf->free_bytes;
+}
+
+static size_t memmgr_heap_tlsf_get_max_free_block(void* heap) {
+    MemmgrTlsf* tlsf = heap;
+    if(!tlsf->fl_bitmap) return 0;
+
+    // Largest block is in the highest non-empty list
+    uint32_t fl = memmgr_tlsf_fls(tlsf->fl_bitmap);
+    uint32_t sl = memmgr_tlsf_fls(tlsf->sl_bitmap[fl]);
+    size_t max_size = 0;
+    for(MemmgrTlsfBlock* block = tlsf->free_lists[fl][sl]; block; block = block->next_free) {
+        max_size = MAX(max_size, memmgr_tlsf_block_size(block));
+    }
+
+    return max_size;
+}
+
+static void
+    memmgr_heap_tlsf_walk_free(void* heap, MemmgrHeapWalkCallback callback, void* context) {
+    MemmgrTlsf* tlsf = heap;
+
+    // Physical order, same as first fit free list
+    for(MemmgrTlsfBlock* block = tlsf->first; block != tlsf->last;
+        block = memmgr_tlsf_block_next(block)) {
+        if(memmgr_tlsf_block_is_free(block)) {
+            callback(block, memmgr_tlsf_block_size(block) + MEMMGR_TLSF_HEADER_SIZE, context);
+        }
+    }
+}
+
+const MemmgrHeapAllocator memmgr_heap_allocator_tlsf = {
+    .name = "tlsf",
+    .init = memmgr_heap_tlsf_init,
+    .alloc = memmgr_heap_tlsf_alloc,
+    .free = memmgr_heap_tlsf_free,
+    .get_size = memmgr_heap_tlsf_get_size,
+    .is_allocated = memmgr_heap_tlsf_is_allocated,
+    .get_free = memmgr_heap_tlsf_get_free,
+    .get_max_free_block = memmgr_heap_tlsf_get_max_free_block,
+    .walk_free = memmgr_heap_tlsf_walk_free,
+};
@@ -0,0 +1,288 @@
+#include "memmgr_profiler.h"
+#include "memmgr_heap.h"
+#include "common_defines.h"
+#include "check.h"
+#include "kernel.h"
+
+#include <string.h>
+
+#ifndef FURI_HOST
+#include <stm32wbxx.h>
+/* Code and stack bounds from linker script */
+extern const uint32_t _etext;
+extern const uint32_t _estack;
+#endif
+
+/** Sampled allocations remembered until freed, power of 2 */
+#define MEMMGR_PROFILER_LIVE_SIZE (256U)
+/** Stack words scanned for return addresses */
+#define MEMMGR_PROFILER_STACK_SCAN (64U)
+
+typedef struct {
+    uintptr_t address; /**< 0 for empty slot */
+    uint16_t site;
+    uint32_t size;
+} MemmgrProfilerLive;
+
+typedef struct {
+    MemmgrProfilerConfig config;
+    uint32_t start_tick;
+    uint32_t samples;
+    uint32_t dropped;
+    MemmgrProfilerSite sites[MEMMGR_PROFILER_SITES];
+    size_t sites_count;
+    MemmgrProfilerLive live[MEMMGR_PROFILER_LIVE_SIZE];
+    size_t live_count;
+    MemmgrProfilerSample ring[MEMMGR_PROFILER_RING_SIZE];
+    size_t ring_head;
+    size_t ring_count;
+} MemmgrProfiler;
+
+/* Data is only touched in critical section, counters are atomic */
+static MemmgrProfiler* volatile memmgr_profiler = NULL;
+static volatile int32_t memmgr_profiler_countdown = 0;
+static volatile uint32_t memmgr_profiler_allocations = 0;
+
+static inline size_t memmgr_profiler_live_hash(uintptr_t address) {
+    return ((address >> 3) * 2654435761U) & (MEMMGR_PROFILER_LIVE_SIZE - 1);
+}
+
+static bool memmgr_profiler_live_insert(
+    MemmgrProfiler* profiler,
+    uintptr_t address,
+    uint16_t site,
+    uint32_t size) {
+    // Keep load factor under 3/4, probe chains stay short
+    if(profiler->live_count >= MEMMGR_PROFILER_LIVE_SIZE * 3 / 4) return false;
+
+    size_t index = memmgr_profiler_live_hash(address);
+    while(profiler->live[index].address) {
+        index = (index + 1) & (MEMMGR_PROFILER_LIVE_SIZE - 1);
+    }
+    profiler->live[index].address = address;
+    profiler->live[index].site = site;
+    profiler->live[index].size = size;
+    profiler->live_count++;
+    return true;
+}
+
+static MemmgrProfilerLive*
+    memmgr_profiler_live_find(MemmgrProfiler* profiler, uintptr_t address) {
+    size_t index = memmgr_profiler_live_hash(address);
+    while(profiler->live[index].address) {
+        if(profiler->live[index].address == address) return &profiler->live[index];
+        index = (index + 1) & (MEMMGR_PROFILER_LIVE_SIZE - 1);
+    }
+    return NULL;
+}
+
+static void memmgr_profiler_live_remove(MemmgrProfiler* profiler, MemmgrProfilerLive* entry) {
+    // Backward shift deletion: no tombstones in linear probing table
+    size_t hole = entry - profiler->live;
+    size_t index = hole;
+    while(true) {
+        index = (index + 1) & (MEMMGR_PROFILER_LIVE_SIZE - 1);
+        if(!profiler->live[index].address) break;
+        size_t home = memmgr_profiler_live_hash(profiler->live[index].address);
+        // Entry may move to hole if its home is not within (hole, index]
+        bool movable = (hole <= index) ? (home <= hole || home > index) :
+                                         (home <= hole && home > index);
+        if(movable) {
+            profiler->live[hole] = profiler->live[index];
+            hole = index;
+        }
+    }
+    profiler->live[hole].address = 0;
+    profiler->live_count--;
+}
+
+static void memmgr_profiler_capture(uintptr_t* pc, uint8_t depth, const void* caller) {
+    size_t count = 0;
+    pc[count++] = (uintptr_t)caller;
+
+#ifndef FURI_HOST
+    // No frame pointers in firmware: take words that look like Thumb return
+    // addresses in firmware code, good enough for a hint where caller came from
+    const uint32_t* stack = __builtin_frame_address(0);
+    const uint32_t* stack_end = &_estack;
+    for(size_t i = 0; i < MEMMGR_PROFILER_STACK_SCAN && count < depth; i++) {
+        if(&stack[i] >= stack_end) break;
+        uint32_t word = stack[i];
+        if((word & 1) && word > FLASH_BASE && word < (uint32_t)&_etext &&
+           word != pc[count - 1] && word != (uintptr_t)caller) {
+            pc[count++] = word;
+        }
+    }
+#else
+    UNUSED(depth);
+#endif
+
+    for(; count < MEMMGR_PROFILER_STACK_DEPTH; count++) {
+        pc[count] = 0;
+    }
+}
+
+static void memmgr_profiler_sample(
+    MemmgrProfiler* profiler,
+    const void* ptr,
+    size_t size,
+    const void* caller) {
+    profiler->samples++;
+
+    MemmgrProfilerSample* sample = &profiler->ring[profiler->ring_head];
+    profiler->ring_head = (profiler->ring_head + 1) % MEMMGR_PROFILER_RING_SIZE;
+    profiler->ring_count = MIN(profiler->ring_count + 1, (size_t)MEMMGR_PROFILER_RING_SIZE);
+    sample->tick = furi_get_tick();
+    sample->size = size;
+    memmgr_profiler_capture(sample->pc, profiler->config.stack_depth, caller);
+
+    size_t site = 0;
+    while(site < profiler->sites_count && profiler->sites[site].pc != (uintptr_t)caller) {
+        site++;
+    }
+    if(site == profiler->sites_count) {
+        if(site == MEMMGR_PROFILER_SITES) {
+            profiler->dropped++;
+            return;
+        }
+        profiler->sites[site].pc = (uintptr_t)caller;
+        profiler->sites_count++;
+    }
+
+    MemmgrProfilerSite* entry = &profiler->sites[site];
+    entry->allocations++;
+    entry->bytes += size;
+    if(memmgr_profiler_live_insert(profiler, (uintptr_t)ptr, site, size)) {
+        entry->live_bytes += size;
+    } else {
+        // Counted as allocated, but its release can't be seen
+        profiler->dropped++;
+    }
+}
+
+void memmgr_profiler_on_alloc(const void* ptr, size_t size, const void* caller) {
+    if(!memmgr_profiler || !ptr) return;
+
+    __atomic_add_fetch(&memmgr_profiler_allocations, 1, __ATOMIC_RELAXED);
+    if(__atomic_sub_fetch(&memmgr_profiler_countdown, 1, __ATOMIC_RELAXED) > 0) return;
+
+    FURI_CRITICAL_ENTER();
+    MemmgrProfiler* profiler = memmgr_profiler;
+    // Several threads may reach zero, only first one takes the sample
+    if(profiler && memmgr_profiler_countdown <= 0) {
+        memmgr_profiler_countdown = profiler->config.sample_period;
+        memmgr_profiler_sample(profiler, ptr, size, caller);
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void memmgr_profiler_on_free(const void* ptr) {
+    if(!memmgr_profiler || !ptr) return;
+
+    FURI_CRITICAL_ENTER();
+    MemmgrProfiler* profiler = memmgr_profiler;
+    if(profiler && profiler->live_count) {
+        MemmgrProfilerLive* entry = memmgr_profiler_live_find(profiler, (uintptr_t)ptr);
+        if(entry) {
+            MemmgrProfilerSite* site = &profiler->sites[entry->site];
+            site->frees++;
+            site->live_bytes -= entry->size;
+            memmgr_profiler_live_remove(profiler, entry);
+        }
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+bool memmgr_profiler_start(const MemmgrProfilerConfig* config) {
+    furi_assert(config);
+    furi_check(config->sample_period > 0);
+
+    // Profiler memory is not an allocation of whoever started it
+    MemmgrProfiler* profiler = memmgr_heap_alloc_untraced(sizeof(MemmgrProfiler));
+    memset(profiler, 0, sizeof(MemmgrProfiler));
+    profiler->config = *config;
+    profiler->config.stack_depth =
+        CLAMP(profiler->config.stack_depth, MEMMGR_PROFILER_STACK_DEPTH, 1);
+    profiler->start_tick = furi_get_tick();
+
+    bool started = false;
+    FURI_CRITICAL_ENTER();
+    if(!memmgr_profiler) {
+        memmgr_profiler_allocations = 0;
+        memmgr_profiler_countdown = config->sample_period;
+        memmgr_profiler = profiler;
+        started = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(!started) free(profiler);
+    return started;
+}
+
+void memmgr_profiler_stop(void) {
+    FURI_CRITICAL_ENTER();
+    MemmgrProfiler* profiler = memmgr_profiler;
+    memmgr_profiler = NULL;
+    FURI_CRITICAL_EXIT();
+
+    free(profiler);
+}
+
+bool memmgr_profiler_is_running(void) {
+    return memmgr_profiler != NULL;
+}
+
+bool memmgr_profiler_get_stats(MemmgrProfilerStats* stats) {
+    furi_assert(stats);
+    bool running = false;
+
+    FURI_CRITICAL_ENTER();
+    MemmgrProfiler* profiler = memmgr_profiler;
+    if(profiler) {
+        stats->config = profiler->config;
+        stats->duration = furi_get_tick() - profiler->start_tick;
+        stats->allocations = memmgr_profiler_allocations;
+        stats->samples = profiler->samples;
+        stats->dropped = profiler->dropped;
+        stats->sites = profiler->sites_count;
+        running = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return running;
+}
+
+size_t memmgr_profiler_get_sites(MemmgrProfilerSite* sites, size_t count) {
+    furi_assert(sites);
+    size_t copied = 0;
+
+    FURI_CRITICAL_ENTER();
+    MemmgrProfiler* profiler = memmgr_profiler;
+    if(profiler) {
+        copied = MIN(count, profiler->sites_count);
+        memcpy(sites, profiler->sites, copied * sizeof(MemmgrProfilerSite));
+    }
+    FURI_CRITICAL_EXIT();
+
+    return copied;
+}
+
+size_t memmgr_profiler_get_samples(MemmgrProfilerSample* samples, size_t count) {
+    furi_assert(samples);
+    size_t copied = 0;
+
+    FURI_CRITICAL_ENTER();
+    MemmgrProfiler* profiler = memmgr_profiler;
+    if(profiler) {
+        copied = MIN(count, profiler->ring_count);
+        // Newest samples are the interesting ones
+        size_t first = (profiler->ring_head + MEMMGR_PROFILER_RING_SIZE - copied) %
+                       MEMMGR_PROFILER_RING_SIZE;
+        for(size_t i = 0; i < copied; i++) {
+            samples[i] = profiler->ring[(first + i) % MEMMGR_PROFILER_RING_SIZE];
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    return copied;
+}
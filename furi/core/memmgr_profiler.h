@@ -0,0 +1,132 @@
+/**
+ * @file memmgr_profiler.h
+ * Furi: sampling allocation profiler
+ *
+ * When running, every N-th allocation made through malloc family and slab
+ * allocator is sampled: caller address and optionally a few more return
+ * addresses found on the stack are recorded into a ring, and the sample is
+ * accounted to its call site. Sampled allocations are remembered until they
+ * are freed, so each call site knows its allocation rate and live bytes.
+ *
+ * All tables have fixed size and are allocated on start, not sampled
+ * allocations cost an atomic decrement and releases a short hash lookup,
+ * nothing at all while profiler is stopped.
+ *
+ * Addresses are raw return addresses, symbolize them on host against the
+ * firmware ELF: scripts/memprof.py does that for `memprof dump` output.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Call sites tracked, samples from other sites are counted as dropped */
+#define MEMMGR_PROFILER_SITES (48)
+/** Return addresses recorded per sample, first one is allocator caller */
+#define MEMMGR_PROFILER_STACK_DEPTH (4)
+/** Recent samples kept */
+#define MEMMGR_PROFILER_RING_SIZE (32)
+
+typedef struct {
+    uint32_t sample_period; /**< Sample one of this many allocations */
+    uint8_t stack_depth; /**< Return addresses to record, 1 for caller only */
+} MemmgrProfilerConfig;
+
+typedef struct {
+    uintptr_t pc; /**< Allocator caller */
+    uint32_t allocations; /**< Sampled allocations */
+    uint32_t frees; /**< Sampled allocations that were freed */
+    uint32_t bytes; /**< Sampled bytes */
+    uint32_t live_bytes; /**< Sampled bytes not freed yet */
+} MemmgrProfilerSite;
+
+typedef struct {
+    uint32_t tick; /**< Kernel tick of allocation */
+    uint32_t size; /**< Allocation size */
+    uintptr_t pc[MEMMGR_PROFILER_STACK_DEPTH]; /**< Return addresses, 0 terminated */
+} MemmgrProfilerSample;
+
+typedef struct {
+    MemmgrProfilerConfig config;
+    uint32_t duration; /**< Ticks since start */
+    uint32_t allocations; /**< All allocations seen since start */
+    uint32_t samples; /**< Sampled allocations */
+    uint32_t dropped; /**< Samples not accounted: site or live table full */
+    size_t sites; /**< Call sites seen */
+} MemmgrProfilerStats;
+
+/** Start profiler
+ *
+ * @param      config  profiler configuration
+ *
+ * @return     true on success, false if already running
+ */
+bool memmgr_profiler_start(const MemmgrProfilerConfig* config);
+
+/** Stop profiler and drop collected data */
+void memmgr_profiler_stop(void);
+
+/** Check if profiler is running
+ *
+ * @return     true if running
+ */
+bool memmgr_profiler_is_running(void);
+
+/** Get profiler statistics
+ *
+ * @param      stats  output
+ *
+ * @return     false if profiler is not running
+ */
+bool memmgr_profiler_get_stats(MemmgrProfilerStats* stats);
+
+/** Copy call sites, in order of appearance
+ *
+ * @param      sites  output array
+ * @param      count  output array size
+ *
+ * @return     number of sites copied
+ */
+size_t memmgr_profiler_get_sites(MemmgrProfilerSite* sites, size_t count);
+
+/** Copy recent samples, oldest first
+ *
+ * @param      samples  output array
+ * @param      count    output array size
+ *
+ * @return     number of samples copied
+ */
+size_t memmgr_profiler_get_samples(MemmgrProfilerSample* samples, size_t count);
+
+/** Allocator hook: memory allocated
+ *
+ * @param      ptr     allocated memory, NULL is ignored
+ * @param      size    requested size
+ * @param      caller  allocator caller address
+ */
+void memmgr_profiler_on_alloc(const void* ptr, size_t size, const void* caller);
+
+/** Allocator hook: memory is about to be released
+ *
+ * @param      ptr   released memory
+ */
+void memmgr_profiler_on_free(const void* ptr);
+
+/** Heap allocation not reported to profiler
+ *
+ * For allocators that report their allocations themselves.
+ *
+ * @param      size  size in bytes
+ *
+ * @return     pointer to allocated memory
+ */
+void* memmgr_malloc_unprofiled(size_t size);
+
+#ifdef __cplusplus
+}
+#endif
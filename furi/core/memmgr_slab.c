@@ -0,0 +1,602 @@
+#include "memmgr_slab.h"
+#include "memmgr_heap.h"
+#include "memmgr_profiler.h"
+#include "common_defines.h"
+#include "check.h"
+#include "thread.h"
+
+#include <string.h>
+
+/** Objects area of a chunk, header is allocated on top */
+#define MEMMGR_SLAB_CHUNK_SIZE (1024U)
+/** Chunk index capacity: up to 64K of slab objects */
+#define MEMMGR_SLAB_CHUNKS_MAX (64U)
+#define MEMMGR_SLAB_BITMAP_WORDS (MEMMGR_SLAB_CHUNK_SIZE / MEMMGR_SLAB_CLASS_MIN / 32U)
+
+#define MEMMGR_ARENA_ALIGN (8U)
+#define MEMMGR_ARENA_HEADER_SIZE (MEMMGR_ARENA_ALIGN)
+
+typedef struct MemmgrSlabObject {
+    struct MemmgrSlabObject* next;
+} MemmgrSlabObject;
+
+typedef struct MemmgrSlabChunk {
+    struct MemmgrSlabChunk* next; /**< Next chunk of the class with free objects */
+    MemmgrSlabObject* free_list;
+    uint16_t used;
+    uint16_t fresh; /**< Objects never handed out start from this index */
+    uint16_t capacity;
+    uint8_t class_index;
+    bool partial; /**< Chunk is in class list of chunks with free objects */
+    uint32_t allocated[MEMMGR_SLAB_BITMAP_WORDS];
+    uint8_t objects[] __attribute__((aligned(8)));
+} MemmgrSlabChunk;
+
+typedef struct {
+    MemmgrSlabChunk* partial;
+    size_t chunks;
+    size_t used;
+    size_t peak;
+    uint32_t allocations;
+} MemmgrSlabClass;
+
+typedef struct MemmgrArenaBlock {
+    struct MemmgrArenaBlock* next;
+    size_t size;
+    size_t offset;
+    uint8_t data[] __attribute__((aligned(MEMMGR_ARENA_ALIGN)));
+} MemmgrArenaBlock;
+
+struct MemmgrArena {
+    MemmgrArena* next; /**< All arenas, to recognize their pointers on release */
+    MemmgrArenaBlock* blocks; /**< Current block first */
+    size_t block_size;
+    FuriThreadId thread; /**< Thread that entered arena or NULL */
+    size_t used;
+    size_t used_peak;
+    uint32_t allocations;
+};
+
+typedef struct {
+    MemmgrSlabClass classes[MEMMGR_SLAB_CLASSES];
+    MemmgrSlabChunk* chunks[MEMMGR_SLAB_CHUNKS_MAX]; /**< Sorted by address */
+    size_t chunks_count;
+    size_t chunks_peak;
+    uintptr_t low;
+    uintptr_t high;
+    uint32_t heap_fallbacks;
+    uint32_t arena_allocations;
+    MemmgrArena* arenas;
+    volatile size_t arenas_entered;
+} MemmgrSlab;
+
+static MemmgrSlab memmgr_slab = {0};
+
+static inline size_t memmgr_slab_class_index(size_t size) {
+    return size <= MEMMGR_SLAB_CLASS_MIN ? 0 : 32 - __builtin_clz(size - 1) - 4;
+}
+
+static inline size_t memmgr_slab_class_size(size_t class_index) {
+    return MEMMGR_SLAB_CLASS_MIN << class_index;
+}
+
+static inline size_t memmgr_arena_round(size_t size) {
+    return (size + MEMMGR_ARENA_ALIGN - 1) & ~(size_t)(MEMMGR_ARENA_ALIGN - 1);
+}
+
+/* Slab internals, all called in critical section */
+
+static MemmgrSlabChunk* memmgr_slab_find_chunk(uintptr_t address) {
+    if(address < memmgr_slab.low || address >= memmgr_slab.high) return NULL;
+
+    // Last chunk starting at or below address
+    size_t left = 0;
+    size_t right = memmgr_slab.chunks_count;
+    while(left < right) {
+        size_t middle = (left + right) / 2;
+        if((uintptr_t)memmgr_slab.chunks[middle] <= address) {
+            left = middle + 1;
+        } else {
+            right = middle;
+        }
+    }
+    if(left == 0) return NULL;
+
+    MemmgrSlabChunk* chunk = memmgr_slab.chunks[left - 1];
+    uintptr_t objects = (uintptr_t)chunk->objects;
+    if(address < objects || address >= objects + MEMMGR_SLAB_CHUNK_SIZE) return NULL;
+
+    return chunk;
+}
+
+static size_t memmgr_slab_object_index(MemmgrSlabChunk* chunk, uintptr_t address) {
+    size_t offset = address - (uintptr_t)chunk->objects;
+    size_t index = offset >> (chunk->class_index + 4);
+    if((offset & (memmgr_slab_class_size(chunk->class_index) - 1)) || index >= chunk->fresh) {
+        furi_crash("Invalid slab pointer");
+    }
+    return index;
+}
+
+static void memmgr_slab_update_bounds(void) {
+    if(memmgr_slab.chunks_count) {
+        MemmgrSlabChunk* last = memmgr_slab.chunks[memmgr_slab.chunks_count - 1];
+        memmgr_slab.low = (uintptr_t)memmgr_slab.chunks[0];
+        memmgr_slab.high = (uintptr_t)last->objects + MEMMGR_SLAB_CHUNK_SIZE;
+    } else {
+        memmgr_slab.low = 0;
+        memmgr_slab.high = 0;
+    }
+}
+
+static bool memmgr_slab_insert_chunk(MemmgrSlabChunk* chunk) {
+    if(memmgr_slab.chunks_count == MEMMGR_SLAB_CHUNKS_MAX) return false;
+
+    size_t position = 0;
+    while(position < memmgr_slab.chunks_count && memmgr_slab.chunks[position] < chunk) {
+        position++;
+    }
+    memmove(
+        &memmgr_slab.chunks[position + 1],
+        &memmgr_slab.chunks[position],
+        (memmgr_slab.chunks_count - position) * sizeof(MemmgrSlabChunk*));
+    memmgr_slab.chunks[position] = chunk;
+    memmgr_slab.chunks_count++;
+    memmgr_slab.chunks_peak = MAX(memmgr_slab.chunks_peak, memmgr_slab.chunks_count);
+    memmgr_slab_update_bounds();
+
+    MemmgrSlabClass* slab_class = &memmgr_slab.classes[chunk->class_index];
+    chunk->next = slab_class->partial;
+    chunk->partial = true;
+    slab_class->partial = chunk;
+    slab_class->chunks++;
+
+    return true;
+}
+
+static void memmgr_slab_remove_chunk(MemmgrSlabChunk* chunk) {
+    MemmgrSlabClass* slab_class = &memmgr_slab.classes[chunk->class_index];
+    MemmgrSlabChunk** link = &slab_class->partial;
+    while(*link != chunk) {
+        link = &(*link)->next;
+    }
+    *link = chunk->next;
+    slab_class->chunks--;
+
+    size_t position = 0;
+    while(memmgr_slab.chunks[position] != chunk) {
+        position++;
+    }
+    memmove(
+        &memmgr_slab.chunks[position],
+        &memmgr_slab.chunks[position + 1],
+        (memmgr_slab.chunks_count - position - 1) * sizeof(MemmgrSlabChunk*));
+    memmgr_slab.chunks_count--;
+    memmgr_slab_update_bounds();
+}
+
+static void* memmgr_slab_pop(size_t class_index) {
+    MemmgrSlabClass* slab_class = &memmgr_slab.classes[class_index];
+    MemmgrSlabChunk* chunk = slab_class->partial;
+    if(!chunk) return NULL;
+
+    void* object;
+    if(chunk->free_list) {
+        object = chunk->free_list;
+        chunk->free_list = chunk->free_list->next;
+    } else {
+        object = &chunk->objects[chunk->fresh * memmgr_slab_class_size(class_index)];
+        chunk->fresh++;
+    }
+
+    size_t index = memmgr_slab_object_index(chunk, (uintptr_t)object);
+    chunk->allocated[index / 32] |= 1UL << (index % 32);
+    chunk->used++;
+    if(chunk->used == chunk->capacity) {
+        slab_class->partial = chunk->next;
+        chunk->next = NULL;
+        chunk->partial = false;
+    }
+
+    slab_class->used++;
+    slab_class->peak = MAX(slab_class->peak, slab_class->used);
+    slab_class->allocations++;
+
+    return object;
+}
+
+/* Arena internals, all called in critical section */
+
+static MemmgrArena* memmgr_arena_get_current(void) {
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    for(MemmgrArena* arena = memmgr_slab.arenas; arena; arena = arena->next) {
+        if(arena->thread && arena->thread == thread_id) return arena;
+    }
+    return NULL;
+}
+
+static MemmgrArenaBlock* memmgr_arena_find_block(MemmgrArena* arena, uintptr_t address) {
+    for(MemmgrArenaBlock* block = arena->blocks; block; block = block->next) {
+        if(address >= (uintptr_t)block->data && address < (uintptr_t)block->data + block->offset) {
+            return block;
+        }
+    }
+    return NULL;
+}
+
+static bool memmgr_arena_owns(uintptr_t address) {
+    for(MemmgrArena* arena = memmgr_slab.arenas; arena; arena = arena->next) {
+        if(memmgr_arena_find_block(arena, address)) return true;
+    }
+    return false;
+}
+
+static size_t memmgr_arena_object_size(const void* ptr) {
+    return *(const size_t*)((const uint8_t*)ptr - MEMMGR_ARENA_HEADER_SIZE);
+}
+
+static void* memmgr_arena_bump(MemmgrArena* arena, size_t size) {
+    MemmgrArenaBlock* block = arena->blocks;
+    size_t needed = MEMMGR_ARENA_HEADER_SIZE + memmgr_arena_round(size);
+    if(!block || block->size - block->offset < needed) return NULL;
+
+    uint8_t* header = &block->data[block->offset];
+    *(size_t*)header = size;
+    block->offset += needed;
+
+    arena->used += needed;
+    arena->used_peak = MAX(arena->used_peak, arena->used);
+    arena->allocations++;
+    memmgr_slab.arena_allocations++;
+
+    return header + MEMMGR_ARENA_HEADER_SIZE;
+}
+
+static void* memmgr_arena_try_alloc(size_t size) {
+    void* object = NULL;
+    MemmgrArena* arena = NULL;
+
+    FURI_CRITICAL_ENTER();
+    arena = memmgr_arena_get_current();
+    if(arena) object = memmgr_arena_bump(arena, size);
+    FURI_CRITICAL_EXIT();
+
+    if(arena && !object) {
+        size_t needed = MEMMGR_ARENA_HEADER_SIZE + memmgr_arena_round(size);
+        size_t block_size = MAX(arena->block_size, needed);
+        MemmgrArenaBlock* block = malloc(sizeof(MemmgrArenaBlock) + block_size);
+        block->size = block_size;
+
+        FURI_CRITICAL_ENTER();
+        block->next = arena->blocks;
+        arena->blocks = block;
+        object = memmgr_arena_bump(arena, size);
+        FURI_CRITICAL_EXIT();
+    }
+
+    // Arena memory is reused after reset, clear it same as heap does
+    if(object) memset(object, 0, size);
+
+    return object;
+}
+
+static void* memmgr_slab_alloc_from(size_t size, const void* caller) {
+    if(memmgr_slab.arenas_entered) {
+        void* object = memmgr_arena_try_alloc(size);
+        if(object) {
+            memmgr_profiler_on_alloc(object, size, caller);
+            return object;
+        }
+    }
+
+    void* object = NULL;
+    size_t class_index = memmgr_slab_class_index(size);
+
+    if(size && size <= MEMMGR_SLAB_CLASS_MAX) {
+        FURI_CRITICAL_ENTER();
+        object = memmgr_slab_pop(class_index);
+        FURI_CRITICAL_EXIT();
+
+        if(!object && memmgr_slab.chunks_count < MEMMGR_SLAB_CHUNKS_MAX) {
+            // Chunks are not accounted to thread that happened to create them
+            MemmgrSlabChunk* chunk =
+                memmgr_heap_alloc_untraced(sizeof(MemmgrSlabChunk) + MEMMGR_SLAB_CHUNK_SIZE);
+            chunk->class_index = class_index;
+            chunk->capacity = MEMMGR_SLAB_CHUNK_SIZE / memmgr_slab_class_size(class_index);
+
+            FURI_CRITICAL_ENTER();
+            if(memmgr_slab_insert_chunk(chunk)) chunk = NULL;
+            object = memmgr_slab_pop(class_index);
+            FURI_CRITICAL_EXIT();
+
+            // Index filled up by other threads meanwhile
+            if(chunk) free(chunk);
+        }
+    }
+
+    if(object) {
+        memset(object, 0, memmgr_slab_class_size(class_index));
+        memmgr_heap_trace_alloc(object, memmgr_slab_class_size(class_index));
+    } else {
+        object = memmgr_malloc_unprofiled(size);
+        FURI_CRITICAL_ENTER();
+        memmgr_slab.heap_fallbacks++;
+        FURI_CRITICAL_EXIT();
+    }
+
+    // Attributed to slab user, not to this function
+    memmgr_profiler_on_alloc(object, size, caller);
+    return object;
+}
+
+void* memmgr_slab_alloc(size_t size) {
+    return memmgr_slab_alloc_from(size, __builtin_return_address(0));
+}
+
+bool memmgr_slab_release(void* ptr) {
+    uintptr_t address = (uintptr_t)ptr;
+    bool released = false;
+    MemmgrSlabChunk* empty = NULL;
+
+    FURI_CRITICAL_ENTER();
+    MemmgrSlabChunk* chunk = memmgr_slab_find_chunk(address);
+    if(chunk) {
+        MemmgrSlabClass* slab_class = &memmgr_slab.classes[chunk->class_index];
+        size_t index = memmgr_slab_object_index(chunk, address);
+        uint32_t mask = 1UL << (index % 32);
+        if(!(chunk->allocated[index / 32] & mask)) {
+            furi_crash("Slab double free");
+        }
+        chunk->allocated[index / 32] &= ~mask;
+
+        MemmgrSlabObject* object = ptr;
+        object->next = chunk->free_list;
+        chunk->free_list = object;
+        chunk->used--;
+        slab_class->used--;
+
+        if(!chunk->partial) {
+            chunk->next = slab_class->partial;
+            chunk->partial = true;
+            slab_class->partial = chunk;
+        } else if(chunk->used == 0 && (slab_class->partial != chunk || chunk->next)) {
+            // Keep one empty chunk per class to avoid heap round trips
+            memmgr_slab_remove_chunk(chunk);
+            empty = chunk;
+        }
+        released = true;
+    } else if(memmgr_slab.arenas) {
+        // Arena memory is dropped all at once
+        released = memmgr_arena_owns(address);
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(chunk) memmgr_heap_trace_free(ptr);
+    if(empty) free(empty);
+
+    return released;
+}
+
+void memmgr_slab_free(void* ptr) {
+    memmgr_profiler_on_free(ptr);
+    if(ptr && !memmgr_slab_release(ptr)) {
+        free(ptr);
+    }
+}
+
+void* memmgr_slab_realloc(void* ptr, size_t size) {
+    const void* caller = __builtin_return_address(0);
+    if(!ptr) return memmgr_slab_alloc_from(size, caller);
+    if(!size) {
+        memmgr_slab_free(ptr);
+        return NULL;
+    }
+
+    uintptr_t address = (uintptr_t)ptr;
+    size_t old_size = 0;
+    bool owned = false;
+
+    FURI_CRITICAL_ENTER();
+    MemmgrSlabChunk* chunk = memmgr_slab_find_chunk(address);
+    if(chunk) {
+        old_size = memmgr_slab_class_size(chunk->class_index);
+        owned = true;
+    } else if(memmgr_slab.arenas) {
+        for(MemmgrArena* arena = memmgr_slab.arenas; arena && !owned; arena = arena->next) {
+            MemmgrArenaBlock* block = memmgr_arena_find_block(arena, address);
+            if(!block) continue;
+            owned = true;
+            old_size = memmgr_arena_object_size(ptr);
+
+            // Last object of the block grows in place
+            size_t end = memmgr_arena_round(old_size);
+            size_t new_end = memmgr_arena_round(size);
+            bool is_last = (address + end == (uintptr_t)block->data + block->offset);
+            if(is_last && new_end - end <= block->size - block->offset) {
+                block->offset = block->offset - end + new_end;
+                arena->used = arena->used - end + new_end;
+                arena->used_peak = MAX(arena->used_peak, arena->used);
+                *(size_t*)(address - MEMMGR_ARENA_HEADER_SIZE) = size;
+                old_size = SIZE_MAX;
+            } else if(size <= old_size) {
+                old_size = SIZE_MAX;
+            }
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(!owned) return realloc(ptr, size);
+    // Arena object resized in place
+    if(old_size == SIZE_MAX) return ptr;
+    // Same class is fine, shrinking to smaller class releases memory
+    if(chunk && size <= old_size && memmgr_slab_class_index(size) == chunk->class_index) {
+        return ptr;
+    }
+
+    void* new_ptr = memmgr_slab_alloc_from(size, caller);
+    memcpy(new_ptr, ptr, MIN(old_size, size));
+    memmgr_slab_free(ptr);
+
+    return new_ptr;
+}
+
+bool memmgr_slab_owns(const void* ptr) {
+    uintptr_t address = (uintptr_t)ptr;
+
+    FURI_CRITICAL_ENTER();
+    bool owned = memmgr_slab_find_chunk(address) != NULL ||
+                 (memmgr_slab.arenas && memmgr_arena_owns(address));
+    FURI_CRITICAL_EXIT();
+
+    return owned;
+}
+
+bool memmgr_slab_is_allocated(const void* ptr) {
+    uintptr_t address = (uintptr_t)ptr;
+    bool allocated = false;
+
+    FURI_CRITICAL_ENTER();
+    MemmgrSlabChunk* chunk = memmgr_slab_find_chunk(address);
+    if(chunk) {
+        size_t offset = address - (uintptr_t)chunk->objects;
+        size_t index = offset >> (chunk->class_index + 4);
+        allocated = (chunk->allocated[index / 32] & (1UL << (index % 32))) != 0;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return allocated;
+}
+
+void memmgr_slab_get_stats(MemmgrSlabStats* stats) {
+    furi_assert(stats);
+
+    FURI_CRITICAL_ENTER();
+    for(size_t i = 0; i < MEMMGR_SLAB_CLASSES; i++) {
+        const MemmgrSlabClass* slab_class = &memmgr_slab.classes[i];
+        MemmgrSlabClassStats* class_stats = &stats->classes[i];
+        class_stats->object_size = memmgr_slab_class_size(i);
+        class_stats->chunks = slab_class->chunks;
+        class_stats->objects_used = slab_class->used;
+        class_stats->objects_free =
+            slab_class->chunks * (MEMMGR_SLAB_CHUNK_SIZE / class_stats->object_size) -
+            slab_class->used;
+        class_stats->objects_peak = slab_class->peak;
+        class_stats->allocations = slab_class->allocations;
+    }
+    stats->chunk_size = sizeof(MemmgrSlabChunk) + MEMMGR_SLAB_CHUNK_SIZE;
+    stats->chunks_peak = memmgr_slab.chunks_peak;
+    stats->heap_fallbacks = memmgr_slab.heap_fallbacks;
+    stats->arena_allocations = memmgr_slab.arena_allocations;
+    FURI_CRITICAL_EXIT();
+}
+
+MemmgrArena* memmgr_arena_alloc(size_t block_size) {
+    furi_check(block_size > MEMMGR_ARENA_HEADER_SIZE);
+
+    MemmgrArena* arena = malloc(sizeof(MemmgrArena));
+    arena->block_size = memmgr_arena_round(block_size);
+
+    FURI_CRITICAL_ENTER();
+    arena->next = memmgr_slab.arenas;
+    memmgr_slab.arenas = arena;
+    FURI_CRITICAL_EXIT();
+
+    return arena;
+}
+
+static MemmgrArenaBlock* memmgr_arena_detach(MemmgrArena* arena, bool keep_first) {
+    MemmgrArenaBlock* detached = arena->blocks;
+    arena->blocks = NULL;
+
+    if(keep_first && detached) {
+        // First block is the oldest one, last in the list
+        MemmgrArenaBlock** link = &detached;
+        while((*link)->next) {
+            link = &(*link)->next;
+        }
+        arena->blocks = *link;
+        *link = NULL;
+        arena->blocks->offset = 0;
+    }
+
+    arena->used = 0;
+    arena->allocations = 0;
+
+    return detached;
+}
+
+static void memmgr_arena_free_blocks(MemmgrArenaBlock* block) {
+    while(block) {
+        MemmgrArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+void memmgr_arena_free(MemmgrArena* arena) {
+    furi_assert(arena);
+    furi_check(arena->thread == NULL);
+
+    FURI_CRITICAL_ENTER();
+    MemmgrArena** link = &memmgr_slab.arenas;
+    while(*link != arena) {
+        link = &(*link)->next;
+    }
+    *link = arena->next;
+    MemmgrArenaBlock* blocks = memmgr_arena_detach(arena, false);
+    FURI_CRITICAL_EXIT();
+
+    memmgr_arena_free_blocks(blocks);
+    free(arena);
+}
+
+void memmgr_arena_reset(MemmgrArena* arena) {
+    furi_assert(arena);
+    furi_check(arena->thread == NULL);
+
+    FURI_CRITICAL_ENTER();
+    MemmgrArenaBlock* blocks = memmgr_arena_detach(arena, true);
+    FURI_CRITICAL_EXIT();
+
+    memmgr_arena_free_blocks(blocks);
+}
+
+void memmgr_arena_enter(MemmgrArena* arena) {
+    furi_assert(arena);
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    furi_check(thread_id);
+
+    FURI_CRITICAL_ENTER();
+    furi_check(arena->thread == NULL);
+    furi_check(memmgr_arena_get_current() == NULL);
+    arena->thread = thread_id;
+    memmgr_slab.arenas_entered++;
+    FURI_CRITICAL_EXIT();
+}
+
+void memmgr_arena_exit(MemmgrArena* arena) {
+    furi_assert(arena);
+
+    FURI_CRITICAL_ENTER();
+    furi_check(arena->thread == furi_thread_get_current_id());
+    arena->thread = NULL;
+    memmgr_slab.arenas_entered--;
+    FURI_CRITICAL_EXIT();
+}
+
+void memmgr_arena_get_stats(MemmgrArena* arena, MemmgrArenaStats* stats) {
+    furi_assert(arena);
+    furi_assert(stats);
+
+    FURI_CRITICAL_ENTER();
+    stats->blocks = 0;
+    stats->size = 0;
+    for(MemmgrArenaBlock* block = arena->blocks; block; block = block->next) {
+        stats->blocks++;
+        stats->size += block->size;
+    }
+    stats->used = arena->used;
+    stats->used_peak = arena->used_peak;
+    stats->allocations = arena->allocations;
+    FURI_CRITICAL_EXIT();
+}
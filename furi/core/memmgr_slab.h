@@ -0,0 +1,162 @@
+/**
+ * @file memmgr_slab.h
+ * Furi: size-class pools for small short-lived allocations
+ *
+ * Small objects (strings, container nodes) are carved from fixed size chunks
+ * taken from the heap, one size class per chunk. Allocation and release are
+ * a free list pop and push in a short critical section, without scheduler
+ * suspension and first-fit heap walk. Empty chunks are returned to the heap.
+ *
+ * Requests larger than the biggest class or made when chunk index is full
+ * are served by the heap. free() and realloc() recognize slab pointers, so
+ * slab memory may be released either way.
+ *
+ * Arena mode: a thread may enter an arena, then all slab allocations made by
+ * that thread are bump allocated from arena blocks, releasing them is no-op,
+ * and everything is dropped at once by arena reset or free. Objects from the
+ * arena must not outlive it.
+ *
+ * FuriString uses slab allocator. Other modules may route their M*LIB
+ * containers to it by including core/memmgr_slab_mlib.h after furi.h.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size classes, bytes */
+#define MEMMGR_SLAB_CLASSES (4)
+#define MEMMGR_SLAB_CLASS_MIN (16)
+#define MEMMGR_SLAB_CLASS_MAX (MEMMGR_SLAB_CLASS_MIN << (MEMMGR_SLAB_CLASSES - 1))
+
+typedef struct {
+    size_t object_size; /**< Class object size, bytes */
+    size_t chunks; /**< Chunks owned by the class */
+    size_t objects_used; /**< Objects allocated right now */
+    size_t objects_free; /**< Free objects in owned chunks */
+    size_t objects_peak; /**< Maximum of objects_used */
+    uint32_t allocations; /**< Allocations served since boot */
+} MemmgrSlabClassStats;
+
+typedef struct {
+    MemmgrSlabClassStats classes[MEMMGR_SLAB_CLASSES];
+    size_t chunk_size; /**< Chunk size including its header, bytes */
+    size_t chunks_peak; /**< Maximum of chunks owned by all classes */
+    uint32_t heap_fallbacks; /**< Requests passed to the heap */
+    uint32_t arena_allocations; /**< Requests served by arenas */
+} MemmgrSlabStats;
+
+/** Allocate memory from slab pool, heap or current thread arena
+ *
+ * Memory is zeroed, same as heap memory.
+ *
+ * @param      size  size in bytes
+ *
+ * @return     pointer to allocated memory, crashes if out of memory
+ */
+void* memmgr_slab_alloc(size_t size);
+
+/** Resize memory allocated with memmgr_slab_alloc or malloc
+ *
+ * @param      ptr   pointer or NULL
+ * @param      size  new size in bytes, 0 frees memory
+ *
+ * @return     pointer to resized memory
+ */
+void* memmgr_slab_realloc(void* ptr, size_t size);
+
+/** Release memory allocated with memmgr_slab_alloc or malloc
+ *
+ * @param      ptr   pointer or NULL
+ */
+void memmgr_slab_free(void* ptr);
+
+/** Release memory if it belongs to slab pool or arena
+ *
+ * Used by free() to tell slab pointers from heap ones.
+ *
+ * @param      ptr   pointer
+ *
+ * @return     true if pointer was released, false if it belongs to heap
+ */
+bool memmgr_slab_release(void* ptr);
+
+/** Check if pointer belongs to slab pool or arena
+ *
+ * @param      ptr   pointer
+ *
+ * @return     true if pointer is not a heap one
+ */
+bool memmgr_slab_owns(const void* ptr);
+
+/** Check if pointer is a live slab object
+ *
+ * @param      ptr   pointer
+ *
+ * @return     true if pointer is allocated from slab pool
+ */
+bool memmgr_slab_is_allocated(const void* ptr);
+
+/** Get slab pool statistics
+ *
+ * @param      stats  output
+ */
+void memmgr_slab_get_stats(MemmgrSlabStats* stats);
+
+typedef struct MemmgrArena MemmgrArena;
+
+typedef struct {
+    size_t blocks; /**< Blocks owned by arena */
+    size_t size; /**< Memory owned by arena, bytes */
+    size_t used; /**< Memory handed out since last reset, bytes */
+    size_t used_peak; /**< Maximum of used */
+    uint32_t allocations; /**< Allocations since last reset */
+} MemmgrArenaStats;
+
+/** Allocate arena
+ *
+ * @param      block_size  arena block size, larger requests get own block
+ *
+ * @return     MemmgrArena instance
+ */
+MemmgrArena* memmgr_arena_alloc(size_t block_size);
+
+/** Free arena and everything allocated from it
+ *
+ * @param      arena  MemmgrArena instance, must not be entered
+ */
+void memmgr_arena_free(MemmgrArena* arena);
+
+/** Drop everything allocated from arena, keep first block for reuse
+ *
+ * @param      arena  MemmgrArena instance, must not be entered
+ */
+void memmgr_arena_reset(MemmgrArena* arena);
+
+/** Route slab allocations of current thread to arena
+ *
+ * @param      arena  MemmgrArena instance, must not be entered
+ */
+void memmgr_arena_enter(MemmgrArena* arena);
+
+/** Stop routing slab allocations of current thread to arena
+ *
+ * @param      arena  MemmgrArena instance, entered by current thread
+ */
+void memmgr_arena_exit(MemmgrArena* arena);
+
+/** Get arena statistics
+ *
+ * @param      arena  MemmgrArena instance
+ * @param      stats  output
+ */
+void memmgr_arena_get_stats(MemmgrArena* arena, MemmgrArenaStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
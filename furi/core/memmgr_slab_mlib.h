@@ -0,0 +1,23 @@
+/**
+ * @file memmgr_slab_mlib.h
+ * Furi: route M*LIB containers of including module to slab allocator
+ *
+ * Include after furi.h and before container definitions: nodes, buckets and
+ * small arrays of containers defined below come from slab pools. No include
+ * guard on purpose, every module opts in separately.
+ */
+#include "memmgr_slab.h"
+#include <m-core.h>
+
+#undef M_MEMORY_ALLOC
+#undef M_MEMORY_DEL
+#undef M_MEMORY_REALLOC
+#undef M_MEMORY_FREE
+
+#define M_MEMORY_ALLOC(type) ((type*)memmgr_slab_alloc(sizeof(type)))
+#define M_MEMORY_DEL(ptr) memmgr_slab_free(ptr)
+#define M_MEMORY_REALLOC(type, ptr, n)            \
+    (M_UNLIKELY((n) > SIZE_MAX / sizeof(type)) ? \
+         (type*)NULL :                            \
+         (type*)memmgr_slab_realloc((ptr), (n) * sizeof(type)))
+#define M_MEMORY_FREE(ptr) memmgr_slab_free(ptr)
@@ -1,28 +1,56 @@
 #include "kernel.h"
 #include "message_queue.h"
+#include "event_loop_link_i.h"
+#include "memmgr.h"
 #include <FreeRTOS.h>
 #include <queue.h>
 #include "check.h"
 
+typedef struct {
+    StaticQueue_t container;
+    FuriEventLoopLink event_loop_link;
+    uint8_t buffer[];
+} FuriMessageQueueInstance;
+
+static inline QueueHandle_t furi_message_queue_get_handle(FuriMessageQueue* instance) {
+    FuriMessageQueueInstance* queue = instance;
+    return queue ? (QueueHandle_t)&queue->container : NULL;
+}
+
 FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
     furi_assert((furi_kernel_is_irq_or_masked() == 0U) && (msg_count > 0U) && (msg_size > 0U));
 
-    QueueHandle_t handle = xQueueCreate(msg_count, msg_size);
-    furi_check(handle);
+    /* Queue control block, event loop link and storage in one allocation */
+    FuriMessageQueueInstance* instance =
+        malloc(sizeof(FuriMessageQueueInstance) + msg_count * msg_size);
 
-    return ((FuriMessageQueue*)handle);
+    QueueHandle_t handle =
+        xQueueCreateStatic(msg_count, msg_size, instance->buffer, &instance->container);
+    furi_check(handle == (QueueHandle_t)&instance->container);
+
+    return instance;
 }
 
 void furi_message_queue_free(FuriMessageQueue* instance) {
     furi_assert(furi_kernel_is_irq_or_masked() == 0U);
     furi_assert(instance);
 
-    vQueueDelete((QueueHandle_t)instance);
+    FuriMessageQueueInstance* queue = instance;
+    /* Subscriber must unsubscribe before queue is gone */
+    furi_check(!queue->event_loop_link.item_in && !queue->event_loop_link.item_out);
+
+    vQueueDelete(furi_message_queue_get_handle(instance));
+    free(instance);
+}
+
+FuriEventLoopLink* furi_message_queue_get_event_loop_link(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    return &((FuriMessageQueueInstance*)instance)->event_loop_link;
 }
 
 FuriStatus
     furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = furi_message_queue_get_handle(instance);
     FuriStatus stat;
     BaseType_t yield;
 
@@ -54,12 +82,17 @@ FuriStatus
         }
     }
 
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(
+            furi_message_queue_get_event_loop_link(instance), FuriEventLoopEventIn);
+    }
+
     /* Return execution status */
     return (stat);
 }
 
 FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = furi_message_queue_get_handle(instance);
     FuriStatus stat;
     BaseType_t yield;
 
@@ -91,12 +124,17 @@ FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uin
         }
     }
 
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(
+            furi_message_queue_get_event_loop_link(instance), FuriEventLoopEventOut);
+    }
+
     /* Return execution status */
     return (stat);
 }
 
 uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = (StaticQueue_t*)furi_message_queue_get_handle(instance);
     uint32_t capacity;
 
     if(mq == NULL) {
@@ -111,7 +149,7 @@ uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = (StaticQueue_t*)furi_message_queue_get_handle(instance);
     uint32_t size;
 
     if(mq == NULL) {
@@ -126,7 +164,7 @@ uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = furi_message_queue_get_handle(instance);
     UBaseType_t count;
 
     if(hQueue == NULL) {
@@ -142,7 +180,7 @@ uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = (StaticQueue_t*)furi_message_queue_get_handle(instance);
     uint32_t space;
     uint32_t isrm;
 
@@ -164,7 +202,7 @@ uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
 }
 
 FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = furi_message_queue_get_handle(instance);
     FuriStatus stat;
 
     if(furi_kernel_is_irq_or_masked() != 0U) {
@@ -174,6 +212,8 @@ FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
     } else {
         stat = FuriStatusOk;
         (void)xQueueReset(hQueue);
+        furi_event_loop_link_notify(
+            furi_message_queue_get_event_loop_link(instance), FuriEventLoopEventOut);
     }
 
     /* Return execution status */
@@ -2,26 +2,55 @@
 #include "check.h"
 #include "stream_buffer.h"
 #include "common_defines.h"
+#include "event_loop_link_i.h"
+#include "memmgr.h"
 #include <FreeRTOS.h>
 #include <FreeRTOS-Kernel/include/stream_buffer.h>
 
+typedef struct {
+    StaticStreamBuffer_t container;
+    FuriEventLoopLink event_loop_link;
+    uint8_t buffer[];
+} FuriStreamBufferInstance;
+
+static inline StreamBufferHandle_t furi_stream_buffer_get_handle(FuriStreamBuffer* stream_buffer) {
+    FuriStreamBufferInstance* instance = stream_buffer;
+    return (StreamBufferHandle_t)&instance->container;
+}
+
 FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level) {
     furi_assert(size != 0);
 
-    StreamBufferHandle_t handle = xStreamBufferCreate(size, trigger_level);
-    furi_check(handle);
+    /* Control block, event loop link and storage in one allocation,
+     * FreeRTOS needs one extra byte of storage */
+    FuriStreamBufferInstance* instance = malloc(sizeof(FuriStreamBufferInstance) + size + 1);
 
-    return handle;
+    StreamBufferHandle_t handle = xStreamBufferCreateStatic(
+        size, trigger_level, instance->buffer, &instance->container);
+    furi_check(handle == (StreamBufferHandle_t)&instance->container);
+
+    return instance;
 };
 
 void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer) {
     furi_assert(stream_buffer);
-    vStreamBufferDelete(stream_buffer);
+    FuriStreamBufferInstance* instance = stream_buffer;
+    /* Subscriber must unsubscribe before stream buffer is gone */
+    furi_check(!instance->event_loop_link.item_in && !instance->event_loop_link.item_out);
+
+    vStreamBufferDelete(furi_stream_buffer_get_handle(stream_buffer));
+    free(instance);
 };
 
+FuriEventLoopLink* furi_stream_buffer_get_event_loop_link(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    return &((FuriStreamBufferInstance*)stream_buffer)->event_loop_link;
+}
+
 bool furi_stream_set_trigger_level(FuriStreamBuffer* stream_buffer, size_t trigger_level) {
     furi_assert(stream_buffer);
-    return xStreamBufferSetTriggerLevel(stream_buffer, trigger_level) == pdTRUE;
+    return xStreamBufferSetTriggerLevel(
+               furi_stream_buffer_get_handle(stream_buffer), trigger_level) == pdTRUE;
 };
 
 size_t furi_stream_buffer_send(
@@ -33,10 +62,17 @@ size_t furi_stream_buffer_send(
 
     if(FURI_IS_IRQ_MODE()) {
         BaseType_t yield;
-        ret = xStreamBufferSendFromISR(stream_buffer, data, length, &yield);
+        ret = xStreamBufferSendFromISR(
+            furi_stream_buffer_get_handle(stream_buffer), data, length, &yield);
         portYIELD_FROM_ISR(yield);
     } else {
-        ret = xStreamBufferSend(stream_buffer, data, length, timeout);
+        ret = xStreamBufferSend(
+            furi_stream_buffer_get_handle(stream_buffer), data, length, timeout);
+    }
+
+    if(ret) {
+        furi_event_loop_link_notify(
+            furi_stream_buffer_get_event_loop_link(stream_buffer), FuriEventLoopEventIn);
     }
 
     return ret;
@@ -51,33 +87,42 @@ size_t furi_stream_buffer_receive(
 
     if(FURI_IS_IRQ_MODE()) {
         BaseType_t yield;
-        ret = xStreamBufferReceiveFromISR(stream_buffer, data, length, &yield);
+        ret = xStreamBufferReceiveFromISR(
+            furi_stream_buffer_get_handle(stream_buffer), data, length, &yield);
         portYIELD_FROM_ISR(yield);
     } else {
-        ret = xStreamBufferReceive(stream_buffer, data, length, timeout);
+        ret = xStreamBufferReceive(
+            furi_stream_buffer_get_handle(stream_buffer), data, length, timeout);
+    }
+
+    if(ret) {
+        furi_event_loop_link_notify(
+            furi_stream_buffer_get_event_loop_link(stream_buffer), FuriEventLoopEventOut);
     }
 
     return ret;
 }
 
 size_t furi_stream_buffer_bytes_available(FuriStreamBuffer* stream_buffer) {
-    return xStreamBufferBytesAvailable(stream_buffer);
+    return xStreamBufferBytesAvailable(furi_stream_buffer_get_handle(stream_buffer));
 };
 
 size_t furi_stream_buffer_spaces_available(FuriStreamBuffer* stream_buffer) {
-    return xStreamBufferSpacesAvailable(stream_buffer);
+    return xStreamBufferSpacesAvailable(furi_stream_buffer_get_handle(stream_buffer));
 };
 
 bool furi_stream_buffer_is_full(FuriStreamBuffer* stream_buffer) {
-    return xStreamBufferIsFull(stream_buffer) == pdTRUE;
+    return xStreamBufferIsFull(furi_stream_buffer_get_handle(stream_buffer)) == pdTRUE;
 };
 
 bool furi_stream_buffer_is_empty(FuriStreamBuffer* stream_buffer) {
-    return (xStreamBufferIsEmpty(stream_buffer) == pdTRUE);
+    return (xStreamBufferIsEmpty(furi_stream_buffer_get_handle(stream_buffer)) == pdTRUE);
 };
 
 FuriStatus furi_stream_buffer_reset(FuriStreamBuffer* stream_buffer) {
-    if(xStreamBufferReset(stream_buffer) == pdPASS) {
+    if(xStreamBufferReset(furi_stream_buffer_get_handle(stream_buffer)) == pdPASS) {
+        furi_event_loop_link_notify(
+            furi_stream_buffer_get_event_loop_link(stream_buffer), FuriEventLoopEventOut);
         return FuriStatusOk;
     } else {
         return FuriStatusError;
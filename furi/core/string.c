@@ -1,4 +1,6 @@
 #include "string.h"
+// Strings are small and short-lived: both struct and buffer come from slab pools
+#include "memmgr_slab_mlib.h"
 #include <m-string.h>
 
 struct FuriString {
@@ -23,19 +25,19 @@ struct FuriString {
 #undef furi_string_cat
 
 FuriString* furi_string_alloc() {
-    FuriString* string = malloc(sizeof(FuriString));
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString));
     string_init(string->string);
     return string;
 }
 
 FuriString* furi_string_alloc_set(const FuriString* s) {
-    FuriString* string = malloc(sizeof(FuriString)); //-V799
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString)); //-V799
     string_init_set(string->string, s->string);
     return string;
 } //-V773
 
 FuriString* furi_string_alloc_set_str(const char cstr[]) {
-    FuriString* string = malloc(sizeof(FuriString)); //-V799
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString)); //-V799
     string_init_set(string->string, cstr);
     return string;
 } //-V773
@@ -49,21 +51,21 @@ FuriString* furi_string_alloc_printf(const char format[], ...) {
 }
 
 FuriString* furi_string_alloc_vprintf(const char format[], va_list args) {
-    FuriString* string = malloc(sizeof(FuriString));
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString));
     string_init_vprintf(string->string, format, args);
     return string;
 }
 
 FuriString* furi_string_alloc_move(FuriString* s) {
-    FuriString* string = malloc(sizeof(FuriString));
+    FuriString* string = memmgr_slab_alloc(sizeof(FuriString));
     string_init_move(string->string, s->string);
-    free(s);
+    memmgr_slab_free(s);
     return string;
 }
 
 void furi_string_free(FuriString* s) {
     string_clear(s->string);
-    free(s);
+    memmgr_slab_free(s);
 }
 
 void furi_string_reserve(FuriString* s, size_t alloc) {
@@ -81,7 +83,7 @@ void furi_string_swap(FuriString* v1, FuriString* v2) {
 void furi_string_move(FuriString* v1, FuriString* v2) {
     string_clear(v1->string);
     string_init_move(v1->string, v2->string);
-    free(v2);
+    memmgr_slab_free(v2);
 }
 
 size_t furi_string_hash(const FuriString* v) {
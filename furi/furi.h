@@ -4,11 +4,14 @@
 
 #include "core/check.h"
 #include "core/common_defines.h"
+#include "core/event_loop.h"
 #include "core/event_flag.h"
 #include "core/kernel.h"
 #include "core/log.h"
 #include "core/memmgr.h"
 #include "core/memmgr_heap.h"
+#include "core/memmgr_profiler.h"
+#include "core/memmgr_slab.h"
 #include "core/message_queue.h"
 #include "core/mutex.h"
 #include "core/pubsub.h"
@@ -69,6 +69,28 @@ struct DigitalSignalInternals {
  */
 #define SEQUENCE_SIZE_REALLOCATE_INCREMENT 256
 
+typedef struct DigitalSignalCacheEntry DigitalSignalCacheEntry;
+
+struct DigitalSignalCacheEntry {
+    DigitalSignalCacheEntry* next;
+    uint32_t hash;
+    uint32_t key_size;
+    uint32_t gpio_buff[2];
+    uint32_t reload_reg_entries;
+    uint32_t data[]; /* reload register values, followed by the key */
+};
+
+struct DigitalSignalCache {
+    const GpioPin* gpio;
+    size_t size;
+    DigitalSignalCacheEntry* entries;
+    uint32_t send_time;
+    bool send_time_active;
+    LL_DMA_InitTypeDef dma_config_gpio;
+    LL_DMA_InitTypeDef dma_config_timer;
+    DigitalSignalCacheStats stats;
+};
+
 DigitalSignal* digital_signal_alloc(uint32_t max_edges_cnt) {
     DigitalSignal* signal = malloc(sizeof(DigitalSignal));
     signal->start_level = true;
@@ -303,13 +325,30 @@ void digital_signal_send(DigitalSignal* signal, const GpioPin* gpio) {
         return;
     }
 
-    /* Configure gpio as output */
+    digital_signal_prepare(signal, gpio);
+    digital_signal_send_prepared(signal);
+}
+
+void digital_signal_prepare(DigitalSignal* signal, const GpioPin* gpio) {
+    furi_assert(signal);
+    furi_assert(gpio);
+
     signal->internals->gpio = gpio;
+    digital_signal_prepare_arr(signal);
+}
+
+void digital_signal_send_prepared(DigitalSignal* signal) {
+    furi_assert(signal);
+    furi_assert(signal->internals->gpio);
+
+    if(!signal->internals->reload_reg_entries) {
+        return;
+    }
+
+    /* Configure gpio as output */
     furi_hal_gpio_init(
         signal->internals->gpio, GpioModeOutputPushPull, GpioPullNo, GpioSpeedVeryHigh);
 
-    digital_signal_prepare_arr(signal);
-
     digital_signal_setup_dma(signal);
     digital_signal_setup_timer();
     digital_signal_start_timer();
@@ -664,3 +703,228 @@ void digital_sequence_timebase_correction(DigitalSequence* sequence, float facto
         }
     }
 }
+
+DigitalSignalCache* digital_signal_cache_alloc(const GpioPin* gpio) {
+    furi_assert(gpio);
+
+    DigitalSignalCache* cache = malloc(sizeof(DigitalSignalCache));
+    cache->gpio = gpio;
+    cache->size = 0;
+    cache->entries = NULL;
+    cache->send_time = 0;
+    cache->send_time_active = false;
+    memset(&cache->stats, 0, sizeof(DigitalSignalCacheStats));
+
+    cache->dma_config_gpio.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+    cache->dma_config_gpio.Mode = LL_DMA_MODE_CIRCULAR;
+    cache->dma_config_gpio.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    cache->dma_config_gpio.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    cache->dma_config_gpio.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_WORD;
+    cache->dma_config_gpio.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_WORD;
+    cache->dma_config_gpio.NbData = 2;
+    cache->dma_config_gpio.PeriphOrM2MSrcAddress = (uint32_t) & (gpio->port->BSRR);
+    cache->dma_config_gpio.PeriphRequest = LL_DMAMUX_REQ_TIM2_UP;
+    cache->dma_config_gpio.Priority = LL_DMA_PRIORITY_VERYHIGH;
+
+    cache->dma_config_timer.PeriphOrM2MSrcAddress = (uint32_t) & (TIM2->ARR);
+    cache->dma_config_timer.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+    cache->dma_config_timer.Mode = LL_DMA_MODE_NORMAL;
+    cache->dma_config_timer.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    cache->dma_config_timer.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    cache->dma_config_timer.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_WORD;
+    cache->dma_config_timer.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_WORD;
+    cache->dma_config_timer.PeriphRequest = LL_DMAMUX_REQ_TIM2_UP;
+    cache->dma_config_timer.Priority = LL_DMA_PRIORITY_HIGH;
+
+    return cache;
+}
+
+void digital_signal_cache_free(DigitalSignalCache* cache) {
+    furi_assert(cache);
+
+    digital_signal_cache_flush(cache);
+    free(cache);
+}
+
+static size_t digital_signal_cache_entry_size(DigitalSignalCacheEntry* entry) {
+    return sizeof(DigitalSignalCacheEntry) + entry->reload_reg_entries * sizeof(uint32_t) +
+           entry->key_size;
+}
+
+static uint32_t digital_signal_cache_hash(const uint8_t* key, size_t key_size) {
+    /* FNV-1a */
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < key_size; i++) {
+        hash = (hash ^ key[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+static DigitalSignalCacheEntry* digital_signal_cache_find(
+    DigitalSignalCache* cache,
+    const uint8_t* key,
+    size_t key_size,
+    uint32_t hash) {
+    for(DigitalSignalCacheEntry* entry = cache->entries; entry; entry = entry->next) {
+        if(entry->hash == hash && entry->key_size == key_size &&
+           !memcmp(&entry->data[entry->reload_reg_entries], key, key_size)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+void digital_signal_cache_set_size(DigitalSignalCache* cache, size_t size) {
+    furi_assert(cache);
+
+    cache->size = size;
+    if(cache->stats.used > size) {
+        digital_signal_cache_flush(cache);
+    }
+}
+
+void digital_signal_cache_flush(DigitalSignalCache* cache) {
+    furi_assert(cache);
+
+    while(cache->entries) {
+        DigitalSignalCacheEntry* entry = cache->entries;
+        cache->entries = entry->next;
+        free(entry);
+    }
+    cache->stats.entries = 0;
+    cache->stats.used = 0;
+}
+
+bool digital_signal_cache_add(
+    DigitalSignalCache* cache,
+    const uint8_t* key,
+    size_t key_size,
+    DigitalSignal* signal) {
+    furi_assert(cache);
+    furi_assert(key);
+    furi_assert(signal);
+
+    uint32_t hash = digital_signal_cache_hash(key, key_size);
+    if(digital_signal_cache_find(cache, key, key_size, hash)) {
+        return true;
+    }
+
+    signal->internals->reload_reg_remainder = 0;
+    digital_signal_prepare(signal, cache->gpio);
+
+    uint32_t reload_reg_entries = signal->internals->reload_reg_entries;
+    size_t entry_size =
+        sizeof(DigitalSignalCacheEntry) + reload_reg_entries * sizeof(uint32_t) + key_size;
+    if(!reload_reg_entries || cache->stats.used + entry_size > cache->size) {
+        return false;
+    }
+
+    DigitalSignalCacheEntry* entry = malloc(entry_size);
+    entry->hash = hash;
+    entry->key_size = key_size;
+    entry->gpio_buff[0] = signal->internals->gpio_buff[0];
+    entry->gpio_buff[1] = signal->internals->gpio_buff[1];
+    entry->reload_reg_entries = reload_reg_entries;
+    memcpy(entry->data, signal->reload_reg_buff, reload_reg_entries * sizeof(uint32_t));
+    memcpy(&entry->data[reload_reg_entries], key, key_size);
+
+    entry->next = cache->entries;
+    cache->entries = entry;
+    cache->stats.entries++;
+    cache->stats.used += digital_signal_cache_entry_size(entry);
+
+    return true;
+}
+
+bool digital_signal_cache_add_sequence(
+    DigitalSignalCache* cache,
+    const uint8_t* key,
+    size_t key_size,
+    DigitalSequence* sequence) {
+    furi_assert(cache);
+    furi_assert(sequence);
+
+    if(!sequence->sequence_used) {
+        return false;
+    }
+
+    DigitalSignal* signal = digital_sequence_bake(sequence);
+    bool success = digital_signal_cache_add(cache, key, key_size, signal);
+    digital_signal_free(signal);
+
+    return success;
+}
+
+void digital_signal_cache_set_sendtime(DigitalSignalCache* cache, uint32_t send_time) {
+    furi_assert(cache);
+
+    cache->send_time = send_time;
+    cache->send_time_active = true;
+}
+
+bool digital_signal_cache_send(DigitalSignalCache* cache, const uint8_t* key, size_t key_size) {
+    furi_assert(cache);
+    furi_assert(key);
+
+    uint32_t start = DWT->CYCCNT;
+
+    DigitalSignalCacheEntry* entry = NULL;
+    if(cache->entries) {
+        entry = digital_signal_cache_find(
+            cache, key, key_size, digital_signal_cache_hash(key, key_size));
+    }
+    if(!entry) {
+        /* send time belongs to this response only */
+        cache->send_time_active = false;
+        return false;
+    }
+
+    furi_hal_gpio_init(cache->gpio, GpioModeOutputPushPull, GpioPullNo, GpioSpeedVeryHigh);
+
+    FURI_CRITICAL_ENTER();
+
+    digital_signal_stop_dma();
+    cache->dma_config_gpio.MemoryOrM2MDstAddress = (uint32_t)entry->gpio_buff;
+    cache->dma_config_timer.MemoryOrM2MDstAddress = (uint32_t)entry->data;
+    cache->dma_config_timer.NbData = entry->reload_reg_entries;
+    LL_DMA_Init(DMA1, LL_DMA_CHANNEL_1, &cache->dma_config_gpio);
+    LL_DMA_Init(DMA1, LL_DMA_CHANNEL_2, &cache->dma_config_timer);
+    LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_1);
+    LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_2);
+    digital_signal_setup_timer();
+
+    cache->stats.hits++;
+    cache->stats.hit_prepare_time += DWT->CYCCNT - start;
+
+    /* same as for sequences: wait till the core timer passed beyond the send time */
+    if(cache->send_time_active) {
+        cache->send_time_active = false;
+        while(cache->send_time - DWT->CYCCNT < 0x80000000) {
+        }
+    }
+    digital_signal_start_timer();
+
+    while(!LL_DMA_IsActiveFlag_TC2(DMA1)) {
+    }
+
+    digital_signal_stop_timer();
+    digital_signal_stop_dma();
+
+    FURI_CRITICAL_EXIT();
+
+    return true;
+}
+
+void digital_signal_cache_add_miss(DigitalSignalCache* cache, uint32_t prepare_time) {
+    furi_assert(cache);
+
+    cache->stats.misses++;
+    cache->stats.miss_prepare_time += prepare_time;
+}
+
+void digital_signal_cache_get_stats(DigitalSignalCache* cache, DigitalSignalCacheStats* stats) {
+    furi_assert(cache);
+    furi_assert(stats);
+
+    *stats = cache->stats;
+}
@@ -31,6 +31,18 @@ typedef struct DigitalSignal {
 
 typedef struct DigitalSequence DigitalSequence;
 
+/* ready to send signals, looked up by a caller defined key */
+typedef struct DigitalSignalCache DigitalSignalCache;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint64_t hit_prepare_time; /* CPU cycles from lookup to transmission start, total */
+    uint64_t miss_prepare_time; /* CPU cycles spent building uncached signals, total */
+    size_t entries;
+    size_t used; /* bytes */
+} DigitalSignalCacheStats;
+
 DigitalSignal* digital_signal_alloc(uint32_t max_edges_cnt);
 
 void digital_signal_free(DigitalSignal* signal);
@@ -51,6 +63,11 @@ uint32_t digital_signal_get_edge(DigitalSignal* signal, uint32_t edge_num);
 
 void digital_signal_send(DigitalSignal* signal, const GpioPin* gpio);
 
+/* split version of digital_signal_send, for callers that measure or reuse preparation */
+void digital_signal_prepare(DigitalSignal* signal, const GpioPin* gpio);
+
+void digital_signal_send_prepared(DigitalSignal* signal);
+
 DigitalSequence* digital_sequence_alloc(uint32_t size, const GpioPin* gpio);
 
 void digital_sequence_free(DigitalSequence* sequence);
@@ -70,6 +87,39 @@ void digital_sequence_clear(DigitalSequence* sequence);
 
 void digital_sequence_timebase_correction(DigitalSequence* sequence, float factor);
 
+/* cache is empty and disabled (size 0) after allocation */
+DigitalSignalCache* digital_signal_cache_alloc(const GpioPin* gpio);
+
+void digital_signal_cache_free(DigitalSignalCache* cache);
+
+/* set memory limit in bytes, entries are dropped if they do not fit anymore */
+void digital_signal_cache_set_size(DigitalSignalCache* cache, size_t size);
+
+void digital_signal_cache_flush(DigitalSignalCache* cache);
+
+/* prepare signal and store a copy of its reload values, false if it does not fit */
+bool digital_signal_cache_add(
+    DigitalSignalCache* cache,
+    const uint8_t* key,
+    size_t key_size,
+    DigitalSignal* signal);
+
+bool digital_signal_cache_add_sequence(
+    DigitalSignalCache* cache,
+    const uint8_t* key,
+    size_t key_size,
+    DigitalSequence* sequence);
+
+void digital_signal_cache_set_sendtime(DigitalSignalCache* cache, uint32_t send_time);
+
+/* send cached signal, false if there is no entry for the key and nothing was sent */
+bool digital_signal_cache_send(DigitalSignalCache* cache, const uint8_t* key, size_t key_size);
+
+/* account a signal that was not found in cache and had to be built by the caller */
+void digital_signal_cache_add_miss(DigitalSignalCache* cache, uint32_t prepare_time);
+
+void digital_signal_cache_get_stats(DigitalSignalCache* cache, DigitalSignalCacheStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -120,6 +120,14 @@ FlipperFormat* flipper_format_file_alloc(Storage* storage);
  */
 FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage);
 
+/**
+ * Allocate FlipperFormat as file, buffered mode with custom cache size.
+ * Use for big files that are read sequentially, like signal libraries.
+ * @param cache_size cache size in bytes
+ * @return FlipperFormat* pointer to a FlipperFormat instance
+ */
+FlipperFormat* flipper_format_buffered_file_alloc_ex(Storage* storage, size_t cache_size);
+
 /**
  * Open existing file. 
  * Use only if FlipperFormat allocated as a file.
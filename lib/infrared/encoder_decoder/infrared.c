@@ -43,7 +43,22 @@ typedef struct {
     InfraredGetProtocolVariant get_protocol_variant;
 } InfraredEncoderDecoder;
 
+/* Protocol families built in. Firmware built with INFRARED_PROTOCOLS fbt
+ * option defines INFRARED_PROTOCOLS_SELECTED and only listed families,
+ * otherwise all of them are present. Protocols of left out families are
+ * not valid: they are neither decoded nor encoded, nor found by name. */
+#ifndef INFRARED_PROTOCOLS_SELECTED
+#define INFRARED_PROTOCOL_NEC
+#define INFRARED_PROTOCOL_SAMSUNG
+#define INFRARED_PROTOCOL_RC5
+#define INFRARED_PROTOCOL_RC6
+#define INFRARED_PROTOCOL_SIRC
+#define INFRARED_PROTOCOL_KASEIKYO
+#define INFRARED_PROTOCOL_RCA
+#endif
+
 static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
+#ifdef INFRARED_PROTOCOL_NEC
     {
         .decoder =
             {.alloc = infrared_decoder_nec_alloc,
@@ -58,6 +73,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .free = infrared_encoder_nec_free},
         .get_protocol_variant = infrared_protocol_nec_get_variant,
     },
+#endif
+#ifdef INFRARED_PROTOCOL_SAMSUNG
     {
         .decoder =
             {.alloc = infrared_decoder_samsung32_alloc,
@@ -72,6 +89,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .free = infrared_encoder_samsung32_free},
         .get_protocol_variant = infrared_protocol_samsung32_get_variant,
     },
+#endif
+#ifdef INFRARED_PROTOCOL_RC5
     {
         .decoder =
             {.alloc = infrared_decoder_rc5_alloc,
@@ -86,6 +105,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .free = infrared_encoder_rc5_free},
         .get_protocol_variant = infrared_protocol_rc5_get_variant,
     },
+#endif
+#ifdef INFRARED_PROTOCOL_RC6
     {
         .decoder =
             {.alloc = infrared_decoder_rc6_alloc,
@@ -100,6 +121,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .free = infrared_encoder_rc6_free},
         .get_protocol_variant = infrared_protocol_rc6_get_variant,
     },
+#endif
+#ifdef INFRARED_PROTOCOL_SIRC
     {
         .decoder =
             {.alloc = infrared_decoder_sirc_alloc,
@@ -114,6 +137,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .free = infrared_encoder_sirc_free},
         .get_protocol_variant = infrared_protocol_sirc_get_variant,
     },
+#endif
+#ifdef INFRARED_PROTOCOL_KASEIKYO
     {
         .decoder =
             {.alloc = infrared_decoder_kaseikyo_alloc,
@@ -128,6 +153,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .free = infrared_encoder_kaseikyo_free},
         .get_protocol_variant = infrared_protocol_kaseikyo_get_variant,
     },
+#endif
+#ifdef INFRARED_PROTOCOL_RCA
     {
         .decoder =
             {.alloc = infrared_decoder_rca_alloc,
@@ -142,6 +169,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .free = infrared_encoder_rca_free},
         .get_protocol_variant = infrared_protocol_rca_get_variant,
     },
+#endif
 };
 
 static int infrared_find_index_by_protocol(InfraredProtocol protocol);
@@ -293,6 +321,7 @@ bool infrared_is_protocol_valid(InfraredProtocol protocol) {
 
 InfraredProtocol infrared_get_protocol_by_name(const char* protocol_name) {
     for(InfraredProtocol protocol = 0; protocol < InfraredProtocolMAX; ++protocol) {
+        if(!infrared_is_protocol_valid(protocol)) continue;
         const char* name = infrared_get_protocol_name(protocol);
         if(!strcmp(name, protocol_name)) return protocol;
     }
@@ -0,0 +1,794 @@
+#include "infrared_index.h"
+
+#include <furi.h>
+#include <m-array.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "InfraredIndex"
+
+/* File layout, all values little endian:
+ *  InfraredIndexHeader
+ *  uint16_t buckets[INFRARED_INDEX_BUCKET_COUNT + 1], first entry of every bucket
+ *  InfraredIndexSource[source_count], sorted by path
+ *  InfraredIndexEntry[entry_count], sorted by key
+ *  name table: length byte followed by name, for every entry
+ */
+#define INFRARED_INDEX_MAGIC (0x58495249UL) /* "IRIX" */
+#define INFRARED_INDEX_VERSION (2)
+
+/* Bucket is selected by the top byte of key, lookup reads one bucket */
+#define INFRARED_INDEX_BUCKET_COUNT (256)
+#define INFRARED_INDEX_PATH_SIZE (64)
+#define INFRARED_INDEX_NAME_SIZE (256)
+
+/* Entries are sorted in RAM on rebuild, 8 bytes each */
+#define INFRARED_INDEX_ENTRY_COUNT_MAX (8192)
+
+/* Long enough to cover the command part of common protocols */
+#define INFRARED_INDEX_RAW_TIMINGS (128)
+#define INFRARED_INDEX_RAW_TIMINGS_MIN (8)
+#define INFRARED_INDEX_RAW_HEADER (2)
+/* Timings closer than 1/4 of the shorter one or than jitter, us, are the same */
+#define INFRARED_INDEX_RAW_TOLERANCE_DIV (4)
+#define INFRARED_INDEX_RAW_JITTER (200)
+
+#define INFRARED_INDEX_LOOKUP_CHUNK (16)
+#define INFRARED_INDEX_WRITE_BUFFER_SIZE (512)
+#define INFRARED_INDEX_SOURCE_CACHE_SIZE (4 * 1024)
+
+#define INFRARED_INDEX_HASH_INIT (2166136261UL)
+#define INFRARED_INDEX_HASH_PRIME (16777619UL)
+#define INFRARED_INDEX_KEY_MESSAGE ('M')
+#define INFRARED_INDEX_KEY_RAW ('R')
+
+#define INFRARED_INDEX_NOT_REUSED (UINT32_MAX)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t source_count;
+    uint32_t entry_count;
+    uint32_t names_size;
+} __attribute__((packed)) InfraredIndexHeader;
+
+typedef struct {
+    uint32_t timestamp;
+    uint32_t names_start; /**< Names of this source are contiguous in name table */
+    uint32_t names_size;
+    char path[INFRARED_INDEX_PATH_SIZE];
+} __attribute__((packed)) InfraredIndexSource;
+
+typedef struct {
+    uint32_t key;
+    uint32_t name; /**< Offset in name table */
+} __attribute__((packed)) InfraredIndexEntry;
+
+ARRAY_DEF(InfraredIndexSourceArray, InfraredIndexSource, M_POD_OPLIST);
+ARRAY_DEF(InfraredIndexEntryArray, InfraredIndexEntry, M_POD_OPLIST);
+ARRAY_DEF(InfraredIndexDirArray, FuriString*, FURI_STRING_OPLIST);
+
+typedef struct {
+    File* file;
+    uint8_t buffer[INFRARED_INDEX_WRITE_BUFFER_SIZE];
+    size_t used;
+    uint32_t written;
+    bool success;
+} InfraredIndexWriter;
+
+struct InfraredIndex {
+    Storage* storage;
+    FuriString* path;
+    InfraredIndexDirArray_t dirs;
+
+    File* file; /**< Open index, NULL if there is none */
+    InfraredIndexHeader header;
+    uint16_t buckets[INFRARED_INDEX_BUCKET_COUNT + 1];
+    InfraredIndexSourceArray_t sources;
+
+    char name[INFRARED_INDEX_NAME_SIZE];
+    InfraredIndexStats stats;
+};
+
+static uint32_t infrared_index_hash(uint32_t hash, uint32_t value) {
+    for(size_t i = 0; i < sizeof(uint32_t); i++) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= INFRARED_INDEX_HASH_PRIME;
+    }
+    return hash;
+}
+
+static uint32_t infrared_index_message_key(const InfraredMessage* message) {
+    uint32_t key = infrared_index_hash(INFRARED_INDEX_HASH_INIT, INFRARED_INDEX_KEY_MESSAGE);
+    key = infrared_index_hash(key, message->protocol);
+    key = infrared_index_hash(key, message->address);
+    return infrared_index_hash(key, message->command);
+}
+
+static int infrared_index_timing_compare(const void* a, const void* b) {
+    uint32_t timing_a = *(const uint32_t*)a;
+    uint32_t timing_b = *(const uint32_t*)b;
+    return (timing_a > timing_b) - (timing_a < timing_b);
+}
+
+/* Timings are grouped into clusters of close durations, the way protocol
+ * decoders match against mark/space with a tolerance, and every timing is
+ * replaced by the rank of its cluster. No fixed bin edges: key only changes
+ * when jitter merges or splits clusters, not when a timing crosses a bin.
+ * Header is told apart by position, not by duration (Kaseikyo header space
+ * is 4/3 of a one bit space), so it is left out. */
+static bool infrared_index_raw_key(const uint32_t* timings, size_t timings_size, uint32_t* key) {
+    timings_size = MIN(timings_size, (size_t)INFRARED_INDEX_RAW_TIMINGS);
+    if(timings_size < INFRARED_INDEX_RAW_TIMINGS_MIN) return false;
+    timings += INFRARED_INDEX_RAW_HEADER;
+    timings_size -= INFRARED_INDEX_RAW_HEADER;
+
+    // Sorted copy is reduced in place to the upper bound of every cluster
+    uint32_t* clusters = malloc(sizeof(uint32_t) * timings_size);
+    memcpy(clusters, timings, sizeof(uint32_t) * timings_size);
+    qsort(clusters, timings_size, sizeof(uint32_t), infrared_index_timing_compare);
+
+    size_t cluster_count = 0;
+    for(size_t i = 1; i <= timings_size; i++) {
+        uint32_t last = clusters[i - 1];
+        if((i == timings_size) ||
+           (clusters[i] - last > MAX(last / INFRARED_INDEX_RAW_TOLERANCE_DIV,
+                                      (uint32_t)INFRARED_INDEX_RAW_JITTER))) {
+            clusters[cluster_count++] = last;
+        }
+    }
+
+    uint32_t hash = infrared_index_hash(INFRARED_INDEX_HASH_INIT, INFRARED_INDEX_KEY_RAW);
+    for(size_t i = 0; i < timings_size; i++) {
+        uint32_t rank = 0;
+        while(timings[i] > clusters[rank]) rank++;
+        hash = infrared_index_hash(hash, rank);
+    }
+    free(clusters);
+
+    *key = hash;
+    return true;
+}
+
+static size_t infrared_index_sources_offset() {
+    return sizeof(InfraredIndexHeader) + sizeof(uint16_t) * (INFRARED_INDEX_BUCKET_COUNT + 1);
+}
+
+static size_t infrared_index_entries_offset(const InfraredIndexHeader* header) {
+    return infrared_index_sources_offset() + sizeof(InfraredIndexSource) * header->source_count;
+}
+
+static size_t infrared_index_names_offset(const InfraredIndexHeader* header) {
+    return infrared_index_entries_offset(header) +
+           sizeof(InfraredIndexEntry) * header->entry_count;
+}
+
+static bool infrared_index_read(File* file, size_t offset, void* data, size_t size) {
+    return storage_file_seek(file, offset, true) && (storage_file_read(file, data, size) == size);
+}
+
+static void infrared_index_writer_flush(InfraredIndexWriter* writer) {
+    if(writer->used && writer->success) {
+        writer->success = storage_file_write(writer->file, writer->buffer, writer->used) ==
+                          writer->used;
+    }
+    writer->used = 0;
+}
+
+static void infrared_index_writer_put(InfraredIndexWriter* writer, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    writer->written += size;
+
+    while(size) {
+        size_t chunk = MIN(size, sizeof(writer->buffer) - writer->used);
+        memcpy(&writer->buffer[writer->used], bytes, chunk);
+        writer->used += chunk;
+        bytes += chunk;
+        size -= chunk;
+        if(writer->used == sizeof(writer->buffer)) {
+            infrared_index_writer_flush(writer);
+        }
+    }
+}
+
+static void infrared_index_writer_copy(
+    InfraredIndexWriter* writer,
+    File* file,
+    size_t offset,
+    size_t size) {
+    infrared_index_writer_flush(writer);
+    if(!storage_file_seek(file, offset, true)) {
+        writer->success = false;
+        return;
+    }
+
+    while(size && writer->success) {
+        size_t chunk = MIN(size, sizeof(writer->buffer));
+        if(storage_file_read(file, writer->buffer, chunk) != chunk) {
+            writer->success = false;
+            break;
+        }
+        writer->used = chunk;
+        writer->written += chunk;
+        infrared_index_writer_flush(writer);
+        size -= chunk;
+    }
+}
+
+static void infrared_index_close(InfraredIndex* index) {
+    if(index->file) {
+        storage_file_free(index->file);
+        index->file = NULL;
+    }
+    memset(&index->header, 0, sizeof(InfraredIndexHeader));
+    memset(index->buckets, 0, sizeof(index->buckets));
+    InfraredIndexSourceArray_reset(index->sources);
+}
+
+static bool infrared_index_load(InfraredIndex* index) {
+    infrared_index_close(index);
+
+    File* file = storage_file_alloc(index->storage);
+    InfraredIndexHeader* header = &index->header;
+    bool success = false;
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(index->path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(!infrared_index_read(file, 0, header, sizeof(InfraredIndexHeader))) break;
+        if((header->magic != INFRARED_INDEX_MAGIC) ||
+           (header->version != INFRARED_INDEX_VERSION) ||
+           (header->entry_count > INFRARED_INDEX_ENTRY_COUNT_MAX)) {
+            FURI_LOG_W(TAG, "Unsupported index");
+            break;
+        }
+        if(storage_file_read(file, index->buckets, sizeof(index->buckets)) !=
+           sizeof(index->buckets))
+            break;
+        if(index->buckets[INFRARED_INDEX_BUCKET_COUNT] != header->entry_count) break;
+
+        InfraredIndexSourceArray_resize(index->sources, header->source_count);
+        size_t sources_size = sizeof(InfraredIndexSource) * header->source_count;
+        if(sources_size && storage_file_read(
+                               file,
+                               InfraredIndexSourceArray_get(index->sources, 0),
+                               sources_size) != sources_size)
+            break;
+
+        if(storage_file_size(file) != infrared_index_names_offset(header) + header->names_size)
+            break;
+
+        success = true;
+    } while(false);
+
+    if(success) {
+        index->file = file;
+    } else {
+        storage_file_free(file);
+        memset(header, 0, sizeof(InfraredIndexHeader));
+        InfraredIndexSourceArray_reset(index->sources);
+    }
+
+    return success;
+}
+
+InfraredIndex* infrared_index_alloc(Storage* storage, const char* index_path) {
+    furi_assert(storage);
+    furi_assert(index_path);
+
+    InfraredIndex* index = malloc(sizeof(InfraredIndex));
+    index->storage = storage;
+    index->path = furi_string_alloc_set(index_path);
+    InfraredIndexDirArray_init(index->dirs);
+    InfraredIndexSourceArray_init(index->sources);
+
+    infrared_index_load(index);
+    index->stats.source_count = index->header.source_count;
+    index->stats.entry_count = index->header.entry_count;
+
+    return index;
+}
+
+void infrared_index_free(InfraredIndex* index) {
+    furi_assert(index);
+
+    infrared_index_close(index);
+    InfraredIndexSourceArray_clear(index->sources);
+    InfraredIndexDirArray_clear(index->dirs);
+    furi_string_free(index->path);
+    free(index);
+}
+
+void infrared_index_add_source_dir(InfraredIndex* index, const char* path) {
+    furi_assert(index);
+    furi_assert(path);
+
+    FuriString* dir = furi_string_alloc_set(path);
+    InfraredIndexDirArray_push_back(index->dirs, dir);
+    furi_string_free(dir);
+}
+
+static int infrared_index_source_compare(const void* a, const void* b) {
+    return strcmp(((const InfraredIndexSource*)a)->path, ((const InfraredIndexSource*)b)->path);
+}
+
+static void infrared_index_scan(InfraredIndex* index, InfraredIndexSourceArray_t sources) {
+    File* dir = storage_file_alloc(index->storage);
+    FileInfo fileinfo;
+
+    InfraredIndexDirArray_it_t it;
+    for(InfraredIndexDirArray_it(it, index->dirs); !InfraredIndexDirArray_end_p(it);
+        InfraredIndexDirArray_next(it)) {
+        const char* dir_path = furi_string_get_cstr(*InfraredIndexDirArray_cref(it));
+        if(!storage_dir_open(dir, dir_path)) {
+            storage_dir_close(dir);
+            continue;
+        }
+
+        while(storage_dir_read(dir, &fileinfo, index->name, sizeof(index->name))) {
+            size_t name_length = strlen(index->name);
+            if(file_info_is_dir(&fileinfo) || (name_length < 3) ||
+               strcmp(&index->name[name_length - 3], ".ir")) {
+                continue;
+            }
+
+            InfraredIndexSource source = {0};
+            if(snprintf(source.path, sizeof(source.path), "%s/%s", dir_path, index->name) >=
+               (int)sizeof(source.path)) {
+                FURI_LOG_W(TAG, "Path is too long: %s", index->name);
+                continue;
+            }
+            if(storage_common_timestamp(index->storage, source.path, &source.timestamp) !=
+               FSE_OK) {
+                continue;
+            }
+            InfraredIndexSourceArray_push_back(sources, source);
+        }
+
+        storage_dir_close(dir);
+    }
+
+    storage_file_free(dir);
+
+    if(InfraredIndexSourceArray_size(sources)) {
+        qsort(
+            InfraredIndexSourceArray_get(sources, 0),
+            InfraredIndexSourceArray_size(sources),
+            sizeof(InfraredIndexSource),
+            infrared_index_source_compare);
+    }
+}
+
+static const InfraredIndexSource*
+    infrared_index_find_source(InfraredIndexSourceArray_t sources, const char* path) {
+    for(size_t i = 0; i < InfraredIndexSourceArray_size(sources); i++) {
+        const InfraredIndexSource* source = InfraredIndexSourceArray_cget(sources, i);
+        if(!strcmp(source->path, path)) {
+            return source;
+        }
+    }
+    return NULL;
+}
+
+static bool infrared_index_is_actual(InfraredIndex* index, InfraredIndexSourceArray_t sources) {
+    if(!index->file) return false;
+    if(InfraredIndexSourceArray_size(sources) != InfraredIndexSourceArray_size(index->sources))
+        return false;
+
+    for(size_t i = 0; i < InfraredIndexSourceArray_size(sources); i++) {
+        const InfraredIndexSource* source = InfraredIndexSourceArray_cget(sources, i);
+        const InfraredIndexSource* indexed = InfraredIndexSourceArray_cget(index->sources, i);
+        if(strcmp(source->path, indexed->path) || (source->timestamp != indexed->timestamp)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool infrared_index_read_key(
+    FlipperFormat* ff,
+    FuriString* value,
+    uint32_t* timings,
+    uint32_t* key) {
+    if(!flipper_format_read_string(ff, "type", value)) return false;
+
+    if(furi_string_equal(value, "parsed")) {
+        InfraredMessage message = {0};
+        if(!flipper_format_read_string(ff, "protocol", value)) return false;
+        message.protocol = infrared_get_protocol_by_name(furi_string_get_cstr(value));
+        if(!infrared_is_protocol_valid(message.protocol)) return false;
+        if(!flipper_format_read_hex(ff, "address", (uint8_t*)&message.address, 4) ||
+           !flipper_format_read_hex(ff, "command", (uint8_t*)&message.command, 4)) {
+            return false;
+        }
+        *key = infrared_index_message_key(&message);
+        return true;
+
+    } else if(furi_string_equal(value, "raw")) {
+        uint32_t timings_size;
+        if(!flipper_format_get_value_count(ff, "data", &timings_size)) return false;
+        timings_size = MIN(timings_size, (uint32_t)INFRARED_INDEX_RAW_TIMINGS);
+        // Values after the first ones are skipped with the rest of the line
+        if(!flipper_format_read_uint32(ff, "data", timings, timings_size)) return false;
+        return infrared_index_raw_key(timings, timings_size, key);
+    }
+
+    return false;
+}
+
+static void infrared_index_parse(
+    InfraredIndex* index,
+    const char* path,
+    InfraredIndexEntryArray_t entries,
+    InfraredIndexWriter* names) {
+    FlipperFormat* ff =
+        flipper_format_buffered_file_alloc_ex(index->storage, INFRARED_INDEX_SOURCE_CACHE_SIZE);
+    FuriString* name = furi_string_alloc();
+    FuriString* value = furi_string_alloc();
+    uint32_t* timings = malloc(sizeof(uint32_t) * INFRARED_INDEX_RAW_TIMINGS);
+    uint32_t version;
+
+    if(flipper_format_buffered_file_open_existing(ff, path) &&
+       flipper_format_read_header(ff, value, &version)) {
+        while(flipper_format_read_string(ff, "name", name)) {
+            InfraredIndexEntry entry;
+            if(!infrared_index_read_key(ff, value, timings, &entry.key)) continue;
+
+            if(InfraredIndexEntryArray_size(entries) == INFRARED_INDEX_ENTRY_COUNT_MAX) {
+                FURI_LOG_W(TAG, "Index is full, %s is not complete", path);
+                break;
+            }
+
+            uint8_t length = MIN(furi_string_size(name), (size_t)UINT8_MAX);
+            entry.name = names->written;
+            infrared_index_writer_put(names, &length, sizeof(length));
+            infrared_index_writer_put(names, furi_string_get_cstr(name), length);
+            InfraredIndexEntryArray_push_back(entries, entry);
+        }
+    } else {
+        FURI_LOG_W(TAG, "Failed to parse %s", path);
+    }
+
+    free(timings);
+    furi_string_free(value);
+    furi_string_free(name);
+    flipper_format_free(ff);
+}
+
+/* Entries of sources that didn't change are moved to their new place in name table */
+static bool infrared_index_reuse_entries(
+    InfraredIndex* index,
+    const uint32_t* names_start,
+    InfraredIndexEntryArray_t entries) {
+    const size_t source_count = InfraredIndexSourceArray_size(index->sources);
+    InfraredIndexEntry chunk[INFRARED_INDEX_LOOKUP_CHUNK];
+
+    if(!storage_file_seek(index->file, infrared_index_entries_offset(&index->header), true)) {
+        return false;
+    }
+
+    for(size_t i = 0; i < index->header.entry_count; i += COUNT_OF(chunk)) {
+        size_t count = MIN(COUNT_OF(chunk), index->header.entry_count - i);
+        if(storage_file_read(index->file, chunk, sizeof(InfraredIndexEntry) * count) !=
+           sizeof(InfraredIndexEntry) * count) {
+            return false;
+        }
+
+        for(size_t j = 0; j < count; j++) {
+            for(size_t k = 0; k < source_count; k++) {
+                const InfraredIndexSource* source =
+                    InfraredIndexSourceArray_cget(index->sources, k);
+                if((chunk[j].name < source->names_start) ||
+                   (chunk[j].name >= source->names_start + source->names_size)) {
+                    continue;
+                }
+                if(names_start[k] != INFRARED_INDEX_NOT_REUSED) {
+                    InfraredIndexEntry entry = {
+                        .key = chunk[j].key,
+                        .name = chunk[j].name - source->names_start + names_start[k],
+                    };
+                    InfraredIndexEntryArray_push_back(entries, entry);
+                }
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+static int infrared_index_entry_compare(const void* a, const void* b) {
+    uint32_t key_a = ((const InfraredIndexEntry*)a)->key;
+    uint32_t key_b = ((const InfraredIndexEntry*)b)->key;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+static bool infrared_index_write(
+    InfraredIndex* index,
+    const char* path,
+    InfraredIndexSourceArray_t sources,
+    InfraredIndexEntryArray_t entries,
+    File* names_file,
+    uint32_t names_size) {
+    InfraredIndexWriter* writer = malloc(sizeof(InfraredIndexWriter));
+    writer->file = storage_file_alloc(index->storage);
+    writer->used = 0;
+    writer->written = 0;
+    writer->success = storage_file_open(writer->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+
+    const size_t entry_count = InfraredIndexEntryArray_size(entries);
+    uint16_t* buckets = malloc(sizeof(uint16_t) * (INFRARED_INDEX_BUCKET_COUNT + 1));
+    for(size_t i = 0, bucket = 0; bucket <= INFRARED_INDEX_BUCKET_COUNT; bucket++) {
+        while((i < entry_count) &&
+              ((InfraredIndexEntryArray_cget(entries, i)->key >> 24) < bucket)) {
+            i++;
+        }
+        buckets[bucket] = i;
+    }
+
+    // Magic is written last, so that interrupted write leaves an invalid index
+    InfraredIndexHeader header = {
+        .magic = 0,
+        .version = INFRARED_INDEX_VERSION,
+        .source_count = InfraredIndexSourceArray_size(sources),
+        .entry_count = entry_count,
+        .names_size = names_size,
+    };
+
+    infrared_index_writer_put(writer, &header, sizeof(header));
+    infrared_index_writer_put(
+        writer, buckets, sizeof(uint16_t) * (INFRARED_INDEX_BUCKET_COUNT + 1));
+    for(size_t i = 0; i < header.source_count; i++) {
+        infrared_index_writer_put(
+            writer, InfraredIndexSourceArray_cget(sources, i), sizeof(InfraredIndexSource));
+    }
+    for(size_t i = 0; i < entry_count; i++) {
+        infrared_index_writer_put(
+            writer, InfraredIndexEntryArray_cget(entries, i), sizeof(InfraredIndexEntry));
+    }
+    infrared_index_writer_copy(writer, names_file, 0, names_size);
+    infrared_index_writer_flush(writer);
+
+    header.magic = INFRARED_INDEX_MAGIC;
+    bool success = writer->success && storage_file_seek(writer->file, 0, true) &&
+                   (storage_file_write(writer->file, &header, sizeof(header)) == sizeof(header));
+
+    free(buckets);
+    storage_file_free(writer->file);
+    free(writer);
+
+    return success;
+}
+
+static bool infrared_index_rebuild(InfraredIndex* index, InfraredIndexSourceArray_t sources) {
+    FuriString* tmp_path = furi_string_alloc_printf("%s.tmp", furi_string_get_cstr(index->path));
+    FuriString* names_path =
+        furi_string_alloc_printf("%s.names", furi_string_get_cstr(index->path));
+
+    InfraredIndexEntryArray_t entries;
+    InfraredIndexEntryArray_init(entries);
+
+    InfraredIndexWriter* names = malloc(sizeof(InfraredIndexWriter));
+    names->file = storage_file_alloc(index->storage);
+    names->used = 0;
+    names->written = 0;
+    names->success = storage_file_open(
+        names->file, furi_string_get_cstr(names_path), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+
+    // Name table of unchanged sources is copied as is
+    const size_t source_count = InfraredIndexSourceArray_size(sources);
+    const size_t old_source_count = InfraredIndexSourceArray_size(index->sources);
+    uint32_t* names_start = malloc(sizeof(uint32_t) * MAX(old_source_count, 1u));
+    bool* reused = malloc(sizeof(bool) * MAX(source_count, 1u));
+    bool any_reused = false;
+
+    for(size_t i = 0; i < old_source_count; i++) {
+        names_start[i] = INFRARED_INDEX_NOT_REUSED;
+    }
+
+    for(size_t i = 0; i < source_count; i++) {
+        InfraredIndexSource* source = InfraredIndexSourceArray_get(sources, i);
+        const InfraredIndexSource* old =
+            index->file ? infrared_index_find_source(index->sources, source->path) : NULL;
+        reused[i] = old && (old->timestamp == source->timestamp);
+        if(reused[i]) {
+            source->names_start = names->written;
+            source->names_size = old->names_size;
+            names_start[old - InfraredIndexSourceArray_cget(index->sources, 0)] =
+                source->names_start;
+            infrared_index_writer_copy(
+                names,
+                index->file,
+                infrared_index_names_offset(&index->header) + old->names_start,
+                old->names_size);
+            any_reused = true;
+        }
+    }
+
+    bool success = names->success;
+    if(success && any_reused) {
+        success = infrared_index_reuse_entries(index, names_start, entries);
+    }
+
+    for(size_t i = 0; success && (i < source_count); i++) {
+        if(reused[i]) continue;
+        InfraredIndexSource* source = InfraredIndexSourceArray_get(sources, i);
+        source->names_start = names->written;
+        infrared_index_parse(index, source->path, entries, names);
+        source->names_size = names->written - source->names_start;
+        index->stats.sources_parsed++;
+    }
+    infrared_index_writer_flush(names);
+    success = success && names->success;
+
+    free(reused);
+    free(names_start);
+
+    if(success) {
+        if(InfraredIndexEntryArray_size(entries)) {
+            qsort(
+                InfraredIndexEntryArray_get(entries, 0),
+                InfraredIndexEntryArray_size(entries),
+                sizeof(InfraredIndexEntry),
+                infrared_index_entry_compare);
+        }
+        success = infrared_index_write(
+            index, furi_string_get_cstr(tmp_path), sources, entries, names->file, names->written);
+    }
+
+    storage_file_free(names->file);
+    free(names);
+    InfraredIndexEntryArray_clear(entries);
+
+    // Old index is not needed anymore
+    infrared_index_close(index);
+    storage_common_remove(index->storage, furi_string_get_cstr(names_path));
+
+    if(success) {
+        storage_common_remove(index->storage, furi_string_get_cstr(index->path));
+        success = storage_common_rename(
+                      index->storage,
+                      furi_string_get_cstr(tmp_path),
+                      furi_string_get_cstr(index->path)) == FSE_OK;
+    }
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Failed to write index");
+        storage_common_remove(index->storage, furi_string_get_cstr(tmp_path));
+    }
+
+    furi_string_free(names_path);
+    furi_string_free(tmp_path);
+
+    return success && infrared_index_load(index);
+}
+
+bool infrared_index_sync(InfraredIndex* index) {
+    furi_assert(index);
+
+    uint32_t start = furi_get_tick();
+    index->stats.sources_parsed = 0;
+    InfraredIndexSourceArray_t sources;
+    InfraredIndexSourceArray_init(sources);
+
+    infrared_index_scan(index, sources);
+
+    bool success = infrared_index_is_actual(index, sources);
+    if(!success) {
+        success = infrared_index_rebuild(index, sources);
+        FURI_LOG_I(
+            TAG,
+            "Rebuilt: %lu entries, %u of %u sources parsed",
+            index->header.entry_count,
+            index->stats.sources_parsed,
+            InfraredIndexSourceArray_size(sources));
+    }
+
+    InfraredIndexSourceArray_clear(sources);
+
+    index->stats.source_count = index->header.source_count;
+    index->stats.entry_count = index->header.entry_count;
+    index->stats.sync_time = furi_get_tick() - start;
+
+    return success;
+}
+
+static bool infrared_index_read_match(
+    InfraredIndex* index,
+    uint32_t name,
+    InfraredIndexMatch* match) {
+    uint8_t length;
+    size_t offset = infrared_index_names_offset(&index->header) + name;
+
+    if(!infrared_index_read(index->file, offset, &length, sizeof(length)) ||
+       (storage_file_read(index->file, index->name, length) != length)) {
+        return false;
+    }
+    index->name[length] = '\0';
+
+    for(size_t i = 0; i < InfraredIndexSourceArray_size(index->sources); i++) {
+        const InfraredIndexSource* source = InfraredIndexSourceArray_cget(index->sources, i);
+        if((name >= source->names_start) && (name < source->names_start + source->names_size)) {
+            match->path = source->path;
+            match->name = index->name;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static size_t infrared_index_lookup(
+    InfraredIndex* index,
+    uint32_t key,
+    InfraredIndexMatchCallback callback,
+    void* context) {
+    if(!index->file) return 0;
+
+    const size_t entries_offset = infrared_index_entries_offset(&index->header);
+    const size_t bucket = key >> 24;
+    const size_t end = index->buckets[bucket + 1];
+    InfraredIndexEntry chunk[INFRARED_INDEX_LOOKUP_CHUNK];
+    size_t found = 0;
+    bool proceed = true;
+
+    for(size_t position = index->buckets[bucket]; proceed && (position < end);) {
+        size_t count = MIN(COUNT_OF(chunk), end - position);
+        if(!infrared_index_read(
+               index->file,
+               entries_offset + sizeof(InfraredIndexEntry) * position,
+               chunk,
+               sizeof(InfraredIndexEntry) * count)) {
+            break;
+        }
+        position += count;
+
+        for(size_t i = 0; proceed && (i < count); i++) {
+            if(chunk[i].key != key) continue;
+            InfraredIndexMatch match;
+            if(!infrared_index_read_match(index, chunk[i].name, &match)) continue;
+            found++;
+            proceed = callback(&match, context);
+        }
+    }
+
+    return found;
+}
+
+size_t infrared_index_lookup_message(
+    InfraredIndex* index,
+    const InfraredMessage* message,
+    InfraredIndexMatchCallback callback,
+    void* context) {
+    furi_assert(index);
+    furi_assert(message);
+    furi_assert(callback);
+
+    return infrared_index_lookup(index, infrared_index_message_key(message), callback, context);
+}
+
+size_t infrared_index_lookup_raw(
+    InfraredIndex* index,
+    const uint32_t* timings,
+    size_t timings_size,
+    InfraredIndexMatchCallback callback,
+    void* context) {
+    furi_assert(index);
+    furi_assert(timings);
+    furi_assert(callback);
+
+    uint32_t key;
+    if(!infrared_index_raw_key(timings, timings_size, &key)) {
+        return 0;
+    }
+
+    return infrared_index_lookup(index, key, callback, context);
+}
+
+void infrared_index_get_stats(InfraredIndex* index, InfraredIndexStats* stats) {
+    furi_assert(index);
+    furi_assert(stats);
+    *stats = index->stats;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file infrared_index.h
+ * Infrared signal reverse lookup index
+ *
+ * Maps a received signal to the files and button names that contain it.
+ * Decoded signals are keyed by protocol, address and command. Raw signals
+ * are keyed by a coarse fingerprint of their first timings, normalized to
+ * the shortest one, so only a clean capture of the same remote matches.
+ *
+ * Index is kept in a file next to the sources. Sync compares source file
+ * timestamps with the ones stored in the index and parses only changed
+ * files, entries of unchanged ones are copied from the previous index.
+ */
+#pragma once
+
+#include <infrared.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct InfraredIndex InfraredIndex;
+
+typedef struct {
+    const char* path; /**< File containing the signal */
+    const char* name; /**< Button name */
+} InfraredIndexMatch;
+
+/** Match callback
+ *
+ * @param      match    match, valid during the call only
+ * @param      context  callback context
+ *
+ * @return     true to continue lookup
+ */
+typedef bool (*InfraredIndexMatchCallback)(const InfraredIndexMatch* match, void* context);
+
+typedef struct {
+    size_t source_count;
+    size_t entry_count;
+    size_t sources_parsed; /**< Sources parsed by the last sync, 0 if index was actual */
+    uint32_t sync_time; /**< Duration of the last sync, ms */
+} InfraredIndexStats;
+
+/** Allocate index and load it if it exists
+ *
+ * @param      storage     Storage instance
+ * @param      index_path  index file path
+ *
+ * @return     InfraredIndex instance
+ */
+InfraredIndex* infrared_index_alloc(Storage* storage, const char* index_path);
+
+/** Free index
+ *
+ * @param      index  InfraredIndex instance
+ */
+void infrared_index_free(InfraredIndex* index);
+
+/** Add directory with .ir files to index, not recursive
+ *
+ * @param      index  InfraredIndex instance
+ * @param      path   directory path
+ */
+void infrared_index_add_source_dir(InfraredIndex* index, const char* path);
+
+/** Bring index up to date with its sources
+ *
+ * Blocks while changed sources are parsed.
+ *
+ * @param      index  InfraredIndex instance
+ *
+ * @return     true if index is usable
+ */
+bool infrared_index_sync(InfraredIndex* index);
+
+/** Find decoded signal
+ *
+ * @param      index     InfraredIndex instance
+ * @param      message   decoded signal
+ * @param      callback  called for every match
+ * @param      context   callback context
+ *
+ * @return     number of matches reported
+ */
+size_t infrared_index_lookup_message(
+    InfraredIndex* index,
+    const InfraredMessage* message,
+    InfraredIndexMatchCallback callback,
+    void* context);
+
+/** Find raw signal
+ *
+ * @param      index         InfraredIndex instance
+ * @param      timings       raw signal timings, us
+ * @param      timings_size  timings count
+ * @param      callback      called for every match
+ * @param      context       callback context
+ *
+ * @return     number of matches reported
+ */
+size_t infrared_index_lookup_raw(
+    InfraredIndex* index,
+    const uint32_t* timings,
+    size_t timings_size,
+    InfraredIndexMatchCallback callback,
+    void* context);
+
+/** Get index statistics
+ *
+ * @param      index  InfraredIndex instance
+ * @param      stats  output
+ */
+void infrared_index_get_stats(InfraredIndex* index, InfraredIndexStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
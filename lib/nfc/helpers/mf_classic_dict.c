@@ -11,6 +11,9 @@
 
 #define NFC_MF_CLASSIC_KEY_LEN (13)
 
+/* System dictionary is tens of KiB, scanned key by key from start to end */
+#define MF_CLASSIC_DICT_CACHE_SIZE (4 * 1024)
+
 struct MfClassicDict {
     Stream* stream;
     uint32_t total_keys;
@@ -37,7 +40,7 @@ bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
 MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
     MfClassicDict* dict = malloc(sizeof(MfClassicDict));
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    dict->stream = buffered_file_stream_alloc(storage);
+    dict->stream = buffered_file_stream_alloc_ex(storage, MF_CLASSIC_DICT_CACHE_SIZE);
     furi_record_close(RECORD_STORAGE);
 
     bool dict_loaded = false;
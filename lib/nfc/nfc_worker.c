@@ -1007,6 +1007,7 @@ void nfc_worker_emulate_mf_classic(NfcWorker* nfc_worker) {
     };
     NfcaSignal* nfca_signal = nfca_signal_alloc();
     tx_rx.nfca_signal = nfca_signal;
+    mf_classic_emulator_prepare_signal(nfca_signal);
 
     rfal_platform_spi_acquire();
 
@@ -1026,6 +1027,15 @@ void nfc_worker_emulate_mf_classic(NfcWorker* nfc_worker) {
         emulator.data_changed = false;
     }
 
+    DigitalSignalCacheStats stats;
+    nfca_signal_get_cache_stats(nfca_signal, &stats);
+    FURI_LOG_D(
+        TAG,
+        "Response cache: %lu hits, %lu misses, %lu us preparing misses",
+        stats.hits,
+        stats.misses,
+        (uint32_t)(stats.miss_prepare_time / furi_hal_cortex_instructions_per_microsecond()));
+
     nfca_signal_free(nfca_signal);
 
     rfal_platform_spi_release();
@@ -1278,6 +1288,7 @@ void nfc_worker_analyze_reader(NfcWorker* nfc_worker) {
     };
     NfcaSignal* nfca_signal = nfca_signal_alloc();
     tx_rx.nfca_signal = nfca_signal;
+    mf_classic_emulator_prepare_signal(nfca_signal);
     reader_analyzer_prepare_tx_rx(reader_analyzer, &tx_rx, true);
     reader_analyzer_start(nfc_worker->reader_analyzer, ReaderAnalyzerModeMfkey);
     reader_analyzer_set_callback(reader_analyzer, nfc_worker_reader_analyzer_callback, nfc_worker);
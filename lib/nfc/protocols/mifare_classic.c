@@ -19,6 +19,8 @@
 #define MF_CLASSIC_INCREMENT_CMD 0xC1U
 #define MF_CLASSIC_RESTORE_CMD 0xC2U
 
+#define MF_CLASSIC_EMULATOR_SIGNAL_CACHE_SIZE (1024)
+
 const char* mf_classic_get_type_str(MfClassicType type) {
     if(type == MfClassicTypeMini) {
         return "MIFARE Mini 0.3K";
@@ -1225,6 +1227,19 @@ bool mf_classic_emulator(
     return !need_reset;
 }
 
+void mf_classic_emulator_prepare_signal(NfcaSignal* nfca_signal) {
+    furi_assert(nfca_signal);
+
+    // Everything else is encrypted with the session keystream, only plain NACKs are static
+    uint8_t nacks[] = {MF_CLASSIC_NACK_BUF_VALID_CMD, MF_CLASSIC_NACK_BUF_INVALID_CMD};
+    uint8_t parity = 0;
+
+    nfca_signal_set_cache_size(nfca_signal, MF_CLASSIC_EMULATOR_SIGNAL_CACHE_SIZE);
+    for(size_t i = 0; i < COUNT_OF(nacks); i++) {
+        nfca_signal_cache_add(nfca_signal, &nacks[i], 4, &parity);
+    }
+}
+
 void mf_classic_halt(FuriHalNfcTxRxContext* tx_rx, Crypto1* crypto) {
     furi_assert(tx_rx);
 
@@ -208,6 +208,8 @@ bool mf_classic_emulator(
     FuriHalNfcTxRxContext* tx_rx,
     bool is_reader_analyzer);
 
+void mf_classic_emulator_prepare_signal(NfcaSignal* nfca_signal);
+
 void mf_classic_halt(FuriHalNfcTxRxContext* tx_rx, Crypto1* crypto);
 
 bool mf_classic_write_block(
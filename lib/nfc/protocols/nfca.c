@@ -2,6 +2,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <furi.h>
+#include <furi_hal.h>
 
 #define NFCA_CRC_INIT (0x6363)
 
@@ -13,6 +14,9 @@
 
 #define NFCA_SIGNAL_MAX_EDGES (1350)
 
+/* bit count, then data and parity of frames up to 16 bytes with CRC */
+#define NFCA_SIGNAL_CACHE_KEY_MAX (2 + 18 + 3)
+
 typedef struct {
     uint8_t cmd;
     uint8_t param;
@@ -101,6 +105,7 @@ NfcaSignal* nfca_signal_alloc() {
     nfca_add_bit(nfca_signal->one, true);
     nfca_add_bit(nfca_signal->zero, false);
     nfca_signal->tx_signal = digital_signal_alloc(NFCA_SIGNAL_MAX_EDGES);
+    nfca_signal->cache = digital_signal_cache_alloc(&gpio_spi_r_mosi);
 
     return nfca_signal;
 }
@@ -111,6 +116,7 @@ void nfca_signal_free(NfcaSignal* nfca_signal) {
     digital_signal_free(nfca_signal->one);
     digital_signal_free(nfca_signal->zero);
     digital_signal_free(nfca_signal->tx_signal);
+    digital_signal_cache_free(nfca_signal->cache);
     free(nfca_signal);
 }
 
@@ -138,3 +144,70 @@ void nfca_signal_encode(NfcaSignal* nfca_signal, uint8_t* data, uint16_t bits, u
         }
     }
 }
+
+void nfca_signal_set_cache_size(NfcaSignal* nfca_signal, size_t size) {
+    furi_assert(nfca_signal);
+
+    digital_signal_cache_set_size(nfca_signal->cache, size);
+}
+
+static size_t nfca_signal_cache_key(uint8_t* key, uint8_t* data, uint16_t bits, uint8_t* parity) {
+    size_t data_size = (bits + 7) / 8;
+    size_t parity_size = (bits < 8) ? 0 : (bits / 8 + 7) / 8;
+    size_t key_size = 2 + data_size + parity_size;
+
+    if(key_size > NFCA_SIGNAL_CACHE_KEY_MAX) {
+        return 0;
+    }
+
+    key[0] = bits & 0xff;
+    key[1] = bits >> 8;
+    memcpy(&key[2], data, data_size);
+    memcpy(&key[2 + data_size], parity, parity_size);
+
+    return key_size;
+}
+
+bool nfca_signal_cache_add(
+    NfcaSignal* nfca_signal,
+    uint8_t* data,
+    uint16_t bits,
+    uint8_t* parity) {
+    furi_assert(nfca_signal);
+    furi_assert(data);
+    furi_assert(parity);
+
+    uint8_t key[NFCA_SIGNAL_CACHE_KEY_MAX];
+    size_t key_size = nfca_signal_cache_key(key, data, bits, parity);
+    if(!key_size) {
+        return false;
+    }
+
+    nfca_signal_encode(nfca_signal, data, bits, parity);
+    return digital_signal_cache_add(nfca_signal->cache, key, key_size, nfca_signal->tx_signal);
+}
+
+void nfca_signal_send(NfcaSignal* nfca_signal, uint8_t* data, uint16_t bits, uint8_t* parity) {
+    furi_assert(nfca_signal);
+    furi_assert(data);
+    furi_assert(parity);
+
+    uint32_t start = DWT->CYCCNT;
+
+    uint8_t key[NFCA_SIGNAL_CACHE_KEY_MAX];
+    size_t key_size = nfca_signal_cache_key(key, data, bits, parity);
+    if(key_size && digital_signal_cache_send(nfca_signal->cache, key, key_size)) {
+        return;
+    }
+
+    nfca_signal_encode(nfca_signal, data, bits, parity);
+    digital_signal_prepare(nfca_signal->tx_signal, &gpio_spi_r_mosi);
+    digital_signal_cache_add_miss(nfca_signal->cache, DWT->CYCCNT - start);
+    digital_signal_send_prepared(nfca_signal->tx_signal);
+}
+
+void nfca_signal_get_cache_stats(NfcaSignal* nfca_signal, DigitalSignalCacheStats* stats) {
+    furi_assert(nfca_signal);
+
+    digital_signal_cache_get_stats(nfca_signal->cache, stats);
+}
@@ -12,6 +12,7 @@ typedef struct {
     DigitalSignal* one;
     DigitalSignal* zero;
     DigitalSignal* tx_signal;
+    DigitalSignalCache* cache;
 } NfcaSignal;
 
 uint16_t nfca_get_crc16(uint8_t* buff, uint16_t len);
@@ -29,3 +30,15 @@ NfcaSignal* nfca_signal_alloc();
 void nfca_signal_free(NfcaSignal* nfca_signal);
 
 void nfca_signal_encode(NfcaSignal* nfca_signal, uint8_t* data, uint16_t bits, uint8_t* parity);
+
+void nfca_signal_set_cache_size(NfcaSignal* nfca_signal, size_t size);
+
+bool nfca_signal_cache_add(
+    NfcaSignal* nfca_signal,
+    uint8_t* data,
+    uint16_t bits,
+    uint8_t* parity);
+
+void nfca_signal_send(NfcaSignal* nfca_signal, uint8_t* data, uint16_t bits, uint8_t* parity);
+
+void nfca_signal_get_cache_stats(NfcaSignal* nfca_signal, DigitalSignalCacheStats* stats);
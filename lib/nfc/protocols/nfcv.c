@@ -23,6 +23,15 @@
 #define DIGITAL_SIGNAL_UNIT_S (100000000000.0f)
 #define DIGITAL_SIGNAL_UNIT_US (100000.0f)
 
+/* inventory (~6.7 KiB) and plain acknowledge (~2 KiB) at high data rate,
+ * reduced to what heap can spare above the reserve */
+#define NFCV_EMU_CACHE_SIZE (10 * 1024)
+#define NFCV_EMU_CACHE_HEAP_RESERVE (16 * 1024)
+/* response flags, then data and CRC of frames up to 16 bytes */
+#define NFCV_EMU_CACHE_KEY_MAX (1 + 16 + 2)
+#define NFCV_EMU_CACHE_FLAGS \
+    (NfcVSendFlagsSof | NfcVSendFlagsCrc | NfcVSendFlagsEof | NfcVSendFlagsHighRate)
+
 ReturnCode nfcv_inventory(uint8_t* uid) {
     uint16_t received = 0;
     rfalNfcvInventoryRes res;
@@ -350,6 +359,16 @@ bool nfcv_emu_alloc(NfcVData* nfcv_data) {
     }
 
     bool success = true;
+    if(!nfcv_data->emu_air.cache) {
+        size_t free_heap = memmgr_get_free_heap();
+        size_t cache_size = free_heap > NFCV_EMU_CACHE_HEAP_RESERVE ?
+                                MIN(free_heap - NFCV_EMU_CACHE_HEAP_RESERVE,
+                                    (size_t)NFCV_EMU_CACHE_SIZE) :
+                                0;
+        nfcv_data->emu_air.cache = digital_signal_cache_alloc(&gpio_spi_r_mosi);
+        digital_signal_cache_set_size(nfcv_data->emu_air.cache, cache_size);
+    }
+
     success &= nfcv_emu_alloc_signals(&nfcv_data->emu_air, &nfcv_data->emu_air.signals_high, 1);
     success &= nfcv_emu_alloc_signals(&nfcv_data->emu_air, &nfcv_data->emu_air.signals_low, 4);
 
@@ -415,6 +434,9 @@ void nfcv_emu_free(NfcVData* nfcv_data) {
     if(nfcv_data->emu_air.nfcv_signal) {
         digital_sequence_free(nfcv_data->emu_air.nfcv_signal);
     }
+    if(nfcv_data->emu_air.cache) {
+        digital_signal_cache_free(nfcv_data->emu_air.cache);
+    }
     if(nfcv_data->emu_air.reader_signal) {
         // Stop pulse reader and disable bus before free
         pulse_reader_stop(nfcv_data->emu_air.reader_signal);
@@ -427,33 +449,25 @@ void nfcv_emu_free(NfcVData* nfcv_data) {
     nfcv_data->emu_air.nfcv_resp_pulse = NULL;
     nfcv_data->emu_air.nfcv_resp_half_pulse = NULL;
     nfcv_data->emu_air.nfcv_signal = NULL;
+    nfcv_data->emu_air.cache = NULL;
     nfcv_data->emu_air.reader_signal = NULL;
 
     nfcv_emu_free_signals(&nfcv_data->emu_air.signals_high);
     nfcv_emu_free_signals(&nfcv_data->emu_air.signals_low);
 }
 
-void nfcv_emu_send(
-    FuriHalNfcTxRxContext* tx_rx,
-    NfcVData* nfcv,
-    uint8_t* data,
-    uint8_t length,
-    NfcVSendFlags flags,
-    uint32_t send_time) {
-    furi_assert(tx_rx);
-    furi_assert(nfcv);
-
+static NfcVSendFlags nfcv_emu_send_flags(NfcVSendFlags flags) {
     /* picked default value (0) to match the most common format */
     if(flags == NfcVSendFlagsNormal) {
         flags = NfcVSendFlagsSof | NfcVSendFlagsCrc | NfcVSendFlagsEof |
                 NfcVSendFlagsOneSubcarrier | NfcVSendFlagsHighRate;
     }
+    return flags;
+}
 
-    if(flags & NfcVSendFlagsCrc) {
-        nfcv_crc(data, length);
-        length += 2;
-    }
-
+/* data shall already contain the CRC, if requested */
+static void
+    nfcv_emu_build_sequence(NfcVData* nfcv, uint8_t* data, uint8_t length, NfcVSendFlags flags) {
     /* depending on the request flags, send with high or low rate */
     uint32_t bit0 = (flags & NfcVSendFlagsHighRate) ? NFCV_SIG_BIT0 : NFCV_SIG_LOW_BIT0;
     uint32_t bit1 = (flags & NfcVSendFlagsHighRate) ? NFCV_SIG_BIT1 : NFCV_SIG_LOW_BIT1;
@@ -477,10 +491,74 @@ void nfcv_emu_send(
     if(flags & NfcVSendFlagsEof) {
         digital_sequence_add(nfcv->emu_air.nfcv_signal, eof);
     }
+}
+
+static size_t
+    nfcv_emu_cache_key(uint8_t* key, uint8_t* data, uint8_t length, NfcVSendFlags flags) {
+    if(1 + length > NFCV_EMU_CACHE_KEY_MAX) {
+        return 0;
+    }
+
+    /* subcarrier selection does not change the waveform */
+    key[0] = flags & NFCV_EMU_CACHE_FLAGS;
+    memcpy(&key[1], data, length);
+
+    return 1 + length;
+}
+
+/* data shall have room for the CRC */
+static void nfcv_emu_cache_add(NfcVData* nfcv, uint8_t* data, uint8_t length) {
+    uint8_t key[NFCV_EMU_CACHE_KEY_MAX];
+
+    nfcv_crc(data, length);
+    length += 2;
+
+    size_t key_size = nfcv_emu_cache_key(key, data, length, NFCV_EMU_CACHE_FLAGS);
+    if(key_size) {
+        nfcv_emu_build_sequence(nfcv, data, length, NFCV_EMU_CACHE_FLAGS);
+        digital_signal_cache_add_sequence(
+            nfcv->emu_air.cache, key, key_size, nfcv->emu_air.nfcv_signal);
+    }
+}
+
+void nfcv_emu_send(
+    FuriHalNfcTxRxContext* tx_rx,
+    NfcVData* nfcv,
+    uint8_t* data,
+    uint8_t length,
+    NfcVSendFlags flags,
+    uint32_t send_time) {
+    furi_assert(tx_rx);
+    furi_assert(nfcv);
+
+    uint32_t start = DWT->CYCCNT;
+
+    flags = nfcv_emu_send_flags(flags);
+
+    if(flags & NfcVSendFlagsCrc) {
+        nfcv_crc(data, length);
+        length += 2;
+    }
 
     furi_hal_gpio_write(&gpio_spi_r_mosi, GPIO_LEVEL_UNMODULATED);
-    digital_sequence_set_sendtime(nfcv->emu_air.nfcv_signal, send_time);
-    digital_sequence_send(nfcv->emu_air.nfcv_signal);
+
+    uint8_t key[NFCV_EMU_CACHE_KEY_MAX];
+    size_t key_size = nfcv_emu_cache_key(key, data, length, flags);
+    bool sent = false;
+
+    if(key_size) {
+        digital_signal_cache_set_sendtime(nfcv->emu_air.cache, send_time);
+        sent = digital_signal_cache_send(nfcv->emu_air.cache, key, key_size);
+    }
+
+    if(!sent) {
+        nfcv_emu_build_sequence(nfcv, data, length, flags);
+        digital_signal_cache_add_miss(nfcv->emu_air.cache, DWT->CYCCNT - start);
+
+        digital_sequence_set_sendtime(nfcv->emu_air.nfcv_signal, send_time);
+        digital_sequence_send(nfcv->emu_air.nfcv_signal);
+    }
+
     furi_hal_gpio_write(&gpio_spi_r_mosi, GPIO_LEVEL_UNMODULATED);
 
     if(tx_rx->sniff_tx) {
@@ -503,6 +581,51 @@ static int nfcv_revuidcmp(uint8_t* dst, uint8_t* src) {
     return 0;
 }
 
+static uint8_t nfcv_emu_inventory_response(
+    FuriHalNfcDevData* nfc_data,
+    NfcVData* nfcv_data,
+    uint8_t* buffer) {
+    uint8_t buffer_pos = 0;
+    buffer[buffer_pos++] = NFCV_NOERROR;
+    buffer[buffer_pos++] = nfcv_data->dsfid;
+    nfcv_revuidcpy(&buffer[buffer_pos], nfc_data->uid);
+    buffer_pos += NFCV_UID_LENGTH;
+
+    return buffer_pos;
+}
+
+static uint8_t nfcv_emu_sysinfo_response(
+    FuriHalNfcDevData* nfc_data,
+    NfcVData* nfcv_data,
+    uint8_t* buffer) {
+    uint8_t buffer_pos = 0;
+    buffer[buffer_pos++] = NFCV_NOERROR;
+    buffer[buffer_pos++] = NFCV_SYSINFO_FLAG_DSFID | NFCV_SYSINFO_FLAG_AFI |
+                           NFCV_SYSINFO_FLAG_MEMSIZE | NFCV_SYSINFO_FLAG_ICREF;
+    nfcv_revuidcpy(&buffer[buffer_pos], nfc_data->uid);
+    buffer_pos += NFCV_UID_LENGTH;
+    buffer[buffer_pos++] = nfcv_data->dsfid; /* DSFID */
+    buffer[buffer_pos++] = nfcv_data->afi; /* AFI */
+    buffer[buffer_pos++] = nfcv_data->block_num - 1; /* number of blocks */
+    buffer[buffer_pos++] = nfcv_data->block_size - 1; /* block size */
+    buffer[buffer_pos++] = nfcv_data->ic_ref; /* IC reference */
+
+    return buffer_pos;
+}
+
+/* responses that only depend on the card data, as long as it is not written,
+ * most frequent first: whatever does not fit the cache is built on request */
+static void nfcv_emu_prefill_cache(FuriHalNfcDevData* nfc_data, NfcVData* nfcv_data) {
+    uint8_t buffer[NFCV_EMU_CACHE_KEY_MAX];
+    uint8_t length = 0;
+
+    length = nfcv_emu_inventory_response(nfc_data, nfcv_data, buffer);
+    nfcv_emu_cache_add(nfcv_data, buffer, length);
+
+    buffer[0] = NFCV_NOERROR;
+    nfcv_emu_cache_add(nfcv_data, buffer, 1);
+}
+
 void nfcv_emu_handle_packet(
     FuriHalNfcTxRxContext* tx_rx,
     FuriHalNfcDevData* nfc_data,
@@ -651,11 +774,8 @@ void nfcv_emu_handle_packet(
         }
 
         if(!nfcv_data->quiet && respond) {
-            int buffer_pos = 0;
-            ctx->response_buffer[buffer_pos++] = NFCV_NOERROR;
-            ctx->response_buffer[buffer_pos++] = nfcv_data->dsfid;
-            nfcv_revuidcpy(&ctx->response_buffer[buffer_pos], nfc_data->uid);
-            buffer_pos += NFCV_UID_LENGTH;
+            uint8_t buffer_pos =
+                nfcv_emu_inventory_response(nfc_data, nfcv_data, ctx->response_buffer);
 
             nfcv_emu_send(
                 tx_rx,
@@ -877,17 +997,8 @@ void nfcv_emu_handle_packet(
     }
 
     case NFCV_CMD_GET_SYSTEM_INFO: {
-        int buffer_pos = 0;
-        ctx->response_buffer[buffer_pos++] = NFCV_NOERROR;
-        ctx->response_buffer[buffer_pos++] = NFCV_SYSINFO_FLAG_DSFID | NFCV_SYSINFO_FLAG_AFI |
-                                             NFCV_SYSINFO_FLAG_MEMSIZE | NFCV_SYSINFO_FLAG_ICREF;
-        nfcv_revuidcpy(&ctx->response_buffer[buffer_pos], nfc_data->uid);
-        buffer_pos += NFCV_UID_LENGTH;
-        ctx->response_buffer[buffer_pos++] = nfcv_data->dsfid; /* DSFID */
-        ctx->response_buffer[buffer_pos++] = nfcv_data->afi; /* AFI */
-        ctx->response_buffer[buffer_pos++] = nfcv_data->block_num - 1; /* number of blocks */
-        ctx->response_buffer[buffer_pos++] = nfcv_data->block_size - 1; /* block size */
-        ctx->response_buffer[buffer_pos++] = nfcv_data->ic_ref; /* IC reference */
+        uint8_t buffer_pos =
+            nfcv_emu_sysinfo_response(nfc_data, nfcv_data, ctx->response_buffer);
 
         nfcv_emu_send(
             tx_rx,
@@ -1218,6 +1329,10 @@ void nfcv_emu_init(FuriHalNfcDevData* nfc_data, NfcVData* nfcv_data) {
         break;
     }
 
+    if(nfcv_data->sub_type != NfcVTypeSniff) {
+        nfcv_emu_prefill_cache(nfc_data, nfcv_data);
+    }
+
     /* allocate a 512 edge buffer, more than enough */
     nfcv_data->emu_air.reader_signal =
         pulse_reader_alloc(&gpio_nfc_irq_rfid_pull, NFCV_PULSE_BUFFER);
@@ -1236,6 +1351,22 @@ void nfcv_emu_deinit(NfcVData* nfcv_data) {
     furi_assert(nfcv_data);
 
     furi_hal_spi_bus_handle_init(&furi_hal_spi_bus_handle_nfc);
+
+    if(nfcv_data->emu_air.cache) {
+        DigitalSignalCacheStats stats;
+        digital_signal_cache_get_stats(nfcv_data->emu_air.cache, &stats);
+        uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+        FURI_LOG_D(
+            TAG,
+            "Response cache: %zu bytes, %lu hits, avg %lu us, %lu misses, avg %lu us",
+            stats.used,
+            stats.hits,
+            stats.hits ? (uint32_t)(stats.hit_prepare_time / stats.hits / cycles_per_us) : 0,
+            stats.misses,
+            stats.misses ? (uint32_t)(stats.miss_prepare_time / stats.misses / cycles_per_us) :
+                           0);
+    }
+
     nfcv_emu_free(nfcv_data);
 
     if(nfcv_data->emu_protocol_ctx) {
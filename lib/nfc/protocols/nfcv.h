@@ -240,6 +240,7 @@ typedef struct {
     NfcVEmuAirSignals signals_high;
     NfcVEmuAirSignals signals_low;
     DigitalSequence* nfcv_signal;
+    DigitalSignalCache* cache; /* prepared static responses */
 } NfcVEmuAir;
 
 typedef void (*NfcVEmuProtocolHandler)(
@@ -1,8 +1,20 @@
 #include "environment.h"
 #include "registry.h"
+#include "subghz_keystore_cache.h"
+
+#define TAG "SubGhzEnvironment"
 
 struct SubGhzEnvironment {
     SubGhzKeystore* keystore;
+    // Keys come from cache when it's there, own keystore only refers to them
+    SubGhzKeystoreCache* keystore_cache;
+    SubGhzKeystore* keystore_shared;
+    // Replaced after use: decoders may still iterate them, released with environment
+    SubGhzKeystore* keystore_retired[SUBGHZ_KEYSTORE_CACHE_FILES_MAX];
+    size_t keystore_retired_count;
+    FuriString* keystore_files[SUBGHZ_KEYSTORE_CACHE_FILES_MAX];
+    size_t keystore_files_count;
+    bool keystore_is_used;
     const SubGhzProtocolRegistry* protocol_registry;
     const char* came_atomo_rainbow_table_file_name;
     const char* nice_flor_s_rainbow_table_file_name;
@@ -13,6 +25,13 @@ SubGhzEnvironment* subghz_environment_alloc() {
     SubGhzEnvironment* instance = malloc(sizeof(SubGhzEnvironment));
 
     instance->keystore = subghz_keystore_alloc();
+    instance->keystore_cache = furi_record_exists(RECORD_SUBGHZ_KEYSTORE) ?
+                                   furi_record_open(RECORD_SUBGHZ_KEYSTORE) :
+                                   NULL;
+    instance->keystore_shared = NULL;
+    instance->keystore_retired_count = 0;
+    instance->keystore_files_count = 0;
+    instance->keystore_is_used = false;
     instance->protocol_registry = NULL;
     instance->came_atomo_rainbow_table_file_name = NULL;
     instance->nice_flor_s_rainbow_table_file_name = NULL;
@@ -30,18 +49,89 @@ void subghz_environment_free(SubGhzEnvironment* instance) {
     instance->alutech_at_4n_rainbow_table_file_name = NULL;
     subghz_keystore_free(instance->keystore);
 
+    if(instance->keystore_cache) {
+        if(instance->keystore_shared) {
+            subghz_keystore_cache_release(instance->keystore_cache, instance->keystore_shared);
+        }
+        for(size_t i = 0; i < instance->keystore_retired_count; i++) {
+            subghz_keystore_cache_release(instance->keystore_cache, instance->keystore_retired[i]);
+        }
+        for(size_t i = 0; i < instance->keystore_files_count; i++) {
+            furi_string_free(instance->keystore_files[i]);
+        }
+        furi_record_close(RECORD_SUBGHZ_KEYSTORE);
+    }
+
     free(instance);
 }
 
+static void
+    subghz_environment_get_keystore_files(SubGhzEnvironment* instance, const char** files) {
+    for(size_t i = 0; i < instance->keystore_files_count; i++) {
+        files[i] = furi_string_get_cstr(instance->keystore_files[i]);
+    }
+}
+
+static uint32_t subghz_environment_acquire_keystore(SubGhzEnvironment* instance) {
+    const char* files[SUBGHZ_KEYSTORE_CACHE_FILES_MAX];
+    subghz_environment_get_keystore_files(instance, files);
+
+    uint32_t loaded = 0;
+    SubGhzKeystore* shared = subghz_keystore_cache_acquire(
+        instance->keystore_cache, files, instance->keystore_files_count, &loaded);
+    subghz_keystore_share(instance->keystore, shared);
+    if(instance->keystore_shared && instance->keystore_is_used) {
+        // One per file loaded after use at most
+        furi_check(instance->keystore_retired_count < SUBGHZ_KEYSTORE_CACHE_FILES_MAX);
+        instance->keystore_retired[instance->keystore_retired_count++] =
+            instance->keystore_shared;
+    } else if(instance->keystore_shared) {
+        subghz_keystore_cache_release(instance->keystore_cache, instance->keystore_shared);
+    }
+    instance->keystore_shared = shared;
+
+    return loaded;
+}
+
 bool subghz_environment_load_keystore(SubGhzEnvironment* instance, const char* filename) {
     furi_assert(instance);
 
-    return subghz_keystore_load(instance->keystore, filename);
+    if(!instance->keystore_cache) {
+        return subghz_keystore_load(instance->keystore, filename);
+    }
+
+    if(instance->keystore_files_count == SUBGHZ_KEYSTORE_CACHE_FILES_MAX) {
+        FURI_LOG_E(TAG, "Too many keystore files");
+        return false;
+    }
+    size_t index = instance->keystore_files_count++;
+    instance->keystore_files[index] = furi_string_alloc_set(filename);
+
+    // Files are usually loaded one by one: when cached keystore starts with
+    // the same ones, it's taken on first use, so no partial copy is loaded
+    uint32_t loaded = 0;
+    if(!instance->keystore_is_used) {
+        const char* files[SUBGHZ_KEYSTORE_CACHE_FILES_MAX];
+        subghz_environment_get_keystore_files(instance, files);
+        if(subghz_keystore_cache_peek(
+               instance->keystore_cache, files, instance->keystore_files_count, &loaded)) {
+            return loaded & (1UL << index);
+        }
+    }
+
+    loaded = subghz_environment_acquire_keystore(instance);
+    return loaded & (1UL << index);
 }
 
 SubGhzKeystore* subghz_environment_get_keystore(SubGhzEnvironment* instance) {
     furi_assert(instance);
 
+    instance->keystore_is_used = true;
+    if(instance->keystore_cache && instance->keystore_files_count &&
+       !instance->keystore_shared) {
+        subghz_environment_acquire_keystore(instance);
+    }
+
     return instance->keystore;
 }
 
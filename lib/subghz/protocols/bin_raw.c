@@ -5,7 +5,6 @@
 #include "../blocks/encoder.h"
 #include "../blocks/generic.h"
 #include "../blocks/math.h"
-#include <lib/toolbox/float_tools.h>
 #include <lib/toolbox/stream/stream.h>
 #include <lib/flipper_format/flipper_format_i.h>
 
@@ -21,6 +20,9 @@
 #define BIN_RAW_TE_MIN_COUNT 40
 #define BIN_RAW_BUF_MIN_DATA_COUNT 128
 #define BIN_RAW_MAX_MARKUP_COUNT 20
+//durations classified: first 512, but not the last 100, there is usually garbage at the end
+#define BIN_RAW_CLASSIFY_MAX_COUNT 512
+#define BIN_RAW_CLASSIFY_TAIL_COUNT 100
 
 //#define BIN_RAW_DEBUG
 
@@ -63,6 +65,12 @@ struct BinRAW_Markup {
 };
 typedef struct BinRAW_Markup BinRAW_Markup;
 
+struct BinRAW_Class {
+    float duration;
+    uint16_t count;
+};
+typedef struct BinRAW_Class BinRAW_Class;
+
 struct SubGhzProtocolDecoderBinRAW {
     SubGhzProtocolDecoderBase base;
 
@@ -72,6 +80,8 @@ struct SubGhzProtocolDecoderBinRAW {
     uint8_t* data;
     BinRAW_Markup data_markup[BIN_RAW_MAX_MARKUP_COUNT];
     size_t data_raw_ind;
+    BinRAW_Class classes[BIN_RAW_SEARCH_CLASSES];
+    size_t classified_ind;
     uint32_t te;
     float adaptive_threshold_rssi;
 };
@@ -378,6 +388,28 @@ void subghz_protocol_decoder_bin_raw_reset(void* context) {
 #endif
 }
 
+/** 
+ * Put duration into the first class it is within 25% of, or into a new class
+ * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
+ */
+static void subghz_protocol_bin_raw_classify_next(SubGhzProtocolDecoderBinRAW* instance) {
+    float duration = (float)(abs(instance->data_raw[instance->classified_ind++]));
+
+    for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
+        BinRAW_Class* class = &instance->classes[k];
+        if(class->count == 0) {
+            class->duration = duration;
+            class->count++;
+            break;
+        } else if(DURATION_DIFF(duration, class->duration) < (class->duration / 4)) {
+            //running average k=0.05, single precision is done by FPU
+            class->duration += (duration - class->duration) * 0.05f;
+            class->count++;
+            break;
+        }
+    }
+}
+
 void subghz_protocol_decoder_bin_raw_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderBinRAW* instance = context;
@@ -387,59 +419,48 @@ void subghz_protocol_decoder_bin_raw_feed(void* context, bool level, uint32_t du
             instance->decoder.parser_step = BinRAWDecoderStepBufFull;
         } else {
             instance->data_raw[instance->data_raw_ind++] = (level ? duration : -duration);
+            //classify as durations arrive, so only the tail is left for the end of burst
+            if((instance->classified_ind < BIN_RAW_CLASSIFY_MAX_COUNT) &&
+               (instance->classified_ind + BIN_RAW_CLASSIFY_TAIL_COUNT < instance->data_raw_ind)) {
+                subghz_protocol_bin_raw_classify_next(instance);
+            }
         }
     }
 }
 
+/** 
+ * Number of TE in duration, rounded half away from zero
+ * @param duration Duration, negative for low level
+ * @param te TE
+ * @return Signed number of TE
+ */
+static int32_t subghz_protocol_bin_raw_get_te_count(int32_t duration, uint32_t te) {
+    int32_t count = (abs(duration) * 2 + te) / (te * 2);
+    return (duration < 0) ? -count : count;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzProtocolDecoderBinRAW* instance
  */
 static bool
     subghz_protocol_bin_raw_check_remote_controller(SubGhzProtocolDecoderBinRAW* instance) {
-    struct {
-        float data;
-        uint16_t count;
-    } classes[BIN_RAW_SEARCH_CLASSES];
-
+    BinRAW_Class* classes = instance->classes;
     size_t ind = 0;
 
-    memset(classes, 0x00, sizeof(classes));
-
     uint16_t data_markup_ind = 0;
     memset(instance->data_markup, 0x00, BIN_RAW_MAX_MARKUP_COUNT * sizeof(BinRAW_Markup));
 
-    if(instance->data_raw_ind < 512) {
-        ind =
-            instance->data_raw_ind -
-            100; //there is usually garbage at the end of the record, we exclude it from the classification
+    //classify what was not classified while receiving: at most the tail
+    if(instance->data_raw_ind < BIN_RAW_CLASSIFY_MAX_COUNT) {
+        ind = instance->data_raw_ind - BIN_RAW_CLASSIFY_TAIL_COUNT;
     } else {
-        ind = 512;
+        ind = BIN_RAW_CLASSIFY_MAX_COUNT;
     }
-
-    //sort the durations to find the shortest correlated interval
-    for(size_t i = 0; i < ind; i++) {
-        for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-            if(classes[k].count == 0) {
-                classes[k].data = (float)(abs(instance->data_raw[i]));
-                classes[k].count++;
-                break;
-            } else if(
-                DURATION_DIFF((float)(abs(instance->data_raw[i])), (classes[k].data)) <
-                (classes[k].data / 4)) { //if the test value does not differ by more than 25%
-                classes[k].data += ((float)(abs(instance->data_raw[i])) - classes[k].data) *
-                                   0.05f; //running average k=0.05
-                classes[k].count++;
-                break;
-            }
-        }
+    while(instance->classified_ind < ind) {
+        subghz_protocol_bin_raw_classify_next(instance);
     }
 
-    // if(classes[BIN_RAW_SEARCH_CLASSES - 1].count != 0) {
-    //     //filling the classifier, it means that they received an unclean signal
-    //     return false;
-    // }
-
     //looking for the minimum te with an occurrence greater than BIN_RAW_TE_MIN_COUNT
     instance->te = subghz_protocol_bin_raw_const.te_long * 2;
 
@@ -456,12 +477,11 @@ static bool
         swap = false;
         for(size_t i = 1; i < BIN_RAW_SEARCH_CLASSES; i++) {
             if(classes[i].count > classes[i - 1].count) {
-                uint32_t data = classes[i - 1].data;
-                uint32_t count = classes[i - 1].count;
-                classes[i - 1].data = classes[i].data;
-                classes[i - 1].count = classes[i].count;
-                classes[i].data = data;
-                classes[i].count = count;
+                BinRAW_Class class = classes[i - 1];
+                classes[i - 1] = classes[i];
+                classes[i] = class;
+                //moved down class was always truncated to whole us, TE and gap depend on it
+                classes[i].duration = (uint32_t)class.duration;
                 swap = true;
             }
         }
@@ -470,13 +490,17 @@ static bool
     bin_raw_debug_tag(TAG, "Sorted durations\r\n");
     bin_raw_debug("\t\tind\tcount\tus\r\n");
     for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-        bin_raw_debug("\t\t%zu\t%u\t%lu\r\n", k, classes[k].count, (uint32_t)classes[k].data);
+        bin_raw_debug(
+            "\t\t%zu\t%u\t%lu\r\n",
+            k,
+            classes[k].count,
+            (uint32_t)classes[k].duration);
     }
     bin_raw_debug("\r\n");
 #endif
     if((classes[0].count > BIN_RAW_TE_MIN_COUNT) && (classes[1].count == 0)) {
         //adopted only the preamble
-        instance->te = (uint32_t)classes[0].data;
+        instance->te = (uint32_t)classes[0].duration;
         te_ok = true;
         gap = 0; //gap no
     } else {
@@ -485,27 +509,24 @@ static bool
         if((classes[0].count < BIN_RAW_TE_MIN_COUNT) ||
            (classes[1].count < (BIN_RAW_TE_MIN_COUNT >> 1)))
             return false;
-        //arrange the first 2 date values in ascending order
-        if(classes[0].data > classes[1].data) {
-            uint32_t data = classes[1].data;
-            classes[0].data = classes[1].data;
-            classes[1].data = data;
-        }
+        //the shorter one is the candidate, the second is checked to be a multiple of it
+        float te_short = MIN(classes[0].duration, classes[1].duration);
+        float te_long = classes[1].duration;
 
         //determine the value to be corrected
         for(uint8_t k = 1; k < 5; k++) {
-            float delta = (classes[1].data / (classes[0].data / k));
+            float delta = (te_long / (te_short / k));
             bin_raw_debug_tag(TAG, "K_div= %f\r\n", (double)(delta));
             delta -= (uint32_t)delta;
 
             if((delta < 0.20f) || (delta > 0.80f)) {
-                instance->te = (uint32_t)classes[0].data / k;
+                instance->te = (uint32_t)te_short / k;
                 bin_raw_debug_tag(TAG, "K= %d\r\n", k);
                 te_ok = true; //found a correlated duration
                 break;
             }
         }
-        if(!te_ok) {
+        if(!te_ok || !instance->te) {
             //did not find the minimum TE satisfying the condition
             return false;
         }
@@ -513,8 +534,8 @@ static bool
 
         //looking for a gap
         for(size_t k = 2; k < BIN_RAW_SEARCH_CLASSES; k++) {
-            if((classes[k].count > 2) && (classes[k].data > gap)) {
-                gap = (uint32_t)classes[k].data;
+            if((classes[k].count > 2) && (classes[k].duration > gap)) {
+                gap = (uint32_t)classes[k].duration;
                 gap_delta = gap / 5; //calculate 20% deviation from ideal value
             }
         }
@@ -540,9 +561,12 @@ static bool
         bin_raw_debug_tag(TAG, "Tinted sequence\r\n");
         ind = (BIN_RAW_BUF_DATA_SIZE * 8);
         uint16_t bit_count = 0;
+        //gap is the first duration, nothing before it
+        if(gap_ind == 0) return false;
         do {
             gap_ind--;
-            data_temp = (int)(round((float)(instance->data_raw[gap_ind]) / instance->te));
+            data_temp =
+                subghz_protocol_bin_raw_get_te_count(instance->data_raw[gap_ind], instance->te);
             bin_raw_debug("%d ", data_temp);
             if(data_temp == 0) bit_count++; //there is noise in the package
             for(size_t i = 0; i < abs(data_temp); i++) {
@@ -577,27 +601,31 @@ static bool
 
         bin_raw_debug("\r\n\t count bit= %zu\r\n\r\n", (BIN_RAW_BUF_DATA_SIZE * 8) - ind);
 
-        //reset the classifier and classify the received data
-        memset(classes, 0x00, sizeof(classes));
+        //classify the received pieces by the number of bits in them
+        struct {
+            uint16_t bit_count;
+            uint16_t count;
+        } lengths[BIN_RAW_SEARCH_CLASSES];
+        memset(lengths, 0x00, sizeof(lengths));
 
         bin_raw_debug_tag(TAG, "Sort the found pieces by the number of bits in them\r\n");
         for(size_t i = 0; i < data_markup_ind; i++) {
             for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-                if(classes[k].count == 0) {
-                    classes[k].data = instance->data_markup[i].bit_count;
-                    classes[k].count++;
+                if(lengths[k].count == 0) {
+                    lengths[k].bit_count = instance->data_markup[i].bit_count;
+                    lengths[k].count++;
                     break;
-                } else if(instance->data_markup[i].bit_count == (uint16_t)classes[k].data) {
-                    classes[k].count++;
+                } else if(instance->data_markup[i].bit_count == lengths[k].bit_count) {
+                    lengths[k].count++;
                     break;
                 }
             }
         }
 
 #ifdef BIN_RAW_DEBUG
-        bin_raw_debug("\t\tind\tcount\tus\r\n");
+        bin_raw_debug("\t\tind\tcount\tbits\r\n");
         for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-            bin_raw_debug("\t\t%zu\t%u\t%lu\r\n", k, classes[k].count, (uint32_t)classes[k].data);
+            bin_raw_debug("\t\t%zu\t%u\t%u\r\n", k, lengths[k].count, lengths[k].bit_count);
         }
         bin_raw_debug("\r\n");
 #endif
@@ -605,8 +633,8 @@ static bool
         //choose the value with the maximum repetition
         data_temp = 0;
         for(size_t i = 0; i < BIN_RAW_SEARCH_CLASSES; i++) {
-            if((classes[i].count > 1) && (data_temp < classes[i].count))
-                data_temp = (int)classes[i].data;
+            if((lengths[i].count > 1) && (data_temp < lengths[i].count))
+                data_temp = lengths[i].bit_count;
         }
 
         //if(data_markup_ind == 0) return false;
@@ -805,7 +833,8 @@ static bool
         bin_raw_debug_tag(TAG, "Sequence analysis without gap\r\n");
         ind = 0;
         for(size_t i = 0; i < instance->data_raw_ind; i++) {
-            int data_temp = (int)(round((float)(instance->data_raw[i]) / instance->te));
+            int data_temp =
+                subghz_protocol_bin_raw_get_te_count(instance->data_raw[i], instance->te);
             if(data_temp == 0) break; //found an interval 2 times shorter than TE, this is noise
             bin_raw_debug("%d  ", data_temp);
 
@@ -886,8 +915,10 @@ void subghz_protocol_decoder_bin_raw_data_input_rssi(
 
         bin_raw_debug("%ld %ld :", (int32_t)rssi, (int32_t)instance->adaptive_threshold_rssi);
         if(rssi > (instance->adaptive_threshold_rssi + BIN_RAW_DELTA_RSSI)) {
+            //only received part of data_raw is ever read, no need to clear it
             instance->data_raw_ind = 0;
-            memset(instance->data_raw, 0x00, BIN_RAW_BUF_RAW_SIZE * sizeof(int32_t));
+            instance->classified_ind = 0;
+            memset(instance->classes, 0x00, sizeof(instance->classes));
             memset(instance->data, 0x00, BIN_RAW_BUF_RAW_SIZE * sizeof(uint8_t));
             instance->decoder.parser_step = BinRAWDecoderStepWrite;
             bin_raw_debug_tag(TAG, "RSSI\r\n");
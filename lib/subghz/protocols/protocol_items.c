@@ -1,48 +1,181 @@
 #include "protocol_items.h"
 
+/* Protocols built into registry. Firmware built with SUBGHZ_PROTOCOLS fbt
+ * option defines SUBGHZ_PROTOCOLS_SELECTED and only listed protocols,
+ * otherwise all of them are present. Left out protocols are not found by
+ * name and their code is dropped by linker unless referenced elsewhere. */
+#ifndef SUBGHZ_PROTOCOLS_SELECTED
+#define SUBGHZ_PROTOCOL_GATE_TX
+#define SUBGHZ_PROTOCOL_KEELOQ
+#define SUBGHZ_PROTOCOL_STAR_LINE
+#define SUBGHZ_PROTOCOL_NICE_FLO
+#define SUBGHZ_PROTOCOL_CAME
+#define SUBGHZ_PROTOCOL_FAAC_SLH
+#define SUBGHZ_PROTOCOL_NICE_FLOR_S
+#define SUBGHZ_PROTOCOL_CAME_TWEE
+#define SUBGHZ_PROTOCOL_CAME_ATOMO
+#define SUBGHZ_PROTOCOL_NERO_SKETCH
+#define SUBGHZ_PROTOCOL_IDO
+#define SUBGHZ_PROTOCOL_KIA
+#define SUBGHZ_PROTOCOL_HORMANN
+#define SUBGHZ_PROTOCOL_NERO_RADIO
+#define SUBGHZ_PROTOCOL_SOMFY_TELIS
+#define SUBGHZ_PROTOCOL_SOMFY_KEYTIS
+#define SUBGHZ_PROTOCOL_SCHER_KHAN
+#define SUBGHZ_PROTOCOL_PRINCETON
+#define SUBGHZ_PROTOCOL_RAW
+#define SUBGHZ_PROTOCOL_LINEAR
+#define SUBGHZ_PROTOCOL_SECPLUS_V2
+#define SUBGHZ_PROTOCOL_SECPLUS_V1
+#define SUBGHZ_PROTOCOL_MEGACODE
+#define SUBGHZ_PROTOCOL_HOLTEK
+#define SUBGHZ_PROTOCOL_CHAMB_CODE
+#define SUBGHZ_PROTOCOL_POWER_SMART
+#define SUBGHZ_PROTOCOL_MARANTEC
+#define SUBGHZ_PROTOCOL_BETT
+#define SUBGHZ_PROTOCOL_DOITRAND
+#define SUBGHZ_PROTOCOL_PHOENIX_V2
+#define SUBGHZ_PROTOCOL_HONEYWELL_WDB
+#define SUBGHZ_PROTOCOL_MAGELLAN
+#define SUBGHZ_PROTOCOL_INTERTECHNO_V3
+#define SUBGHZ_PROTOCOL_CLEMSA
+#define SUBGHZ_PROTOCOL_ANSONIC
+#define SUBGHZ_PROTOCOL_SMC5326
+#define SUBGHZ_PROTOCOL_HOLTEK_TH12X
+#define SUBGHZ_PROTOCOL_LINEAR_DELTA3
+#define SUBGHZ_PROTOCOL_DOOYA
+#define SUBGHZ_PROTOCOL_ALUTECH_AT_4N
+#define SUBGHZ_PROTOCOL_KINGGATES_STYLO_4K
+#define SUBGHZ_PROTOCOL_BIN_RAW
+#endif
+
 const SubGhzProtocol* subghz_protocol_registry_items[] = {
+#ifdef SUBGHZ_PROTOCOL_GATE_TX
     &subghz_protocol_gate_tx,
+#endif
+#ifdef SUBGHZ_PROTOCOL_KEELOQ
     &subghz_protocol_keeloq,
+#endif
+#ifdef SUBGHZ_PROTOCOL_STAR_LINE
     &subghz_protocol_star_line,
+#endif
+#ifdef SUBGHZ_PROTOCOL_NICE_FLO
     &subghz_protocol_nice_flo,
+#endif
+#ifdef SUBGHZ_PROTOCOL_CAME
     &subghz_protocol_came,
+#endif
+#ifdef SUBGHZ_PROTOCOL_FAAC_SLH
     &subghz_protocol_faac_slh,
+#endif
+#ifdef SUBGHZ_PROTOCOL_NICE_FLOR_S
     &subghz_protocol_nice_flor_s,
+#endif
+#ifdef SUBGHZ_PROTOCOL_CAME_TWEE
     &subghz_protocol_came_twee,
+#endif
+#ifdef SUBGHZ_PROTOCOL_CAME_ATOMO
     &subghz_protocol_came_atomo,
+#endif
+#ifdef SUBGHZ_PROTOCOL_NERO_SKETCH
     &subghz_protocol_nero_sketch,
+#endif
+#ifdef SUBGHZ_PROTOCOL_IDO
     &subghz_protocol_ido,
+#endif
+#ifdef SUBGHZ_PROTOCOL_KIA
     &subghz_protocol_kia,
+#endif
+#ifdef SUBGHZ_PROTOCOL_HORMANN
     &subghz_protocol_hormann,
+#endif
+#ifdef SUBGHZ_PROTOCOL_NERO_RADIO
     &subghz_protocol_nero_radio,
+#endif
+#ifdef SUBGHZ_PROTOCOL_SOMFY_TELIS
     &subghz_protocol_somfy_telis,
+#endif
+#ifdef SUBGHZ_PROTOCOL_SOMFY_KEYTIS
     &subghz_protocol_somfy_keytis,
+#endif
+#ifdef SUBGHZ_PROTOCOL_SCHER_KHAN
     &subghz_protocol_scher_khan,
+#endif
+#ifdef SUBGHZ_PROTOCOL_PRINCETON
     &subghz_protocol_princeton,
+#endif
+#ifdef SUBGHZ_PROTOCOL_RAW
     &subghz_protocol_raw,
+#endif
+#ifdef SUBGHZ_PROTOCOL_LINEAR
     &subghz_protocol_linear,
+#endif
+#ifdef SUBGHZ_PROTOCOL_SECPLUS_V2
     &subghz_protocol_secplus_v2,
+#endif
+#ifdef SUBGHZ_PROTOCOL_SECPLUS_V1
     &subghz_protocol_secplus_v1,
+#endif
+#ifdef SUBGHZ_PROTOCOL_MEGACODE
     &subghz_protocol_megacode,
+#endif
+#ifdef SUBGHZ_PROTOCOL_HOLTEK
     &subghz_protocol_holtek,
+#endif
+#ifdef SUBGHZ_PROTOCOL_CHAMB_CODE
     &subghz_protocol_chamb_code,
+#endif
+#ifdef SUBGHZ_PROTOCOL_POWER_SMART
     &subghz_protocol_power_smart,
+#endif
+#ifdef SUBGHZ_PROTOCOL_MARANTEC
     &subghz_protocol_marantec,
+#endif
+#ifdef SUBGHZ_PROTOCOL_BETT
     &subghz_protocol_bett,
+#endif
+#ifdef SUBGHZ_PROTOCOL_DOITRAND
     &subghz_protocol_doitrand,
+#endif
+#ifdef SUBGHZ_PROTOCOL_PHOENIX_V2
     &subghz_protocol_phoenix_v2,
+#endif
+#ifdef SUBGHZ_PROTOCOL_HONEYWELL_WDB
     &subghz_protocol_honeywell_wdb,
+#endif
+#ifdef SUBGHZ_PROTOCOL_MAGELLAN
     &subghz_protocol_magellan,
+#endif
+#ifdef SUBGHZ_PROTOCOL_INTERTECHNO_V3
     &subghz_protocol_intertechno_v3,
+#endif
+#ifdef SUBGHZ_PROTOCOL_CLEMSA
     &subghz_protocol_clemsa,
+#endif
+#ifdef SUBGHZ_PROTOCOL_ANSONIC
     &subghz_protocol_ansonic,
+#endif
+#ifdef SUBGHZ_PROTOCOL_SMC5326
     &subghz_protocol_smc5326,
+#endif
+#ifdef SUBGHZ_PROTOCOL_HOLTEK_TH12X
     &subghz_protocol_holtek_th12x,
+#endif
+#ifdef SUBGHZ_PROTOCOL_LINEAR_DELTA3
     &subghz_protocol_linear_delta3,
+#endif
+#ifdef SUBGHZ_PROTOCOL_DOOYA
     &subghz_protocol_dooya,
+#endif
+#ifdef SUBGHZ_PROTOCOL_ALUTECH_AT_4N
     &subghz_protocol_alutech_at_4n,
+#endif
+#ifdef SUBGHZ_PROTOCOL_KINGGATES_STYLO_4K
     &subghz_protocol_kinggates_stylo_4k,
+#endif
+#ifdef SUBGHZ_PROTOCOL_BIN_RAW
     &subghz_protocol_bin_raw,
+#endif
 };
 
 const SubGhzProtocolRegistry subghz_protocol_registry = {
@@ -5,23 +5,121 @@
 
 #include <m-array.h>
 
+/* Decoder is allocated by owner thread: when protocol passes filter, is looked
+ * up by name or receiver is restored after idle. Released when filter excludes
+ * it or receiver was idle, decoders looked up by name are pinned: pointer was
+ * given away and stays valid until receiver is freed. Decode never allocates,
+ * released decoders are skipped until restored. */
 typedef struct {
-    SubGhzProtocolEncoderBase* base;
+    const SubGhzProtocol* protocol;
+    SubGhzProtocolDecoderBase* base;
+    SubGhzProtocolDecoderBase* retired;
+    bool pinned;
+    size_t size;
+    uint32_t allocations;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
 #define M_OPL_SubGhzReceiverSlotArray_t() ARRAY_OPLIST(SubGhzReceiverSlotArray, M_POD_OPLIST)
 
 struct SubGhzReceiver {
+    SubGhzEnvironment* environment;
     SubGhzReceiverSlotArray_t slots;
     SubGhzProtocolFlag filter;
+    // Guards slot allocation and release, decoders are fed without it
+    FuriMutex* mutex;
+
+    // Decode and reset calls in progress and times all of them returned
+    uint32_t active;
+    uint32_t epoch;
+    uint32_t last_decode;
 
     SubGhzReceiverCallback callback;
     void* context;
 };
 
+static void subghz_receiver_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context);
+
+static void subghz_receiver_enter(SubGhzReceiver* instance) {
+    __atomic_add_fetch(&instance->active, 1, __ATOMIC_SEQ_CST);
+}
+
+static void subghz_receiver_exit(SubGhzReceiver* instance) {
+    if(__atomic_load_n(&instance->active, __ATOMIC_RELAXED) == 1) {
+        __atomic_add_fetch(&instance->epoch, 1, __ATOMIC_SEQ_CST);
+    }
+    __atomic_sub_fetch(&instance->active, 1, __ATOMIC_SEQ_CST);
+}
+
+/* Wait until every decode or reset that could have seen retired decoders has returned.
+ * Never returns if called from receiver callback: it would wait for itself. */
+static void subghz_receiver_wait_quiescent(SubGhzReceiver* instance) {
+    uint32_t epoch = __atomic_load_n(&instance->epoch, __ATOMIC_SEQ_CST);
+    while(__atomic_load_n(&instance->active, __ATOMIC_SEQ_CST) &&
+          __atomic_load_n(&instance->epoch, __ATOMIC_SEQ_CST) == epoch) {
+        furi_delay_tick(1);
+    }
+}
+
+static SubGhzProtocolDecoderBase* subghz_receiver_slot_get_base(
+    SubGhzReceiver* instance,
+    SubGhzReceiverSlot* slot,
+    bool pin) {
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    slot->pinned |= pin;
+    if(!slot->base) {
+        size_t free_heap = memmgr_get_free_heap();
+        SubGhzProtocolDecoderBase* base = slot->protocol->decoder->alloc(instance->environment);
+        subghz_protocol_decoder_base_set_decoder_callback(
+            base, subghz_receiver_rx_callback, instance);
+        // Approximate: other threads may allocate at the same time
+        size_t free_heap_after = memmgr_get_free_heap();
+        slot->size = free_heap > free_heap_after ? free_heap - free_heap_after : 0;
+        slot->allocations++;
+        // Published when ready: decode may be running on RX thread
+        __atomic_store_n(&slot->base, base, __ATOMIC_SEQ_CST);
+    }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+    return slot->base;
+}
+
+/* Release decoders not pinned and not passing filter, all of them if idle is set */
+static size_t subghz_receiver_release(SubGhzReceiver* instance, bool idle) {
+    size_t released = 0;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(slot->base && !slot->pinned &&
+               (idle || (slot->protocol->flag & instance->filter) == 0)) {
+                slot->retired = slot->base;
+                __atomic_store_n(&slot->base, NULL, __ATOMIC_SEQ_CST);
+                released++;
+            }
+        }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    if(released) {
+        subghz_receiver_wait_quiescent(instance);
+
+        furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+        for
+            M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+                if(slot->retired) {
+                    slot->protocol->decoder->free(slot->retired);
+                    slot->retired = NULL;
+                }
+            }
+        furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+    }
+
+    return released;
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
+    instance->environment = environment;
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     SubGhzReceiverSlotArray_init(instance->slots);
     const SubGhzProtocolRegistry* protocol_registry_items =
         subghz_environment_get_protocol_registry(environment);
@@ -32,10 +130,15 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
 
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
-            slot->base = protocol->decoder->alloc(environment);
+            memset(slot, 0, sizeof(SubGhzReceiverSlot));
+            slot->protocol = protocol;
         }
     }
 
+    instance->filter = 0;
+    instance->active = 0;
+    instance->epoch = 0;
+    instance->last_decode = furi_get_tick();
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
@@ -50,10 +153,13 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
     // Release allocated slots
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            slot->base->protocol->decoder->free(slot->base);
-            slot->base = NULL;
+            if(slot->base) {
+                slot->protocol->decoder->free(slot->base);
+                slot->base = NULL;
+            }
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
+    furi_mutex_free(instance->mutex);
 
     free(instance);
 }
@@ -62,22 +168,36 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
     furi_assert(instance);
     furi_assert(instance->slots);
 
+    subghz_receiver_enter(instance);
+    instance->last_decode = furi_get_tick();
+
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
+            if((slot->protocol->flag & instance->filter) != 0) {
+                SubGhzProtocolDecoderBase* base = __atomic_load_n(&slot->base, __ATOMIC_SEQ_CST);
+                // Released while idle, skipped until restored
+                if(base) slot->protocol->decoder->feed(base, level, duration);
             }
         }
+
+    subghz_receiver_exit(instance);
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
     furi_assert(instance);
     furi_assert(instance->slots);
 
+    subghz_receiver_enter(instance);
+
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            slot->base->protocol->decoder->reset(slot->base);
+            SubGhzProtocolDecoderBase* base = __atomic_load_n(&slot->base, __ATOMIC_SEQ_CST);
+            if(base) {
+                slot->protocol->decoder->reset(base);
+            }
         }
+
+    subghz_receiver_exit(instance);
 }
 
 static void subghz_receiver_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
@@ -93,19 +213,66 @@ void subghz_receiver_set_rx_callback(
     void* context) {
     furi_assert(instance);
 
-    for
-        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            subghz_protocol_decoder_base_set_decoder_callback(
-                (SubGhzProtocolDecoderBase*)slot->base, subghz_receiver_rx_callback, instance);
-        }
-
+    // Decoders call receiver callback since allocation
     instance->callback = callback;
     instance->context = context;
 }
 
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter) {
     furi_assert(instance);
+
     instance->filter = filter;
+    subghz_receiver_restore(instance);
+    subghz_receiver_release(instance, false);
+}
+
+size_t subghz_receiver_restore(SubGhzReceiver* instance) {
+    furi_assert(instance);
+    size_t restored = 0;
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if((slot->protocol->flag & instance->filter) != 0 && !slot->base) {
+                subghz_receiver_slot_get_base(instance, slot, false);
+                restored++;
+            }
+        }
+    // Idle time counts from now, not from last signal before release
+    instance->last_decode = furi_get_tick();
+
+    return restored;
+}
+
+size_t subghz_receiver_release_idle(SubGhzReceiver* instance, uint32_t timeout) {
+    furi_assert(instance);
+
+    if(furi_get_tick() - instance->last_decode < furi_ms_to_ticks(timeout)) {
+        return 0;
+    }
+    return subghz_receiver_release(instance, true);
+}
+
+size_t subghz_receiver_get_footprint(
+    SubGhzReceiver* instance,
+    SubGhzReceiverFootprint* footprint,
+    size_t count) {
+    furi_assert(instance);
+    size_t index = 0;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(index < count) {
+                footprint[index].name = slot->protocol->name;
+                footprint[index].size = slot->size;
+                footprint[index].allocations = slot->allocations;
+                footprint[index].is_allocated = slot->base != NULL;
+            }
+            index++;
+        }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    return index;
 }
 
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
@@ -115,8 +282,8 @@ SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
 
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if(strcmp(slot->base->protocol->name, decoder_name) == 0) {
-                result = (SubGhzProtocolDecoderBase*)slot->base;
+            if(strcmp(slot->protocol->name, decoder_name) == 0) {
+                result = subghz_receiver_slot_get_base(instance, slot, true);
                 break;
             }
         }
@@ -14,8 +14,19 @@ typedef void (*SubGhzReceiverCallback)(
     SubGhzProtocolDecoderBase* decoder_base,
     void* context);
 
+/** Decoder memory use, one per protocol with decoder */
+typedef struct {
+    const char* name; /**< Protocol name */
+    size_t size; /**< Heap taken by last allocation, bytes, approximate */
+    uint32_t allocations; /**< Times decoder was allocated */
+    bool is_allocated; /**< Decoder is allocated now */
+} SubGhzReceiverFootprint;
+
 /**
  * Allocate and init SubGhzReceiver.
+ * Decoders are allocated on first use: when protocol passes filter, is looked
+ * up by name or receives signal. Decoders that don't pass filter anymore or
+ * were idle are released, except ones looked up by name.
  * @param environment Pointer to a SubGhzEnvironment instance
  * @return SubGhzReceiver* pointer to a SubGhzReceiver instance
  */
@@ -54,13 +65,47 @@ void subghz_receiver_set_rx_callback(
 
 /**
  * Set the filter of receivers that will work at the moment.
+ * Allocates decoders passing filter, releases the rest.
+ * Must not be called from receiver callback.
  * @param instance Pointer to a SubGhzReceiver instance
  * @param filter Filter, SubGhzProtocolFlag
  */
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter);
 
+/**
+ * Release decoders if nothing was decoded for a while.
+ * Released decoders are skipped by decode until subghz_receiver_restore.
+ * Must not be called from receiver callback.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param timeout Time since last decode, ms
+ * @return size_t number of decoders released
+ */
+size_t subghz_receiver_release_idle(SubGhzReceiver* instance, uint32_t timeout);
+
+/**
+ * Allocate decoders passing filter that were released while idle.
+ * Call before feeding signal again, decode itself never allocates.
+ * Must not be called from receiver callback.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @return size_t number of decoders allocated
+ */
+size_t subghz_receiver_restore(SubGhzReceiver* instance);
+
+/**
+ * Get decoder memory use.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param footprint Array to fill, can be NULL if count is 0
+ * @param count Array size
+ * @return size_t number of protocols with decoder, may be more than count
+ */
+size_t subghz_receiver_get_footprint(
+    SubGhzReceiver* instance,
+    SubGhzReceiverFootprint* footprint,
+    size_t count);
+
 /**
  * Search for a cattery by his name.
+ * Decoder is allocated if needed and kept until receiver is freed.
  * @param instance Pointer to a SubGhzReceiver instance
  * @param decoder_name Receiver name
  * @return SubGhzProtocolDecoderBase* pointer to a SubGhzProtocolDecoderBase instance
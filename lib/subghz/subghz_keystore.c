@@ -28,12 +28,15 @@ typedef enum {
 
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    // Keys of this one are used instead of own
+    SubGhzKeystore* shared;
 };
 
 SubGhzKeystore* subghz_keystore_alloc() {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    instance->shared = NULL;
 
     return instance;
 }
@@ -340,7 +343,13 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
 
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
     furi_assert(instance);
-    return &instance->data;
+    return instance->shared ? &instance->shared->data : &instance->data;
+}
+
+void subghz_keystore_share(SubGhzKeystore* instance, SubGhzKeystore* shared) {
+    furi_assert(instance);
+    furi_assert(shared != instance);
+    instance->shared = shared;
 }
 
 bool subghz_keystore_raw_encrypted_save(
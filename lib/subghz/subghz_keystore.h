@@ -54,6 +54,13 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_
  */
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance);
 
+/** 
+ * Use keys of another keystore instead of own ones
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param shared Pointer to a SubGhzKeystore instance to get keys from, read only, NULL to use own
+ */
+void subghz_keystore_share(SubGhzKeystore* instance, SubGhzKeystore* shared);
+
 /** 
  * Save RAW encrypted to file
  * @param input_file_name Full path to the input file
@@ -0,0 +1,326 @@
+#include "subghz_keystore_cache.h"
+
+#include <furi.h>
+#include <m-array.h>
+#include <storage/storage.h>
+
+#define TAG "SubGhzKeystoreCache"
+
+#define SUBGHZ_KEYSTORE_CACHE_PRELOAD_STACK_SIZE (2 * 1024)
+#define SUBGHZ_KEYSTORE_CACHE_SD_WAIT_MS (1000)
+#define SUBGHZ_KEYSTORE_CACHE_SD_WAIT_RETRIES (10)
+#define SUBGHZ_KEYSTORE_CACHE_PRELOAD_DONE (1UL << 0)
+
+typedef struct {
+    FuriString* files[SUBGHZ_KEYSTORE_CACHE_FILES_MAX];
+    uint32_t timestamps[SUBGHZ_KEYSTORE_CACHE_FILES_MAX];
+    size_t count;
+    uint32_t loaded;
+    SubGhzKeystore* keystore;
+    uint32_t refs;
+    // Preloaded: cache holds a reference
+    bool is_pinned;
+    // Files changed: keystore is not given out anymore, freed when released
+    bool is_stale;
+} SubGhzKeystoreCacheEntry;
+
+ARRAY_DEF(SubGhzKeystoreCacheEntryArray, SubGhzKeystoreCacheEntry*, M_PTR_OPLIST)
+#define M_OPL_SubGhzKeystoreCacheEntryArray_t() \
+    ARRAY_OPLIST(SubGhzKeystoreCacheEntryArray, M_PTR_OPLIST)
+
+struct SubGhzKeystoreCache {
+    FuriMutex* mutex;
+    SubGhzKeystoreCacheEntryArray_t entries;
+
+    FuriThread* preload_thread;
+    FuriString* preload_files[SUBGHZ_KEYSTORE_CACHE_FILES_MAX];
+    size_t preload_count;
+    // Set when there is no background load in progress
+    FuriEventFlag* preload_flag;
+};
+
+static uint32_t subghz_keystore_cache_timestamp(Storage* storage, const char* file) {
+    uint32_t timestamp = 0;
+    if(storage_common_timestamp(storage, file, &timestamp) != FSE_OK) {
+        timestamp = 0;
+    }
+    return timestamp;
+}
+
+static bool subghz_keystore_cache_entry_match(
+    SubGhzKeystoreCacheEntry* entry,
+    const char* const* files,
+    size_t count,
+    bool prefix) {
+    if(entry->is_stale || count > entry->count || (!prefix && count != entry->count)) {
+        return false;
+    }
+    for(size_t i = 0; i < count; i++) {
+        if(!furi_string_equal(entry->files[i], files[i])) return false;
+    }
+    return true;
+}
+
+static bool
+    subghz_keystore_cache_entry_is_changed(SubGhzKeystoreCacheEntry* entry, Storage* storage) {
+    for(size_t i = 0; i < entry->count; i++) {
+        uint32_t timestamp =
+            subghz_keystore_cache_timestamp(storage, furi_string_get_cstr(entry->files[i]));
+        if(timestamp != entry->timestamps[i]) return true;
+    }
+    return false;
+}
+
+static SubGhzKeystoreCacheEntry*
+    subghz_keystore_cache_entry_load(Storage* storage, const char* const* files, size_t count) {
+    SubGhzKeystoreCacheEntry* entry = malloc(sizeof(SubGhzKeystoreCacheEntry));
+    size_t free_heap = memmgr_get_free_heap();
+    uint32_t start = furi_get_tick();
+
+    entry->keystore = subghz_keystore_alloc();
+    entry->count = count;
+    entry->loaded = 0;
+    entry->refs = 0;
+    entry->is_pinned = false;
+    entry->is_stale = false;
+    for(size_t i = 0; i < count; i++) {
+        entry->files[i] = furi_string_alloc_set(files[i]);
+        // Taken before load: file changed while loading is loaded again next time
+        entry->timestamps[i] = subghz_keystore_cache_timestamp(storage, files[i]);
+        if(subghz_keystore_load(entry->keystore, files[i])) {
+            entry->loaded |= (1UL << i);
+        }
+    }
+
+    size_t free_heap_after = memmgr_get_free_heap();
+    FURI_LOG_I(
+        TAG,
+        "%zu keys from %zu files in %lu ms, %zu bytes",
+        SubGhzKeyArray_size(*subghz_keystore_get_data(entry->keystore)),
+        count,
+        furi_get_tick() - start,
+        free_heap > free_heap_after ? free_heap - free_heap_after : 0);
+
+    return entry;
+}
+
+static void subghz_keystore_cache_entry_unref(
+    SubGhzKeystoreCache* instance,
+    SubGhzKeystoreCacheEntry* entry) {
+    furi_assert(entry->refs);
+    if(--entry->refs) return;
+
+    SubGhzKeystoreCacheEntryArray_it_t it;
+    for(SubGhzKeystoreCacheEntryArray_it(it, instance->entries);
+        !SubGhzKeystoreCacheEntryArray_end_p(it);
+        SubGhzKeystoreCacheEntryArray_next(it)) {
+        if(*SubGhzKeystoreCacheEntryArray_cref(it) == entry) {
+            SubGhzKeystoreCacheEntryArray_remove(instance->entries, it);
+            break;
+        }
+    }
+
+    for(size_t i = 0; i < entry->count; i++) {
+        furi_string_free(entry->files[i]);
+    }
+    subghz_keystore_free(entry->keystore);
+    free(entry);
+}
+
+/* Called with mutex taken */
+static SubGhzKeystoreCacheEntry* subghz_keystore_cache_entry_acquire(
+    SubGhzKeystoreCache* instance,
+    const char* const* files,
+    size_t count) {
+    SubGhzKeystoreCacheEntry* entry = NULL;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    for
+        M_EACH(item, instance->entries, SubGhzKeystoreCacheEntryArray_t) {
+            if(subghz_keystore_cache_entry_match(*item, files, count, false)) {
+                entry = *item;
+                break;
+            }
+        }
+
+    bool is_pinned = false;
+    if(entry && subghz_keystore_cache_entry_is_changed(entry, storage)) {
+        FURI_LOG_I(TAG, "Files changed, reloading");
+        // Current users keep old keys, pin moves to new ones
+        entry->is_stale = true;
+        is_pinned = entry->is_pinned;
+        if(is_pinned) {
+            entry->is_pinned = false;
+            subghz_keystore_cache_entry_unref(instance, entry);
+        }
+        entry = NULL;
+    }
+
+    if(!entry) {
+        entry = subghz_keystore_cache_entry_load(storage, files, count);
+        if(is_pinned) {
+            entry->is_pinned = true;
+            entry->refs++;
+        }
+        SubGhzKeystoreCacheEntryArray_push_back(instance->entries, entry);
+    }
+    entry->refs++;
+
+    furi_record_close(RECORD_STORAGE);
+    return entry;
+}
+
+static int32_t subghz_keystore_cache_preload_thread(void* context) {
+    SubGhzKeystoreCache* instance = context;
+
+    // Started with the system: SD card may still be mounting
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    for(size_t i = 0; i < SUBGHZ_KEYSTORE_CACHE_SD_WAIT_RETRIES; i++) {
+        if(storage_sd_status(storage) == FSE_OK) break;
+        furi_delay_ms(SUBGHZ_KEYSTORE_CACHE_SD_WAIT_MS);
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    const char* files[SUBGHZ_KEYSTORE_CACHE_FILES_MAX];
+    for(size_t i = 0; i < instance->preload_count; i++) {
+        files[i] = furi_string_get_cstr(instance->preload_files[i]);
+    }
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzKeystoreCacheEntry* entry =
+        subghz_keystore_cache_entry_acquire(instance, files, instance->preload_count);
+    if(entry->loaded && !entry->is_pinned) {
+        entry->is_pinned = true;
+    } else {
+        // Nothing to keep or already kept
+        subghz_keystore_cache_entry_unref(instance, entry);
+    }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+    furi_event_flag_set(instance->preload_flag, SUBGHZ_KEYSTORE_CACHE_PRELOAD_DONE);
+
+    return 0;
+}
+
+SubGhzKeystoreCache* subghz_keystore_cache_alloc(void) {
+    SubGhzKeystoreCache* instance = malloc(sizeof(SubGhzKeystoreCache));
+
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    SubGhzKeystoreCacheEntryArray_init(instance->entries);
+    instance->preload_thread = NULL;
+    instance->preload_count = 0;
+    instance->preload_flag = furi_event_flag_alloc();
+    furi_event_flag_set(instance->preload_flag, SUBGHZ_KEYSTORE_CACHE_PRELOAD_DONE);
+
+    return instance;
+}
+
+void subghz_keystore_cache_free(SubGhzKeystoreCache* instance) {
+    furi_assert(instance);
+
+    if(instance->preload_thread) {
+        furi_thread_join(instance->preload_thread);
+        furi_thread_free(instance->preload_thread);
+        for(size_t i = 0; i < instance->preload_count; i++) {
+            furi_string_free(instance->preload_files[i]);
+        }
+    }
+
+    // Only pinned keystores are left
+    while(!SubGhzKeystoreCacheEntryArray_empty_p(instance->entries)) {
+        SubGhzKeystoreCacheEntry* entry = *SubGhzKeystoreCacheEntryArray_get(
+            instance->entries, SubGhzKeystoreCacheEntryArray_size(instance->entries) - 1);
+        furi_check(entry->is_pinned && entry->refs == 1);
+        subghz_keystore_cache_entry_unref(instance, entry);
+    }
+    SubGhzKeystoreCacheEntryArray_clear(instance->entries);
+    furi_mutex_free(instance->mutex);
+    furi_event_flag_free(instance->preload_flag);
+
+    free(instance);
+}
+
+void subghz_keystore_cache_preload(
+    SubGhzKeystoreCache* instance,
+    const char* const* files,
+    size_t count) {
+    furi_assert(instance);
+    furi_check(count > 0 && count <= SUBGHZ_KEYSTORE_CACHE_FILES_MAX);
+    furi_check(!instance->preload_thread);
+
+    for(size_t i = 0; i < count; i++) {
+        instance->preload_files[i] = furi_string_alloc_set(files[i]);
+    }
+    instance->preload_count = count;
+    furi_event_flag_clear(instance->preload_flag, SUBGHZ_KEYSTORE_CACHE_PRELOAD_DONE);
+
+    instance->preload_thread = furi_thread_alloc_ex(
+        "SubGhzKeystorePreload",
+        SUBGHZ_KEYSTORE_CACHE_PRELOAD_STACK_SIZE,
+        subghz_keystore_cache_preload_thread,
+        instance);
+    furi_thread_set_priority(instance->preload_thread, FuriThreadPriorityLow);
+    furi_thread_start(instance->preload_thread);
+}
+
+SubGhzKeystore* subghz_keystore_cache_acquire(
+    SubGhzKeystoreCache* instance,
+    const char* const* files,
+    size_t count,
+    uint32_t* loaded) {
+    furi_assert(instance);
+    furi_check(count <= SUBGHZ_KEYSTORE_CACHE_FILES_MAX);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzKeystoreCacheEntry* entry = subghz_keystore_cache_entry_acquire(instance, files, count);
+    if(loaded) *loaded = entry->loaded;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    return entry->keystore;
+}
+
+void subghz_keystore_cache_release(SubGhzKeystoreCache* instance, SubGhzKeystore* keystore) {
+    furi_assert(instance);
+    SubGhzKeystoreCacheEntry* entry = NULL;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    for
+        M_EACH(item, instance->entries, SubGhzKeystoreCacheEntryArray_t) {
+            if((*item)->keystore == keystore) {
+                entry = *item;
+                break;
+            }
+        }
+    furi_check(entry);
+    subghz_keystore_cache_entry_unref(instance, entry);
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+}
+
+bool subghz_keystore_cache_peek(
+    SubGhzKeystoreCache* instance,
+    const char* const* files,
+    size_t count,
+    uint32_t* loaded) {
+    furi_assert(instance);
+    bool result = false;
+
+    // Preload may still be waiting for SD card and hasn't taken mutex yet
+    furi_check(
+        furi_event_flag_wait(
+            instance->preload_flag,
+            SUBGHZ_KEYSTORE_CACHE_PRELOAD_DONE,
+            FuriFlagWaitAny | FuriFlagNoClear,
+            FuriWaitForever) == SUBGHZ_KEYSTORE_CACHE_PRELOAD_DONE);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    for
+        M_EACH(item, instance->entries, SubGhzKeystoreCacheEntryArray_t) {
+            if(subghz_keystore_cache_entry_match(*item, files, count, true)) {
+                if(loaded) *loaded = (*item)->loaded & ((1UL << count) - 1);
+                result = true;
+                break;
+            }
+        }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    return result;
+}
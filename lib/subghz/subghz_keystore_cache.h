@@ -0,0 +1,82 @@
+#pragma once
+
+#include "subghz_keystore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RECORD_SUBGHZ_KEYSTORE "subghz_keystore"
+
+/** Keystore files in one cached keystore, at most */
+#define SUBGHZ_KEYSTORE_CACHE_FILES_MAX (4)
+
+typedef struct SubGhzKeystoreCache SubGhzKeystoreCache;
+
+/**
+ * Allocate SubGhzKeystoreCache.
+ * Keystores loaded from the same list of files are shared by everyone who
+ * acquired them and freed when last one is released.
+ * @return SubGhzKeystoreCache* pointer to a SubGhzKeystoreCache instance
+ */
+SubGhzKeystoreCache* subghz_keystore_cache_alloc(void);
+
+/**
+ * Free SubGhzKeystoreCache, all keystores must be released.
+ * @param instance Pointer to a SubGhzKeystoreCache instance
+ */
+void subghz_keystore_cache_free(SubGhzKeystoreCache* instance);
+
+/**
+ * Load keystore in background and keep it until cache is freed.
+ * @param instance Pointer to a SubGhzKeystoreCache instance
+ * @param files Full paths to the files, in load order
+ * @param count Number of files, up to SUBGHZ_KEYSTORE_CACHE_FILES_MAX
+ */
+void subghz_keystore_cache_preload(
+    SubGhzKeystoreCache* instance,
+    const char* const* files,
+    size_t count);
+
+/**
+ * Get keystore with keys from files, loaded in given order.
+ * Cached keystore is used unless one of files has changed since it was
+ * loaded, waits for background load of the same files.
+ * @param instance Pointer to a SubGhzKeystoreCache instance
+ * @param files Full paths to the files, in load order
+ * @param count Number of files, up to SUBGHZ_KEYSTORE_CACHE_FILES_MAX
+ * @param loaded Bit per file loaded successfully, can be NULL
+ * @return SubGhzKeystore* shared keystore, read only
+ */
+SubGhzKeystore* subghz_keystore_cache_acquire(
+    SubGhzKeystoreCache* instance,
+    const char* const* files,
+    size_t count,
+    uint32_t* loaded);
+
+/**
+ * Release keystore acquired from cache.
+ * @param instance Pointer to a SubGhzKeystoreCache instance
+ * @param keystore Pointer to a SubGhzKeystore instance
+ */
+void subghz_keystore_cache_release(SubGhzKeystoreCache* instance, SubGhzKeystore* keystore);
+
+/**
+ * Check if there is keystore loaded from files that start with given ones.
+ * Waits for background load to finish, SD card wait included.
+ * Files are not checked for changes.
+ * @param instance Pointer to a SubGhzKeystoreCache instance
+ * @param files Full paths to the files, in load order
+ * @param count Number of files, up to SUBGHZ_KEYSTORE_CACHE_FILES_MAX
+ * @param loaded Bit per given file loaded successfully, can be NULL
+ * @return true if there is one
+ */
+bool subghz_keystore_cache_peek(
+    SubGhzKeystoreCache* instance,
+    const char* const* files,
+    size_t count,
+    uint32_t* loaded);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,6 +4,10 @@
 
 #define TAG "SubGhzWorker"
 
+typedef enum {
+    SubGhzWorkerEvtStop = (1 << 0),
+} SubGhzWorkerEvt;
+
 struct SubGhzWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
@@ -38,43 +42,79 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     if(sizeof(LevelDuration) != ret) instance->overrun = true;
 }
 
-/** Worker callback thread
+/** Stream buffer callback, drains everything received so far
  * 
+ * @param stream stream buffer
  * @param context 
- * @return exit code 
  */
-static int32_t subghz_worker_thread_callback(void* context) {
+static void subghz_worker_stream_callback(FuriStreamBuffer* stream, void* context) {
     SubGhzWorker* instance = context;
 
     LevelDuration level_duration;
-    while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
-                FURI_LOG_E(TAG, "Overrun buffer");
-                if(instance->overrun_callback) instance->overrun_callback(instance->context);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-
-                if((duration < instance->filter_duration) ||
-                   (instance->filter_level_duration.level == level)) {
-                    instance->filter_level_duration.duration += duration;
-
-                } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
-
-                    instance->filter_level_duration.duration = duration;
-                    instance->filter_level_duration.level = level;
-                }
+    while(furi_stream_buffer_receive(stream, &level_duration, sizeof(LevelDuration), 0) ==
+          sizeof(LevelDuration)) {
+        if(level_duration_is_reset(level_duration)) {
+            FURI_LOG_E(TAG, "Overrun buffer");
+            if(instance->overrun_callback) instance->overrun_callback(instance->context);
+        } else {
+            bool level = level_duration_get_level(level_duration);
+            uint32_t duration = level_duration_get_duration(level_duration);
+
+            if((duration < instance->filter_duration) ||
+               (instance->filter_level_duration.level == level)) {
+                instance->filter_level_duration.duration += duration;
+
+            } else if(instance->filter_level_duration.level != level) {
+                if(instance->pair_callback)
+                    instance->pair_callback(
+                        instance->context,
+                        instance->filter_level_duration.level,
+                        instance->filter_level_duration.duration);
+
+                instance->filter_level_duration.duration = duration;
+                instance->filter_level_duration.level = level;
             }
         }
     }
+}
+
+static void subghz_worker_flags_callback(uint32_t flags, void* context) {
+    FuriEventLoop* event_loop = context;
+    if(flags & SubGhzWorkerEvtStop) furi_event_loop_stop(event_loop);
+}
+
+/** Worker callback thread
+ * 
+ * @param context 
+ * @return exit code 
+ */
+static int32_t subghz_worker_thread_callback(void* context) {
+    SubGhzWorker* instance = context;
+
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    furi_event_loop_subscribe_stream_buffer(
+        event_loop,
+        instance->stream,
+        FuriEventLoopEventIn,
+        subghz_worker_stream_callback,
+        instance);
+    furi_event_loop_subscribe_thread_flags(
+        event_loop, SubGhzWorkerEvtStop, subghz_worker_flags_callback, event_loop);
+
+    furi_event_loop_run(event_loop);
+
+    FuriEventLoopStats stats;
+    furi_event_loop_get_stats(event_loop, &stats);
+    FURI_LOG_D(
+        TAG,
+        "%lu wakeups, %lu events in %lu ms, latency max %lu us",
+        stats.wakeups,
+        stats.events,
+        stats.duration,
+        stats.latency_max);
+
+    furi_event_loop_unsubscribe(event_loop, instance->stream);
+    furi_event_loop_free(event_loop);
 
     return 0;
 }
@@ -135,6 +175,7 @@ void subghz_worker_stop(SubGhzWorker* instance) {
 
     instance->running = false;
 
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), SubGhzWorkerEvtStop);
     furi_thread_join(instance->thread);
 }
 
@@ -1,6 +1,7 @@
 #include "compress.h"
 
 #include <furi.h>
+#include <furi_hal_flash.h>
 #include <lib/heatshrink/heatshrink_encoder.h>
 #include <lib/heatshrink/heatshrink_decoder.h>
 
@@ -22,9 +23,26 @@ typedef struct {
 
 _Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
 
+/** Decoded icons are kept this long below free heap, otherwise cache is dropped */
+#define COMPRESS_ICON_CACHE_HEAP_RESERVE (16 * 1024u)
+
+typedef struct CompressIconCacheEntry {
+    const uint8_t* icon_data; /**< Key: compressed data in flash */
+    struct CompressIconCacheEntry* prev;
+    struct CompressIconCacheEntry* next;
+    uint16_t size;
+    uint8_t data[];
+} CompressIconCacheEntry;
+
 struct CompressIcon {
     heatshrink_decoder* decoder;
     uint8_t decoded_buff[COMPRESS_ICON_DECODED_BUFF_SIZE];
+
+    /* Most recently used entry first */
+    CompressIconCacheEntry* cache_head;
+    CompressIconCacheEntry* cache_tail;
+    size_t cache_size;
+    CompressIconCacheStats stats;
 };
 
 CompressIcon* compress_icon_alloc() {
@@ -35,44 +53,179 @@ CompressIcon* compress_icon_alloc() {
         COMPRESS_LOOKAHEAD_BUFF_SIZE_LOG);
     heatshrink_decoder_reset(instance->decoder);
     memset(instance->decoded_buff, 0, sizeof(instance->decoded_buff));
+    instance->cache_head = NULL;
+    instance->cache_tail = NULL;
+    instance->cache_size = 0;
+    memset(&instance->stats, 0, sizeof(instance->stats));
 
     return instance;
 }
 
 void compress_icon_free(CompressIcon* instance) {
     furi_assert(instance);
+    compress_icon_cache_flush(instance);
     heatshrink_decoder_free(instance->decoder);
     free(instance);
 }
 
+static size_t compress_icon_cache_entry_size(const CompressIconCacheEntry* entry) {
+    return sizeof(CompressIconCacheEntry) + entry->size;
+}
+
+static void compress_icon_cache_unlink(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    if(entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        instance->cache_head = entry->next;
+    }
+
+    if(entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        instance->cache_tail = entry->prev;
+    }
+}
+
+static void compress_icon_cache_push_front(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = instance->cache_head;
+    if(instance->cache_head) {
+        instance->cache_head->prev = entry;
+    } else {
+        instance->cache_tail = entry;
+    }
+    instance->cache_head = entry;
+}
+
+static void compress_icon_cache_evict(CompressIcon* instance) {
+    CompressIconCacheEntry* entry = instance->cache_tail;
+    compress_icon_cache_unlink(instance, entry);
+    instance->stats.used -= compress_icon_cache_entry_size(entry);
+    instance->stats.entries--;
+    instance->stats.evictions++;
+    free(entry);
+}
+
+static void compress_icon_cache_shrink(CompressIcon* instance, size_t size) {
+    while(instance->cache_tail && (instance->stats.used + size > instance->cache_size)) {
+        compress_icon_cache_evict(instance);
+    }
+}
+
+static CompressIconCacheEntry*
+    compress_icon_cache_find(CompressIcon* instance, const uint8_t* icon_data) {
+    for(CompressIconCacheEntry* entry = instance->cache_head; entry; entry = entry->next) {
+        if(entry->icon_data == icon_data) {
+            if(entry != instance->cache_head) {
+                compress_icon_cache_unlink(instance, entry);
+                compress_icon_cache_push_front(instance, entry);
+            }
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/* Heap data may be freed and its address reused by another icon: only flash is safe as a key */
+static bool compress_icon_is_cacheable(const uint8_t* icon_data) {
+    return furi_hal_flash_contains_address((size_t)icon_data);
+}
+
+static void compress_icon_cache_insert(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    const uint8_t* data,
+    size_t size) {
+    size_t entry_size = sizeof(CompressIconCacheEntry) + size;
+    if(entry_size > instance->cache_size) {
+        instance->stats.uncached++;
+        return;
+    }
+
+    // Cache is the first thing to give up when heap runs low
+    if(memmgr_get_free_heap() < COMPRESS_ICON_CACHE_HEAP_RESERVE + entry_size) {
+        instance->stats.pressure_flushes++;
+        compress_icon_cache_flush(instance);
+        return;
+    }
+
+    compress_icon_cache_shrink(instance, entry_size);
+
+    CompressIconCacheEntry* entry = malloc(entry_size);
+    entry->icon_data = icon_data;
+    entry->size = size;
+    memcpy(entry->data, data, size);
+    compress_icon_cache_push_front(instance, entry);
+    instance->stats.used += entry_size;
+    instance->stats.entries++;
+}
+
+void compress_icon_set_cache_size(CompressIcon* instance, size_t size) {
+    furi_assert(instance);
+    instance->cache_size = size;
+    compress_icon_cache_shrink(instance, 0);
+}
+
+void compress_icon_cache_flush(CompressIcon* instance) {
+    furi_assert(instance);
+    while(instance->cache_tail) {
+        compress_icon_cache_evict(instance);
+    }
+}
+
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+    *stats = instance->stats;
+}
+
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff) {
     furi_assert(instance);
     furi_assert(icon_data);
     furi_assert(decoded_buff);
 
     CompressHeader* header = (CompressHeader*)icon_data;
-    if(header->is_compressed) {
-        size_t data_processed = 0;
-        heatshrink_decoder_sink(
+    if(!header->is_compressed) {
+        *decoded_buff = (uint8_t*)&icon_data[1];
+        return;
+    }
+
+    bool cacheable = instance->cache_size && compress_icon_is_cacheable(icon_data);
+    if(cacheable) {
+        CompressIconCacheEntry* entry = compress_icon_cache_find(instance, icon_data);
+        if(entry) {
+            instance->stats.hits++;
+            *decoded_buff = entry->data;
+            return;
+        }
+        instance->stats.misses++;
+    }
+
+    size_t data_processed = 0;
+    size_t decoded_size = 0;
+    heatshrink_decoder_sink(
+        instance->decoder,
+        (uint8_t*)&icon_data[sizeof(CompressHeader)],
+        header->compressed_buff_size,
+        &data_processed);
+    while(decoded_size < sizeof(instance->decoded_buff)) {
+        HSD_poll_res res = heatshrink_decoder_poll(
             instance->decoder,
-            (uint8_t*)&icon_data[sizeof(CompressHeader)],
-            header->compressed_buff_size,
+            &instance->decoded_buff[decoded_size],
+            sizeof(instance->decoded_buff) - decoded_size,
             &data_processed);
-        while(1) {
-            HSD_poll_res res = heatshrink_decoder_poll(
-                instance->decoder,
-                instance->decoded_buff,
-                sizeof(instance->decoded_buff),
-                &data_processed);
-            furi_assert((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
-            if(res != HSDR_POLL_MORE) {
-                break;
-            }
+        furi_assert((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
+        decoded_size += data_processed;
+        if(res != HSDR_POLL_MORE) {
+            break;
         }
-        heatshrink_decoder_reset(instance->decoder);
-        *decoded_buff = instance->decoded_buff;
-    } else {
-        *decoded_buff = (uint8_t*)&icon_data[1];
+    }
+    heatshrink_decoder_reset(instance->decoder);
+    *decoded_buff = instance->decoded_buff;
+
+    if(cacheable) {
+        compress_icon_cache_insert(instance, icon_data, instance->decoded_buff, decoded_size);
     }
 }
 
@@ -27,10 +27,46 @@ CompressIcon* compress_icon_alloc();
  */
 void compress_icon_free(CompressIcon* instance);
 
+/** Decoded icon cache statistics */
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions; /**< Entries dropped to fit the budget or on flush */
+    uint32_t uncached; /**< Decoded icons bigger than the whole budget */
+    uint32_t pressure_flushes; /**< Cache was dropped because heap was low */
+    size_t entries;
+    size_t used; /**< Bytes taken from heap, including entry headers */
+} CompressIconCacheStats;
+
+/** Set decoded icon cache budget
+ *
+ * Decoded icons are kept in LRU order, keyed by compressed data pointer.
+ * Only icons stored in flash are cached: heap data may be freed and its
+ * address reused. Cache is flushed when free heap runs low.
+ *
+ * @param      instance  The Compress Icon instance
+ * @param      size      budget in bytes, 0 disables cache (default)
+ */
+void compress_icon_set_cache_size(CompressIcon* instance, size_t size);
+
+/** Free all decoded icons
+ *
+ * @param      instance  The Compress Icon instance
+ */
+void compress_icon_cache_flush(CompressIcon* instance);
+
+/** Get decoded icon cache statistics
+ *
+ * @param      instance  The Compress Icon instance
+ * @param      stats     output
+ */
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats);
+
 /** Decompress icon
  *
  * @warning    decoded_buff pointer set by this function is valid till next
- *             `compress_icon_decode` or `compress_icon_free` call
+ *             `compress_icon_decode`, `compress_icon_set_cache_size`,
+ *             `compress_icon_cache_flush` or `compress_icon_free` call
  *
  * @param      instance      The Compress Icon instance
  * @param      icon_data     pointer to icon data
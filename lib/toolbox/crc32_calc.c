@@ -1,38 +1,38 @@
 #include "crc32_calc.h"
-#include <littlefs/lfs_util.h>
-
-#define CRC_DATA_BUFFER_MAX_LEN 512
+#include "hash/crc32_sliced.h"
+#include "hash/hash.h"
 
 uint32_t crc32_calc_buffer(uint32_t crc, const void* buffer, size_t size) {
-    // TODO FL-3547: consider removing dependency on LFS
-    return ~lfs_crc(~crc, buffer, size);
+    return crc32_sliced_calc(crc, buffer, size);
 }
 
-uint32_t crc32_calc_file(File* file, const FileCrcProgressCb progress_cb, void* context) {
+static bool crc32_calc_file_internal(
+    File* file,
+    const FileCrcProgressCb progress_cb,
+    void* context,
+    uint32_t* crc) {
     furi_check(storage_file_is_open(file) && storage_file_seek(file, 0, true));
 
-    uint32_t file_crc = 0;
-
-    uint8_t* data_buffer = malloc(CRC_DATA_BUFFER_MAX_LEN);
-    uint16_t data_buffer_valid_len;
-
-    uint32_t file_size = storage_file_size(file);
-
-    /* Feed file contents per sector into CRC calc */
-    for(uint32_t fptr = 0; fptr < file_size;) {
-        data_buffer_valid_len = storage_file_read(file, data_buffer, CRC_DATA_BUFFER_MAX_LEN);
-        if(data_buffer_valid_len == 0) {
-            break;
-        }
-        fptr += data_buffer_valid_len;
+    Hash* hash = hash_alloc(HashTypeCrc32);
+    bool success = hash_update_file(hash, file, progress_cb, context);
+    *crc = hash_get_crc32(hash);
+    hash_free(hash);
 
-        if(progress_cb && (fptr % CRC_DATA_BUFFER_MAX_LEN == 0)) {
-            progress_cb(fptr * 100 / file_size, context);
-        }
-
-        file_crc = crc32_calc_buffer(file_crc, data_buffer, data_buffer_valid_len);
-    }
-    free(data_buffer);
+    return success;
+}
 
+uint32_t crc32_calc_file(File* file, const FileCrcProgressCb progress_cb, void* context) {
+    uint32_t file_crc;
+    crc32_calc_file_internal(file, progress_cb, context, &file_crc);
     return file_crc;
 }
+
+bool crc32_calc_file_check(
+    File* file,
+    uint32_t expected_crc,
+    const FileCrcProgressCb progress_cb,
+    void* context) {
+    uint32_t file_crc;
+    return crc32_calc_file_internal(file, progress_cb, context, &file_crc) &&
+           (file_crc == expected_crc);
+}
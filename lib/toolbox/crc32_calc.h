@@ -11,8 +11,23 @@ uint32_t crc32_calc_buffer(uint32_t crc, const void* buffer, size_t size);
 
 typedef void (*FileCrcProgressCb)(const uint8_t progress, void* context);
 
+/** Calculate CRC-32 of whole file
+ *
+ * Read errors are not reported: result is CRC of data read before the error.
+ * Use crc32_calc_file_check to validate a file.
+ */
 uint32_t crc32_calc_file(File* file, const FileCrcProgressCb progress_cb, void* context);
 
+/** Check that whole file can be read and its CRC-32 matches
+ *
+ * @return     false on read error or CRC mismatch
+ */
+bool crc32_calc_file_check(
+    File* file,
+    uint32_t expected_crc,
+    const FileCrcProgressCb progress_cb,
+    void* context);
+
 #ifdef __cplusplus
 }
 #endif
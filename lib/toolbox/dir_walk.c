@@ -1,32 +1,54 @@
 #include "dir_walk.h"
-#include <m-list.h>
+#include <m-array.h>
 
-LIST_DEF(DirIndexList, uint32_t);
+/* Levels deeper than that share the last handle and rewind on step out */
+#define DIR_WALK_HANDLES_MAX (8)
+#define DIR_WALK_NAME_MAX (256)
+
+typedef struct {
+    size_t parent_length; /**< Path length of parent directory */
+    FileInfo fileinfo; /**< Directory info, for post-order */
+} DirWalkLevel;
+
+ARRAY_DEF(DirWalkLevelArray, DirWalkLevel, M_POD_OPLIST);
 
 struct DirWalk {
-    File* file;
+    Storage* storage;
+    File* files[DIR_WALK_HANDLES_MAX];
     FuriString* path;
-    DirIndexList_t index_list;
-    uint32_t current_index;
+    DirWalkLevelArray_t levels;
+    char* name;
     bool recursive;
+    DirWalkOrder order;
     DirWalkFilterCb filter_cb;
     void* filter_context;
 };
 
 DirWalk* dir_walk_alloc(Storage* storage) {
     DirWalk* dir_walk = malloc(sizeof(DirWalk));
+    dir_walk->storage = storage;
     dir_walk->path = furi_string_alloc();
-    dir_walk->file = storage_file_alloc(storage);
-    DirIndexList_init(dir_walk->index_list);
+    dir_walk->name = malloc(DIR_WALK_NAME_MAX);
+    // Handles of nested levels are allocated on first use
+    memset(dir_walk->files, 0, sizeof(dir_walk->files));
+    dir_walk->files[0] = storage_file_alloc(storage);
+    DirWalkLevelArray_init(dir_walk->levels);
     dir_walk->recursive = true;
+    dir_walk->order = DirWalkOrderPre;
     dir_walk->filter_cb = NULL;
     return dir_walk;
 }
 
 void dir_walk_free(DirWalk* dir_walk) {
-    storage_file_free(dir_walk->file);
+    dir_walk_close(dir_walk);
+    for(size_t i = 0; i < DIR_WALK_HANDLES_MAX; i++) {
+        if(dir_walk->files[i]) {
+            storage_file_free(dir_walk->files[i]);
+        }
+    }
     furi_string_free(dir_walk->path);
-    DirIndexList_clear(dir_walk->index_list);
+    DirWalkLevelArray_clear(dir_walk->levels);
+    free(dir_walk->name);
     free(dir_walk);
 }
 
@@ -34,15 +56,31 @@ void dir_walk_set_recursive(DirWalk* dir_walk, bool recursive) {
     dir_walk->recursive = recursive;
 }
 
+void dir_walk_set_order(DirWalk* dir_walk, DirWalkOrder order) {
+    dir_walk->order = order;
+}
+
 void dir_walk_set_filter_cb(DirWalk* dir_walk, DirWalkFilterCb cb, void* context) {
     dir_walk->filter_cb = cb;
     dir_walk->filter_context = context;
 }
 
+static size_t dir_walk_depth(DirWalk* dir_walk) {
+    return DirWalkLevelArray_size(dir_walk->levels);
+}
+
+static File* dir_walk_file(DirWalk* dir_walk, size_t depth) {
+    size_t index = MIN(depth, (size_t)DIR_WALK_HANDLES_MAX - 1);
+    if(!dir_walk->files[index]) {
+        dir_walk->files[index] = storage_file_alloc(dir_walk->storage);
+    }
+    return dir_walk->files[index];
+}
+
 bool dir_walk_open(DirWalk* dir_walk, const char* path) {
+    dir_walk_close(dir_walk);
     furi_string_set(dir_walk->path, path);
-    dir_walk->current_index = 0;
-    return storage_dir_open(dir_walk->file, path);
+    return storage_dir_open(dir_walk_file(dir_walk, 0), path);
 }
 
 static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* fileinfo) {
@@ -53,105 +91,189 @@ static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* filei
     }
 }
 
+static void dir_walk_step_into(DirWalk* dir_walk, const char* name, const FileInfo* fileinfo) {
+    DirWalkLevel* level = DirWalkLevelArray_push_new(dir_walk->levels);
+    level->parent_length = furi_string_size(dir_walk->path);
+    level->fileinfo = *fileinfo;
+    furi_string_cat_printf(dir_walk->path, "/%s", name);
+
+    size_t depth = dir_walk_depth(dir_walk);
+    File* file = dir_walk_file(dir_walk, depth);
+    if(depth >= DIR_WALK_HANDLES_MAX) {
+        // Shared handle, parent is open in it
+        storage_dir_close(file);
+    }
+
+    // Open error is reported by the next read
+    storage_dir_open(file, furi_string_get_cstr(dir_walk->path));
+}
+
+static bool dir_walk_step_out(DirWalk* dir_walk) {
+    size_t depth = dir_walk_depth(dir_walk);
+    File* file = dir_walk_file(dir_walk, depth);
+    storage_dir_close(file);
+
+    DirWalkLevel level;
+    DirWalkLevelArray_pop_back(&level, dir_walk->levels);
+
+    // Remember name of the directory we are leaving, to find it in shared handle
+    strlcpy(
+        dir_walk->name,
+        furi_string_get_cstr(dir_walk->path) + level.parent_length + 1,
+        DIR_WALK_NAME_MAX);
+    furi_string_left(dir_walk->path, level.parent_length);
+
+    if(depth < DIR_WALK_HANDLES_MAX) {
+        // Parent handle is still open at the right position
+        return true;
+    }
+
+    // Rewind by name, not by index: entries returned before may have been removed
+    if(!storage_dir_open(file, furi_string_get_cstr(dir_walk->path))) {
+        return false;
+    }
+
+    char* name = malloc(DIR_WALK_NAME_MAX);
+    FileInfo info;
+    bool found = false;
+    while(!found && storage_dir_read(file, &info, name, DIR_WALK_NAME_MAX - 1)) {
+        found = (strcmp(name, dir_walk->name) == 0);
+    }
+    free(name);
+
+    // If it is gone, directory is over: next read will report it
+    return found || storage_file_get_error(file) == FSE_NOT_EXIST;
+}
+
+static void dir_walk_output(
+    DirWalk* dir_walk,
+    const char* name,
+    const FileInfo* info,
+    FuriString* return_path,
+    FileInfo* fileinfo) {
+    if(return_path != NULL) {
+        if(name) {
+            furi_string_printf( //-V576
+                return_path,
+                "%s/%s",
+                furi_string_get_cstr(dir_walk->path),
+                name);
+        } else {
+            furi_string_set(return_path, dir_walk->path);
+        }
+    }
+
+    if(fileinfo != NULL) {
+        memcpy(fileinfo, info, sizeof(FileInfo));
+    }
+}
+
 static DirWalkResult
     dir_walk_iter(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
-    DirWalkResult result = DirWalkError;
-    char* name = malloc(256); // FIXME: remove magic number
+    char* name = dir_walk->name;
     FileInfo info;
-    bool end = false;
-
-    while(!end) {
-        storage_dir_read(dir_walk->file, &info, name, 255);
-
-        if(storage_file_get_error(dir_walk->file) == FSE_OK) {
-            result = DirWalkOK;
-            dir_walk->current_index++;
-
-            if(dir_walk_filter(dir_walk, name, &info)) {
-                if(return_path != NULL) {
-                    furi_string_printf( //-V576
-                        return_path,
-                        "%s/%s",
-                        furi_string_get_cstr(dir_walk->path),
-                        name);
-                }
 
-                if(fileinfo != NULL) {
-                    memcpy(fileinfo, &info, sizeof(FileInfo));
-                }
+    while(true) {
+        File* file = dir_walk_file(dir_walk, dir_walk_depth(dir_walk));
 
-                end = true;
-            }
+        if(storage_dir_read(file, &info, name, DIR_WALK_NAME_MAX - 1)) {
+            bool step_into = file_info_is_dir(&info) && dir_walk->recursive;
+            bool found = (!step_into || dir_walk->order == DirWalkOrderPre) &&
+                         dir_walk_filter(dir_walk, name, &info);
 
-            if(file_info_is_dir(&info) && dir_walk->recursive) {
-                // step into
-                DirIndexList_push_back(dir_walk->index_list, dir_walk->current_index);
-                dir_walk->current_index = 0;
-                storage_dir_close(dir_walk->file);
+            if(found) {
+                dir_walk_output(dir_walk, name, &info, return_path, fileinfo);
+            }
 
-                furi_string_cat_printf(dir_walk->path, "/%s", name);
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+            if(step_into) {
+                dir_walk_step_into(dir_walk, name, &info);
             }
-        } else if(storage_file_get_error(dir_walk->file) == FSE_NOT_EXIST) {
-            if(DirIndexList_size(dir_walk->index_list) == 0) {
-                // last
-                result = DirWalkLast;
-                end = true;
-            } else {
-                // step out
-                uint32_t index;
-                DirIndexList_pop_back(&index, dir_walk->index_list);
-                dir_walk->current_index = 0;
-
-                storage_dir_close(dir_walk->file);
-
-                size_t last_char = furi_string_search_rchar(dir_walk->path, '/');
-                if(last_char != FURI_STRING_FAILURE) {
-                    furi_string_left(dir_walk->path, last_char);
-                }
 
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+            if(found) {
+                return DirWalkOK;
+            }
+        } else if(storage_file_get_error(file) == FSE_NOT_EXIST) {
+            if(dir_walk_depth(dir_walk) == 0) {
+                return DirWalkLast;
+            }
 
-                // rewind
-                while(true) {
-                    if(index == dir_walk->current_index) {
-                        result = DirWalkOK;
-                        break;
-                    }
+            bool found = false;
+            if(dir_walk->order == DirWalkOrderPost) {
+                DirWalkLevel* level = DirWalkLevelArray_back(dir_walk->levels);
+                const char* dir_name =
+                    furi_string_get_cstr(dir_walk->path) + level->parent_length + 1;
+                info = level->fileinfo;
+                found = dir_walk_filter(dir_walk, dir_name, &info);
+                if(found) {
+                    dir_walk_output(dir_walk, NULL, &info, return_path, fileinfo);
+                }
+            }
 
-                    if(!storage_dir_read(dir_walk->file, &info, name, 255)) {
-                        result = DirWalkError;
-                        end = true;
-                        break;
-                    }
+            if(!dir_walk_step_out(dir_walk)) {
+                return DirWalkError;
+            }
 
-                    dir_walk->current_index++;
-                }
+            if(found) {
+                return DirWalkOK;
             }
         } else {
-            result = DirWalkError;
-            end = true;
+            return DirWalkError;
         }
     }
-
-    free(name);
-    return result;
 }
 
 FS_Error dir_walk_get_error(DirWalk* dir_walk) {
-    return storage_file_get_error(dir_walk->file);
+    return storage_file_get_error(dir_walk_file(dir_walk, dir_walk_depth(dir_walk)));
 }
 
 DirWalkResult dir_walk_read(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     return dir_walk_iter(dir_walk, return_path, fileinfo);
 }
 
+DirWalkResult
+    dir_walk_read_batch(DirWalk* dir_walk, size_t batch_size, DirWalkBatchCb cb, void* context) {
+    furi_assert(dir_walk);
+    furi_assert(cb);
+    furi_check(batch_size);
+
+    DirWalkEntry* entries = malloc(sizeof(DirWalkEntry) * batch_size);
+    for(size_t i = 0; i < batch_size; i++) {
+        entries[i].path = furi_string_alloc();
+    }
+
+    DirWalkResult result = DirWalkOK;
+    size_t count = 0;
+
+    do {
+        result = dir_walk_iter(dir_walk, entries[count].path, &entries[count].fileinfo);
+        if(result == DirWalkOK) {
+            count++;
+        }
+
+        if((count == batch_size) || (count && result == DirWalkLast)) {
+            if(!cb(entries, count, context)) {
+                result = DirWalkOK;
+                break;
+            }
+            count = 0;
+        }
+    } while(result == DirWalkOK);
+
+    for(size_t i = 0; i < batch_size; i++) {
+        furi_string_free(entries[i].path);
+    }
+    free(entries);
+
+    return result;
+}
+
 void dir_walk_close(DirWalk* dir_walk) {
-    if(storage_file_is_open(dir_walk->file)) {
-        storage_dir_close(dir_walk->file);
+    for(size_t i = 0; i < DIR_WALK_HANDLES_MAX; i++) {
+        if(dir_walk->files[i] && storage_file_is_open(dir_walk->files[i])) {
+            storage_dir_close(dir_walk->files[i]);
+        }
     }
 
-    DirIndexList_reset(dir_walk->index_list);
+    DirWalkLevelArray_reset(dir_walk->levels);
     furi_string_reset(dir_walk->path);
-    dir_walk->current_index = 0;
 }
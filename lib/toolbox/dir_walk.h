@@ -13,8 +13,21 @@ typedef enum {
     DirWalkLast, /**< Last element */
 } DirWalkResult;
 
+typedef enum {
+    DirWalkOrderPre, /**< Directory is returned before its contents (default) */
+    DirWalkOrderPost, /**< Directory is returned after its contents, suitable for removal */
+} DirWalkOrder;
+
+typedef struct {
+    FuriString* path; /**< Full path of element */
+    FileInfo fileinfo; /**< Element info */
+} DirWalkEntry;
+
 typedef bool (*DirWalkFilterCb)(const char* name, FileInfo* fileinfo, void* ctx);
 
+/** Batch callback. Should return false to stop walking. */
+typedef bool (*DirWalkBatchCb)(const DirWalkEntry* entries, size_t count, void* ctx);
+
 /**
  * Allocate DirWalk
  * @param storage 
@@ -35,6 +48,16 @@ void dir_walk_free(DirWalk* dir_walk);
  */
 void dir_walk_set_recursive(DirWalk* dir_walk, bool recursive);
 
+/**
+ * Set traversal order (DirWalkOrderPre by default)
+ * 
+ * In post-order, elements may be removed as soon as they are returned:
+ * walk position is not affected by removal of already returned elements.
+ * @param dir_walk 
+ * @param order 
+ */
+void dir_walk_set_order(DirWalk* dir_walk, DirWalkOrder order);
+
 /**
  * Set filter callback (Should return true if the data is valid)
  * @param dir_walk 
@@ -68,6 +91,18 @@ FS_Error dir_walk_get_error(DirWalk* dir_walk);
  */
 DirWalkResult dir_walk_read(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo);
 
+/**
+ * Read all remaining elements, passing them to callback in batches
+ * @param dir_walk 
+ * @param batch_size maximum elements per callback call
+ * @param cb 
+ * @param context 
+ * @return DirWalkResult DirWalkLast if all elements were processed,
+ *         DirWalkOK if callback stopped walking
+ */
+DirWalkResult
+    dir_walk_read_batch(DirWalk* dir_walk, size_t batch_size, DirWalkBatchCb cb, void* context);
+
 /**
  * Close directory
  * @param dir_walk 
@@ -0,0 +1,28 @@
+/**
+ * @file crc32_sliced.h
+ * Table driven CRC-32 (IEEE 802.3), slicing by 4
+ *
+ * Plain C without furi dependencies, usable on host.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Calculate CRC-32, processing 4 bytes per step
+ *
+ * @param      crc     CRC of preceding data, 0 for first chunk
+ * @param      buffer  data pointer
+ * @param      size    data size in bytes
+ *
+ * @return     CRC of preceding data and given chunk
+ */
+uint32_t crc32_sliced_calc(uint32_t crc, const void* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,203 @@
+#include "hash.h"
+#include "crc32_sliced.h"
+#include "../md5.h"
+#include "../sha256.h"
+
+#include <furi.h>
+#include <furi_hal_crc.h>
+
+#define TAG "Hash"
+
+/* Storage requests are expensive, read files in big chunks */
+#define HASH_FILE_BUFFER_SIZE (4096)
+
+/* Below that, acquiring CRC unit costs more than software calculation */
+#define HASH_CRC32_HW_THRESHOLD (64)
+
+struct Hash {
+    HashType type;
+    union {
+        uint32_t crc32;
+        md5_context md5;
+        sha256_context sha256;
+    };
+};
+
+Hash* hash_alloc(HashType type) {
+    Hash* hash = malloc(sizeof(Hash));
+    hash->type = type;
+    hash_reset(hash);
+    return hash;
+}
+
+void hash_free(Hash* hash) {
+    furi_assert(hash);
+    free(hash);
+}
+
+HashType hash_get_type(Hash* hash) {
+    furi_assert(hash);
+    return hash->type;
+}
+
+size_t hash_get_digest_size(HashType type) {
+    switch(type) {
+    case HashTypeCrc32:
+        return sizeof(uint32_t);
+    case HashTypeMd5:
+        return 16;
+    case HashTypeSha256:
+        return SHA256_DIGEST_SIZE;
+    default:
+        furi_crash(NULL);
+    }
+}
+
+void hash_reset(Hash* hash) {
+    furi_assert(hash);
+
+    switch(hash->type) {
+    case HashTypeCrc32:
+        hash->crc32 = 0;
+        break;
+    case HashTypeMd5:
+        md5_starts(&hash->md5);
+        break;
+    case HashTypeSha256:
+        sha256_start(&hash->sha256);
+        break;
+    default:
+        furi_crash(NULL);
+    }
+}
+
+static uint32_t hash_crc32_calc(uint32_t crc, const void* data, size_t size) {
+    // Don't wait for CRC unit: if somebody else is using it, software is faster than waiting
+    if((size >= HASH_CRC32_HW_THRESHOLD) && furi_hal_crc_acquire(0)) {
+        crc = furi_hal_crc_calc(crc, data, size);
+        furi_hal_crc_release();
+    } else {
+        crc = crc32_sliced_calc(crc, data, size);
+    }
+
+    return crc;
+}
+
+void hash_update(Hash* hash, const void* data, size_t size) {
+    furi_assert(hash);
+    furi_assert(data || !size);
+
+    switch(hash->type) {
+    case HashTypeCrc32:
+        hash->crc32 = hash_crc32_calc(hash->crc32, data, size);
+        break;
+    case HashTypeMd5:
+        md5_update(&hash->md5, data, size);
+        break;
+    case HashTypeSha256:
+        sha256_update(&hash->sha256, data, size);
+        break;
+    default:
+        furi_crash(NULL);
+    }
+}
+
+size_t hash_finish(Hash* hash, uint8_t* digest) {
+    furi_assert(hash);
+    furi_assert(digest);
+
+    switch(hash->type) {
+    case HashTypeCrc32:
+        digest[0] = hash->crc32 >> 24;
+        digest[1] = hash->crc32 >> 16;
+        digest[2] = hash->crc32 >> 8;
+        digest[3] = hash->crc32;
+        break;
+    case HashTypeMd5:
+        md5_finish(&hash->md5, digest);
+        break;
+    case HashTypeSha256:
+        sha256_finish(&hash->sha256, digest);
+        break;
+    default:
+        furi_crash(NULL);
+    }
+
+    hash_reset(hash);
+    return hash_get_digest_size(hash->type);
+}
+
+uint32_t hash_get_crc32(Hash* hash) {
+    furi_assert(hash);
+    furi_check(hash->type == HashTypeCrc32);
+    return hash->crc32;
+}
+
+bool hash_update_file(Hash* hash, File* file, HashProgressCallback callback, void* context) {
+    furi_assert(hash);
+    furi_assert(file);
+
+    uint8_t* buffer = malloc(HASH_FILE_BUFFER_SIZE);
+    uint64_t position = storage_file_tell(file);
+    const uint64_t file_size = storage_file_size(file);
+    bool success = true;
+
+    while(position < file_size) {
+        size_t read_size = storage_file_read(file, buffer, HASH_FILE_BUFFER_SIZE);
+        if(read_size == 0) {
+            success = false;
+            break;
+        }
+
+        hash_update(hash, buffer, read_size);
+        position += read_size;
+
+        if(callback) {
+            callback(position * 100 / file_size, context);
+        }
+    }
+
+    free(buffer);
+    return success && (storage_file_get_error(file) == FSE_OK);
+}
+
+bool hash_copy_file(Hash* hash, File* source, File* destination) {
+    furi_assert(hash);
+    furi_assert(source);
+    furi_assert(destination);
+
+    uint8_t* buffer = malloc(HASH_FILE_BUFFER_SIZE);
+    bool success = true;
+
+    while(true) {
+        size_t read_size = storage_file_read(source, buffer, HASH_FILE_BUFFER_SIZE);
+        if(storage_file_get_error(source) != FSE_OK) {
+            success = false;
+            break;
+        }
+        if(read_size == 0) {
+            break;
+        }
+
+        // Data is read from storage once and used twice
+        hash_update(hash, buffer, read_size);
+
+        if(storage_file_write(destination, buffer, read_size) != read_size) {
+            success = false;
+            break;
+        }
+    }
+
+    free(buffer);
+    return success;
+}
+
+void hash_digest_to_string(const uint8_t* digest, size_t size, FuriString* output) {
+    furi_assert(digest);
+    furi_assert(output);
+
+    furi_string_reset(output);
+    for(size_t i = 0; i < size; i++) {
+        furi_string_cat_printf(output, "%02x", digest[i]);
+    }
+}
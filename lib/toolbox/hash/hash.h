@@ -0,0 +1,128 @@
+/**
+ * @file hash.h
+ * Unified streaming hash API
+ *
+ * One context type for CRC-32, MD5 and SHA-256. CRC-32 is calculated by
+ * CRC unit when it is available, table driven software otherwise. Data can
+ * be fed in chunks of any size, including while it is being copied between
+ * files.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HASH_DIGEST_SIZE_MAX (32)
+
+typedef enum {
+    HashTypeCrc32, /**< CRC-32 (IEEE 802.3), 4 byte digest, big endian */
+    HashTypeMd5, /**< MD5, 16 byte digest */
+    HashTypeSha256, /**< SHA-256, 32 byte digest */
+} HashType;
+
+typedef struct Hash Hash;
+
+/** File hashing progress, in percent */
+typedef void (*HashProgressCallback)(uint8_t progress, void* context);
+
+/** Allocate hash context, ready for update
+ *
+ * @param      type  hash algorithm
+ *
+ * @return     Hash instance
+ */
+Hash* hash_alloc(HashType type);
+
+/** Free hash context
+ *
+ * @param      hash  Hash instance
+ */
+void hash_free(Hash* hash);
+
+/** Get hash algorithm
+ *
+ * @param      hash  Hash instance
+ *
+ * @return     HashType
+ */
+HashType hash_get_type(Hash* hash);
+
+/** Get digest size
+ *
+ * @param      type  hash algorithm
+ *
+ * @return     digest size in bytes
+ */
+size_t hash_get_digest_size(HashType type);
+
+/** Start new calculation, discarding fed data
+ *
+ * @param      hash  Hash instance
+ */
+void hash_reset(Hash* hash);
+
+/** Feed data
+ *
+ * @param      hash  Hash instance
+ * @param      data  data pointer
+ * @param      size  data size in bytes
+ */
+void hash_update(Hash* hash, const void* data, size_t size);
+
+/** Get digest and reset context
+ *
+ * @param      hash    Hash instance
+ * @param      digest  output buffer, at least hash_get_digest_size bytes
+ *
+ * @return     digest size in bytes
+ */
+size_t hash_finish(Hash* hash, uint8_t* digest);
+
+/** Get CRC-32 of data fed so far, without resetting context
+ *
+ * Result is the same as of crc32_calc_buffer.
+ *
+ * @param      hash  Hash instance, HashTypeCrc32 only
+ *
+ * @return     CRC-32 value
+ */
+uint32_t hash_get_crc32(Hash* hash);
+
+/** Feed file contents, from current position to the end of file
+ *
+ * @param      hash         Hash instance
+ * @param      file         opened File instance
+ * @param      callback     optional progress callback
+ * @param      context      callback context
+ *
+ * @return     true if whole file was read
+ */
+bool hash_update_file(Hash* hash, File* file, HashProgressCallback callback, void* context);
+
+/** Copy file contents, from current position to the end of file, feeding it
+ * to hash on the way, so data is read only once
+ *
+ * @param      hash         Hash instance
+ * @param      source       opened File instance to read from
+ * @param      destination  opened File instance to write to
+ *
+ * @return     true if whole file was copied
+ */
+bool hash_copy_file(Hash* hash, File* source, File* destination);
+
+/** Format digest as lowercase hex string
+ *
+ * @param      digest  digest bytes
+ * @param      size    digest size
+ * @param      output  FuriString to store result
+ */
+void hash_digest_to_string(const uint8_t* digest, size_t size, FuriString* output);
+
+#ifdef __cplusplus
+}
+#endif
@@ -43,10 +43,14 @@ const StreamVTable buffered_file_stream_vtable = {
 };
 
 Stream* buffered_file_stream_alloc(Storage* storage) {
+    return buffered_file_stream_alloc_ex(storage, STREAM_CACHE_DEFAULT_SIZE);
+}
+
+Stream* buffered_file_stream_alloc_ex(Storage* storage, size_t cache_size) {
     BufferedFileStream* stream = malloc(sizeof(BufferedFileStream));
 
     stream->file_stream = file_stream_alloc(storage);
-    stream->cache = stream_cache_alloc();
+    stream->cache = stream_cache_alloc_ex(cache_size);
     stream->sync_pending = false;
 
     stream->stream_base.vtable = &buffered_file_stream_vtable;
@@ -140,6 +144,12 @@ static bool buffered_file_stream_seek(
     if((new_offset != 0) || (offset_type != StreamOffsetFromCurrent)) {
         if(stream->sync_pending) {
             success = buffered_file_stream_sync((Stream*)stream);
+        } else if(
+            (offset_type == StreamOffsetFromCurrent) && (offset < 0) &&
+            ((size_t)-offset <= stream_cache_capacity(stream->cache))) {
+            // Short step back, like read_line giving back bytes past the end of line
+            // across a fill: reading goes on from there, keep the window
+            stream_cache_discard(stream->cache);
         } else {
             stream_cache_drop(stream->cache);
         }
@@ -200,6 +210,13 @@ static size_t buffered_file_stream_read(BufferedFileStream* stream, uint8_t* dat
             if(stream->sync_pending) {
                 if(!buffered_file_stream_flush(stream)) break;
             }
+            if(need_to_read >= stream_cache_capacity(stream->cache)) {
+                // Cache is exhausted and would not fit the rest anyway, read it directly
+                stream_cache_drop(stream->cache);
+                need_to_read -= stream_read(
+                    stream->file_stream, data + (size - need_to_read), need_to_read);
+                break;
+            }
             if(!stream_cache_fill(stream->cache, stream->file_stream)) break;
         }
     }
@@ -13,6 +13,16 @@ extern "C" {
  */
 Stream* buffered_file_stream_alloc(Storage* storage);
 
+/**
+ * Allocate a file stream with buffered read operations and custom cache size.
+ * While file is read sequentially, cache is filled in growing chunks up to
+ * cache_size, so random access does not pay for reading the whole cache.
+ * @param storage pointer to Storage instance
+ * @param cache_size cache size in bytes
+ * @return Stream*
+ */
+Stream* buffered_file_stream_alloc_ex(Storage* storage, size_t cache_size);
+
 /**
  * Opens an existing file or creates a new one.
  * @param stream pointer to file stream object.
@@ -5,6 +5,7 @@
 #include <core/common_defines.h>
 
 #define STREAM_BUFFER_SIZE (32U)
+#define STREAM_READ_LINE_BUFFER_SIZE (64U)
 
 void stream_free(Stream* stream) {
     furi_assert(stream);
@@ -145,33 +146,55 @@ static bool stream_write_struct(Stream* stream, const void* context) {
     return (stream_write(stream, write_data->data, write_data->size) == write_data->size);
 }
 
+/* Append line chunk to string, dropping CR. Chunk must be followed by one
+ * writable byte, it is used for temporary string terminator. */
+static void stream_read_line_append(FuriString* str_result, uint8_t* data, size_t size) {
+    while(size) {
+        uint8_t* carriage_return = memchr(data, '\r', size);
+        size_t span = carriage_return ? (size_t)(carriage_return - data) : size;
+
+        if(span) {
+            const uint8_t terminator_backup = data[span];
+            data[span] = '\0';
+            if(strlen((const char*)data) == span) {
+                furi_string_cat_str(str_result, (const char*)data);
+            } else {
+                // Binary zeroes in line, slow path
+                for(size_t i = 0; i < span; i++) {
+                    furi_string_push_back(str_result, data[i]);
+                }
+            }
+            data[span] = terminator_backup;
+        }
+
+        if(carriage_return) {
+            span++;
+        }
+        data += span;
+        size -= span;
+    }
+}
+
 bool stream_read_line(Stream* stream, FuriString* str_result) {
     furi_string_reset(str_result);
-    uint8_t buffer[STREAM_BUFFER_SIZE];
+    uint8_t buffer[STREAM_READ_LINE_BUFFER_SIZE + 1];
 
     do {
-        uint16_t bytes_were_read = stream_read(stream, buffer, STREAM_BUFFER_SIZE);
+        size_t bytes_were_read = stream_read(stream, buffer, STREAM_READ_LINE_BUFFER_SIZE);
         if(bytes_were_read == 0) break;
 
-        bool result = false;
-        bool error = false;
-        for(uint16_t i = 0; i < bytes_were_read; i++) {
-            if(buffer[i] == '\n') {
-                if(!stream_seek(stream, i - bytes_were_read + 1, StreamOffsetFromCurrent)) {
-                    error = true;
-                    break;
-                }
-                furi_string_push_back(str_result, buffer[i]);
-                result = true;
-                break;
-            } else if(buffer[i] == '\r') {
-                // Ignore
-            } else {
-                furi_string_push_back(str_result, buffer[i]);
+        uint8_t* line_feed = memchr(buffer, '\n', bytes_were_read);
+        size_t line_size = line_feed ? (size_t)(line_feed - buffer) + 1 : bytes_were_read;
+        stream_read_line_append(str_result, buffer, line_size);
+
+        if(line_feed) {
+            // Give back bytes read past the end of line
+            if(line_size < bytes_were_read) {
+                stream_seek(
+                    stream,
+                    (int32_t)line_size - (int32_t)bytes_were_read,
+                    StreamOffsetFromCurrent);
             }
-        }
-
-        if(result || error) {
             break;
         }
     } while(true);
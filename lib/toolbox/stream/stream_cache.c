@@ -1,29 +1,46 @@
 #include "stream_cache.h"
 
-#define STREAM_CACHE_MAX_SIZE 1024U
-
 struct StreamCache {
-    uint8_t data[STREAM_CACHE_MAX_SIZE];
+    uint8_t* data;
     size_t data_size;
     size_t position;
+    size_t capacity;
+    size_t window; /**< Size of next fill, grows on sequential reads */
 };
 
 StreamCache* stream_cache_alloc() {
+    return stream_cache_alloc_ex(STREAM_CACHE_DEFAULT_SIZE);
+}
+
+StreamCache* stream_cache_alloc_ex(size_t capacity) {
+    furi_check(capacity > 0);
     StreamCache* cache = malloc(sizeof(StreamCache));
+    cache->data = malloc(capacity);
     cache->data_size = 0;
     cache->position = 0;
+    cache->capacity = capacity;
+    cache->window = MIN(capacity, STREAM_CACHE_DEFAULT_SIZE);
     return cache;
 }
+
 void stream_cache_free(StreamCache* cache) {
     furi_assert(cache);
     cache->data_size = 0;
     cache->position = 0;
+    free(cache->data);
     free(cache);
 }
 
 void stream_cache_drop(StreamCache* cache) {
     cache->data_size = 0;
     cache->position = 0;
+    // Cache is dropped on seek and before write: access is not sequential anymore
+    cache->window = MIN(cache->capacity, STREAM_CACHE_DEFAULT_SIZE);
+}
+
+void stream_cache_discard(StreamCache* cache) {
+    cache->data_size = 0;
+    cache->position = 0;
 }
 
 bool stream_cache_at_end(StreamCache* cache) {
@@ -39,8 +56,17 @@ size_t stream_cache_pos(StreamCache* cache) {
     return cache->position;
 }
 
+size_t stream_cache_capacity(StreamCache* cache) {
+    return cache->capacity;
+}
+
 size_t stream_cache_fill(StreamCache* cache, Stream* stream) {
-    const size_t size_read = stream_read(stream, cache->data, STREAM_CACHE_MAX_SIZE);
+    // Previous fill was consumed to the end without seeks: reading is sequential
+    if((cache->data_size > 0) && (cache->position == cache->data_size)) {
+        cache->window = MIN(cache->window * 2, cache->capacity);
+    }
+
+    const size_t size_read = stream_read(stream, cache->data, cache->window);
     cache->data_size = size_read;
     cache->position = 0;
     return size_read;
@@ -66,7 +92,7 @@ size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size) {
 
 size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size) {
     furi_assert(cache->data_size >= cache->position);
-    const size_t size_written = MIN(size, STREAM_CACHE_MAX_SIZE - cache->position);
+    const size_t size_written = MIN(size, cache->capacity - cache->position);
     if(size_written > 0) {
         memcpy(cache->data + cache->position, data, size_written);
         cache->position += size_written;
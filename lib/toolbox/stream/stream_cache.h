@@ -6,14 +6,26 @@
 extern "C" {
 #endif
 
+/** Default cache size, also initial read window of bigger caches */
+#define STREAM_CACHE_DEFAULT_SIZE 1024U
+
 typedef struct StreamCache StreamCache;
 
 /**
- * Allocate stream cache.
+ * Allocate stream cache of default size.
  * @return StreamCache* pointer to a StreamCache instance
  */
 StreamCache* stream_cache_alloc();
 
+/**
+ * Allocate stream cache of given size.
+ * Reads start with default size window, which doubles on every sequential
+ * fill until whole cache is used. Dropping the cache resets the window.
+ * @param capacity Cache size in bytes
+ * @return StreamCache* pointer to a StreamCache instance
+ */
+StreamCache* stream_cache_alloc_ex(size_t capacity);
+
 /**
  * Free stream cache.
  * @param cache Pointer to a StreamCache instance
@@ -26,6 +38,12 @@ void stream_cache_free(StreamCache* cache);
  */
 void stream_cache_drop(StreamCache* cache);
 
+/**
+ * Drop the cache contents, keep read window: reading stays sequential.
+ * @param cache Pointer to a StreamCache instance
+ */
+void stream_cache_discard(StreamCache* cache);
+
 /**
  * Determine if the internal cursor is at end the end of cached data.
  * @param cache Pointer to a StreamCache instance
@@ -47,6 +65,13 @@ size_t stream_cache_size(StreamCache* cache);
  */
 size_t stream_cache_pos(StreamCache* cache);
 
+/**
+ * Get the cache capacity.
+ * @param cache Pointer to a StreamCache instance
+ * @return Maximum size of cached data.
+ */
+size_t stream_cache_capacity(StreamCache* cache);
+
 /**
  * Load the cache with new data from a stream.
  * @param cache Pointer to a StreamCache instance
@@ -1,22 +1,31 @@
 #include "tar_archive.h"
+#include "tar_archive_pipe.h"
 
 #include <microtar.h>
 #include <storage/storage.h>
 #include <furi.h>
 #include <toolbox/path.h>
+#include <toolbox/dir_walk.h>
+#include <lib/heatshrink/heatshrink_decoder.h>
 
 #define TAG "TarArch"
-#define MAX_NAME_LEN 255
-#define FILE_BLOCK_SIZE 512
 
 #define FILE_OPEN_NTRIES 10
 #define FILE_OPEN_RETRY_DELAY 25
 
+/* Must match parameters used by packer, see scripts/update.py */
+#define HEATSHRINK_INPUT_BUFFER_SIZE 512
+#define HEATSHRINK_WINDOW_SIZE_LOG 8
+#define HEATSHRINK_LOOKAHEAD_SIZE_LOG 4
+
 typedef struct TarArchive {
     Storage* storage;
     mtar_t tar;
     tar_unpack_file_cb unpack_cb;
     void* unpack_cb_context;
+    TarArchiveStats stats;
+    /* Shared by all members extracted in one go */
+    TarArchivePipe* extract_pipe;
 } TarArchive;
 
 /* API WRAPPER */
@@ -55,6 +64,9 @@ TarArchive* tar_archive_alloc(Storage* storage) {
     TarArchive* archive = malloc(sizeof(TarArchive));
     archive->storage = storage;
     archive->unpack_cb = NULL;
+    archive->stats.bytes_processed = 0;
+    archive->stats.time_ms = 0;
+    archive->extract_pipe = NULL;
     return archive;
 }
 
@@ -97,6 +109,27 @@ void tar_archive_free(TarArchive* archive) {
     free(archive);
 }
 
+void tar_archive_get_stats(TarArchive* archive, TarArchiveStats* stats) {
+    furi_assert(archive);
+    furi_assert(stats);
+    *stats = archive->stats;
+}
+
+void tar_archive_log_stats(TarArchive* archive, const char* operation) {
+    furi_assert(archive);
+    furi_assert(operation);
+    /* bytes per millisecond == kB/s */
+    uint32_t kbps = archive->stats.bytes_processed / MAX(archive->stats.time_ms, 1UL);
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu bytes in %lu ms, %lu.%02lu MB/s",
+        operation,
+        archive->stats.bytes_processed,
+        archive->stats.time_ms,
+        kbps / 1000,
+        (kbps % 1000) / 10);
+}
+
 void tar_archive_set_file_callback(TarArchive* archive, tar_unpack_file_cb callback, void* context) {
     furi_assert(archive);
     archive->unpack_cb = callback;
@@ -169,10 +202,118 @@ typedef struct {
     Storage_name_converter converter;
 } TarArchiveDirectoryOpParams;
 
-static bool archive_extract_current_file(TarArchive* archive, const char* dst_path) {
+static void tar_archive_account(TarArchive* archive, uint32_t bytes, uint32_t start_tick) {
+    archive->stats.bytes_processed += bytes;
+    archive->stats.time_ms += furi_get_tick() - start_tick;
+}
+
+bool tar_archive_is_compressed_name(const char* name) {
+    size_t name_len = strlen(name);
+    size_t suffix_len = strlen(TAR_ARCHIVE_COMPRESSED_SUFFIX);
+    return (name_len > suffix_len) &&
+           (strcmp(&name[name_len - suffix_len], TAR_ARCHIVE_COMPRESSED_SUFFIX) == 0);
+}
+
+/* Moves decoded data into pipe buffers, acquiring new ones as they fill up */
+static bool tar_archive_drain_decoder(
+    heatshrink_decoder* decoder,
+    TarArchivePipe* pipe,
+    TarArchivePipeBuffer** out_buffer,
+    uint32_t* bytes_written) {
+    HSD_poll_res poll_res;
+    do {
+        TarArchivePipeBuffer* buffer = *out_buffer;
+        size_t poll_size = 0;
+        poll_res = heatshrink_decoder_poll(
+            decoder,
+            &buffer->data[buffer->size],
+            TAR_ARCHIVE_PIPE_BUFFER_SIZE - buffer->size,
+            &poll_size);
+        if(poll_res < 0) {
+            return false;
+        }
+        buffer->size += poll_size;
+        *bytes_written += poll_size;
+        if(buffer->size == TAR_ARCHIVE_PIPE_BUFFER_SIZE) {
+            /* Committed buffer is worker's even on failure */
+            *out_buffer = NULL;
+            if(!tar_archive_pipe_commit(pipe, buffer)) {
+                return false;
+            }
+            *out_buffer = tar_archive_pipe_acquire(pipe);
+        }
+    } while(poll_res == HSDR_POLL_MORE);
+    return true;
+}
+
+static bool archive_extract_current_data_compressed(
+    TarArchive* archive,
+    TarArchivePipe* pipe,
+    uint32_t* bytes_written) {
     mtar_t* tar = &archive->tar;
+    uint8_t* readbuf = malloc(HEATSHRINK_INPUT_BUFFER_SIZE);
+    heatshrink_decoder* decoder = heatshrink_decoder_alloc(
+        HEATSHRINK_INPUT_BUFFER_SIZE, HEATSHRINK_WINDOW_SIZE_LOG, HEATSHRINK_LOOKAHEAD_SIZE_LOG);
+    TarArchivePipeBuffer* out_buffer = tar_archive_pipe_acquire(pipe);
+
+    bool success = true;
+    while(success && !mtar_eof_data(tar)) {
+        int32_t readcnt = mtar_read_data(tar, readbuf, HEATSHRINK_INPUT_BUFFER_SIZE);
+        if(readcnt <= 0) {
+            success = false;
+            break;
+        }
+
+        size_t sunk = 0;
+        while(success && (sunk < (size_t)readcnt)) {
+            size_t sink_size = 0;
+            if(heatshrink_decoder_sink(decoder, &readbuf[sunk], readcnt - sunk, &sink_size) < 0) {
+                success = false;
+                break;
+            }
+            sunk += sink_size;
+            success = tar_archive_drain_decoder(decoder, pipe, &out_buffer, bytes_written);
+        }
+    }
+
+    while(success && (heatshrink_decoder_finish(decoder) == HSDR_FINISH_MORE)) {
+        success = tar_archive_drain_decoder(decoder, pipe, &out_buffer, bytes_written);
+    }
+
+    /* Partially filled (or empty) tail buffer must be returned to pipe anyway */
+    if(out_buffer) {
+        success = tar_archive_pipe_commit(pipe, out_buffer) && success;
+    }
+    heatshrink_decoder_free(decoder);
+    free(readbuf);
+    return success;
+}
+
+static bool archive_extract_current_data(
+    TarArchive* archive,
+    TarArchivePipe* pipe,
+    uint32_t* bytes_written) {
+    mtar_t* tar = &archive->tar;
+    bool success = true;
+    while(!mtar_eof_data(tar)) {
+        /* Read straight into pipe buffer, worker writes previous one meanwhile */
+        TarArchivePipeBuffer* buffer = tar_archive_pipe_acquire(pipe);
+        int32_t readcnt = mtar_read_data(tar, buffer->data, TAR_ARCHIVE_PIPE_BUFFER_SIZE);
+        buffer->size = (readcnt > 0) ? readcnt : 0;
+        *bytes_written += buffer->size;
+        if(!tar_archive_pipe_commit(pipe, buffer) || (readcnt <= 0)) {
+            success = false;
+            break;
+        }
+    }
+    return success;
+}
+
+static bool
+    archive_extract_current_file(TarArchive* archive, const char* dst_path, bool compressed) {
     File* out_file = storage_file_alloc(archive->storage);
-    uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
+    uint32_t start_tick = furi_get_tick();
+    uint32_t bytes_written = 0;
 
     bool success = true;
     uint8_t n_tries = FILE_OPEN_NTRIES;
@@ -191,16 +332,19 @@ static bool archive_extract_current_file(TarArchive* archive, const char* dst_pa
             break;
         }
 
-        while(!mtar_eof_data(tar)) {
-            int32_t readcnt = mtar_read_data(tar, readbuf, FILE_BLOCK_SIZE);
-            if(!readcnt || !storage_file_write(out_file, readbuf, readcnt)) {
-                success = false;
-                break;
-            }
+        TarArchivePipe* pipe = archive->extract_pipe;
+        tar_archive_pipe_set_file(pipe, out_file);
+        if(compressed) {
+            success = archive_extract_current_data_compressed(archive, pipe, &bytes_written);
+        } else {
+            success = archive_extract_current_data(archive, pipe, &bytes_written);
         }
+        /* Nothing may be left in flight once file is closed */
+        success = tar_archive_pipe_flush(pipe) && success;
     } while(false);
+
+    tar_archive_account(archive, bytes_written, start_tick);
     storage_file_free(out_file);
-    free(readbuf);
 
     return success;
 }
@@ -240,6 +384,12 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     FURI_LOG_D(TAG, "Extracting %u bytes to '%s'", header->size, header->name);
 
     FuriString* converted_fname = furi_string_alloc_set(header->name);
+    bool compressed = tar_archive_is_compressed_name(header->name);
+    if(compressed) {
+        furi_string_left(
+            converted_fname,
+            furi_string_size(converted_fname) - strlen(TAR_ARCHIVE_COMPRESSED_SUFFIX));
+    }
     if(op_params->converter) {
         op_params->converter(converted_fname);
     }
@@ -247,8 +397,8 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     full_extracted_fname = furi_string_alloc();
     path_concat(op_params->work_dir, furi_string_get_cstr(converted_fname), full_extracted_fname);
 
-    bool success =
-        archive_extract_current_file(archive, furi_string_get_cstr(full_extracted_fname));
+    bool success = archive_extract_current_file(
+        archive, furi_string_get_cstr(full_extracted_fname), compressed);
 
     furi_string_free(converted_fname);
     furi_string_free(full_extracted_fname);
@@ -268,7 +418,13 @@ bool tar_archive_unpack_to(
 
     FURI_LOG_I(TAG, "Restoring '%s'", destination);
 
-    return (mtar_foreach(&archive->tar, archive_extract_foreach_cb, &param) == MTAR_ESUCCESS);
+    archive->extract_pipe = tar_archive_pipe_alloc(NULL, TarArchivePipeModeWrite);
+    bool success =
+        (mtar_foreach(&archive->tar, archive_extract_foreach_cb, &param) == MTAR_ESUCCESS);
+    tar_archive_pipe_free(archive->extract_pipe);
+    archive->extract_pipe = NULL;
+
+    return success;
 };
 
 bool tar_archive_add_file(
@@ -277,9 +433,10 @@ bool tar_archive_add_file(
     const char* archive_fname,
     const int32_t file_size) {
     furi_assert(archive);
-    uint8_t* file_buffer = malloc(FILE_BLOCK_SIZE);
     bool success = false;
     File* src_file = storage_file_alloc(archive->storage);
+    uint32_t start_tick = furi_get_tick();
+    uint32_t bytes_read = 0;
     uint8_t n_tries = FILE_OPEN_NTRIES;
     do {
         while(n_tries-- > 0) {
@@ -297,60 +454,65 @@ bool tar_archive_add_file(
         }
 
         success = true; // if file is empty, that's not an error
-        uint16_t bytes_read = 0;
-        while((bytes_read = storage_file_read(src_file, file_buffer, FILE_BLOCK_SIZE))) {
-            success = tar_archive_file_add_data_block(archive, file_buffer, bytes_read);
-            if(!success) {
+        /* Worker reads next chunk from source while current one goes to archive */
+        TarArchivePipe* pipe = tar_archive_pipe_alloc(src_file, TarArchivePipeModeRead);
+        while(true) {
+            TarArchivePipeBuffer* buffer = tar_archive_pipe_receive(pipe);
+            bool last = buffer->last;
+            if(buffer->size) {
+                success = tar_archive_file_add_data_block(archive, buffer->data, buffer->size);
+                bytes_read += buffer->size;
+            }
+            tar_archive_pipe_release(pipe, buffer);
+            if(!success || last) {
                 break;
             }
         }
+        success = success && !tar_archive_pipe_has_error(pipe);
+        tar_archive_pipe_free(pipe);
 
         success = success && tar_archive_file_finalize(archive);
     } while(false);
 
+    tar_archive_account(archive, bytes_read, start_tick);
     storage_file_free(src_file);
-    free(file_buffer);
     return success;
 }
 
 bool tar_archive_add_dir(TarArchive* archive, const char* fs_full_path, const char* path_prefix) {
     furi_assert(archive);
     furi_check(path_prefix);
-    File* directory = storage_file_alloc(archive->storage);
+    DirWalk* dir_walk = dir_walk_alloc(archive->storage);
+    FuriString* element_fs_abs_path = furi_string_alloc();
+    FuriString* element_name = furi_string_alloc();
     FileInfo file_info;
 
     FURI_LOG_I(TAG, "Backing up '%s', '%s'", fs_full_path, path_prefix);
-    char* name = malloc(MAX_NAME_LEN);
+    const size_t fs_path_length = strlen(fs_full_path) + 1;
     bool success = false;
 
     do {
-        if(!storage_dir_open(directory, fs_full_path)) {
+        if(!dir_walk_open(dir_walk, fs_full_path)) {
             break;
         }
 
+        // Pre-order: directory header goes before its contents
         while(true) {
-            if(!storage_dir_read(directory, &file_info, name, MAX_NAME_LEN)) {
-                success = true; /* empty dir / no more files */
+            DirWalkResult result = dir_walk_read(dir_walk, element_fs_abs_path, &file_info);
+            if(result != DirWalkOK) {
+                success = (result == DirWalkLast); /* no more files */
                 break;
             }
 
-            FuriString* element_name = furi_string_alloc();
-            FuriString* element_fs_abs_path = furi_string_alloc();
-
-            path_concat(fs_full_path, name, element_fs_abs_path);
+            const char* relative_path = furi_string_get_cstr(element_fs_abs_path) + fs_path_length;
             if(strlen(path_prefix)) {
-                path_concat(path_prefix, name, element_name);
+                path_concat(path_prefix, relative_path, element_name);
             } else {
-                furi_string_set(element_name, name);
+                furi_string_set(element_name, relative_path);
             }
 
             if(file_info_is_dir(&file_info)) {
-                success =
-                    tar_archive_dir_add_element(archive, furi_string_get_cstr(element_name)) &&
-                    tar_archive_add_dir(
-                        archive,
-                        furi_string_get_cstr(element_fs_abs_path),
-                        furi_string_get_cstr(element_name));
+                success = tar_archive_dir_add_element(archive, furi_string_get_cstr(element_name));
             } else {
                 success = tar_archive_add_file(
                     archive,
@@ -358,8 +520,6 @@ bool tar_archive_add_dir(TarArchive* archive, const char* fs_full_path, const ch
                     furi_string_get_cstr(element_name),
                     file_info.size);
             }
-            furi_string_free(element_name);
-            furi_string_free(element_fs_abs_path);
 
             if(!success) {
                 break;
@@ -367,8 +527,9 @@ bool tar_archive_add_dir(TarArchive* archive, const char* fs_full_path, const ch
         }
     } while(false);
 
-    free(name);
-    storage_file_free(directory);
+    furi_string_free(element_name);
+    furi_string_free(element_fs_abs_path);
+    dir_walk_free(dir_walk);
     return success;
 }
 
@@ -382,5 +543,12 @@ bool tar_archive_unpack_file(
     if(mtar_find(&archive->tar, archive_fname) != MTAR_ESUCCESS) {
         return false;
     }
-    return archive_extract_current_file(archive, destination);
+
+    archive->extract_pipe = tar_archive_pipe_alloc(NULL, TarArchivePipeModeWrite);
+    bool success = archive_extract_current_file(
+        archive, destination, tar_archive_is_compressed_name(archive_fname));
+    tar_archive_pipe_free(archive->extract_pipe);
+    archive->extract_pipe = NULL;
+
+    return success;
 }
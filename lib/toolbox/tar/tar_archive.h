@@ -10,6 +10,15 @@ extern "C" {
 
 typedef struct TarArchive TarArchive;
 
+/** Suffix of members holding heatshrink-compressed data, stripped on unpacking */
+#define TAR_ARCHIVE_COMPRESSED_SUFFIX ".hs"
+
+/** Data transfer statistics, accumulated over archive lifetime */
+typedef struct {
+    uint32_t bytes_processed; /**< Payload bytes moved between archive and filesystem */
+    uint32_t time_ms; /**< Time spent moving them */
+} TarArchiveStats;
+
 typedef struct Storage Storage;
 
 typedef enum {
@@ -45,6 +54,15 @@ bool tar_archive_unpack_file(
     const char* archive_fname,
     const char* destination);
 
+/* Get data transfer statistics for throughput reporting */
+void tar_archive_get_stats(TarArchive* archive, TarArchiveStats* stats);
+
+/* Log data transfer statistics as size, time and throughput, prefixed with operation name */
+void tar_archive_log_stats(TarArchive* archive, const char* operation);
+
+/* Check if archive member name denotes heatshrink-compressed data */
+bool tar_archive_is_compressed_name(const char* name);
+
 /* Optional per-entry callback on unpacking - return false to skip entry */
 typedef bool (*tar_unpack_file_cb)(const char* name, bool is_directory, void* context);
 
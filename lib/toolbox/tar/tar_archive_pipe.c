@@ -0,0 +1,173 @@
+#include "tar_archive_pipe.h"
+
+#include <furi.h>
+
+#define TAG "TarPipe"
+
+#define TAR_ARCHIVE_PIPE_STACK_SIZE (2048)
+#define TAR_ARCHIVE_PIPE_BUFFER_ALIGNMENT (32)
+
+struct TarArchivePipe {
+    File* file;
+    TarArchivePipeMode mode;
+    FuriThread* thread;
+    /* Both queues carry TarArchivePipeBuffer pointers, NULL stops the worker */
+    FuriMessageQueue* empty_queue;
+    FuriMessageQueue* full_queue;
+    TarArchivePipeBuffer buffers[TAR_ARCHIVE_PIPE_BUFFER_COUNT];
+    volatile bool error;
+};
+
+static void tar_archive_pipe_put(FuriMessageQueue* queue, TarArchivePipeBuffer* buffer) {
+    furi_check(furi_message_queue_put(queue, &buffer, FuriWaitForever) == FuriStatusOk);
+}
+
+static TarArchivePipeBuffer* tar_archive_pipe_get(FuriMessageQueue* queue) {
+    TarArchivePipeBuffer* buffer = NULL;
+    furi_check(furi_message_queue_get(queue, &buffer, FuriWaitForever) == FuriStatusOk);
+    return buffer;
+}
+
+static void tar_archive_pipe_worker_write(TarArchivePipe* pipe) {
+    TarArchivePipeBuffer* buffer;
+    while((buffer = tar_archive_pipe_get(pipe->full_queue))) {
+        /* After first failure keep draining buffers, so producer never blocks */
+        if(!pipe->error && buffer->size) {
+            if(storage_file_write(pipe->file, buffer->data, buffer->size) != buffer->size) {
+                FURI_LOG_E(TAG, "Write failed");
+                pipe->error = true;
+            }
+        }
+        buffer->size = 0;
+        tar_archive_pipe_put(pipe->empty_queue, buffer);
+    }
+}
+
+static void tar_archive_pipe_worker_read(TarArchivePipe* pipe) {
+    bool eof = false;
+    TarArchivePipeBuffer* buffer;
+    while(!eof && (buffer = tar_archive_pipe_get(pipe->empty_queue))) {
+        buffer->size = storage_file_read(pipe->file, buffer->data, TAR_ARCHIVE_PIPE_BUFFER_SIZE);
+        if(storage_file_get_error(pipe->file) != FSE_OK) {
+            FURI_LOG_E(TAG, "Read failed");
+            pipe->error = true;
+        }
+        eof = pipe->error || (buffer->size < TAR_ARCHIVE_PIPE_BUFFER_SIZE);
+        buffer->last = eof;
+        tar_archive_pipe_put(pipe->full_queue, buffer);
+    }
+}
+
+static int32_t tar_archive_pipe_worker(void* context) {
+    TarArchivePipe* pipe = context;
+    if(pipe->mode == TarArchivePipeModeWrite) {
+        tar_archive_pipe_worker_write(pipe);
+    } else {
+        tar_archive_pipe_worker_read(pipe);
+    }
+    return 0;
+}
+
+TarArchivePipe* tar_archive_pipe_alloc(File* file, TarArchivePipeMode mode) {
+    furi_assert(file || mode == TarArchivePipeModeWrite);
+    TarArchivePipe* pipe = malloc(sizeof(TarArchivePipe));
+    pipe->file = file;
+    pipe->mode = mode;
+    pipe->error = false;
+
+    /* One extra slot for the stop marker */
+    const uint32_t queue_size = TAR_ARCHIVE_PIPE_BUFFER_COUNT + 1;
+    pipe->empty_queue = furi_message_queue_alloc(queue_size, sizeof(TarArchivePipeBuffer*));
+    pipe->full_queue = furi_message_queue_alloc(queue_size, sizeof(TarArchivePipeBuffer*));
+
+    for(size_t i = 0; i < TAR_ARCHIVE_PIPE_BUFFER_COUNT; i++) {
+        TarArchivePipeBuffer* buffer = &pipe->buffers[i];
+        buffer->data =
+            aligned_malloc(TAR_ARCHIVE_PIPE_BUFFER_SIZE, TAR_ARCHIVE_PIPE_BUFFER_ALIGNMENT);
+        buffer->size = 0;
+        buffer->last = false;
+        tar_archive_pipe_put(pipe->empty_queue, buffer);
+    }
+
+    pipe->thread = furi_thread_alloc_ex(
+        "TarArchivePipe", TAR_ARCHIVE_PIPE_STACK_SIZE, tar_archive_pipe_worker, pipe);
+    furi_thread_start(pipe->thread);
+
+    return pipe;
+}
+
+void tar_archive_pipe_free(TarArchivePipe* pipe) {
+    furi_assert(pipe);
+
+    /* Reader waits for empty buffers, writer waits for filled ones */
+    tar_archive_pipe_put(
+        (pipe->mode == TarArchivePipeModeWrite) ? pipe->full_queue : pipe->empty_queue, NULL);
+    furi_thread_join(pipe->thread);
+    furi_thread_free(pipe->thread);
+
+    for(size_t i = 0; i < TAR_ARCHIVE_PIPE_BUFFER_COUNT; i++) {
+        aligned_free(pipe->buffers[i].data);
+    }
+
+    furi_message_queue_free(pipe->empty_queue);
+    furi_message_queue_free(pipe->full_queue);
+    free(pipe);
+}
+
+void tar_archive_pipe_set_file(TarArchivePipe* pipe, File* file) {
+    furi_assert(pipe);
+    furi_assert(file);
+    furi_assert(pipe->mode == TarArchivePipeModeWrite);
+    /* Worker only touches file while it has a buffer, flushed pipe has none */
+    pipe->file = file;
+    pipe->error = false;
+}
+
+TarArchivePipeBuffer* tar_archive_pipe_acquire(TarArchivePipe* pipe) {
+    furi_assert(pipe);
+    furi_assert(pipe->mode == TarArchivePipeModeWrite);
+    return tar_archive_pipe_get(pipe->empty_queue);
+}
+
+bool tar_archive_pipe_commit(TarArchivePipe* pipe, TarArchivePipeBuffer* buffer) {
+    furi_assert(pipe);
+    furi_assert(buffer);
+    furi_assert(pipe->mode == TarArchivePipeModeWrite);
+    tar_archive_pipe_put(pipe->full_queue, buffer);
+    return !pipe->error;
+}
+
+bool tar_archive_pipe_flush(TarArchivePipe* pipe) {
+    furi_assert(pipe);
+    furi_assert(pipe->mode == TarArchivePipeModeWrite);
+
+    /* All buffers are back in empty queue only when worker is idle */
+    TarArchivePipeBuffer* buffers[TAR_ARCHIVE_PIPE_BUFFER_COUNT];
+    for(size_t i = 0; i < TAR_ARCHIVE_PIPE_BUFFER_COUNT; i++) {
+        buffers[i] = tar_archive_pipe_get(pipe->empty_queue);
+    }
+    for(size_t i = 0; i < TAR_ARCHIVE_PIPE_BUFFER_COUNT; i++) {
+        tar_archive_pipe_put(pipe->empty_queue, buffers[i]);
+    }
+
+    return !pipe->error;
+}
+
+TarArchivePipeBuffer* tar_archive_pipe_receive(TarArchivePipe* pipe) {
+    furi_assert(pipe);
+    furi_assert(pipe->mode == TarArchivePipeModeRead);
+    return tar_archive_pipe_get(pipe->full_queue);
+}
+
+void tar_archive_pipe_release(TarArchivePipe* pipe, TarArchivePipeBuffer* buffer) {
+    furi_assert(pipe);
+    furi_assert(buffer);
+    furi_assert(pipe->mode == TarArchivePipeModeRead);
+    buffer->size = 0;
+    tar_archive_pipe_put(pipe->empty_queue, buffer);
+}
+
+bool tar_archive_pipe_has_error(TarArchivePipe* pipe) {
+    furi_assert(pipe);
+    return pipe->error;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file tar_archive_pipe.h
+ * Double-buffered file I/O pipe used by TarArchive
+ *
+ * Pipe owns a small set of I/O buffers and a worker thread that moves them
+ * to or from a file, so storage latency overlaps with archive processing on
+ * the caller side.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of a single pipe buffer, multiple of tar block size */
+#define TAR_ARCHIVE_PIPE_BUFFER_SIZE (8 * 512)
+
+/** Number of buffers in flight */
+#define TAR_ARCHIVE_PIPE_BUFFER_COUNT (2)
+
+typedef struct TarArchivePipe TarArchivePipe;
+
+typedef enum {
+    TarArchivePipeModeWrite, /**< Caller fills buffers, worker writes them to file */
+    TarArchivePipeModeRead, /**< Worker reads file into buffers, caller consumes them */
+} TarArchivePipeMode;
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    bool last; /**< Read mode: no more buffers will follow */
+} TarArchivePipeBuffer;
+
+/** Allocate pipe and start worker thread
+ *
+ * @param      file  opened File instance, must outlive the pipe, can be NULL
+ *                   in write mode, see tar_archive_pipe_set_file
+ * @param      mode  pipe direction
+ *
+ * @return     TarArchivePipe instance
+ */
+TarArchivePipe* tar_archive_pipe_alloc(File* file, TarArchivePipeMode mode);
+
+/** Write mode: switch pipe to another file and clear error
+ *
+ * Pipe must be flushed, so one pipe can be used for a number of files.
+ *
+ * @param      pipe  TarArchivePipe instance
+ * @param      file  opened File instance, must stay open while it's used
+ */
+void tar_archive_pipe_set_file(TarArchivePipe* pipe, File* file);
+
+/** Stop worker thread and free pipe
+ *
+ * In write mode, pending buffers are flushed before worker stops.
+ *
+ * @param      pipe  TarArchivePipe instance
+ */
+void tar_archive_pipe_free(TarArchivePipe* pipe);
+
+/** Write mode: get empty buffer, blocks until worker releases one
+ *
+ * @param      pipe  TarArchivePipe instance
+ *
+ * @return     buffer with size set to 0
+ */
+TarArchivePipeBuffer* tar_archive_pipe_acquire(TarArchivePipe* pipe);
+
+/** Write mode: hand filled buffer over to worker
+ *
+ * Buffer belongs to worker after this call, even if false is returned.
+ *
+ * @param      pipe    TarArchivePipe instance
+ * @param      buffer  buffer obtained with tar_archive_pipe_acquire
+ *
+ * @return     false if worker has failed to write any of previous buffers
+ */
+bool tar_archive_pipe_commit(TarArchivePipe* pipe, TarArchivePipeBuffer* buffer);
+
+/** Write mode: wait for all committed buffers to be written
+ *
+ * @param      pipe  TarArchivePipe instance
+ *
+ * @return     true if all data was written
+ */
+bool tar_archive_pipe_flush(TarArchivePipe* pipe);
+
+/** Read mode: get next filled buffer, blocks until worker provides one
+ *
+ * @param      pipe  TarArchivePipe instance
+ *
+ * @return     filled buffer
+ */
+TarArchivePipeBuffer* tar_archive_pipe_receive(TarArchivePipe* pipe);
+
+/** Read mode: return consumed buffer to worker
+ *
+ * @param      pipe    TarArchivePipe instance
+ * @param      buffer  buffer obtained with tar_archive_pipe_receive
+ */
+void tar_archive_pipe_release(TarArchivePipe* pipe, TarArchivePipeBuffer* buffer);
+
+/** Check if worker has encountered storage error
+ *
+ * @param      pipe  TarArchivePipe instance
+ *
+ * @return     true on error
+ */
+bool tar_archive_pipe_has_error(TarArchivePipe* pipe);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,13 +8,11 @@
 #define DFU_SIGNATURE "DfuSe"
 
 bool dfu_file_validate_crc(File* dfuf, const DfuPageTaskProgressCb progress_cb, void* context) {
-    uint32_t file_crc = crc32_calc_file(dfuf, progress_cb, context);
-
     /* Last 4 bytes of DFU file = CRC of previous file contents, inverted
      * If we calculate whole file CRC32, incl. embedded CRC,
      * that should give us 0xFFFFFFFF 
      */
-    return file_crc == VALID_WHOLE_FILE_CRC;
+    return crc32_calc_file_check(dfuf, VALID_WHOLE_FILE_CRC, progress_cb, context);
 }
 
 uint8_t dfu_file_validate_headers(File* dfuf, const DfuValidationParams* reference_params) {
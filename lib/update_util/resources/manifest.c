@@ -3,6 +3,8 @@
 #include <toolbox/stream/buffered_file_stream.h>
 #include <toolbox/hex.h>
 
+#define RESOURCE_MANIFEST_CACHE_SIZE (4 * 1024)
+
 struct ResourceManifestReader {
     Storage* storage;
     Stream* stream;
@@ -14,7 +16,8 @@ ResourceManifestReader* resource_manifest_reader_alloc(Storage* storage) {
     ResourceManifestReader* resource_manifest =
         (ResourceManifestReader*)malloc(sizeof(ResourceManifestReader));
     resource_manifest->storage = storage;
-    resource_manifest->stream = buffered_file_stream_alloc(resource_manifest->storage);
+    resource_manifest->stream =
+        buffered_file_stream_alloc_ex(resource_manifest->storage, RESOURCE_MANIFEST_CACHE_SIZE);
     memset(&resource_manifest->entry, 0, sizeof(ResourceManifestEntry));
     resource_manifest->entry.name = furi_string_alloc();
     resource_manifest->linebuf = furi_string_alloc();
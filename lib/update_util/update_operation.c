@@ -182,8 +182,7 @@ UpdatePrepareResult update_operation_prepare(const char* manifest_file_path) {
             break;
         }
 
-        uint32_t crc = crc32_calc_file(file, NULL, NULL);
-        if(crc != manifest->staged_loader_crc) {
+        if(!crc32_calc_file_check(file, manifest->staged_loader_crc, NULL, NULL)) {
             result = UpdatePrepareResultStageIntegrityError;
             break;
         }
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+
+import os
+
+from flipper.app import App
+from flipper.assets.animation_pack import PACK_FILENAME, AnimationPack
+from flipper.assets.icon import bm2xbm, file2xbm
+from flipper.utils.fff import FlipperFormatFile
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_convert = self.subparsers.add_parser(
+            "convert", help="Convert dolphin animations to frame packs"
+        )
+        self.parser_convert.add_argument(
+            "directory",
+            help="Dolphin directory with manifest.txt: SD card copy or assets source",
+        )
+        self.parser_convert.add_argument(
+            "-r",
+            "--remove-frames",
+            action="store_true",
+            help="Remove frame files after conversion",
+        )
+        self.parser_convert.set_defaults(func=self.convert)
+
+        self.parser_verify = self.subparsers.add_parser(
+            "verify", help="Check that pack matches frame files"
+        )
+        self.parser_verify.add_argument("animation_directory")
+        self.parser_verify.set_defaults(func=self.verify)
+
+    def _animation_names(self, directory: str):
+        file = FlipperFormatFile()
+        file.load(os.path.join(directory, "manifest.txt"))
+        file.getHeader()
+        names = []
+        while True:
+            try:
+                names.append(file.readKey("Name"))
+            except EOFError:
+                break
+        return names
+
+    def _load_geometry(self, animation_directory: str):
+        file = FlipperFormatFile()
+        file.load(os.path.join(animation_directory, "meta.txt"))
+        file.getHeader()
+        return file.readKeyInt("Width"), file.readKeyInt("Height")
+
+    def _load_frames(self, animation_directory: str):
+        frames = []
+        filenames = []
+        while True:
+            base = os.path.join(animation_directory, f"frame_{len(frames)}")
+            if os.path.isfile(base + ".bm"):
+                filenames.append(base + ".bm")
+                with open(filenames[-1], "rb") as file:
+                    frames.append(bm2xbm(file.read()))
+            elif os.path.isfile(base + ".png"):
+                filenames.append(base + ".png")
+                frames.append(file2xbm(filenames[-1]).data)
+            else:
+                break
+        return frames, filenames
+
+    def convert(self):
+        total_before = total_after = total_files = 0
+
+        for name in self._animation_names(self.args.directory):
+            animation_directory = os.path.join(self.args.directory, name)
+            width, height = self._load_geometry(animation_directory)
+            frames, filenames = self._load_frames(animation_directory)
+            if not frames:
+                self.logger.warning(f"{name}: no frame files, skipping")
+                continue
+
+            pack = AnimationPack(width, height)
+            for frame in frames:
+                pack.add_frame(frame)
+            data = pack.pack()
+            with open(os.path.join(animation_directory, PACK_FILENAME), "wb") as file:
+                file.write(data)
+
+            size_before = sum(os.path.getsize(filename) for filename in filenames)
+            self.logger.info(
+                f"{name}: {len(filenames)} files, {size_before} bytes -> {len(data)} bytes"
+            )
+            total_before += size_before
+            total_after += len(data)
+            total_files += len(filenames)
+
+            if self.args.remove_frames:
+                for filename in filenames:
+                    os.remove(filename)
+
+        self.logger.info(
+            f"Total: {total_files} frame files, {total_before} bytes -> {total_after} bytes"
+        )
+        return 0
+
+    def verify(self):
+        with open(
+            os.path.join(self.args.animation_directory, PACK_FILENAME), "rb"
+        ) as file:
+            pack = AnimationPack.unpack(file.read())
+
+        frames, _ = self._load_frames(self.args.animation_directory)
+        if frames != pack.frames:
+            self.logger.error("Pack doesn't match frame files")
+            return 1
+
+        self.logger.info(f"{len(frames)} frames match")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
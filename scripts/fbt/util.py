@@ -60,3 +60,38 @@ def path_as_posix(path):
     if SCons.Platform.platform_default() == "win32":
         return path.replace(os.path.sep, os.path.altsep)
     return path
+
+
+# Protocol registries that can be trimmed at build time:
+# option name -> (define prefix, registry source with `#ifdef <prefix>_<NAME>` entries,
+# protocols built regardless of selection)
+PROTOCOL_REGISTRIES = {
+    # Read RAW and saved RAW files look raw up by name
+    "SUBGHZ_PROTOCOLS": ("SUBGHZ_PROTOCOL", "lib/subghz/protocols/protocol_items.c", ("raw",)),
+    "INFRARED_PROTOCOLS": ("INFRARED_PROTOCOL", "lib/infrared/encoder_decoder/infrared.c", ()),
+}
+
+
+def get_protocol_selection_cdefines(env):
+    cdefines = []
+    for option, (prefix, registry, required) in PROTOCOL_REGISTRIES.items():
+        selected = env.get(option)
+        if isinstance(selected, str):
+            selected = selected.split(",")
+        selected = [name.strip().lower() for name in selected or () if name.strip()]
+        if not selected:
+            continue
+
+        source = env.File(f"#/{registry}").rfile().get_text_contents()
+        known = set(re.findall(rf"^#ifdef {prefix}_(\w+)$", source, re.MULTILINE))
+        for name in selected:
+            if name.upper() not in known:
+                raise StopError(
+                    f"{option}: unknown protocol '{name}', "
+                    f"available: {', '.join(sorted(n.lower() for n in known))}"
+                )
+        selected.extend(name for name in required if name not in selected)
+
+        cdefines.append(f"{prefix}S_SELECTED")
+        cdefines.extend(f"{prefix}_{name.upper()}" for name in selected)
+    return cdefines
@@ -15,6 +15,22 @@ Firmware & apps:
         Build and upload all FAP apps over USB
     
 
+Host:
+    host_build, host_benchmark:
+        Build protocol libraries for the host; run decoder benchmark
+    host_storage_benchmark:
+        Run storage service on the host, see BACKEND, CLIENTS
+    host_storage_int_benchmark:
+        Compare internal storage littlefs profiles, see INT_FILES, ROUNDS
+    host_hash_benchmark:
+        Measure CRC-32, MD5 and SHA-256 throughput on the host, see SIZE
+    host_heap_benchmark:
+        Compare heap allocators on the host, see TRACE, SESSIONS
+    host_bin_raw_benchmark:
+        Time BinRAW feed and burst analysis, digest its output, see OUTPUT, REPEATS
+    host_subghz_decode:
+        Decode SubGhz RAW recordings on all cores, see FILES, OUTPUT, ASSETS, JOBS
+
 Flashing & debugging:
     flash, jflash:
         Flash firmware to target using SWD probe. See also SWD_TRANSPORT, SWD_TRANSPORT_SERIAL
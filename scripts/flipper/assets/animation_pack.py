@@ -0,0 +1,153 @@
+import struct
+
+# Must match applications/services/desktop/animations/animation_pack.h
+PACK_FILENAME = "frames.pack"
+PACK_MAGIC = b"FBAP"
+PACK_VERSION = 1
+
+FRAME_TYPE_KEY = 0
+FRAME_TYPE_DELTA = 1
+
+HEADER_FORMAT = "<4sBBBBHH"
+INDEX_ENTRY_FORMAT = "<IHBB"
+
+RLE_LITERAL_MAX = 128
+RLE_RUN_MIN = 2
+RLE_RUN_MAX = 129
+
+# Longest delta chain to decode when playback jumps, e.g. on activation
+KEY_FRAME_INTERVAL = 8
+
+
+def rle_encode(data: bytes) -> bytes:
+    """PackBits: control < 0x80 is followed by (control + 1) literal bytes,
+    otherwise next byte is repeated (control - 0x80 + 2) times"""
+    output = bytearray()
+    literal = bytearray()
+
+    def flush_literal():
+        for start in range(0, len(literal), RLE_LITERAL_MAX):
+            chunk = literal[start : start + RLE_LITERAL_MAX]
+            output.append(len(chunk) - 1)
+            output.extend(chunk)
+        literal.clear()
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < RLE_RUN_MAX:
+            run += 1
+
+        # Two byte run in the middle of literal is cheaper as literal
+        if run > RLE_RUN_MIN or (run == RLE_RUN_MIN and not literal):
+            flush_literal()
+            output.append(0x80 + run - RLE_RUN_MIN)
+            output.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+
+    flush_literal()
+    return bytes(output)
+
+
+def rle_decode(data: bytes, size: int, base: bytes = None) -> bytes:
+    output = bytearray(base) if base else bytearray(size)
+    i = out = 0
+    while i < len(data):
+        control = data[i]
+        i += 1
+        if control < RLE_LITERAL_MAX:
+            count = control + 1
+            chunk = data[i : i + count]
+            i += count
+        else:
+            count = control - RLE_LITERAL_MAX + RLE_RUN_MIN
+            chunk = bytes([data[i]]) * count
+            i += 1
+        for value in chunk:
+            output[out] = (output[out] ^ value) if base else value
+            out += 1
+
+    assert out == size
+    return bytes(output)
+
+
+class AnimationPack:
+    def __init__(self, width: int, height: int):
+        self.width = width
+        self.height = height
+        self.frame_size = ((width + 7) // 8) * height
+        self.frames = []
+
+    def add_frame(self, data: bytes):
+        assert len(data) == self.frame_size, "Frame size doesn't match geometry"
+        self.frames.append(bytes(data))
+
+    def _encode_frames(self):
+        encoded = []
+        chain = 0
+        previous = None
+        for frame in self.frames:
+            key = rle_encode(frame)
+            frame_type, data = FRAME_TYPE_KEY, key
+            if previous is not None and chain < KEY_FRAME_INTERVAL:
+                delta = rle_encode(bytes(a ^ b for a, b in zip(previous, frame)))
+                if len(delta) < len(key):
+                    frame_type, data = FRAME_TYPE_DELTA, delta
+
+            chain = chain + 1 if frame_type == FRAME_TYPE_DELTA else 0
+            encoded.append((frame_type, data))
+            previous = frame
+
+        return encoded
+
+    def pack(self) -> bytes:
+        assert 0 < len(self.frames) < 256
+        encoded = self._encode_frames()
+        max_data_size = max(len(data) for _, data in encoded)
+
+        header = struct.pack(
+            HEADER_FORMAT,
+            PACK_MAGIC,
+            PACK_VERSION,
+            self.width,
+            self.height,
+            len(self.frames),
+            max_data_size,
+            0,
+        )
+
+        offset = len(header) + struct.calcsize(INDEX_ENTRY_FORMAT) * len(encoded)
+        index = bytearray()
+        for frame_type, data in encoded:
+            index += struct.pack(INDEX_ENTRY_FORMAT, offset, len(data), frame_type, 0)
+            offset += len(data)
+
+        return header + bytes(index) + b"".join(data for _, data in encoded)
+
+    @staticmethod
+    def unpack(data: bytes):
+        magic, version, width, height, frame_count, _, _ = struct.unpack_from(
+            HEADER_FORMAT, data
+        )
+        assert magic == PACK_MAGIC and version == PACK_VERSION
+
+        pack = AnimationPack(width, height)
+        entry_offset = struct.calcsize(HEADER_FORMAT)
+        previous = None
+        for _ in range(frame_count):
+            offset, size, frame_type, _ = struct.unpack_from(
+                INDEX_ENTRY_FORMAT, data, entry_offset
+            )
+            entry_offset += struct.calcsize(INDEX_ENTRY_FORMAT)
+            base = previous if frame_type == FRAME_TYPE_DELTA else None
+            previous = rle_decode(data[offset : offset + size], pack.frame_size, base)
+            pack.frames.append(previous)
+
+        return pack
+
+    def save(self, filename: str):
+        with open(filename, "wb") as file:
+            file.write(self.pack())
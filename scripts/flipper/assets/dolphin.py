@@ -5,13 +5,12 @@ from collections import Counter
 
 from flipper.utils.fff import FlipperFormatFile
 from flipper.utils.templite import Templite
-from .icon import ImageTools, file2image
+from .animation_pack import PACK_FILENAME, AnimationPack
+from .icon import ImageTools, file2image, file2xbm
 
 
-def _convert_image_to_bm(pair: set):
-    source_filename, destination_filename = pair
-    image = file2image(source_filename)
-    image.write(destination_filename)
+def _convert_image_to_xbm(source_filename: str):
+    return file2xbm(source_filename).data
 
 
 def _convert_image(source_filename: str):
@@ -218,18 +217,17 @@ class DolphinBubbleAnimation:
 
         file.save(meta_filename)
 
-        to_pack = []
-        for index, frame in enumerate(self.frames):
-            to_pack.append(
-                (frame, os.path.join(animation_directory, f"frame_{index}.bm"))
-            )
-
+        # All frames go to single pack file, streamed by firmware
         if ImageTools.is_processing_slow():
             pool = multiprocessing.Pool()
-            pool.map(_convert_image_to_bm, to_pack)
+            frames = pool.map(_convert_image_to_xbm, self.frames)
         else:
-            for image in to_pack:
-                _convert_image_to_bm(image)
+            frames = list(_convert_image_to_xbm(frame) for frame in self.frames)
+
+        pack = AnimationPack(self.meta["Width"], self.meta["Height"])
+        for frame in frames:
+            pack.add_frame(frame)
+        pack.save(os.path.join(animation_directory, PACK_FILENAME))
 
     def process(self):
         if ImageTools.is_processing_slow():
@@ -73,11 +73,26 @@ class ImageTools:
 
         return heatshrink2.compress(data, window_sz2=8, lookahead_sz2=4)
 
+    def hs2xbm(self, data):
+        if self.__hs2_unavailable:
+            return subprocess.check_output(
+                ["heatshrink", "-d", "-w8", "-l4"], input=data
+            )
+
+        try:
+            import heatshrink2
+        except ImportError:
+            self.__hs2_unavailable = True
+            self.logger.info("heatshrink2 module is missing, using heatshrink cli util")
+            return self.hs2xbm(data)
+
+        return heatshrink2.decompress(data, window_sz2=8, lookahead_sz2=4)
+
 
 __tools = ImageTools()
 
 
-def file2image(file):
+def file2xbm(file):
     output = __tools.png2xbm(file)
     assert output
 
@@ -88,7 +103,24 @@ def file2image(file):
     data = f.read().strip().replace("\n", "").replace(" ", "").split("=")[1][:-1]
     data_str = data[1:-1].replace(",", " ").replace("0x", "")
 
-    data_bin = bytearray.fromhex(data_str)
+    return Image(width, height, bytearray.fromhex(data_str))
+
+
+def bm2xbm(data: bytes):
+    # Inverse of file2image encoding: raw or LZSS compressed bitmap
+    if data[0] == 0x00:
+        return bytes(data[1:])
+
+    assert data[0] == 0x01 and data[1] == 0x00
+    size = data[2] | (data[3] << 8)
+    return bytes(__tools.hs2xbm(bytes(data[4 : 4 + size])))
+
+
+def file2image(file):
+    xbm = file2xbm(file)
+    width = xbm.width
+    height = xbm.height
+    data_bin = xbm.data
 
     # Encode icon data with LZSS
     data_encoded_str = __tools.xbm2hs(data_bin)
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+
+import re
+import subprocess
+
+from flipper.app import App
+from flipper.storage import FlipperStorage
+from flipper.utils.cdc import resolve_port
+
+HEADER_RE = re.compile(
+    r"memprof: period (\d+) depth (\d+) time (\d+) ms "
+    r"allocations (\d+) samples (\d+) dropped (\d+)"
+)
+SITE_RE = re.compile(
+    r"site (0x[0-9a-f]+) allocs (\d+) frees (\d+) bytes (\d+) live_bytes (\d+)"
+)
+SAMPLE_RE = re.compile(r"sample (\d+) (\d+)((?: 0x[0-9a-f]+)*)")
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("-p", "--port", help="CDC Port", default="auto")
+
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_start = self.subparsers.add_parser(
+            "start", help="Start profiler on device"
+        )
+        self.parser_start.add_argument(
+            "--period", help="Sample one of N allocations", type=int, default=64
+        )
+        self.parser_start.add_argument(
+            "--depth", help="Return addresses per sample, 1..4", type=int, default=1
+        )
+        self.parser_start.set_defaults(func=self.start)
+
+        self.parser_stop = self.subparsers.add_parser(
+            "stop", help="Stop profiler on device"
+        )
+        self.parser_stop.set_defaults(func=self.stop)
+
+        self.parser_dump = self.subparsers.add_parser(
+            "dump", help="Save profiler data from device"
+        )
+        self.parser_dump.add_argument("output", help="Dump file")
+        self.parser_dump.set_defaults(func=self.dump)
+
+        self.parser_report = self.subparsers.add_parser(
+            "report", help="Symbolize dump and print call sites"
+        )
+        self.parser_report.add_argument(
+            "input", help="Dump file, read from device if omitted", nargs="?"
+        )
+        self.parser_report.add_argument(
+            "--elf", help="Firmware ELF", default="build/latest/firmware.elf"
+        )
+        self.parser_report.add_argument(
+            "--addr2line", help="addr2line binary", default="arm-none-eabi-addr2line"
+        )
+        self.parser_report.add_argument(
+            "--sort",
+            help="Sort call sites by",
+            choices=("live", "bytes", "allocs"),
+            default="live",
+        )
+        self.parser_report.set_defaults(func=self.report)
+
+    def _command(self, line: str) -> str:
+        if not (port := resolve_port(self.logger, self.args.port)):
+            return None
+
+        storage = FlipperStorage(port)
+        storage.start()
+        try:
+            data = storage.send_and_wait_prompt(line + "\r")
+        finally:
+            storage.stop()
+
+        # Strip echoed command and prompt
+        lines = data.decode("ascii").split(FlipperStorage.CLI_EOL)
+        return FlipperStorage.CLI_EOL.join(lines[1:]).rstrip()
+
+    def start(self):
+        output = self._command(f"memprof start {self.args.period} {self.args.depth}")
+        if output is None:
+            return 1
+        self.logger.info(output)
+        return 0
+
+    def stop(self):
+        output = self._command("memprof stop")
+        if output is None:
+            return 1
+        return 0
+
+    def _fetch(self) -> str:
+        output = self._command("memprof dump")
+        if output is not None and not HEADER_RE.search(output):
+            self.logger.error(output)
+            return None
+        return output
+
+    def dump(self):
+        if (output := self._fetch()) is None:
+            return 1
+        with open(self.args.output, "w") as f:
+            f.write(output + "\n")
+        self.logger.info(f"Saved to {self.args.output}")
+        return 0
+
+    def _symbolize(self, addresses):
+        # Return address points after the call, step back into it
+        addresses = sorted(set(addresses))
+        if not addresses:
+            return {}
+        cmd = [self.args.addr2line, "-f", "-C", "-e", self.args.elf]
+        cmd.extend(hex((address & ~1) - 1) for address in addresses)
+        try:
+            output = subprocess.check_output(cmd, text=True).splitlines()
+        except (OSError, subprocess.CalledProcessError) as e:
+            self.logger.warning(f"Symbolization failed: {e}")
+            return {}
+
+        symbols = {}
+        for index, address in enumerate(addresses):
+            function, location = output[index * 2], output[index * 2 + 1]
+            location = location.split(" ")[0]
+            symbols[address] = f"{function} {location}"
+        return symbols
+
+    def report(self):
+        if self.args.input:
+            with open(self.args.input) as f:
+                data = f.read()
+        elif (data := self._fetch()) is None:
+            return 1
+
+        header = HEADER_RE.search(data)
+        if not header:
+            self.logger.error("No profiler header in dump")
+            return 1
+        period, depth, time_ms, allocations, samples, dropped = map(
+            int, header.groups()
+        )
+
+        sites = []
+        for match in SITE_RE.finditer(data):
+            pc = int(match.group(1), 16)
+            sites.append((pc, *map(int, match.groups()[1:])))
+        stacks = []
+        for match in SAMPLE_RE.finditer(data):
+            stack = [int(pc, 16) for pc in match.group(3).split()]
+            stacks.append((int(match.group(1)), int(match.group(2)), stack))
+
+        symbols = self._symbolize(
+            [site[0] for site in sites] + [pc for _, _, stack in stacks for pc in stack]
+        )
+
+        print(
+            f"Period {period}, {time_ms} ms, {allocations} allocations, "
+            f"{samples} samples, {dropped} dropped"
+        )
+        if dropped:
+            print("Some samples were not accounted, figures are lower bounds")
+        print()
+
+        # Every sample stands for `period` allocations
+        key = {"live": 4, "bytes": 3, "allocs": 1}[self.args.sort]
+        sites.sort(key=lambda site: site[key], reverse=True)
+        print(f"{'live':>10} {'bytes':>10} {'allocs':>8} {'frees':>8}  call site")
+        for pc, allocs, frees, nbytes, live in sites:
+            print(
+                f"{live * period:>10} {nbytes * period:>10} "
+                f"{allocs * period:>8} {frees * period:>8}  "
+                f"0x{pc:08x} {symbols.get(pc, '')}"
+            )
+
+        if stacks and depth > 1:
+            print()
+            print("Recent samples:")
+            for tick, size, stack in stacks:
+                print(f"{tick:>10} {size:>6}")
+                for pc in stack:
+                    print(f"{'':>18}0x{pc:08x} {symbols.get(pc, '')}")
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -1,5 +1,6 @@
 #!/usr/bin/env python3
 
+import io
 import math
 import os
 import shutil
@@ -23,6 +24,10 @@ class Main(App):
     RESOURCE_TAR_FORMAT = tarfile.USTAR_FORMAT
     RESOURCE_FILE_NAME = "resources.tar"
     RESOURCE_ENTRY_NAME_MAX_LENGTH = 100
+    # Must match firmware's TAR_ARCHIVE_COMPRESSED_SUFFIX & decoder parameters
+    RESOURCE_COMPRESSED_SUFFIX = ".hs"
+    RESOURCE_HEATSHRINK_WINDOW_SZ2 = 8
+    RESOURCE_HEATSHRINK_LOOKAHEAD_SZ2 = 4
 
     WHITELISTED_STACK_TYPES = set(
         map(
@@ -52,6 +57,12 @@ class Main(App):
             "--dfu", dest="dfu", default="", required=False
         )
         self.parser_generate.add_argument("-r", dest="resources", required=False)
+        self.parser_generate.add_argument(
+            "--compress-resources",
+            dest="compress_resources",
+            action="store_true",
+            help="Store resource files as heatshrink-compressed members",
+        )
         self.parser_generate.add_argument("--stage", dest="stage", required=True)
         self.parser_generate.add_argument(
             "--radio", dest="radiobin", default="", required=False
@@ -216,16 +227,48 @@ class Main(App):
         tarinfo.uname = tarinfo.gname = "furippa"
         return tarinfo
 
+    def _add_compressed_resources(self, tarball: tarfile.TarFile, srcdir: str):
+        import heatshrink2
+
+        for dirpath, dirnames, filenames in os.walk(srcdir):
+            dirnames.sort()
+            arc_dirpath = os.path.relpath(dirpath, srcdir).replace(os.sep, "/")
+            if arc_dirpath != ".":
+                dirinfo = tarball.gettarinfo(dirpath, arc_dirpath)
+                tarball.addfile(self._tar_filter(dirinfo))
+            for filename in sorted(filenames):
+                file_path = join(dirpath, filename)
+                arcname = (
+                    filename if arc_dirpath == "." else f"{arc_dirpath}/{filename}"
+                )
+                with open(file_path, "rb") as f:
+                    data = f.read()
+                compressed = heatshrink2.compress(
+                    data,
+                    window_sz2=self.RESOURCE_HEATSHRINK_WINDOW_SZ2,
+                    lookahead_sz2=self.RESOURCE_HEATSHRINK_LOOKAHEAD_SZ2,
+                )
+                # Only keep compressed form when it actually saves space
+                if len(compressed) < len(data):
+                    arcname += self.RESOURCE_COMPRESSED_SUFFIX
+                    data = compressed
+                tarinfo = self._tar_filter(tarball.gettarinfo(file_path, arcname))
+                tarinfo.size = len(data)
+                tarball.addfile(tarinfo, io.BytesIO(data))
+
     def package_resources(self, srcdir: str, dst_name: str):
         try:
             with tarfile.open(
                 dst_name, self.RESOURCE_TAR_MODE, format=self.RESOURCE_TAR_FORMAT
             ) as tarball:
-                tarball.add(
-                    srcdir,
-                    arcname="",
-                    filter=self._tar_filter,
-                )
+                if self.args.compress_resources:
+                    self._add_compressed_resources(tarball, srcdir)
+                else:
+                    tarball.add(
+                        srcdir,
+                        arcname="",
+                        filter=self._tar_filter,
+                    )
             return True
         except ValueError as e:
             self.logger.error(f"Cannot package resources: {e}")